@@ -5,8 +5,13 @@
 
 set ( SHELL ${ENABLE_SHELL} )
 set ( UNIT_TEST ${ENABLE_UNIT_TESTS} )
+set ( BENCHMARK_TEST ${ENABLE_BENCHMARK_TESTS} )
 set ( PIGLET ${ENABLE_PIGLET} )
 
+if ( ENABLE_BENCHMARK_TESTS AND NOT ENABLE_UNIT_TESTS )
+    message ( FATAL_ERROR "benchmarks run through the catch harness; configure with ENABLE_UNIT_TESTS too" )
+endif ()
+
 if ( NOT ENABLE_COREFILES )
     set ( NOCOREFILE ON )
 endif ( NOT ENABLE_COREFILES )
@@ -17,6 +22,7 @@ set ( USE_TSC_CLOCK ${ENABLE_TSC_CLOCK} )
 set ( NO_PROFILER ${DISABLE_SNORT_PROFILER} )
 set ( DEEP_PROFILING ${ENABLE_DEEP_PROFILING} )
 set ( NO_MEM_MGR ${DISABLE_MEMORY_MANAGER} )
+set ( NO_TRACE ${DISABLE_SNORT_TRACE} )
 
 if ( ENABLE_LARGE_PCAP )
     set ( _FILE_OFFSET_BITS 64 )
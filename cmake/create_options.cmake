@@ -17,6 +17,7 @@ option ( ENABLE_STATIC_DAQ "link static DAQ modules" ON )
 # features
 option ( ENABLE_SHELL "enable shell support" OFF )
 option ( ENABLE_UNIT_TESTS "enable unit tests" OFF )
+option ( ENABLE_BENCHMARK_TESTS "enable micro benchmarks run by the perf-bench target (requires unit tests)" OFF )
 option ( ENABLE_PIGLET "enable piglet test harness" OFF )
 
 option ( ENABLE_COREFILES "Prevent Snort from generating core files" ON )
@@ -43,6 +44,7 @@ option ( ENABLE_PROFILE "Enable profiling options (developers only)" OFF )
 option ( DISABLE_SNORT_PROFILER "Disable snort Profiler (developers only)" OFF )
 option ( ENABLE_DEEP_PROFILING "Enable deep profiling of snort functions (developers only)" OFF )
 option ( DISABLE_MEMORY_MANAGER "Disable snort memory manager (developers only)" OFF )
+option ( DISABLE_SNORT_TRACE "Compile out trace message emission (production builds)" OFF )
 option ( ENABLE_ADDRESS_SANITIZER "enable address sanitizer support" OFF )
 option ( ENABLE_THREAD_SANITIZER "enable thread sanitizer support" OFF )
 option ( ENABLE_UB_SANITIZER "enable undefined behavior sanitizer support" OFF )
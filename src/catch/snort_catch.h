@@ -27,6 +27,13 @@
 // provide test cases from dynamic plugins to the global list of tests to be
 // run. This header should be used instead of including catch.hpp directly.
 
+// micro benchmarks ride the same catch session; the define must precede
+// catch.hpp in every translation unit, which including config.h first
+// guarantees
+#ifdef BENCHMARK_TEST
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#endif
+
 // pragma for running unit tests on dynamic modules
 #pragma GCC visibility push(default)
 #include "catch.hpp"
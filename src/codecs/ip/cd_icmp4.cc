@@ -129,8 +129,7 @@ void Icmp4Codec::get_protocol_ids(std::vector<ProtocolId>& v)
 
 inline bool Icmp4Codec::valid_checksum_from_daq(const RawData& raw)
 {
-    const DAQ_PktDecodeData_t* pdd =
-        (const DAQ_PktDecodeData_t*) daq_msg_get_meta(raw.daq_msg, DAQ_PKT_META_DECODE_DATA);
+    const DAQ_PktDecodeData_t* pdd = raw.pkt_decode_data;
     if (!pdd || !pdd->flags.bits.l4_checksum || !pdd->flags.bits.icmp || !pdd->flags.bits.l4)
         return false;
     // Sanity check to make sure we're talking about the same thing if offset is available
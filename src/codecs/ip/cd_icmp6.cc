@@ -118,8 +118,7 @@ void Icmp6Codec::get_protocol_ids(std::vector<ProtocolId>& v)
 
 inline bool Icmp6Codec::valid_checksum_from_daq(const RawData& raw)
 {
-    const DAQ_PktDecodeData_t* pdd =
-        (const DAQ_PktDecodeData_t*) daq_msg_get_meta(raw.daq_msg, DAQ_PKT_META_DECODE_DATA);
+    const DAQ_PktDecodeData_t* pdd = raw.pkt_decode_data;
     if (!pdd || !pdd->flags.bits.l4_checksum || !pdd->flags.bits.icmp || !pdd->flags.bits.l4)
         return false;
     // Sanity check to make sure we're talking about the same thing if offset is available
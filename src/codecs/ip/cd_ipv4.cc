@@ -28,6 +28,7 @@
 #include <random>
 
 #include "codecs/codec_module.h"
+#include "detection/signature.h"
 #include "framework/codec.h"
 #include "log/log_text.h"
 #include "log/messages.h"
@@ -53,6 +54,7 @@ const PegInfo pegs[]
 {
     { CountType::SUM, "bad_checksum", "nonzero ip checksums" },
     { CountType::SUM, "checksum_bypassed", "checksum calculations bypassed" },
+    { CountType::SUM, "option_scans_elided", "option misc scans skipped (no decoder rule consumes them)" },
     { CountType::END, nullptr, nullptr }
 };
 
@@ -60,6 +62,7 @@ struct Stats
 {
     PegCount bad_cksum;
     PegCount cksum_bypassed;
+    PegCount opt_scans_elided;
 };
 
 static THREAD_LOCAL Stats stats;
@@ -131,8 +134,7 @@ private:
 
 inline bool Ipv4Codec::valid_checksum_from_daq(const RawData& raw)
 {
-    const DAQ_PktDecodeData_t* pdd =
-        (const DAQ_PktDecodeData_t*) daq_msg_get_meta(raw.daq_msg, DAQ_PKT_META_DECODE_DATA);
+    const DAQ_PktDecodeData_t* pdd = raw.pkt_decode_data;
     if (!pdd || !pdd->flags.bits.l3_checksum || !pdd->flags.bits.ipv4 || !pdd->flags.bits.l3)
         return false;
     // Sanity check to make sure we're talking about the same thing if offset is available
@@ -157,6 +159,24 @@ void Ipv4Codec::get_protocol_ids(std::vector<ProtocolId>& v)
     v.emplace_back(ProtocolId::IPIP);
 }
 
+// IPMiscTests makes a second pass over the options solely to raise
+// 116:DECODE_ICMP_DOS_ATTEMPT and 116:DECODE_IP_OPTION_SET; when neither
+// rule is in the current policy the pass produces nothing and can be
+// skipped.  the answer is memoized per config for reload safety.
+static bool ip_misc_rules_active(const SnortConfig* conf)
+{
+    static THREAD_LOCAL const SnortConfig* last_conf = nullptr;
+    static THREAD_LOCAL bool active = true;
+
+    if ( conf != last_conf )
+    {
+        active = GetOTN(GID_DECODE, DECODE_ICMP_DOS_ATTEMPT)
+            or GetOTN(GID_DECODE, DECODE_IP_OPTION_SET);
+        last_conf = conf;
+    }
+    return active;
+}
+
 bool Ipv4Codec::decode(const RawData& raw, CodecData& codec, DecodeData& snort)
 {
     uint32_t ip_len; /* length from the start of the ip hdr to the pkt end */
@@ -241,7 +261,7 @@ bool Ipv4Codec::decode(const RawData& raw, CodecData& codec, DecodeData& snort)
     // set the api now since this layer has been verified as valid
     snort.ip_api.set(iph);
     // update to real IP when needed
-    const DAQ_NAPTInfo_t* napti = (const DAQ_NAPTInfo_t*) daq_msg_get_meta(raw.daq_msg, DAQ_PKT_META_NAPT_INFO);
+    const DAQ_NAPTInfo_t* napti = raw.napt_info;
     if (napti && codec.ip_layer_cnt == 1)
     {
         SfIp real_src;
@@ -332,7 +352,13 @@ bool Ipv4Codec::decode(const RawData& raw, CodecData& codec, DecodeData& snort)
 
     snort.set_pkt_type(PktType::IP);
     codec.proto_bits |= PROTO_BIT__IP;
-    IPMiscTests(iph, codec, ip::IP4_HEADER_LEN + ip_opt_len);
+    if ( ip_opt_len )
+    {
+        if ( ip_misc_rules_active(codec.conf) )
+            IPMiscTests(iph, codec, ip::IP4_HEADER_LEN + ip_opt_len);
+        else
+            stats.opt_scans_elided++;
+    }
 
     codec.lyr_len = hlen - codec.invalid_bytes;
     codec.curr_ip6_extension = 0;  // necessary since next protos numbers share
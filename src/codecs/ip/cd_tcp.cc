@@ -152,8 +152,7 @@ void TcpCodec::get_protocol_ids(std::vector<ProtocolId>& v)
 
 inline bool TcpCodec::valid_checksum_from_daq(const RawData& raw)
 {
-    const DAQ_PktDecodeData_t* pdd =
-        (const DAQ_PktDecodeData_t*) daq_msg_get_meta(raw.daq_msg, DAQ_PKT_META_DECODE_DATA);
+    const DAQ_PktDecodeData_t* pdd = raw.pkt_decode_data;
     if (!pdd || !pdd->flags.bits.l4_checksum || !pdd->flags.bits.tcp || !pdd->flags.bits.l4)
         return false;
     // Sanity check to make sure we're talking about the same thing if offset is available
@@ -270,7 +269,7 @@ bool TcpCodec::decode(const RawData& raw, CodecData& codec, DecodeData& snort)
     snort.set_pkt_type(PktType::TCP);
     snort.tcph = tcph;
 
-    const DAQ_NAPTInfo_t* napti = (const DAQ_NAPTInfo_t*) daq_msg_get_meta(raw.daq_msg, DAQ_PKT_META_NAPT_INFO);
+    const DAQ_NAPTInfo_t* napti = raw.napt_info;
     if (napti && codec.ip_layer_cnt == 1)
     {
         snort.sp = ntohs(napti->src_port);
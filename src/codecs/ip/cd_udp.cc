@@ -238,8 +238,7 @@ private:
 
 inline bool UdpCodec::valid_checksum_from_daq(const RawData& raw)
 {
-    const DAQ_PktDecodeData_t* pdd =
-        (const DAQ_PktDecodeData_t*) daq_msg_get_meta(raw.daq_msg, DAQ_PKT_META_DECODE_DATA);
+    const DAQ_PktDecodeData_t* pdd = raw.pkt_decode_data;
     if (!pdd || !pdd->flags.bits.l4_checksum || !pdd->flags.bits.udp || !pdd->flags.bits.l4)
         return false;
     // Sanity check to make sure we're talking about the same thing if offset is available
@@ -391,7 +390,7 @@ bool UdpCodec::decode(const RawData& raw, CodecData& codec, DecodeData& snort)
     uint16_t src_port;
     uint16_t dst_port;
 
-    const DAQ_NAPTInfo_t* napti = (const DAQ_NAPTInfo_t*) daq_msg_get_meta(raw.daq_msg, DAQ_PKT_META_NAPT_INFO);
+    const DAQ_NAPTInfo_t* napti = raw.napt_info;
     if (napti && codec.ip_layer_cnt == 1)
     {
         src_port = ntohs(napti->src_port);
@@ -24,6 +24,14 @@
 
 #include <protocols/protocol_ids.h>
 
+#if defined(__x86_64__) && defined(__GNUC__)
+#define CHECKSUM_AVX2
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define CHECKSUM_NEON
+#include <arm_neon.h>
+#endif
+
 namespace checksum
 {
 union Pseudoheader
@@ -79,6 +87,60 @@ inline uint16_t ip_cksum(const uint16_t* buf, std::size_t len);
  */
 namespace detail
 {
+// wide kernels for the bulk of the payload; they consume whole vectors and
+// leave the remainder (and the final fold) to the scalar code below.  the
+// ones complement sum is commutative, so accumulating 16 bit words in 32
+// bit lanes and reducing at the end gives the same result as the serial
+// fold as long as the lanes cannot overflow - at two words per lane per
+// step that would take far more than 64KB, the maximum datagram size.
+#ifdef CHECKSUM_AVX2
+__attribute__((target("avx2")))
+inline uint32_t cksum_wide(const uint16_t*& sp, std::size_t& len, uint32_t cksum)
+{
+    __m256i acc = _mm256_setzero_si256();
+    const __m256i wmask = _mm256_set1_epi32(0xFFFF);
+
+    while ( len >= 32 )
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sp));
+        acc = _mm256_add_epi32(acc, _mm256_add_epi32(
+            _mm256_and_si256(v, wmask), _mm256_srli_epi32(v, 16)));
+        sp += 16;
+        len -= 32;
+    }
+
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(acc),
+        _mm256_extracti128_si256(acc, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4E));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xB1));
+
+    return cksum + static_cast<uint32_t>(_mm_cvtsi128_si32(s));
+}
+
+inline bool have_cksum_wide()
+{
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2;
+}
+#elif defined(CHECKSUM_NEON)
+inline uint32_t cksum_wide(const uint16_t*& sp, std::size_t& len, uint32_t cksum)
+{
+    uint32x4_t acc = vdupq_n_u32(0);
+
+    while ( len >= 16 )
+    {
+        acc = vpadalq_u16(acc, vld1q_u16(sp));
+        sp += 8;
+        len -= 16;
+    }
+
+    return cksum + vaddvq_u32(acc);
+}
+
+inline bool have_cksum_wide()
+{ return true; }
+#endif
+
 inline uint16_t cksum_add(const uint16_t* buf, std::size_t len, uint32_t cksum)
 {
     const uint16_t* sp = buf;
@@ -87,6 +149,10 @@ inline uint16_t cksum_add(const uint16_t* buf, std::size_t len, uint32_t cksum)
     // gcc 5.4 -O3 generates unaligned quadword instructions that crash; fixed in gcc 8.0.1
     if ( !( reinterpret_cast<std::uintptr_t>(sp) & 0x01 ) )
     {
+#if defined(CHECKSUM_AVX2) || defined(CHECKSUM_NEON)
+        if ( len >= 64 and have_cksum_wide() )
+            cksum = cksum_wide(sp, len, cksum);
+#endif
         while ( len > 1 )
         {
             cksum += *sp++;
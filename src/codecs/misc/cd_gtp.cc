@@ -25,6 +25,7 @@
 #include "codecs/codec_module.h"
 #include "framework/codec.h"
 #include "main/snort_config.h"
+#include "main/thread.h"
 
 using namespace snort;
 
@@ -72,12 +73,53 @@ struct GTPHdr
     uint8_t type;
     uint16_t length;
 };
+
+/* Template of the last validated v1 extension header chain.  Tunnels emit
+ * back to back packets with the same header shape, so remember the bytes
+ * that drive the layout and skip the bounds checked walk when they repeat.
+ * TEID, sequence number and extension payloads may differ per packet and
+ * are not part of the template. */
+#define GTP_TEMPLATE_MAX_EXTS 4
+
+struct GTPDecapTemplate
+{
+    uint32_t raw_len;
+    uint16_t lyr_len;
+    uint8_t flag;
+    uint8_t num_exts;
+    uint8_t first_next_type;
+    uint16_t ext_off[GTP_TEMPLATE_MAX_EXTS];
+    uint8_t ext_len[GTP_TEMPLATE_MAX_EXTS];
+    uint8_t ext_next[GTP_TEMPLATE_MAX_EXTS];
+};
 } // anonymous namespace
 
+static THREAD_LOCAL GTPDecapTemplate gtp_template;
+
 static const uint32_t GTP_MIN_LEN = 8;
 static const uint32_t GTP_V0_HEADER_LEN = 20;
 static const uint32_t GTP_V1_HEADER_LEN = 12;
 
+static inline bool gtp_template_match(const RawData& raw, const GTPHdr* hdr)
+{
+    if ((gtp_template.num_exts == 0) || (gtp_template.flag != hdr->flag) ||
+        (gtp_template.raw_len != raw.len) ||
+        (gtp_template.first_next_type != *(raw.data + GTP_V1_HEADER_LEN - 1)))
+        return false;
+
+    /* All offsets were bounds checked against the same raw length when the
+     * template was recorded */
+    for (uint8_t i = 0; i < gtp_template.num_exts; i++)
+    {
+        if ((*(raw.data + gtp_template.ext_off[i]) != gtp_template.ext_len[i]) ||
+            (*(raw.data + gtp_template.ext_off[i] + (gtp_template.ext_len[i] * 4) - 1) !=
+            gtp_template.ext_next[i]))
+            return false;
+    }
+
+    return true;
+}
+
 void GtpCodec::get_protocol_ids(std::vector<ProtocolId>& v)
 {
     v.emplace_back(ProtocolId::GTP);
@@ -130,34 +172,65 @@ bool GtpCodec::decode(const RawData& raw, CodecData& codec, DecodeData& dd)
                 codec_event(codec, DECODE_GTP_BAD_LEN);
                 return false;
             }
-            uint8_t next_hdr_type = *(raw.data + len - 1);
 
-            /*Check extension headers*/
-            while (next_hdr_type)
+            if (gtp_template_match(raw, hdr))
+                len = gtp_template.lyr_len;
+            else
             {
-                uint16_t ext_hdr_len;
-                if (raw.len < (uint32_t)(len + 4))
-                {
-                    codec_event(codec, DECODE_GTP_BAD_LEN);
-                    return false;
-                }
+                uint8_t next_hdr_type = *(raw.data + len - 1);
+                uint8_t num_exts = 0;
+                bool fits = true;
 
-                ext_hdr_len = *(raw.data + len);
+                gtp_template.num_exts = 0;
+                gtp_template.first_next_type = next_hdr_type;
 
-                if (!ext_hdr_len)
+                /*Check extension headers*/
+                while (next_hdr_type)
                 {
-                    codec_event(codec, DECODE_GTP_BAD_LEN);
-                    return false;
+                    uint16_t ext_hdr_len;
+                    if (raw.len < (uint32_t)(len + 4))
+                    {
+                        codec_event(codec, DECODE_GTP_BAD_LEN);
+                        return false;
+                    }
+
+                    ext_hdr_len = *(raw.data + len);
+
+                    if (!ext_hdr_len)
+                    {
+                        codec_event(codec, DECODE_GTP_BAD_LEN);
+                        return false;
+                    }
+
+                    if (num_exts < GTP_TEMPLATE_MAX_EXTS)
+                    {
+                        gtp_template.ext_off[num_exts] = len;
+                        gtp_template.ext_len[num_exts] = (uint8_t)ext_hdr_len;
+                    }
+                    else
+                        fits = false;  /* chain too long to remember */
+
+                    /*Extension header length is a unit of 4 octets*/
+                    len += ext_hdr_len * 4;
+
+                    if (raw.len < len)
+                    {
+                        codec_event(codec, DECODE_GTP_BAD_LEN);
+                        return false;
+                    }
+                    next_hdr_type = *(raw.data + len - 1);
+
+                    if (num_exts < GTP_TEMPLATE_MAX_EXTS)
+                        gtp_template.ext_next[num_exts++] = next_hdr_type;
                 }
-                /*Extension header length is a unit of 4 octets*/
-                len += ext_hdr_len * 4;
 
-                if (raw.len < len)
+                if (fits && num_exts)
                 {
-                    codec_event(codec, DECODE_GTP_BAD_LEN);
-                    return false;
+                    gtp_template.num_exts = num_exts;
+                    gtp_template.raw_len = raw.len;
+                    gtp_template.lyr_len = len;
+                    gtp_template.flag = hdr->flag;
                 }
-                next_hdr_type = *(raw.data + len - 1);
             }
         }
         else
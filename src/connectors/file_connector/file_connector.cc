@@ -118,6 +118,31 @@ bool FileConnector::transmit_message(ConnectorMsgHandle* msg)
     return true;
 }
 
+uint8_t* FileConnector::reserve_message(const uint32_t length)
+{
+    const FileConnectorConfig* cfg = (const FileConnectorConfig*)config;
+
+    // text format needs the per-message formatting in transmit_message, so
+    // it stays on the alloc path
+    if ( cfg->text_format || cfg->direction == Connector::CONN_RECEIVE ||
+        sizeof(FileConnectorMsgHdr) + length > sizeof(tx_buf) )
+        return nullptr;
+
+    return tx_buf + sizeof(FileConnectorMsgHdr);
+}
+
+bool FileConnector::commit_message(const uint32_t length)
+{
+    *(FileConnectorMsgHdr*)tx_buf = FileConnectorMsgHdr(length);
+    file.write((const char*)tx_buf, sizeof(FileConnectorMsgHdr) + length);
+    return true;
+}
+
+void FileConnector::flush_transmit()
+{
+    file.flush();
+}
+
 ConnectorMsgHandle* FileConnector::receive_message_binary()
 {
     uint8_t* buffer = new uint8_t[MAXIMUM_SC_MESSAGE_CONTENT+sizeof(SCMsgHdr)+
@@ -29,6 +29,10 @@
 
 #define FILE_FORMAT_VERSION (1)
 
+// staging buffer for reserved messages; sized for the largest side
+// channel message plus headers
+#define FILE_CONNECTOR_TX_BUF_SIZE (2048)
+
 //-------------------------------------------------------------------------
 // class stuff
 //-------------------------------------------------------------------------
@@ -66,6 +70,9 @@ public:
     void discard_message(snort::ConnectorMsgHandle*) override;
     bool transmit_message(snort::ConnectorMsgHandle*) override;
     snort::ConnectorMsgHandle* receive_message(bool) override;
+    uint8_t* reserve_message(const uint32_t) override;
+    bool commit_message(const uint32_t) override;
+    void flush_transmit() override;
 
     snort::ConnectorMsg* get_connector_msg(snort::ConnectorMsgHandle* handle) override
     { return( &((FileConnectorMsgHandle*)handle)->connector_msg ); }
@@ -77,6 +84,7 @@ public:
 private:
     snort::ConnectorMsgHandle* receive_message_binary();
     snort::ConnectorMsgHandle* receive_message_text();
+    uint8_t tx_buf[FILE_CONNECTOR_TX_BUF_SIZE];
 };
 
 #endif
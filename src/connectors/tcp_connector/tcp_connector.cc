@@ -230,6 +230,7 @@ TcpConnector::TcpConnector(TcpConnectorConfig* tcp_connector_config, int sfd)
 TcpConnector::~TcpConnector()
 {
     stop_receive_thread();
+    flush_transmit();
     delete receive_ring;
     close(sock_fd);
 }
@@ -249,10 +250,56 @@ void TcpConnector::discard_message(ConnectorMsgHandle* msg)
     delete tmsg;
 }
 
+uint8_t* TcpConnector::reserve_message(const uint32_t length)
+{
+    const uint32_t framed_length = sizeof(TcpConnectorMsgHdr) + length;
+
+    if ( sock_fd < 0 || length > UINT16_MAX || framed_length > sizeof(tx_buf) )
+        return nullptr;
+
+    if ( tx_used + framed_length > sizeof(tx_buf) )
+        flush_transmit();
+
+    return tx_buf + tx_used + sizeof(TcpConnectorMsgHdr);
+}
+
+bool TcpConnector::commit_message(const uint32_t length)
+{
+    *(TcpConnectorMsgHdr*)(tx_buf + tx_used) = TcpConnectorMsgHdr(length);
+    tx_used += sizeof(TcpConnectorMsgHdr) + length;
+    return true;
+}
+
+void TcpConnector::flush_transmit()
+{
+    uint32_t offset = 0;
+
+    while ( offset < tx_used )
+    {
+        ssize_t sent = send(sock_fd, (const char*)tx_buf + offset, tx_used - offset, 0);
+
+        if ( sent <= 0 )
+        {
+            if ( sent < 0 && (errno == EINTR || errno == EAGAIN) )
+                continue;
+
+            ErrorMessage("TcpConnector: failed to flush transmit buffer\n");
+            break;
+        }
+
+        offset += sent;
+    }
+
+    tx_used = 0;
+}
+
 bool TcpConnector::transmit_message(ConnectorMsgHandle* msg)
 {
     TcpConnectorMsgHandle* tmsg = (TcpConnectorMsgHandle*)msg;
 
+    // don't reorder individually transmitted messages around batched ones
+    flush_transmit();
+
     if ( sock_fd < 0 )
     {
         ErrorMessage("TcpConnector: transmitting to a closed socket\n");
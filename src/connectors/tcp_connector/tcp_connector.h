@@ -30,6 +30,10 @@
 
 #define TCP_FORMAT_VERSION (1)
 
+// committed messages accumulate here and go out in one send() when the
+// buffer can't take the next message, or on an explicit flush
+#define TCP_CONNECTOR_TX_BUF_SIZE (8192)
+
 //-------------------------------------------------------------------------
 // class stuff
 //-------------------------------------------------------------------------
@@ -71,6 +75,9 @@ public:
     void discard_message(snort::ConnectorMsgHandle*) override;
     bool transmit_message(snort::ConnectorMsgHandle*) override;
     snort::ConnectorMsgHandle* receive_message(bool) override;
+    uint8_t* reserve_message(const uint32_t) override;
+    bool commit_message(const uint32_t) override;
+    void flush_transmit() override;
 
     snort::ConnectorMsg* get_connector_msg(snort::ConnectorMsgHandle* handle) override
     { return( &((TcpConnectorMsgHandle*)handle)->connector_msg ); }
@@ -87,6 +94,8 @@ private:
     void stop_receive_thread();
     void receive_processing_thread();
     ReceiveRing* receive_ring;
+    uint8_t tx_buf[TCP_CONNECTOR_TX_BUF_SIZE];
+    uint32_t tx_used = 0;
 };
 
 #endif
@@ -27,6 +27,7 @@
 #include <cassert>
 
 #include "detection/detection_util.h"
+#include "main/thread.h"
 #include "utils/util.h"
 
 #include "file_decomp_pdf.h"
@@ -313,6 +314,27 @@ fd_status_t File_Decomp(fd_session_t* SessionPtr)
         (SessionPtr->Next_In == nullptr) || (SessionPtr->Next_Out == nullptr) )
         return( File_Decomp_Error );
 
+    /* Enforce the session work budgets.  Processing is already incremental
+       per packet; the budgets bound the total effort one file can demand.
+       An exhausted budget completes the session and the callers revert to
+       forwarding the raw stream. */
+    if ( ((SessionPtr->Compr_Depth != 0) &&
+        (SessionPtr->Total_In >= SessionPtr->Compr_Depth)) ||
+        ((SessionPtr->Decompr_Depth != 0) &&
+        (SessionPtr->Total_Out >= SessionPtr->Decompr_Depth)) )
+    {
+        SessionPtr->State = STATE_COMPLETE;
+        return( File_Decomp_Complete );
+    }
+
+    if ( (SessionPtr->Compr_Depth != 0) &&
+        (SessionPtr->Total_In + SessionPtr->Avail_In > SessionPtr->Compr_Depth) )
+        SessionPtr->Avail_In = SessionPtr->Compr_Depth - SessionPtr->Total_In;
+
+    if ( (SessionPtr->Decompr_Depth != 0) &&
+        (SessionPtr->Total_Out + SessionPtr->Avail_Out > SessionPtr->Decompr_Depth) )
+        SessionPtr->Avail_Out = SessionPtr->Decompr_Depth - SessionPtr->Total_Out;
+
     /* STATE_NEW: Look for one of the configured file signatures. */
     if ( SessionPtr->State == STATE_READY )
     {
@@ -417,6 +439,62 @@ void File_Decomp_Alert(fd_session_t* SessionPtr, int Event)
         (SessionPtr->Alert_Callback)(SessionPtr->Alert_Context, Event);
 }
 
+/* Every zlib inflate stream makes the same two allocations: the internal
+   state structure and the sliding window (~40KB together).  The ZIP parser
+   opens a fresh stream per archive entry, so an office document costs one
+   such pair per member file.  Keep a few freed blocks per thread and hand
+   them back to zlib on the next init instead of going to the heap. */
+#define ZSTATE_CACHE_SLOTS (8)
+
+/* Each block carries its size so a freed block can be matched to a later
+   request.  The header is 8 bytes to preserve alignment for zlib. */
+#define ZSTATE_HDR_LEN (8)
+
+static THREAD_LOCAL struct
+{
+    uint8_t* Base;
+    uint32_t Size;
+} ZState_Cache[ZSTATE_CACHE_SLOTS];
+
+void* File_Decomp_ZAlloc(void*, unsigned Items, unsigned Size)
+{
+    const uint32_t Total = (uint32_t)Items * Size;
+
+    for ( int Slot=0; Slot < ZSTATE_CACHE_SLOTS; Slot++ )
+    {
+        if ( (ZState_Cache[Slot].Base != nullptr) && (ZState_Cache[Slot].Size == Total) )
+        {
+            uint8_t* Base = ZState_Cache[Slot].Base;
+            ZState_Cache[Slot].Base = nullptr;
+            return( Base + ZSTATE_HDR_LEN );
+        }
+    }
+
+    uint8_t* Base = (uint8_t*)snort_alloc(ZSTATE_HDR_LEN + Total);
+    *(uint32_t*)Base = Total;
+    return( Base + ZSTATE_HDR_LEN );
+}
+
+void File_Decomp_ZFree(void*, void* Address)
+{
+    if ( Address == nullptr )
+        return;
+
+    uint8_t* Base = (uint8_t*)Address - ZSTATE_HDR_LEN;
+
+    for ( int Slot=0; Slot < ZSTATE_CACHE_SLOTS; Slot++ )
+    {
+        if ( ZState_Cache[Slot].Base == nullptr )
+        {
+            ZState_Cache[Slot].Base = Base;
+            ZState_Cache[Slot].Size = *(uint32_t*)Base;
+            return;
+        }
+    }
+
+    snort_free(Base);
+}
+
 } // namespace snort
 
 //--------------------------------------------------------------------------
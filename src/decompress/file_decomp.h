@@ -66,6 +66,13 @@ enum file_compression_type_t
 #define FILE_SWF_ANY         (FILE_SWF_LZMA_BIT | FILE_SWF_ZLIB_BIT)
 #define FILE_ZIP_ANY         (FILE_ZIP_DEFL_BIT)
 
+/* Default session work budgets, in bytes.  Callers without their own depth
+   configuration use these so one malformed file can't pin a packet thread;
+   when a budget runs out the session completes and the raw stream passes
+   through unmodified. */
+#define FILE_DECOMP_DEFAULT_COMPR_BUDGET    (16777216)
+#define FILE_DECOMP_DEFAULT_DECOMPR_BUDGET  (67108864)
+
 /* Error codes either passed to caller via the session->Error_Alert of
    the File_Decomp_Alert() call-back function. */
 enum FileDecompError
@@ -124,7 +131,9 @@ struct fd_session_t
     uint32_t Total_Out;  // total number of bytes output so far
 
     // Configuration settings
-    // FIXIT-RC Compr_Depth and Decompr_Depth only support OHI and eventually should be removed
+    // Work budgets for the session: maximum compressed bytes consumed and
+    // decompressed bytes produced; 0 means unlimited.  Enforced by
+    // File_Decomp() so a crafted file can't demand unbounded effort.
     uint32_t Compr_Depth;
     uint32_t Decompr_Depth;
     uint32_t Modes;      // Bit mapped set of potential file/algo modes
@@ -302,6 +311,12 @@ SO_PUBLIC void File_Decomp_Free(fd_session_t*);
 
 /* Call the error alerting call-back function */
 SO_PUBLIC void File_Decomp_Alert(fd_session_t*, int Event);
+
+/* zalloc/zfree hooks for the zlib based decompressors.  Backed by a small
+   per-thread cache so consecutive streams reuse the inflate state and
+   sliding window allocations instead of hitting the heap per stream. */
+SO_PUBLIC void* File_Decomp_ZAlloc(void* Opaque, unsigned Items, unsigned Size);
+SO_PUBLIC void File_Decomp_ZFree(void* Opaque, void* Address);
 }
 #endif
 
@@ -912,8 +912,8 @@ static fd_status_t Init_Stream(fd_session_t* SessionPtr)
 
         memset( (char*)z_s, 0, sizeof(z_stream));
 
-        z_s->zalloc = (alloc_func)nullptr;
-        z_s->zfree = (free_func)nullptr;
+        z_s->zalloc = (alloc_func)File_Decomp_ZAlloc;
+        z_s->zfree = (free_func)File_Decomp_ZFree;
         SYNC_IN(z_s)
 
         z_ret = inflateInit2(z_s, 47);
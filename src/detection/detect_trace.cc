@@ -114,7 +114,14 @@ void node_eval_trace(const detection_option_tree_node_t* node, const Cursor& cur
     const char* name = cursor.get_name();
     unsigned pos = cursor.get_pos();
 
-    if (node->option_type != RULE_OPTION_TYPE_LEAF_NODE )
+    if (node->option_type == RULE_OPTION_TYPE_FUSED )
+    {
+        // option_data is a fused chain of options, not a single IpsOption
+        debug_logf(detection_trace, TRACE_RULE_EVAL, p,
+            "Evaluating fused option chain, cursor name %s, cursor position %u\n",
+            name, pos);
+    }
+    else if (node->option_type != RULE_OPTION_TYPE_LEAF_NODE )
     {
         debug_logf(detection_trace, TRACE_RULE_EVAL, p,
             "Evaluating option %s, cursor name %s, cursor position %u\n",
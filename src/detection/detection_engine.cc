@@ -36,10 +36,13 @@
 #include "managers/inspector_manager.h"
 #include "managers/mpse_manager.h"
 #include "packet_io/active.h"
+#include "packet_io/sfdaq.h"
+#include "packet_io/sfdaq_instance.h"
 #include "parser/parser.h"
 #include "profiler/profiler_defs.h"
 #include "protocols/packet.h"
 #include "stream/stream.h"
+#include "time/clock_defs.h"
 #include "utils/stats.h"
 
 #include "context_switcher.h"
@@ -55,6 +58,9 @@
 
 static THREAD_LOCAL RegexOffload* offloader = nullptr;
 
+// upper bound for detection.onload_quantum (see DetectionEngine::onload)
+#define ONLOAD_QUANTUM_MAX 64
+
 using namespace snort;
 
 //--------------------------------------------------------------------------
@@ -381,6 +387,9 @@ bool DetectionEngine::do_offload(Packet* p)
     offloader->put(p);
     pc.offloads++;
 
+    if ( (PegCount)offloader->count() > pc.offload_depth )
+        pc.offload_depth = offloader->count();
+
 #ifdef REG_TEST
     onload();
     return false;
@@ -394,11 +403,24 @@ bool DetectionEngine::offload(Packet* p)
     ContextSwitcher* sw = Analyzer::get_switcher();
     fp_partial(p);
 
-    if ( p->dsize >= p->context->conf->offload_limit and
-        p->context->searches.items.size() > 0 )
+    // when the last receive drained a full batch this thread is running a
+    // backlog, so fan out smaller pdus too instead of leaving the offload
+    // threads idle while this core saturates
+    uint32_t limit = p->context->conf->offload_limit;
+    const SFDAQInstance* daq = SFDAQ::get_local_instance();
+    bool boosted = daq and daq->was_full_batch();
+
+    if ( boosted )
+        limit >>= 1;
+
+    if ( p->dsize >= limit and p->context->searches.items.size() > 0 )
     {
         if ( offloader->available() )
+        {
+            if ( boosted and p->dsize < p->context->conf->offload_limit )
+                pc.offload_boosts++;
             return do_offload(p);
+        }
 
         pc.offload_busy++;
     }
@@ -438,8 +460,14 @@ void DetectionEngine::idle()
 
 void DetectionEngine::onload(Flow* flow)
 {
-    if ( flow->is_suspended() )
-        pc.onload_waits++;
+    if ( !flow->is_suspended() )
+    {
+        assert(!offloader->on_hold(flow));
+        return;
+    }
+    pc.onload_waits++;
+
+    hr_time t0 = SnortClock::now();
 
     while ( flow->is_suspended() )
     {
@@ -449,6 +477,7 @@ void DetectionEngine::onload(Flow* flow)
         resume_ready_suspends(flow->context_chain); // FIXIT-M makes onload reentrant-safe
         onload();
     }
+    pc.offload_wait_us += TO_USECS(SnortClock::now() - t0);
     assert(!offloader->on_hold(flow));
 }
 
@@ -457,15 +486,36 @@ void DetectionEngine::onload()
     Profile profile(mpsePerfStats);
     Packet* p;
 
-    while (offloader->count() and offloader->get(p))
+    // drain a quantum of completions before resuming anything so the
+    // contexts of a flow that have already returned are onloaded back to
+    // back while its stream state is warm, instead of in arrival order
+    // interleaved across flows
+    Packet* batch[ONLOAD_QUANTUM_MAX];
+    unsigned n = 0;
+
+    const unsigned quantum = SnortConfig::get_conf()->onload_quantum;
+
+    while ( n < quantum and offloader->count() and offloader->get(p) )
     {
         debug_logf(detection_trace, TRACE_DETECTION_ENGINE, p,
             "%" PRIu64 " de::onload %" PRIu64 " (r=%d)\n",
             p->context->packet_number, p->context->context_num, offloader->count());
 
         p->clear_offloaded();
+        batch[n++] = p;
+    }
+
+    for ( unsigned i = 0; i < n; i++ )
+    {
+        Packet* q = batch[i];
+
+        // a chain already walked for an earlier completion may have
+        // pulled this one along; contexts and their packets are pooled
+        // so the pointer stays valid after completion
+        if ( q->context->state != IpsContext::SUSPENDED )
+            continue;
 
-        IpsContextChain& chain = p->flow ? p->flow->context_chain :
+        IpsContextChain& chain = q->flow ? q->flow->context_chain :
             Analyzer::get_switcher()->non_flow_chain;
 
         resume_ready_suspends(chain);
@@ -74,9 +74,15 @@ static const Parameter detection_params[] =
     { "offload_threads", Parameter::PT_INT, "0:max32", "0",
       "maximum number of simultaneous offloads (defaults to disabled)" },
 
+    { "onload_quantum", Parameter::PT_INT, "1:64", "8",
+      "offload completions drained and grouped by flow per onload pass" },
+
     { "pcre_enable", Parameter::PT_BOOL, nullptr, "true",
       "enable pcre pattern matching" },
 
+    { "pcre_jit_stack_size", Parameter::PT_INT, "0:max32", "524288",
+      "maximum per thread pcre jit stack size in bytes, 0 disables jit compilation" },
+
     { "pcre_match_limit", Parameter::PT_INT, "0:max32", "1500",
       "limit pcre backtracking, 0 = off" },
 
@@ -142,9 +148,15 @@ bool DetectionModule::set(const char*, Value& v, SnortConfig* sc)
     else if ( v.is("offload_threads") )
         sc->offload_threads = v.get_uint32();
 
+    else if ( v.is("onload_quantum") )
+        sc->onload_quantum = v.get_uint32();
+
     else if ( v.is("pcre_enable") )
         v.update_mask(sc->run_flags, RUN_FLAG__NO_PCRE, true);
 
+    else if ( v.is("pcre_jit_stack_size") )
+        sc->pcre_jit_stack_size = v.get_uint32();
+
     else if ( v.is("pcre_match_limit") )
         sc->pcre_match_limit = v.get_uint32();
 
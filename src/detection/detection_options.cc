@@ -42,6 +42,7 @@
 #include "hash/xhash.h"
 #include "ips_options/extract.h"
 #include "ips_options/ips_flowbits.h"
+#include "latency/latency_config.h"
 #include "latency/packet_latency.h"
 #include "latency/rule_latency_state.h"
 #include "log/messages.h"
@@ -51,6 +52,7 @@
 #include "parser/parser.h"
 #include "profiler/rule_profiler_defs.h"
 #include "protocols/packet_manager.h"
+#include "utils/stats.h"
 #include "utils/util.h"
 #include "utils/util_cstring.h"
 
@@ -58,6 +60,7 @@
 #include "detection_module.h"
 #include "detection_util.h"
 #include "detect_trace.h"
+#include "fp_config.h"
 #include "fp_create.h"
 #include "fp_detect.h"
 #include "ips_context.h"
@@ -214,6 +217,9 @@ void free_detection_option_tree(detection_option_tree_node_t* node)
     for (int i = 0; i < node->num_children; i++)
         free_detection_option_tree(node->children[i]);
 
+    if ( node->option_type == RULE_OPTION_TYPE_FUSED )
+        snort_free(node->option_data);
+
     snort_free(node->children);
     snort_free(node->state);
     snort_free(node);
@@ -305,7 +311,9 @@ void print_option_tree(detection_option_tree_node_t* node, int level)
     char buf[32];
     const char* opt;
 
-    if ( node->option_type != RULE_OPTION_TYPE_LEAF_NODE )
+    if ( node->option_type == RULE_OPTION_TYPE_FUSED )
+        opt = "fused";
+    else if ( node->option_type != RULE_OPTION_TYPE_LEAF_NODE )
         opt = ((IpsOption*)node->option_data)->get_name();
     else
     {
@@ -326,6 +334,96 @@ void print_option_tree(detection_option_tree_node_t* node, int level)
 #endif
 }
 
+// fused option chains --------------------------------------------------
+//
+// linear runs of byte_extract / byte_jump / byte_test / byte_math nodes
+// are collapsed into a single node at rule compile time.  per node
+// dispatch (profiling clock reads, memoization checks, recursion, var
+// backup) costs more than the byte math itself for protocols like dnp3
+// and modbus that chain these options heavily.
+
+#define FUSED_MAX_OPS 8
+
+struct FusedOptionChain
+{
+    unsigned count;
+    IpsOption* ops[FUSED_MAX_OPS];
+};
+
+static int fused_chain_eval(void* data, Cursor& c, Packet* p)
+{
+    FusedOptionChain* f = (FusedOptionChain*)data;
+    int rval = (int)IpsOption::NO_MATCH;
+
+    ++pc.byte_fused_evals;
+
+    for ( unsigned i = 0; i < f->count; i++ )
+    {
+        rval = (int)f->ops[i]->eval(c, p);
+
+        if ( rval != (int)IpsOption::MATCH )
+            break;
+    }
+    return rval;
+}
+
+static bool is_fusible_node(const detection_option_tree_node_t* n)
+{
+    if ( n->option_type != RULE_OPTION_TYPE_BUFFER_USE or !n->option_data or !n->evaluate )
+        return false;
+
+    const char* name = ((const IpsOption*)n->option_data)->get_name();
+
+    return !strcmp(name, "byte_extract") or !strcmp(name, "byte_jump") or
+        !strcmp(name, "byte_test") or !strcmp(name, "byte_math");
+}
+
+// top down so a whole chain is absorbed into its head before recursing
+// into whatever follows it
+static void fuse_chain(detection_option_tree_node_t* node)
+{
+    if ( is_fusible_node(node) and node->num_children == 1 and
+        is_fusible_node(node->children[0]) )
+    {
+        FusedOptionChain* f = (FusedOptionChain*)snort_calloc(sizeof(FusedOptionChain));
+        f->ops[f->count++] = (IpsOption*)node->option_data;
+
+        while ( node->num_children == 1 and is_fusible_node(node->children[0]) and
+            f->count < FUSED_MAX_OPS )
+        {
+            detection_option_tree_node_t* child = node->children[0];
+
+            f->ops[f->count++] = (IpsOption*)child->option_data;
+
+            snort_free(node->children);
+            node->children = child->children;
+            node->num_children = child->num_children;
+            node->relative_children = child->relative_children;
+
+            snort_free(child->state);
+            snort_free(child);
+        }
+
+        // the head keeps its own is_relative and per thread state; the
+        // options themselves stay owned by the detection option hash
+        node->option_type = RULE_OPTION_TYPE_FUSED;
+        node->option_data = f;
+        node->evaluate = fused_chain_eval;
+    }
+
+    for ( int i = 0; i < node->num_children; i++ )
+        fuse_chain(node->children[i]);
+}
+
+void fuse_option_chains(XHash* doth)
+{
+    if ( !doth )
+        return;
+
+    for ( auto hnode = doth->find_first_node(); hnode; hnode = doth->find_next_node() )
+        fuse_chain((detection_option_tree_node_t*)hnode->data);
+}
+
 void* add_detection_option_tree(SnortConfig* sc, detection_option_tree_node_t* option_tree)
 {
     static std::mutex build_mutex;
@@ -345,6 +443,44 @@ void* add_detection_option_tree(SnortConfig* sc, detection_option_tree_node_t* o
     return nullptr;
 }
 
+// The mpse reports only genuine occurrences of the fast pattern, so when the
+// matched pattern is a rule's entire content with no placement constraints,
+// the confirming re-search in the option tree cannot fail and is skipped.
+// Case-sensitive patterns still confirm because some engines match caselessly
+// and rely on this pass to verify case.  The cursor is left unpositioned, so
+// nodes with relative children are excluded.
+static bool can_elide_confirm(
+    const detection_option_tree_node_t* node, const PatternMatchData* pmd,
+    const PatternMatchData* fp_pmd)
+{
+    if ( !pmd or pmd != fp_pmd )
+        return false;
+
+    if ( node->relative_children )
+        return false;
+
+    if ( pmd->is_negated() or pmd->is_relative() or !pmd->is_no_case() )
+        return false;
+
+    // the fast pattern must be the entire pattern ...
+    if ( pmd->fp_offset or ( pmd->fp_length and pmd->fp_length != pmd->pattern_size ) )
+        return false;
+
+    // ... with no placement constraints of its own
+    if ( pmd->offset or !pmd->is_unbounded() )
+        return false;
+
+    // search_engine.max_pattern_len truncates patterns as they are queued
+    // (fpGetFinalPattern), so the mpse may have verified only a prefix
+    const unsigned max_len =
+        SnortConfig::get_conf()->fast_pattern_config->get_max_pattern_len();
+
+    if ( max_len and pmd->pattern_size > max_len )
+        return false;
+
+    return true;
+}
+
 int detection_option_node_evaluate(
     detection_option_tree_node_t* node, detection_option_eval_data_t& eval_data,
     const Cursor& orig_cursor)
@@ -399,7 +535,8 @@ int detection_option_node_evaluate(
     // Save some stuff off for repeated pattern tests
     PmdLastCheck* content_last = nullptr;
 
-    if ( node->option_type != RULE_OPTION_TYPE_LEAF_NODE )
+    if ( node->option_type != RULE_OPTION_TYPE_LEAF_NODE and
+        node->option_type != RULE_OPTION_TYPE_FUSED )
     {
         IpsOption* opt = (IpsOption*)node->option_data;
         PatternMatchData* pmd = opt->get_pattern(0, RULE_WO_DIR);
@@ -420,21 +557,43 @@ int detection_option_node_evaluate(
             {
                 const auto& sig_info = node->otn->sigInfo;
 
-                for ( const auto& svc : sig_info.services )
+                if ( state.svc_memo.checked and
+                    state.svc_memo.protocol_id == snort_protocol_id )
                 {
-                    if ( snort_protocol_id == svc.snort_protocol_id )
+                    if ( state.svc_memo.mismatch )
                     {
-                        check_ports = 0;
-                        break;  // out of for
+                        pc.svc_memo_skips++;
+                        debug_logf(detection_trace, TRACE_RULE_EVAL, p,
+                            "SID %u not matched because of service mismatch %d\n",
+                            sig_info.sid, snort_protocol_id);
+                        break;  // out of case
                     }
+                    check_ports = state.svc_memo.check_ports;
                 }
-
-                if ( !sig_info.services.empty() and check_ports )
+                else
                 {
-                    debug_logf(detection_trace, TRACE_RULE_EVAL, p,
-                        "SID %u not matched because of service mismatch %d\n",
-                        sig_info.sid, snort_protocol_id);
-                    break;  // out of case
+                    for ( const auto& svc : sig_info.services )
+                    {
+                        if ( snort_protocol_id == svc.snort_protocol_id )
+                        {
+                            check_ports = 0;
+                            break;  // out of for
+                        }
+                    }
+
+                    state.svc_memo.protocol_id = snort_protocol_id;
+                    state.svc_memo.checked = 1;
+                    state.svc_memo.check_ports = (char)check_ports;
+                    state.svc_memo.mismatch =
+                        ( !sig_info.services.empty() and check_ports );
+
+                    if ( state.svc_memo.mismatch )
+                    {
+                        debug_logf(detection_trace, TRACE_RULE_EVAL, p,
+                            "SID %u not matched because of service mismatch %d\n",
+                            sig_info.sid, snort_protocol_id);
+                        break;  // out of case
+                    }
                 }
             }
 
@@ -500,6 +659,21 @@ int detection_option_node_evaluate(
                         break;
                     }
                 }
+
+                // inner ip re-evaluations search different data than the
+                // fast pattern matcher scanned, so they always confirm
+                if ( !(p->packet_flags & PKT_IP_RULE_2ND) )
+                {
+                    IpsOption* opt = (IpsOption*)node->option_data;
+
+                    if ( can_elide_confirm(node, opt->get_pattern(0, RULE_WO_DIR),
+                        (const PatternMatchData*)eval_data.pmd) )
+                    {
+                        pc.fp_confirm_skips++;
+                        rval = (int)IpsOption::MATCH;
+                        break;
+                    }
+                }
                 rval = node->evaluate(node->option_data, cursor, p);
             }
             break;
@@ -680,7 +854,19 @@ int detection_option_node_evaluate(
 
         if ( continue_loop && rval == (int)IpsOption::MATCH && node->relative_children )
         {
-            IpsOption* opt = (IpsOption*)node->option_data;
+            IpsOption* opt;
+
+            if ( node->option_type == RULE_OPTION_TYPE_FUSED )
+            {
+                // option_data is the chain, not an IpsOption; retry belongs
+                // to the tail option the chain absorbed along with the
+                // relative children that asked for it
+                FusedOptionChain* f = (FusedOptionChain*)node->option_data;
+                opt = f->ops[f->count - 1];
+            }
+            else
+                opt = (IpsOption*)node->option_data;
+
             continue_loop = opt->retry(cursor);
         }
         else
@@ -823,12 +1009,34 @@ void detection_option_tree_update_otn_stats(XHash* doth)
     }
 }
 
+// the tightest budget configured for any of the rule's services wins
+static hr_duration service_latency_budget(const OptTreeNode* otn)
+{
+    const RuleLatencyConfig& cfg = SnortConfig::get_conf()->latency->rule_latency;
+    hr_duration budget = 0_ticks;
+
+    if ( !otn or cfg.service_budgets.empty() )
+        return budget;
+
+    for ( const auto& svc : otn->sigInfo.services )
+    {
+        for ( const auto& sb : cfg.service_budgets )
+        {
+            if ( svc.service == sb.first and
+                (budget == 0_ticks or sb.second < budget) )
+                budget = sb.second;
+        }
+    }
+    return budget;
+}
+
 detection_option_tree_root_t* new_root(OptTreeNode* otn)
 {
     detection_option_tree_root_t* p = (detection_option_tree_root_t*)
         snort_calloc(sizeof(detection_option_tree_root_t));
 
     p->latency_state = new RuleLatencyState[ThreadConfig::get_instance_max()]();
+    p->latency_budget = service_latency_budget(otn);
     p->otn = otn;
 
     return p;
@@ -62,6 +62,18 @@ struct dot_node_state_t
         char flowbit_failed;
     } last_check;
 
+    // service pre-check memo; the outcome depends only on the protocol id
+    // and the rule's static service list, so once computed it holds for
+    // every later packet carrying the same id (eg each flush of a pdu
+    // stream) without rescanning the service list
+    struct
+    {
+        uint16_t protocol_id;
+        char checked;
+        char mismatch;
+        char check_ports;
+    } svc_memo;
+
     // FIXIT-L perf profiler stuff should be factored of the node state struct
     hr_duration elapsed;
     hr_duration elapsed_match;
@@ -105,6 +117,9 @@ struct detection_option_tree_root_t
     detection_option_tree_node_t** children;
     RuleLatencyState* latency_state;
 
+    // per service rule latency budget; zero means use latency.rule.max_time
+    hr_duration latency_budget = 0_ticks;
+
     struct OptTreeNode* otn;  // first rule in tree
 };
 
@@ -126,6 +141,10 @@ int detection_option_node_evaluate(
 void print_option_tree(detection_option_tree_node_t*, int level);
 void detection_option_tree_update_otn_stats(snort::XHash*);
 
+// collapse linear byte_extract/byte_jump/byte_test/byte_math runs into
+// single fused nodes; called once after the option trees are compiled
+void fuse_option_chains(snort::XHash*);
+
 detection_option_tree_root_t* new_root(OptTreeNode*);
 void free_detection_option_root(void** existing_tree);
 
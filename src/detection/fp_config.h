@@ -127,11 +127,20 @@ public:
 
     bool set_offload_search_method(const char*);
     void set_max_pattern_len(unsigned);
+
+    unsigned get_max_pattern_len() const
+    { return max_pattern_len; }
     void set_queue_limit(unsigned);
 
     unsigned get_queue_limit() const
     { return queue_limit; }
 
+    void set_num_compile_threads(unsigned n)
+    { num_compile_threads = n; }
+
+    unsigned get_num_compile_threads() const
+    { return num_compile_threads; }
+
     const snort::MpseApi* get_search_api() const
     { return search_api; }
 
@@ -158,6 +167,7 @@ private:
     unsigned max_pattern_len = 0;
 
     unsigned queue_limit = 0;
+    unsigned num_compile_threads = 0;  // 0 means one per packet thread slot
 
     int portlists_flags = 0;
     int num_patterns_truncated = 0;  // due to max_pattern_len
@@ -65,6 +65,12 @@ using namespace std;
 
 static unsigned mpse_count = 0;
 static unsigned offload_mpse_count = 0;
+
+// groups expecting fewer rules than this get the compact bnfa engine
+// instead of the configured search method; thousands of near-empty
+// service groups otherwise dominate the cache footprint
+static const unsigned fp_tiny_group_rules = 8;
+static unsigned tiny_group_count = 0;
 static const char* s_group = "";
 
 static void fpDeletePMX(void* data);
@@ -616,7 +622,30 @@ static int fpAddPortGroupRule(
 
             if ( !pg->mpsegrp[main_pmd->pm_type]->normal_mpse )
             {
-                if (!pg->mpsegrp[main_pmd->pm_type]->create_normal_mpse(sc, &agent))
+                const MpseApi* tiny_api = nullptr;
+
+                // regex capable engines may hold non-literal fast patterns,
+                // so only downgrade when the configured engine is literal-only
+                if ( pg->expected_rules and pg->expected_rules < fp_tiny_group_rules
+                    and !MpseManager::is_regex_capable(search_api) )
+                {
+                    tiny_api = MpseManager::get_search_api("ac_bnfa");
+
+                    if ( tiny_api == search_api )
+                        tiny_api = nullptr;
+                }
+
+                if ( tiny_api )
+                {
+                    if ( !tiny_group_count++ )
+                        MpseManager::start_search_engine(tiny_api);
+
+                    pg->mpsegrp[main_pmd->pm_type]->normal_mpse =
+                        MpseManager::get_search_engine(sc, tiny_api, &agent);
+                }
+
+                if ( !pg->mpsegrp[main_pmd->pm_type]->normal_mpse and
+                    !pg->mpsegrp[main_pmd->pm_type]->create_normal_mpse(sc, &agent))
                 {
                     ParseError("Failed to create normal pattern matcher for %d", main_pmd->pm_type);
                     return -1;
@@ -884,6 +913,15 @@ static void fpCreateRuleMaps(SnortConfig* sc, RulePortTables* p)
     fpCreateInitRuleMap(sc->prmIcmpRTNX, p->icmp.src, p->icmp.dst, p->icmp.any);
     fpCreateInitRuleMap(sc->prmTcpRTNX, p->tcp.src, p->tcp.dst, p->tcp.any);
     fpCreateInitRuleMap(sc->prmUdpRTNX, p->udp.src, p->udp.dst, p->udp.any);
+
+    // bake the generic group selection in now so per packet lookups don't
+    // have to check the fast pattern config
+    bool split = sc->fast_pattern_config->get_split_any_any();
+
+    prmSetGenerics(sc->prmIpRTNX, split);
+    prmSetGenerics(sc->prmIcmpRTNX, split);
+    prmSetGenerics(sc->prmTcpRTNX, split);
+    prmSetGenerics(sc->prmUdpRTNX, split);
 }
 
 static void fpFreeRuleMaps(SnortConfig* sc)
@@ -1020,6 +1058,11 @@ static void fpCreatePortObject2PortGroup(SnortConfig* sc, PortObject2* po, PortO
     PortGroup* pg = PortGroup::alloc();
     s_group = "port";
 
+    pg->expected_rules = po->rule_hash->get_count();
+
+    if ( poaa and poaa->rule_hash and poaa != po )
+        pg->expected_rules += poaa->rule_hash->get_count();
+
     /*
      * Walk the rules in the PortObject and add to
      * the PortGroup pattern state machine
@@ -1236,6 +1279,7 @@ static void fpBuildServicePortGroupByServiceOtnList(
 {
     PortGroup* pg = PortGroup::alloc();
     s_group = srvc;
+    pg->expected_rules = sflist_count(list);
 
     /*
      * add each rule to the service group pattern matchers,
@@ -1579,6 +1623,7 @@ int fpCreateFastPacketDetection(SnortConfig* sc)
 
     mpse_count = 0;
     offload_mpse_count = 0;
+    tiny_group_count = 0;
 
     MpseManager::start_search_engine(fp->get_search_api());
 
@@ -1621,6 +1666,7 @@ int fpCreateFastPacketDetection(SnortConfig* sc)
         if ( c != expected )
             ParseError("Failed to compile %u search engines", expected - c);
 
+        fuse_option_chains(sc->detection_option_tree_hash_table);
         fixup_trees(sc);
     }
 
@@ -1642,6 +1688,9 @@ int fpCreateFastPacketDetection(SnortConfig* sc)
     if ( fp->get_num_patterns_truncated() )
         LogMessage("%25.25s: %-12u\n", "truncated patterns", fp->get_num_patterns_truncated());
 
+    if ( tiny_group_count )
+        LogMessage("%25.25s: %-12u\n", "tiny rule groups", tiny_group_count);
+
     MpseManager::setup_search_engine(fp->get_search_api(), sc);
 
     return 0;
@@ -39,6 +39,8 @@
 
 #include "fp_detect.h"
 
+#include <algorithm>
+
 #include "events/event.h"
 #include "filters/rate_filter.h"
 #include "filters/sfthreshold.h"
@@ -297,6 +299,25 @@ int fpAddMatch(OtnxMatchData* omd, const OptTreeNode* otn)
     return 0;
 }
 
+// Rules that share a header share an RTN, so an alert storm packet with
+// dozens of candidate leaves re-walks the same ip/port predicate chains
+// many times.  The outcome only depends on the packet, so memoize it per
+// packet in a small direct-mapped table; the packet pointer plus packet
+// number guard against stale hits from recycled packets or rebuilt
+// pseudo packets sharing a context.
+#define RTN_MEMO_SLOTS 64
+
+struct RtnMemo
+{
+    const RuleTreeNode* rtn;
+    const Packet* pkt;
+    uint64_t packet_num;
+    char check_ports;
+    char result;
+};
+
+static THREAD_LOCAL RtnMemo rtn_memo[RTN_MEMO_SLOTS];
+
 bool fp_eval_rtn(RuleTreeNode* rtn, Packet* p, int check_ports)
 {
     if ( !rtn or !rtn->enabled() )
@@ -305,10 +326,30 @@ bool fp_eval_rtn(RuleTreeNode* rtn, Packet* p, int check_ports)
     if ( rtn->user_mode() )
         check_ports = 1;
 
-    if (!rtn->rule_func->RuleHeadFunc(p, rtn, rtn->rule_func, check_ports))
-        return false;
+    // inner ip re-evaluation swaps the ip api under the same packet and
+    // udp tunnels do the same for the payload; both change what the head
+    // funcs see without changing the memo key, so bypass the memo as the
+    // per-node memo does for these cases
+    if ( (p->packet_flags & PKT_IP_RULE_2ND) or p->is_udp_tunneled() )
+        return rtn->rule_func->RuleHeadFunc(p, rtn, rtn->rule_func, check_ports) != 0;
+
+    RtnMemo& memo = rtn_memo[(((uintptr_t)rtn) >> 4) % RTN_MEMO_SLOTS];
+
+    if ( memo.rtn == rtn and memo.pkt == p and
+        memo.packet_num == p->context->packet_number and
+        memo.check_ports == (char)check_ports )
+        return memo.result != 0;
 
-    return true;
+    const bool result =
+        rtn->rule_func->RuleHeadFunc(p, rtn, rtn->rule_func, check_ports) != 0;
+
+    memo.rtn = rtn;
+    memo.pkt = p;
+    memo.packet_num = p->context->packet_number;
+    memo.check_ports = (char)check_ports;
+    memo.result = result;
+
+    return result;
 }
 
 int fp_eval_option(void* v, Cursor& c, Packet* p)
@@ -633,14 +674,38 @@ static inline int fpFinalSelectEvent(OtnxMatchData* omd, Packet* p)
              * built in drop/block/reset comes before alert/pass/log as
              * part of the natural ordering....Jan '06..
              */
-            /* Sort the rules in this action group */
-            qsort(omd->matchInfo[i].MatchArray, omd->matchInfo[i].iMatchCount,
-                sizeof(void*), compar);
+            /* Sort the rules in this action group.  Only max_events entries
+             * can be consumed below unless session alerted entries are
+             * skipped over, so order just the top of the group now and sort
+             * the remainder lazily in the rare case the loop runs past it. */
+            const OptTreeNode** match_array = omd->matchInfo[i].MatchArray;
+            unsigned match_count = omd->matchInfo[i].iMatchCount;
+            unsigned sorted = match_count;
+
+            auto lesser = [compar](const OptTreeNode* a, const OptTreeNode* b)
+            { return compar(&a, &b) < 0; };
+
+            if ( match_count > eq->max_events )
+            {
+                std::partial_sort(match_array, match_array + eq->max_events,
+                    match_array + match_count, lesser);
+                sorted = eq->max_events;
+                pc.event_sort_skips += match_count - sorted;
+            }
+            else
+                std::sort(match_array, match_array + match_count, lesser);
 
             /* Process each event in the action (alert,drop,log,...) groups */
-            for (unsigned j = 0; j < omd->matchInfo[i].iMatchCount; j++)
+            for (unsigned j = 0; j < match_count; j++)
             {
-                const OptTreeNode* otn = omd->matchInfo[i].MatchArray[j];
+                if ( j >= sorted )
+                {
+                    std::sort(match_array + sorted, match_array + match_count, lesser);
+                    pc.event_sort_skips -= match_count - sorted;
+                    sorted = match_count;
+                }
+
+                const OptTreeNode* otn = match_array[j];
                 RuleTreeNode* rtn = getRtnFromOtn(otn);
 
                 if ( otn && rtn && Actions::is_pass(rtn->action) )
@@ -1181,8 +1246,30 @@ static inline void fpEvalHeaderSvc(Packet* p, FPTask task)
         return;
 
     PortGroup* svc = nullptr;
+    Flow* flow = p->flow;
 
-    if (p->is_from_server())
+    if ( flow )
+    {
+        // resolve both directions once per flow and service; keying on
+        // the config and protocol id means config reloads and service
+        // changes re-resolve on the next flush
+        if ( flow->svc_pg_conf != p->context->conf or
+            flow->svc_pg_id != snort_protocol_id )
+        {
+            sopg_table_t* sopg = p->context->conf->sopgTable;
+            flow->svc_pg[0] = sopg->get_port_group(false, snort_protocol_id);
+            flow->svc_pg[1] = sopg->get_port_group(true, snort_protocol_id);
+            flow->svc_pg_conf = p->context->conf;
+            flow->svc_pg_id = snort_protocol_id;
+        }
+
+        if (p->is_from_server())
+            svc = flow->svc_pg[0];
+
+        else if (p->is_from_client())
+            svc = flow->svc_pg[1];
+    }
+    else if (p->is_from_server())
         svc = p->context->conf->sopgTable->get_port_group(false, snort_protocol_id);
 
     else if (p->is_from_client())
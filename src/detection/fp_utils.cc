@@ -28,6 +28,7 @@
 #include <mutex>
 #include <thread>
 
+#include "fp_config.h"
 #include "log/messages.h"
 #include "main/snort_config.h"
 #include "parser/parse_conf.h"
@@ -400,6 +401,16 @@ unsigned compile_mpses(struct SnortConfig* sc, bool parallel)
     unsigned max = parallel ? sc->num_slots : 1;
     unsigned count = 0;
 
+    const FastPatternConfig* fp = sc->fast_pattern_config;
+
+    if ( parallel and fp and fp->get_num_compile_threads() )
+        max = fp->get_num_compile_threads();
+
+    // workers use their index as instance id, so they must stay within
+    // the per-thread state slots allocated for packet threads
+    if ( max > sc->num_slots )
+        max = sc->num_slots;
+
     if ( max == 1 )
     {
         compile_mpse(sc, get_instance_id(), &count);
@@ -57,6 +57,7 @@ IpsContext::IpsContext(unsigned size) :
 
     pkth = new DAQ_PktHdr_t;
     buf = new uint8_t[buf_size];
+    scratchpad = new uint8_t[scratchpad_size];
 
     conf = SnortConfig::get_conf();
     const EventQueueConfig* qc = conf->event_queue_config;
@@ -85,6 +86,7 @@ IpsContext::~IpsContext()
     sfeventq_free(equeue);
     fp_clear_context(*this);
 
+    delete[] scratchpad;
     delete[] buf;
     delete pkth;
     delete packet;
@@ -94,6 +96,8 @@ void IpsContext::setup()
 {
     conf = SnortConfig::get_conf();
     remove_gadget = false;
+    scratch_used = 0;
+    buf_cache_seen = buf_cache_have = 0;
 }
 
 void IpsContext::clear()
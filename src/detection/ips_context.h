@@ -29,6 +29,7 @@
 
 #include "detection/detection_util.h"
 #include "framework/codec.h"
+#include "framework/inspector.h"
 #include "framework/mpse.h"
 #include "framework/mpse_batch.h"
 #include "main/snort_types.h"
@@ -73,8 +74,54 @@ public:
     void set_context_data(unsigned id, IpsContextData*);
     IpsContextData* get_context_data(unsigned id) const;
 
+    // bump arena for rule eval temporaries (eg cursor data arrays);
+    // reset wholesale each setup() so there is nothing to free.  returns
+    // nullptr when full - callers must fall back to the heap.
+    void* scratchpad_alloc(size_t n)
+    {
+        n = (n + 15) & ~(size_t)15;
+
+        if ( scratch_used + n > scratchpad_size )
+            return nullptr;
+
+        void* p = scratchpad + scratch_used;
+        scratch_used += n;
+        return p;
+    }
+
     void snapshot_flow(Flow*);
 
+    // inspection buffers are materialized at most once per packet and
+    // shared by all options referencing the same buffer.  keys below
+    // InspectionBuffer::IBT_MAX are gadget buffer types; inspector
+    // specific ids are keyed at IBT_MAX + id.  keys past the cache size
+    // simply bypass the cache.
+    bool buf_is_cached(unsigned key) const
+    { return key < buf_cache_size and (buf_cache_seen & (1u << key)); }
+
+    bool get_cached_buf(unsigned key, InspectionBuffer& b) const
+    {
+        if ( key >= buf_cache_size or !(buf_cache_have & (1u << key)) )
+            return false;
+
+        b = buf_cache[key];
+        return true;
+    }
+
+    void cache_buf(unsigned key, const InspectionBuffer& b, bool have)
+    {
+        if ( key >= buf_cache_size )
+            return;
+
+        buf_cache_seen |= (1u << key);
+
+        if ( have )
+        {
+            buf_cache_have |= (1u << key);
+            buf_cache[key] = b;
+        }
+    }
+
     uint32_t get_session_flags()
     { return flow.session_flags; }
 
@@ -163,13 +210,21 @@ public:
     bool clear_inspectors;
 
     static const unsigned buf_size = Codec::PKT_MAX;
+    static const unsigned scratchpad_size = 16384;
 
     // FIXIT-L eliminate max_ips_id and just resize data vector.
     // Only 5 inspectors currently use the ips context data.
     static constexpr unsigned max_ips_id = 8;
 
 private:
+    static const unsigned buf_cache_size = 32;
+
     FlowSnapshot flow = {};
+    uint8_t* scratchpad;
+    size_t scratch_used = 0;
+    InspectionBuffer buf_cache[buf_cache_size];
+    uint32_t buf_cache_seen = 0;
+    uint32_t buf_cache_have = 0;
     std::vector<IpsContextData*> data;
     std::vector<unsigned> ids_in_use;  // for indirection; FIXIT-P evaluate alternatives
     std::vector<Callback> post_callbacks;
@@ -37,11 +37,8 @@
 
 #include "pcrm.h"
 
-#include "main/snort_config.h"
 #include "utils/util.h"
 
-#include "fp_config.h"
-
 using namespace snort;
 
 PORT_RULE_MAP* prmNewMap()
@@ -49,6 +46,17 @@ PORT_RULE_MAP* prmNewMap()
     return (PORT_RULE_MAP*)snort_calloc(sizeof(PORT_RULE_MAP));
 }
 
+void prmSetGenerics(PORT_RULE_MAP* p, bool split_any_any)
+{
+    PortGroup* gen =
+        ( p->prmGeneric and p->prmGeneric->rule_count > 0 ) ? p->prmGeneric : nullptr;
+
+    // with split any-any the generic group is searched alongside the port
+    // groups; otherwise it only backstops ports with no group of their own
+    p->prmGenericPaired = split_any_any ? gen : nullptr;
+    p->prmGenericOnly = gen;
+}
+
 /*
 **  DESCRIPTION
 **    Given a PORT_RULE_MAP, this function selects the PortGroup or
@@ -96,13 +104,7 @@ static int prmFindRuleGroup(
         *src = p->prmSrcPort[sport];
 
     /* If no Src/Dst rules - use the generic set, if any exist  */
-    if ( p->prmGeneric and (p->prmGeneric->rule_count > 0) )
-    {
-        if ( SnortConfig::get_conf()->fast_pattern_config->get_split_any_any() or (!*src and !*dst) )
-        {
-            *gen = p->prmGeneric;
-        }
-    }
+    *gen = ( *src or *dst ) ? p->prmGenericPaired : p->prmGenericOnly;
 
     if ( *src or *dst or *gen )
         return 1;
@@ -46,10 +46,17 @@ struct PORT_RULE_MAP
     PortGroup* prmSrcPort[snort::MAX_PORTS];
     PortGroup* prmDstPort[snort::MAX_PORTS];
     PortGroup* prmGeneric;
+
+    // resolved once at fp_create time by prmSetGenerics() so the per
+    // packet lookup is just array loads, with no config probing
+    PortGroup* prmGenericPaired;  // generic group when a src or dst group also hit
+    PortGroup* prmGenericOnly;    // generic group when neither port has a group
 };
 
 PORT_RULE_MAP* prmNewMap();
 
+void prmSetGenerics(PORT_RULE_MAP*, bool split_any_any);
+
 int prmFindRuleGroupTcp(PORT_RULE_MAP*, int, int, PortGroup**, PortGroup**, PortGroup**);
 int prmFindRuleGroupUdp(PORT_RULE_MAP*, int, int, PortGroup**, PortGroup**, PortGroup**);
 int prmFindRuleGroupIp(PORT_RULE_MAP*, int, PortGroup**, PortGroup**);
@@ -61,8 +61,9 @@ struct RegexRequest
 #endif
 
     std::atomic<bool> offload { false };
+    std::atomic<bool> parked { false };
 
-    bool go = true;
+    std::atomic<bool> go { true };
 };
 
 RegexOffload* RegexOffload::get_offloader(unsigned max, bool async)
@@ -223,11 +224,14 @@ void ThreadRegexOffload::put(Packet* p)
     busy.emplace_back(req);
     p->context->regex_req_it = std::prev(busy.end());
 
+    req->packet = p;
+    req->offload = true;
+
+    // the worker spins on the offload flag for a while before parking on
+    // the condvar, so the futex round trip is only paid when it is parked
+    if ( req->parked )
     {
         std::unique_lock<std::mutex> lock(req->mutex);
-        req->packet = p;
-
-        req->offload = true;
         req->cond.notify_one();
     }
 
@@ -272,19 +276,46 @@ void ThreadRegexOffload::worker(
     set_instance_id(id);
     SnortConfig::set_conf(initial_config);
 
+    // spinning this long covers back-to-back offloads at high rates;
+    // longer gaps are worth a park
+    const unsigned spin_limit = 4096;
+
     while ( true )
     {
-        {
-            std::unique_lock<std::mutex> lock(req->mutex);
-            req->cond.wait_for(lock, std::chrono::seconds(1));
+        bool ready = false;
 
+        for ( unsigned spin = 0; spin < spin_limit; ++spin )
+        {
+            if ( req->offload )
+            {
+                ready = true;
+                break;
+            }
             if ( !req->go )
                 break;
 
-            if ( !req->offload )
-                continue;
+            std::this_thread::yield();
         }
 
+        if ( !ready )
+        {
+            std::unique_lock<std::mutex> lock(req->mutex);
+            req->parked = true;
+
+            // recheck under the lock so a put() racing with the park
+            // cannot be missed; the timed wait is a backstop
+            while ( req->go and !req->offload )
+                req->cond.wait_for(lock, std::chrono::seconds(1));
+
+            req->parked = false;
+        }
+
+        if ( !req->go )
+            break;
+
+        if ( !req->offload )
+            continue;
+
         assert(req->packet);
         assert(req->packet->is_offloaded());
         assert(req->packet->context->searches.items.size() > 0);
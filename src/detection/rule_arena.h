@@ -0,0 +1,78 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2020-2020 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// rule_arena.h
+
+#ifndef RULE_ARENA_H
+#define RULE_ARENA_H
+
+// bump allocator for parse time rule tree structures.  nodes are carved
+// from large blocks instead of being allocated individually, which keeps
+// the eval graph dense in memory, and all blocks are reclaimed wholesale
+// when the owning SnortConfig is deleted, which makes teardown on reload
+// cheap.  individual nodes are never freed, so only trivially destructible
+// types may live here.
+
+#include <cstdint>
+#include <vector>
+
+#include "utils/util.h"
+
+namespace snort
+{
+
+class RuleArena
+{
+public:
+    RuleArena() = default;
+    RuleArena(const RuleArena&) = delete;
+    RuleArena& operator=(const RuleArena&) = delete;
+
+    ~RuleArena()
+    {
+        for ( auto* b : blocks )
+            snort_free(b);
+    }
+
+    // returns zeroed storage like snort_calloc
+    void* alloc(size_t n)
+    {
+        n = (n + 15) & ~(size_t)15;
+
+        if ( n > avail )
+        {
+            size_t sz = n > block_size ? n : block_size;
+            next = (uint8_t*)snort_calloc(sz);
+            blocks.emplace_back(next);
+            avail = sz;
+        }
+        void* p = next;
+        next += n;
+        avail -= n;
+        return p;
+    }
+
+private:
+    static const size_t block_size = 256 * 1024;
+
+    std::vector<uint8_t*> blocks;
+    uint8_t* next = nullptr;
+    size_t avail = 0;
+};
+
+}
+#endif
@@ -28,7 +28,8 @@ enum option_type_t
     RULE_OPTION_TYPE_BUFFER_USE,   // uses sticky buffer
     RULE_OPTION_TYPE_CONTENT,      // ideally would be eliminated (implies _BUFFER_USE)
     RULE_OPTION_TYPE_FLOWBIT,      // ideally would be eliminated
-    RULE_OPTION_TYPE_OTHER         // for all new buffer independent rule options
+    RULE_OPTION_TYPE_OTHER,        // for all new buffer independent rule options
+    RULE_OPTION_TYPE_FUSED         // internal use by rule compiler (fused option chain)
 };
 
 #endif
@@ -139,14 +139,8 @@ void OtnRemove(GHash* otn_map, OptTreeNode* otn)
 
 OptTreeNode::~OptTreeNode()
 {
-    OptFpList* opt = opt_func;
-
-    while ( opt )
-    {
-        OptFpList* tmp = opt;
-        opt = opt->next;
-        snort_free(tmp);
-    }
+    // opt_func nodes live in the config's rule arena and are reclaimed
+    // wholesale when the config is deleted
 
     for ( auto& ref : sigInfo.refs )
         delete ref;
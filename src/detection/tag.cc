@@ -54,6 +54,12 @@ using namespace snort;
 #define TAG_PRUNE_QUANTUM   300
 #define TAG_MEMCAP          4194304  /* 4MB */
 
+/* most stale nodes released per cache per prune pass; pruning runs at
+ * most once a second so a tag storm is trickled out instead of one
+ * packet paying to release the whole backlog
+ */
+#define TAG_PRUNE_BUDGET    8
+
 #define GID_TAG             2
 #define TAG_LOG_PKT         1
 
@@ -122,7 +128,7 @@ static const unsigned s_max_sessions = 1;
 static TagNode* TagAlloc(XHash*);
 static void TagFree(XHash*, TagNode*);
 static int PruneTagCache(uint32_t, int);
-static int PruneTime(XHash* tree, uint32_t thetime);
+static int PruneTime(XHash* tree, uint32_t thetime, int budget);
 static void TagSession(Packet*, TagData*, uint32_t, uint16_t, void*);
 static void TagHost(Packet*, TagData*, uint32_t, uint16_t, void*);
 static void AddTagNode(Packet*, TagData*, int, uint32_t, uint16_t, void*);
@@ -562,7 +568,9 @@ int CheckTagList(Packet* p, Event& event, void** log_list)
         }
     }
 
-    if ( (unsigned)(p->pkth->ts.tv_sec) > last_prune_time + TAG_PRUNE_QUANTUM )
+    /* prune at most once a second with a small budget; when nothing is
+     * stale this is just a peek at each cache's lru node */
+    if ( (unsigned)(p->pkth->ts.tv_sec) > last_prune_time )
     {
         PruneTagCache(p->pkth->ts.tv_sec, 0);
         last_prune_time = p->pkth->ts.tv_sec;
@@ -581,10 +589,10 @@ static int PruneTagCache(uint32_t thetime, int mustdie)
     if (mustdie == 0)
     {
         if (ssn_tag_cache->get_num_nodes() != 0)
-            pruned = PruneTime(ssn_tag_cache, thetime);
+            pruned = PruneTime(ssn_tag_cache, thetime, TAG_PRUNE_BUDGET);
 
         if (host_tag_cache->get_num_nodes() != 0)
-            pruned += PruneTime(host_tag_cache, thetime);
+            pruned += PruneTime(host_tag_cache, thetime, TAG_PRUNE_BUDGET);
     }
     else
     {
@@ -606,12 +614,13 @@ static int PruneTagCache(uint32_t thetime, int mustdie)
     return pruned;
 }
 
-static int PruneTime(XHash* tree, uint32_t thetime)
+static int PruneTime(XHash* tree, uint32_t thetime, int budget)
 {
     int pruned = 0;
     TagNode* lru_node = nullptr;
 
-    while ((lru_node = (TagNode*)tree->get_lru_user_data()) != nullptr)
+    while (pruned < budget &&
+        (lru_node = (TagNode*)tree->get_lru_user_data()) != nullptr)
     {
         if ((lru_node->last_access + TAG_PRUNE_QUANTUM) < thetime)
         {
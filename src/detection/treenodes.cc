@@ -25,13 +25,17 @@
 #include "treenodes.h"
 
 #include "framework/ips_option.h"
+#include "main/snort_config.h"
 #include "utils/util.h"
 
+#include "rule_arena.h"
+
 using namespace snort;
 
-OptFpList* AddOptFuncToList(RuleOptEvalFunc ro_eval_func, OptTreeNode* otn)
+OptFpList* AddOptFuncToList(RuleOptEvalFunc ro_eval_func, OptTreeNode* otn, SnortConfig* sc)
 {
-    OptFpList* ofp = (OptFpList*)snort_calloc(sizeof(OptFpList));
+    // carved from the config's arena; reclaimed wholesale on config swap
+    OptFpList* ofp = (OptFpList*)sc->rule_arena->alloc(sizeof(OptFpList));
     ofp->OptTestFunc = ro_eval_func;
 
     if ( !otn->opt_func )
@@ -34,6 +34,7 @@ namespace snort
 {
 class IpsOption;
 struct Packet;
+struct SnortConfig;
 }
 struct RuleTreeNode;
 struct PortObject;
@@ -252,7 +253,7 @@ struct OptTreeNode
 };
 
 typedef int (* RuleOptEvalFunc)(void*, Cursor&, snort::Packet*);
-OptFpList* AddOptFuncToList(RuleOptEvalFunc, OptTreeNode*);
+OptFpList* AddOptFuncToList(RuleOptEvalFunc, OptTreeNode*, snort::SnortConfig*);
 
 void* get_rule_type_data(OptTreeNode*, const char* name);
 
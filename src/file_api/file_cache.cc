@@ -38,11 +38,11 @@
 
 using namespace snort;
 
-class ExpectedFileCache : public XHash
+class ExpectedFileCache : public TXHash<sizeof(FileCache::FileHashKey)>
 {
 public:
-    ExpectedFileCache(unsigned rows, unsigned key_len, unsigned datasize)
-        : XHash(rows, key_len, datasize, 0)
+    ExpectedFileCache(unsigned rows, unsigned datasize)
+        : TXHash(rows, datasize, 0)
     { }
 
     ~ExpectedFileCache() override
@@ -81,16 +81,94 @@ static int64_t time_elapsed_ms(struct timeval* now, struct timeval* expire_time,
     return lookup_timeout * 1000 + timersub_ms(now, expire_time);
 }
 
+// 8 filter bits per cached file with two probes gives a false positive
+// rate around 5% at capacity
+#define FILTER_BITS_PER_FILE 8
+
+static uint64_t filter_hash(const FileCache::FileHashKey& key)
+{
+    const uint8_t* bytes = (const uint8_t*)&key;
+    uint64_t h = 0xcbf29ce484222325ULL;
+
+    for (size_t i = 0; i < sizeof(key); i++)
+    {
+        h ^= bytes[i];
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+static inline void filter_positions(const FileCache::FileHashKey& key, uint64_t nbits,
+    uint64_t& bit1, uint64_t& bit2)
+{
+    uint64_t h1 = filter_hash(key);
+    uint64_t h2 = h1 * 0x9e3779b97f4a7c15ULL;
+
+    bit1 = h1 % nbits;
+    bit2 = h2 % nbits;
+}
+
+void FileCache::filter_add(const FileHashKey& key)
+{
+    uint64_t bit1, bit2;
+    filter_positions(key, filter_words * 64, bit1, bit2);
+
+    lookup_filter[bit1 / 64].fetch_or(1ULL << (bit1 % 64), std::memory_order_relaxed);
+    lookup_filter[bit2 / 64].fetch_or(1ULL << (bit2 % 64), std::memory_order_relaxed);
+}
+
+bool FileCache::filter_contains(const FileHashKey& key) const
+{
+    uint64_t bit1, bit2;
+    filter_positions(key, filter_words * 64, bit1, bit2);
+
+    if (!(lookup_filter[bit1 / 64].load(std::memory_order_relaxed) & (1ULL << (bit1 % 64))))
+        return false;
+
+    return (lookup_filter[bit2 / 64].load(std::memory_order_relaxed)
+        & (1ULL << (bit2 % 64))) != 0;
+}
+
+// Expired entries leave their bits behind, so once churn could have
+// saturated the filter it is rebuilt from the live hash nodes. The fresh
+// image is staged off to the side and stored into the live words one by
+// one: every live key has its bits set in both the old and new word
+// values, so concurrent lock-free readers never see a false negative.
+void FileCache::filter_rebuild()
+{
+    uint64_t* staged = (uint64_t*)snort_calloc(filter_words, sizeof(uint64_t));
+
+    for (HashNode* node = fileHash->find_first_node(); node;
+        node = fileHash->find_next_node())
+    {
+        uint64_t bit1, bit2;
+        filter_positions(*(const FileHashKey*)node->key, filter_words * 64, bit1, bit2);
+
+        staged[bit1 / 64] |= 1ULL << (bit1 % 64);
+        staged[bit2 / 64] |= 1ULL << (bit2 % 64);
+    }
+
+    for (uint64_t i = 0; i < filter_words; i++)
+        lookup_filter[i].store(staged[i], std::memory_order_relaxed);
+
+    snort_free(staged);
+    filter_adds = fileHash->get_num_nodes();
+}
+
 FileCache::FileCache(int64_t max_files_cached)
 {
     max_files = max_files_cached;
-    fileHash = new ExpectedFileCache(max_files, sizeof(FileHashKey), sizeof(FileNode));
+    fileHash = new ExpectedFileCache(max_files, sizeof(FileNode));
     fileHash->set_max_nodes(max_files);
+
+    filter_words = (max_files * FILTER_BITS_PER_FILE + 63) / 64;
+    lookup_filter = (std::atomic<uint64_t>*)snort_calloc(filter_words, sizeof(uint64_t));
 }
 
 FileCache::~FileCache()
 {
     delete fileHash;
+    snort_free(lookup_filter);
 }
 
 void FileCache::set_block_timeout(int64_t timeout)
@@ -140,6 +218,13 @@ FileContext* FileCache::add(const FileHashKey& hashKey, int64_t timeout)
 
     std::lock_guard<std::mutex> lock(cache_mutex);
 
+    // set the filter bits before the node is visible in the hash so
+    // lock-free lookups can never miss a present entry
+    filter_add(hashKey);
+
+    if (++filter_adds >= (uint64_t)max_files * 2)
+        filter_rebuild();
+
     if (fileHash->insert((void*)&hashKey, &new_node) != HASH_OK)
     {
         /* Uh, shouldn't get here...
@@ -157,14 +242,28 @@ FileContext* FileCache::add(const FileHashKey& hashKey, int64_t timeout)
 
 FileContext* FileCache::find(const FileHashKey& hashKey, int64_t timeout)
 {
+    if ( !filter_contains(hashKey) )
+    {
+        file_counts.cache_filter_misses++;
+        return nullptr;
+    }
+
     std::lock_guard<std::mutex> lock(cache_mutex);
 
     if ( !fileHash->get_num_nodes() )
+    {
+        file_counts.cache_filter_false_positives++;
         return nullptr;
+    }
 
     HashNode* hash_node = fileHash->find_node(&hashKey);
     if ( !hash_node )
+    {
+        file_counts.cache_filter_false_positives++;
         return nullptr;
+    }
+
+    file_counts.cache_filter_hits++;
 
     FileNode* node = (FileNode*)hash_node->data;
     if ( !node )
@@ -21,6 +21,7 @@
 #ifndef FILE_CACHE_H
 #define FILE_CACHE_H
 
+#include <atomic>
 #include <mutex>
 
 #include "sfip/sf_ip.h"
@@ -70,12 +71,27 @@ private:
     FileVerdict check_verdict(snort::Packet*, snort::FileInfo*, snort::FilePolicyBase*);
     int store_verdict(snort::Flow*, snort::FileInfo*, int64_t timeout);
 
+    void filter_add(const FileHashKey&);
+    bool filter_contains(const FileHashKey&) const;
+    void filter_rebuild();  // caller must hold cache_mutex
+
     /* The hash table of expected files */
     ExpectedFileCache* fileHash = nullptr;
     int64_t block_timeout = DEFAULT_FILE_BLOCK_TIMEOUT;
     int64_t lookup_timeout = DEFAULT_FILE_LOOKUP_TIMEOUT;
     int64_t max_files = DEFAULT_MAX_FILES_CACHED;
     std::mutex cache_mutex;
+
+    // Bloom filter in front of the hash: most lookups are for new files,
+    // and a negative answer here is definitive, so those resolve without
+    // taking cache_mutex. False positives just fall through to find().
+    // Bits are set before insert and only cleared by a locked rebuild
+    // once churn saturates the filter, so readers never see a false
+    // negative. Sized once at construction; raising max_files later only
+    // makes the filter denser.
+    std::atomic<uint64_t>* lookup_filter = nullptr;
+    uint64_t filter_words = 0;
+    uint64_t filter_adds = 0;  // protected by cache_mutex
 };
 
 #endif
@@ -50,6 +50,30 @@ using namespace snort;
 FileMemPool* FileCapture::file_mempool = nullptr;
 int64_t FileCapture::capture_block_size = 0;
 
+// Per-thread magazine of mempool blocks so the common alloc/free path does
+// not take the shared pool mutex. Refills pull half a cache worth in one
+// locked batch; a full cache returns half the same way. Kept small since
+// cached blocks are unavailable to other threads.
+#define BLOCK_CACHE_SIZE 8
+
+static THREAD_LOCAL void* block_cache[BLOCK_CACHE_SIZE];
+static THREAD_LOCAL unsigned block_cache_len;
+
+static void cache_free_block(FileMemPool* pool, void* block)
+{
+    if (block_cache_len == BLOCK_CACHE_SIZE)
+    {
+        const unsigned keep = BLOCK_CACHE_SIZE / 2;
+
+        if (pool->m_free_batch(block_cache + keep, BLOCK_CACHE_SIZE - keep) != FILE_MEM_SUCCESS)
+            file_counts.file_buffers_free_errors++;
+
+        block_cache_len = keep;
+    }
+
+    block_cache[block_cache_len++] = block;
+}
+
 std::mutex FileCapture::capture_mutex;
 std::condition_variable FileCapture::capture_cv;
 std::thread* FileCapture::file_storer = nullptr;
@@ -117,8 +141,7 @@ FileCapture::~FileCapture()
         }
         else
         {
-            if (file_mempool->m_free(file_block) != FILE_MEM_SUCCESS)
-                file_counts.file_buffers_free_errors++;
+            cache_free_block(file_mempool, file_block);
             file_counts.file_buffers_freed_total++;
         }
 
@@ -164,6 +187,17 @@ void FileCapture::exit()
     }
 }
 
+void FileCapture::thread_exit()
+{
+    if (file_mempool and block_cache_len)
+    {
+        if (file_mempool->m_free_batch(block_cache, block_cache_len) != FILE_MEM_SUCCESS)
+            file_counts.file_buffers_free_errors++;
+    }
+
+    block_cache_len = 0;
+}
+
 /*
  * Initialize the file memory pool
  *
@@ -194,14 +228,20 @@ inline FileCaptureBlock* FileCapture::create_file_buffer()
     if (!file_mempool)
         return nullptr;
 
-    FileCaptureBlock* fileBlock = (FileCaptureBlock*)file_mempool->m_alloc();
-
-    if (fileBlock == nullptr)
+    if (!block_cache_len)
     {
-        file_counts.file_memcap_failures_total++;
-        return nullptr;
+        file_counts.file_buffer_refill_stalls++;
+        block_cache_len = file_mempool->m_alloc_batch(block_cache, BLOCK_CACHE_SIZE / 2);
+
+        if (!block_cache_len)
+        {
+            file_counts.file_memcap_failures_total++;
+            return nullptr;
+        }
     }
 
+    FileCaptureBlock* fileBlock = (FileCaptureBlock*)block_cache[--block_cache_len];
+
     file_counts.file_buffers_allocated_total++;
 
     fileBlock->length = 0;
@@ -87,6 +87,10 @@ public:
     // this must be called when snort exits
     static void exit();
 
+    // return this thread's cached blocks to the mempool,
+    // called when a packet thread terminates
+    static void thread_exit();
+
     static FileCaptureState error_capture(FileCaptureState);
 
     static int64_t get_block_size() { return capture_block_size; }
@@ -63,6 +63,12 @@ void FileConfig::process_file_rule(FileMagicRule& rule)
     fileIdentifier.insert_file_rule(rule);
 }
 
+/*Called once after all rule options are parsed*/
+void FileConfig::compile_file_rules()
+{
+    fileIdentifier.compile();
+}
+
 void FileConfig::process_file_policy_rule(FileRule& rule)
 {
     filePolicy.insert_file_rule(rule);
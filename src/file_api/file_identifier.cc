@@ -31,6 +31,8 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <unordered_map>
 
 #include "hash/ghash.h"
 #include "log/messages.h"
@@ -306,6 +308,68 @@ void FileIdentifier::insert_file_rule(FileMagicRule& rule)
     update_trie(identifier_root, node);
 }
 
+/*
+ * Flatten the merged tries into a contiguous state table. The tries and
+ * the merge hash are only needed while rules are being inserted, so they
+ * are released once the table is built.
+ */
+void FileIdentifier::compile()
+{
+    if (!identifier_root || !id_states.empty())
+        return;
+
+    std::unordered_map<IdentifierNode*, uint32_t> state_ids;
+    std::vector<IdentifierNode*> nodes;
+
+    /* Number the nodes breadth first, index 0 is reserved as null */
+    state_ids[identifier_root] = 1;
+    nodes.emplace_back(identifier_root);
+
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+        IdentifierNode* node = nodes[i];
+
+        for (unsigned int index = 0; index < MAX_BRANCH; index++)
+        {
+            IdentifierNode* next = node->next[index];
+
+            if (next && !state_ids.count(next))
+            {
+                state_ids[next] = (uint32_t)nodes.size() + 1;
+                nodes.emplace_back(next);
+            }
+        }
+    }
+
+    id_states.resize(nodes.size() + 1);
+
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+        IdentifierNode* node = nodes[i];
+        IdentifierState& state = id_states[i + 1];
+
+        state.type_id = node->type_id;
+        state.offset = node->offset;
+
+        for (unsigned int index = 0; index < MAX_BRANCH; index++)
+        {
+            if (node->next[index])
+                state.next[index] = state_ids[node->next[index]];
+        }
+    }
+
+    /*Only the table is kept for matching*/
+    for (auto mem_block:id_memory_blocks)
+        snort_free(mem_block);
+    id_memory_blocks.clear();
+    identifier_root = nullptr;
+
+    delete identifier_merge_hash;
+    identifier_merge_hash = nullptr;
+
+    memory_used = id_states.size() * sizeof(IdentifierState);
+}
+
 /*
  * This is the main function to find file type
  * Find file type is to traverse the tries.
@@ -321,13 +385,52 @@ uint32_t FileIdentifier::find_file_type_id(const uint8_t* buf, int len, uint64_t
     if ( !buf || len <= 0 )
         return SNORT_FILE_TYPE_CONTINUE;
 
+    uint64_t end = file_offset + len;
+
+    if (!id_states.empty())
+    {
+        /* Compiled walk: context holds the state index, which is never 0
+         * for a saved state since the root is state 1 */
+        uint32_t current = *context ? (uint32_t)(uintptr_t)(*context) : 1;
+
+        while (current && (id_states[current].offset >= file_offset))
+        {
+            const IdentifierState& state = id_states[current];
+
+            /*Found file id, save and continue*/
+            if (state.type_id)
+            {
+                file_type_id = state.type_id;
+            }
+
+            if ( state.offset >= end )
+            {
+                /* Save current state */
+                *context = (void*)(uintptr_t)current;
+                if (file_type_id)
+                    return file_type_id;
+                else
+                    return SNORT_FILE_TYPE_CONTINUE;
+            }
+
+            /*Move to the next level*/
+            current = state.next[buf[state.offset - file_offset ]];
+        }
+
+        /*Either end of magics or passed the current offset*/
+        *context = nullptr;
+
+        if ( file_type_id == SNORT_FILE_TYPE_CONTINUE )
+            file_type_id = SNORT_FILE_TYPE_UNKNOWN;
+
+        return file_type_id;
+    }
+
     if (!(*context))
         *context = (void*)(identifier_root);
 
     IdentifierNode* current = (IdentifierNode*)(*context);
 
-    uint64_t end = file_offset + len;
-
     while (current &&  (current->offset >= file_offset))
     {
         /*Found file id, save and continue*/
@@ -546,5 +649,103 @@ TEST_CASE ("FileIdRuleFirst", "[FileMagic]")
 
     CHECK(rc.find_file_type_id((const uint8_t*)data, strlen(data), 0, &context) == 1);
 }
+
+TEST_CASE ("FileIdCompiled", "[FileMagic]")
+{
+    FileMagicData magic;
+
+    magic.content = "PDF";
+    magic.offset = 0;
+
+    FileMagicRule rule;
+
+    rule.type = "pdf";
+    rule.file_magics.emplace_back(magic);
+    rule.id = 1;
+
+    FileIdentifier rc;
+    rc.insert_file_rule(rule);
+
+    magic.clear();
+    magic.content = "EXE";
+    magic.offset = 3;
+
+    rule.clear();
+    rule.type = "exe";
+    rule.file_magics.emplace_back(magic);
+    rule.id = 3;
+
+    rc.insert_file_rule(rule);
+
+    rc.compile();
+
+    const char* data = "PDFEXE";
+    void* context = nullptr;
+
+    // Match the last one
+    CHECK((rc.find_file_type_id((const uint8_t*)data, strlen(data), 0, &context) == 3));
+}
+
+TEST_CASE ("FileIdCompiledSplit", "[FileMagic]")
+{
+    FileMagicData magic;
+
+    magic.content = "PDF";
+    magic.offset = 0;
+
+    FileMagicRule rule;
+
+    rule.type = "pdf";
+    rule.file_magics.emplace_back(magic);
+    rule.id = 1;
+
+    FileIdentifier rc;
+    rc.insert_file_rule(rule);
+
+    magic.clear();
+    magic.content = "EXE";
+    magic.offset = 3;
+
+    rule.clear();
+    rule.type = "exe";
+    rule.file_magics.emplace_back(magic);
+    rule.id = 3;
+
+    rc.insert_file_rule(rule);
+
+    rc.compile();
+
+    void* context = nullptr;
+
+    // Context carries the compiled state across segments
+    CHECK((rc.find_file_type_id((const uint8_t*)"PD", 2, 0, &context) ==
+        SNORT_FILE_TYPE_CONTINUE));
+    CHECK((rc.find_file_type_id((const uint8_t*)"FEXE", 4, 2, &context) == 3));
+}
+
+TEST_CASE ("FileIdCompiledUnknown", "[FileMagic]")
+{
+    FileMagicData magic;
+
+    magic.content = "PDF";
+    magic.offset = 0;
+
+    FileMagicRule rule;
+
+    rule.type = "pdf";
+    rule.file_magics.emplace_back(magic);
+    rule.id = 1;
+
+    FileIdentifier rc;
+    rc.insert_file_rule(rule);
+
+    rc.compile();
+
+    const char* data = "DDF";
+    void* context = nullptr;
+
+    CHECK((rc.find_file_type_id((const uint8_t*)data, strlen(data), 0, &context) ==
+        SNORT_FILE_TYPE_UNKNOWN));
+}
 #endif
 
@@ -82,6 +82,17 @@ struct IdentifierNode
     struct IdentifierNode* next[MAX_BRANCH]; /* pointer to an array of 256 identifiers pointers*/
 };
 
+/* Flattened copy of the magic tries: one contiguous state per trie node
+ * with transitions stored as table indices, so the per byte walk scans a
+ * compact array instead of chasing pointers between heap nodes. Built once
+ * after all rules are inserted. */
+struct IdentifierState
+{
+    uint32_t type_id;
+    uint32_t offset;            /* offset from file start */
+    uint32_t next[MAX_BRANCH];  /* state indices, 0 means no transition */
+};
+
 typedef std::list<void* >  IDMemoryBlocks;
 
 class FileIdentifier
@@ -90,6 +101,7 @@ public:
     ~FileIdentifier();
     uint32_t memory_usage() const { return memory_used; }
     void insert_file_rule(FileMagicRule& rule);
+    void compile();
     uint32_t find_file_type_id(const uint8_t* buf, int len, uint64_t offset, void** context);
     const FileMagicRule* get_rule_from_id(uint32_t) const;
     void get_magic_rule_ids_from_type(const std::string&, const std::string&,
@@ -106,6 +118,7 @@ private:
 
     /*properties*/
     IdentifierNode* identifier_root = nullptr; /*Root of magic tries*/
+    std::vector<IdentifierState> id_states; /*Flat state table, entry 0 is the null transition*/
     uint32_t memory_used = 0; /*Track memory usage*/
     snort::GHash* identifier_merge_hash = nullptr;
     FileMagicRule file_magic_rules[FILE_ID_MAX + 1];
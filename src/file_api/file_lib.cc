@@ -578,7 +578,9 @@ void FileContext::process_file_signature_sha256(const uint8_t* file_data, int da
         SHA256_Update((SHA256_CTX*)file_signature_context, file_data, data_size);
         if (file_state.sig_state == FILE_SIG_FLUSH)
         {
-            static uint8_t file_signature_context_backup[sizeof(SHA256_CTX)];
+            // the context must survive the flush, so finalize a copy;
+            // the backup is on the stack as packet threads flush concurrently
+            uint8_t file_signature_context_backup[sizeof(SHA256_CTX)];
             sha256 = (uint8_t*)snort_alloc(SHA256_HASH_SIZE);
             memcpy(file_signature_context_backup, file_signature_context, sizeof(SHA256_CTX));
 
@@ -593,7 +595,7 @@ void FileContext::process_file_signature_sha256(const uint8_t* file_data, int da
         SHA256_Update((SHA256_CTX*)file_signature_context, file_data, data_size);
         if (file_state.sig_state == FILE_SIG_FLUSH)
         {
-            static uint8_t file_signature_context_backup[sizeof(SHA256_CTX)];
+            uint8_t file_signature_context_backup[sizeof(SHA256_CTX)];
             if ( !sha256 )
                 sha256 = (uint8_t*)snort_alloc(SHA256_HASH_SIZE);
             memcpy(file_signature_context_backup, file_signature_context, sizeof(SHA256_CTX));
@@ -162,6 +162,46 @@ int FileMemPool::remove(CircularBuffer* cb, void* obj)
     return FILE_MEM_SUCCESS;
 }
 
+uint64_t FileMemPool::m_alloc_batch(void** objs, uint64_t n)
+{
+    std::lock_guard<std::mutex> lock(pool_mutex);
+
+    uint64_t got = 0;
+
+    while (got < n)
+    {
+        void* b = nullptr;
+
+        if (cbuffer_read(free_list, &b))
+        {
+            if (cbuffer_read(released_list, &b))
+                break;
+        }
+
+        // clear the magic now; unlike m_alloc, a batched block may be
+        // returned unused and must not look like a double free
+        *(MagicType*)b = 0;
+        objs[got++] = b;
+    }
+
+    return got;
+}
+
+int FileMemPool::m_free_batch(void** objs, uint64_t n)
+{
+    std::lock_guard<std::mutex> lock(pool_mutex);
+
+    int ret = FILE_MEM_SUCCESS;
+
+    for (uint64_t i = 0; i < n; i++)
+    {
+        if (remove(free_list, objs[i]) != FILE_MEM_SUCCESS)
+            ret = FILE_MEM_FAIL;
+    }
+
+    return ret;
+}
+
 int FileMemPool::m_free(void* obj)
 {
     std::lock_guard<std::mutex> lock(pool_mutex);
@@ -51,6 +51,12 @@ public:
     // Return: FILE_MEM_SUCCESS or FILE_MEM_FAIL
     int m_free(void* obj);
 
+    // Batch forms of alloc/free that take the pool lock once; these back
+    // the per-thread block caches in FileCapture
+    // Returns: number of objects actually allocated (may be < n)
+    uint64_t m_alloc_batch(void** objs, uint64_t n);
+    int m_free_batch(void** objs, uint64_t n);
+
     // This can be called by a different thread calling file_mempool_alloc()
     // Return: FILE_MEM_SUCCESS or FILE_MEM_FAIL
     int m_release(void* obj);
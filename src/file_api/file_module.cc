@@ -217,6 +217,14 @@ static const PegInfo file_pegs[] =
     { CountType::SUM, "cache_failures", "number of file cache add failures" },
     { CountType::SUM, "files_not_processed", "number of files not processed due to per-flow limit" },
     { CountType::MAX, "max_concurrent_files", "maximum files processed concurrently on a flow" },
+    { CountType::SUM, "buffer_refill_stalls",
+      "number of times file capture refilled its block cache from the shared pool" },
+    { CountType::SUM, "cache_filter_misses",
+      "number of file cache lookups resolved by the filter without locking" },
+    { CountType::SUM, "cache_filter_hits",
+      "number of file cache lookups passed by the filter and found" },
+    { CountType::SUM, "cache_filter_false_positives",
+      "number of file cache lookups passed by the filter but not found" },
     { CountType::END, nullptr, nullptr }
 };
 
@@ -468,6 +476,9 @@ bool FileIdModule::end(const char* fqn, int idx, SnortConfig*)
 {
     if (!idx)
     {
+        if ( fc )
+            fc->compile_file_rules();
+
         if ( need_active )
             Active::set_enabled();
         return true;
@@ -116,7 +116,10 @@ void FileService::thread_init()
 { file_stats_init(); }
 
 void FileService::thread_term()
-{ file_stats_term(); }
+{
+    FileCapture::thread_exit();
+    file_stats_term();
+}
 
 void FileService::enable_file_type()
 {
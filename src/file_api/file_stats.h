@@ -37,6 +37,10 @@ struct FileCounts
     PegCount cache_add_fails;
     PegCount files_over_flow_limit_not_processed;
     PegCount max_concurrent_files_per_flow;
+    PegCount file_buffer_refill_stalls;
+    PegCount cache_filter_misses;
+    PegCount cache_filter_hits;
+    PegCount cache_filter_false_positives;
     PegCount files_buffered_total;
     PegCount files_released_total;
     PegCount files_freed_total;
@@ -90,6 +90,7 @@ void detection_filter_term()
     if ( !detection_filter_hash )
         return;
 
+    sfthd_cache_clear(detection_filter_hash);
     delete detection_filter_hash;
     detection_filter_hash = nullptr;
 }
@@ -102,6 +102,13 @@ typedef struct
 
 static THREAD_LOCAL XHash* rf_hash = nullptr;
 
+/* Last tracking node touched on this thread.  A scan flood hammers the
+ * same tid + address back to back, so most events can reuse this node and
+ * skip the hash probe.  The node's inline key copy makes the shortcut
+ * self validating: a node recycled for another key misses the compare
+ * and the normal probe runs (same scheme as sfthd.cc). */
+static THREAD_LOCAL HashNode* rf_last_node = nullptr;
+
 // private methods ...
 static int _checkThreshold(
     tSFRFConfigNode*,
@@ -160,6 +167,7 @@ void SFRF_Delete()
     if ( !rf_hash )
         return;
 
+    rf_last_node = nullptr;
     delete rf_hash;
     rf_hash = nullptr;
 }
@@ -167,7 +175,12 @@ void SFRF_Delete()
 void SFRF_Flush()
 {
     if ( rf_hash )
+    {
+        // flushed nodes keep their key bytes on the free list, so the
+        // shortcut can't be allowed to match one
+        rf_last_node = nullptr;
         rf_hash->clear_hash();
+    }
 }
 
 static void SFRF_ConfigNodeFree(void* item)
@@ -781,6 +794,11 @@ static tSFRFTrackingNode* _getSFRFTrackingNode(const SfIp* ip, unsigned tid, tim
     key.policyId = get_ips_policy()->policy_id;
     key.padding = 0;
 
+    /* Same entity as the last event through?  The compare covers the same
+     * raw bytes the hash key compare would. */
+    if ( rf_last_node && !memcmp(rf_last_node->key, &key, sizeof(key)) )
+        return (tSFRFTrackingNode*)rf_last_node->data;
+
     // Check for any Permanent sid objects for this gid or add this one ...
     if ( rf_hash->insert(&key, nullptr) == HASH_NOMEM )
     {
@@ -800,5 +818,7 @@ static tSFRFTrackingNode* _getSFRFTrackingNode(const SfIp* ip, unsigned tid, tim
         dynNode->filterState = FS_OFF;
     }
 
+    rf_last_node = rf_hash->get_last_node();
+
     return dynNode;
 }
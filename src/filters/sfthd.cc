@@ -34,6 +34,7 @@
 #include "sfthd.h"
 
 #include <cassert>
+#include <cstring>
 
 #include "hash/ghash.h"
 #include "hash/hash_defs.h"
@@ -51,15 +52,36 @@ using namespace snort;
 
 THREAD_LOCAL EventFilterStats event_filter_stats;
 
-XHash* sfthd_new_hash(unsigned nbytes, size_t key, size_t data)
+/* Threshold state is per packet thread, so a chatty sig hammers this
+ * thread's table with the same key back to back; remember the last node
+ * touched and skip the hash probe when the key repeats.  The node's
+ * inline key copy makes the check self validating: if the node was
+ * recycled for another key meanwhile, the compare misses and the normal
+ * probe runs. */
+static THREAD_LOCAL XHash* last_node_hash = nullptr;
+static THREAD_LOCAL HashNode* last_node = nullptr;
+
+void sfthd_cache_clear(XHash* hash)
 {
-    size_t size = key + data;
-    int nrows;
+    if ( last_node_hash == hash )
+    {
+        last_node_hash = nullptr;
+        last_node = nullptr;
+    }
+}
 
-    /* Calc max ip nodes for this memory */
+/* Calc max ip nodes for this memory */
+static int sfthd_hash_rows(unsigned& nbytes, size_t size)
+{
     if ( nbytes < size )
         nbytes = size;
-    nrows = nbytes / size;
+
+    return nbytes / size;
+}
+
+XHash* sfthd_new_hash(unsigned nbytes, size_t key, size_t data)
+{
+    int nrows = sfthd_hash_rows(nbytes, key + data);
 
     return new XHash(nrows, key, data, nbytes);
 }
@@ -77,10 +99,9 @@ XHash* sfthd_new_hash(unsigned nbytes, size_t key, size_t data)
 
 XHash* sfthd_local_new(unsigned bytes)
 {
+    int rows = sfthd_hash_rows(bytes, sizeof(THD_IP_NODE_KEY) + sizeof(THD_IP_NODE));
     XHash* local_hash =
-        sfthd_new_hash(bytes,
-        sizeof(THD_IP_NODE_KEY),
-        sizeof(THD_IP_NODE));
+        new TXHash<sizeof(THD_IP_NODE_KEY)>(rows, sizeof(THD_IP_NODE), bytes);
 
 #ifdef THD_DEBUG
     if (local_hash == NULL)
@@ -92,10 +113,9 @@ XHash* sfthd_local_new(unsigned bytes)
 
 XHash* sfthd_global_new(unsigned bytes)
 {
+    int rows = sfthd_hash_rows(bytes, sizeof(THD_IP_GNODE_KEY) + sizeof(THD_IP_NODE));
     XHash* global_hash =
-        sfthd_new_hash(bytes,
-        sizeof(THD_IP_GNODE_KEY),
-        sizeof(THD_IP_NODE));
+        new TXHash<sizeof(THD_IP_GNODE_KEY)>(rows, sizeof(THD_IP_NODE), bytes);
 
 #ifdef THD_DEBUG
     if (global_hash == NULL)
@@ -146,6 +166,52 @@ ThresholdObjects* sfthd_objs_new()
     return (ThresholdObjects*)snort_calloc(sizeof(ThresholdObjects));
 }
 
+void sfthd_objs_freeze(ThresholdObjects* thd_objs)
+{
+    if (thd_objs == nullptr)
+        return;
+
+    /* These tables are read-only once the config is loaded but are probed
+     * for every event, so swap in the flat lookup view */
+    for (int i = 0; i < THD_MAX_GENID; i++)
+    {
+        GHash* sfthd_hash = thd_objs->sfthd_array[i];
+
+        if ( !sfthd_hash )
+            continue;
+
+        /* build the sig_id pre-gate bitmap so events with no threshold
+         * objects never reach the hash; skip gen_ids with outsized sig_ids
+         * rather than allocate a sparse map */
+        unsigned max_sid = 0;
+
+        for ( GHashNode* n = sfthd_hash->find_first(); n; n = sfthd_hash->find_next() )
+        {
+            const THD_ITEM* item = (const THD_ITEM*)n->data;
+
+            if ( item->sig_id > max_sid )
+                max_sid = item->sig_id;
+        }
+
+        if ( max_sid < THD_SID_MAP_MAX_BITS )
+        {
+            unsigned bits = (max_sid + 64) & ~63u;
+            uint64_t* map = (uint64_t*)snort_calloc(bits / 8);
+
+            for ( GHashNode* n = sfthd_hash->find_first(); n; n = sfthd_hash->find_next() )
+            {
+                const THD_ITEM* item = (const THD_ITEM*)n->data;
+                map[item->sig_id >> 6] |= (uint64_t)1 << (item->sig_id & 63);
+            }
+
+            thd_objs->sfthd_sid_map[i] = map;
+            thd_objs->sfthd_sid_map_bits[i] = bits;
+        }
+
+        sfthd_hash->freeze();
+    }
+}
+
 void sfthd_node_free(THD_NODE* sfthd_node)
 {
     if ( !sfthd_node )
@@ -169,6 +235,9 @@ void sfthd_objs_free(ThresholdObjects* thd_objs)
     {
         if ( thd_objs->sfthd_array[i] )
             delete thd_objs->sfthd_array[i];
+
+        if ( thd_objs->sfthd_sid_map[i] )
+            snort_free(thd_objs->sfthd_sid_map[i]);
     }
 
     for (PolicyId policy_id = 0; policy_id < thd_objs->numPoliciesAllocated; policy_id++)
@@ -222,7 +291,10 @@ void sfthd_free(THD_STRUCT* thd)
         return;
 
     if ( thd->ip_nodes )
+    {
+        sfthd_cache_clear(thd->ip_nodes);
         delete thd->ip_nodes;
+    }
 
     if ( thd->ip_gnodes )
         delete thd->ip_gnodes;
@@ -872,6 +944,16 @@ int sfthd_test_local(
     key.thd_id = sfthd_node->thd_id;
     key.padding = 0;
 
+    /* Same key as the last event through this table? - the node compare
+     * uses the same raw bytes as the hash key compare would */
+    if ( (last_node_hash == local_hash) && last_node &&
+        !memcmp(last_node->key, &key, sizeof(key)) )
+    {
+        sfthd_ip_node = (THD_IP_NODE*)last_node->data;
+        sfthd_ip_node->count++;
+        return sfthd_test_non_suppress(sfthd_node, sfthd_ip_node, curtime);
+    }
+
     /* Set up a new data element */
     data.count  = 1;
     data.prev   = 0;
@@ -905,6 +987,9 @@ int sfthd_test_local(
         sfthd_ip_node = &data;
     }
 
+    last_node_hash = local_hash;
+    last_node = local_hash->get_last_node();
+
     return sfthd_test_non_suppress(sfthd_node, sfthd_ip_node, curtime);
 }
 
@@ -1072,6 +1157,17 @@ int sfthd_test_threshold(
         /* return 0; */ /* no threshold objects for this gen_id, log it ! */
     }
 
+    /* Pre-gate on the frozen bitmap: a clear bit (or a sig_id past the map)
+       means no threshold objects exist for this gen_id/sig_id in any policy,
+       so skip the hash probe */
+    if ( thd_objs->sfthd_sid_map[gen_id] )
+    {
+        if ( sig_id >= thd_objs->sfthd_sid_map_bits[gen_id] ||
+            !(thd_objs->sfthd_sid_map[gen_id][sig_id >> 6] &
+              ((uint64_t)1 << (sig_id & 63))) )
+            goto global_test;
+    }
+
     key.sig_id = sig_id;
     key.policyId = policy_id;
     /*
@@ -47,6 +47,10 @@ typedef struct sf_list SF_LIST;
 #define THD_GEN_ID_1_ROWS 4096
 #define THD_GEN_ID_ROWS   512
 
+/* Largest sig_id covered by the per gen_id pre-gate bitmaps (128KB each);
+   gen_ids with bigger sig_ids just keep probing the hash. */
+#define THD_SID_MAP_MAX_BITS (1 << 20)
+
 #define THD_NO_THRESHOLD (-1)
 
 #define THD_TOO_MANY_THDOBJ (-15)
@@ -207,6 +211,14 @@ struct ThresholdObjects
     //THD_NODE * (*sfthd_garray)[THD_MAX_GENID];
     THD_NODE*** sfthd_garray;
     PolicyId numPoliciesAllocated;
+
+    /* Dense per gen_id bitmap of sig_ids with local threshold objects in any
+     * policy, built when the config is frozen.  A clear bit - or a sig_id past
+     * the map - means the hash probe can be skipped, so the common
+     * un-thresholded event costs two loads.  Null until frozen, and left null
+     * for gen_ids whose largest sig_id would make the map sparse. */
+    uint64_t* sfthd_sid_map[THD_MAX_GENID];
+    unsigned sfthd_sid_map_bits[THD_MAX_GENID];
 };
 
 struct EventFilterStats
@@ -226,6 +238,7 @@ snort::XHash* sfthd_global_new(unsigned bytes);
 void sfthd_free(THD_STRUCT*);
 ThresholdObjects* sfthd_objs_new();
 void sfthd_objs_free(ThresholdObjects*);
+void sfthd_objs_freeze(ThresholdObjects*);
 
 int sfthd_test_rule(snort::XHash* rule_hash, THD_NODE* sfthd_node,
     const snort::SfIp* sip, const snort::SfIp* dip, long curtime, PolicyId policy_id);
@@ -251,6 +264,10 @@ int sfthd_test_threshold(ThresholdObjects*, THD_STRUCT*, unsigned gen_id, unsign
 
 snort::XHash* sfthd_new_hash(unsigned, size_t, size_t);
 
+// drop the per-thread last-node shortcut if it points into this hash;
+// call before deleting a hash passed to sfthd_test_local / sfthd_test_rule
+void sfthd_cache_clear(snort::XHash*);
+
 int sfthd_test_local(snort::XHash* local_hash, THD_NODE* sfthd_node, const snort::SfIp* sip,
     const snort::SfIp* dip, time_t curtime, PolicyId policy_id);
 
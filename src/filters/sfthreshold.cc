@@ -86,6 +86,16 @@ void ThresholdConfigFree(ThresholdConfig* tc)
     snort_free(tc);
 }
 
+/* Called once the config is fully parsed, before packet threads probe the
+ * threshold tables */
+void ThresholdConfigFreeze(ThresholdConfig* tc)
+{
+    if (tc == nullptr)
+        return;
+
+    sfthd_objs_freeze(tc->thd_objs);
+}
+
 void sfthreshold_free()
 {
     if (thd_runtime != nullptr)
@@ -39,6 +39,7 @@ struct ThresholdConfig
 
 ThresholdConfig* ThresholdConfigNew();
 void ThresholdConfigFree(ThresholdConfig*);
+void ThresholdConfigFreeze(ThresholdConfig*);
 void sfthreshold_reset();
 int sfthreshold_create(snort::SnortConfig*, ThresholdConfig*, THDX_STRUCT*, PolicyId);
 int sfthreshold_test(
@@ -25,6 +25,7 @@
 
 #include "detection/ips_context.h"
 #include "hash/zhash.h"
+#include "main/snort_config.h"
 #include "packet_io/sfdaq_instance.h"
 #include "protocols/packet.h"
 #include "protocols/vlan.h"
@@ -101,6 +102,7 @@ struct ExpectNode
     bool reversed_key = false;
     int direction = 0;
     unsigned count = 0;
+    int key_class = 0;
     SnortProtocolId snort_protocol_id = UNKNOWN_PROTOCOL_ID;
 
     ExpectFlow* head = nullptr;
@@ -109,6 +111,27 @@ struct ExpectNode
     void clear(ExpectFlow*&);
 };
 
+/* Expected keys have at most one real port (see add_flow), so every key
+ * falls in one of three classes by which port is wildcarded.  A lookup
+ * probe can only match stored keys of its own class, which lets lookups
+ * skip probes for classes with no nodes - with FTP or SIP style traffic
+ * usually all but one. */
+enum ExpectKeyClass
+{
+    EXPECT_KEY_FULL,       // both ports present
+    EXPECT_KEY_WILD_LOW,   // port_l is zero
+    EXPECT_KEY_WILD_HIGH   // port_h is zero
+};
+
+static inline int expect_key_class(const FlowKey& key)
+{
+    if (key.port_l == 0)
+        return EXPECT_KEY_WILD_LOW;
+    if (key.port_h == 0)
+        return EXPECT_KEY_WILD_HIGH;
+    return EXPECT_KEY_FULL;
+}
+
 void ExpectNode::clear(ExpectFlow*& list)
 {
     while (head)
@@ -131,6 +154,7 @@ void ExpectCache::prune_lru()
 {
     ExpectNode* node = static_cast<ExpectNode*>( hash_table->lru_first() );
     assert(node);
+    --num_keys[node->key_class];
     node->clear(free_list);
     hash_table->release();
     ++prunes;
@@ -139,7 +163,10 @@ void ExpectCache::prune_lru()
 ExpectNode* ExpectCache::find_node_by_packet(Packet* p, FlowKey &key)
 {
     if (!hash_table->get_num_nodes())
+    {
+        ++fast_rejects;
         return nullptr;
+    }
 
     const SfIp* srcIP = p->ptrs.ip_api.get_src();
     const SfIp* dstIP = p->ptrs.ip_api.get_dst();
@@ -160,9 +187,14 @@ ExpectNode* ExpectCache::find_node_by_packet(Packet* p, FlowKey &key)
         If the client/server addresses were reversed during key creation, the
         source port will be in port_l.
     */
-    // FIXIT-P X This should be optimized to only do full matches when full keys
-    //      are present, likewise for partial keys.
-    ExpectNode* node = static_cast<ExpectNode*>( hash_table->get_user_data(&key) );
+    bool probed_table = false;
+    ExpectNode* node = nullptr;
+
+    if ( num_keys[expect_key_class(key)] )
+    {
+        probed_table = true;
+        node = static_cast<ExpectNode*>( hash_table->get_user_data(&key) );
+    }
     if (!node)
     {
         // FIXIT-M X This logic could fail if IPs were equal because the original key
@@ -183,20 +215,36 @@ ExpectNode* ExpectCache::find_node_by_packet(Packet* p, FlowKey &key)
             port2 = key.port_h;
             key.port_h = 0;
         }
-        node = static_cast<ExpectNode*> ( hash_table->get_user_data(&key) );
+        if ( num_keys[expect_key_class(key)] )
+        {
+            probed_table = true;
+            node = static_cast<ExpectNode*> ( hash_table->get_user_data(&key) );
+        }
         if (!node)
         {
             key.port_l = port1;
             key.port_h = port2;
-            node = static_cast<ExpectNode*> ( hash_table->get_user_data(&key) );
+            if ( num_keys[expect_key_class(key)] )
+            {
+                probed_table = true;
+                node = static_cast<ExpectNode*> ( hash_table->get_user_data(&key) );
+            }
             if (!node)
+            {
+                if ( probed_table )
+                    ++probes;
+                else
+                    ++fast_rejects;
                 return nullptr;
+            }
         }
     }
+    ++probes;
     if (!node->head || (p->pkth->ts.tv_sec > node->expires))
     {
         if (node->head)
             node->clear(free_list);
+        --num_keys[node->key_class];
         hash_table->release_node(&key);
         return nullptr;
     }
@@ -245,10 +293,28 @@ bool ExpectCache::process_expected(ExpectNode* node, FlowKey& key, Packet* p, Fl
     if (!node->snort_protocol_id)
         ignoring = node->direction != 0;
     else
+    {
         lws->ssn_state.snort_protocol_id = node->snort_protocol_id;
 
+        /* The expecting inspector already resolved the service, so push it
+            onto the flow now.  The resulting service change event rebinds the
+            flow straight to the service inspector, sparing the wizard from
+            rediscovering what we were told at add_flow() time. */
+        const char* service =
+            SnortConfig::get_conf()->proto_ref->get_name(node->snort_protocol_id);
+
+        if (service && !lws->service)
+        {
+            lws->set_service(p, service);
+            ++prebound;
+        }
+    }
+
     if (!node->count)
+    {
+        --num_keys[node->key_class];
         hash_table->release_node(&key);
+    }
 
     return ignoring;
 }
@@ -332,6 +398,8 @@ int ExpectCache::add_flow(const Packet *ctrlPkt, PktType type, IpProtocol ip_pro
             prune_lru();
         node = static_cast<ExpectNode*> ( hash_table->get(&key) );
         assert(node);
+        node->key_class = expect_key_class(key);
+        ++num_keys[node->key_class];
         new_node = true;
     }
     else if ( packet_time() > node->expires )
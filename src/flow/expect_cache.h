@@ -107,6 +107,9 @@ public:
     unsigned long get_realized() { return realized; }
     unsigned long get_prunes() { return prunes; }
     unsigned long get_overflows() { return overflows; }
+    unsigned long get_fast_rejects() { return fast_rejects; }
+    unsigned long get_probes() { return probes; }
+    unsigned long get_prebound() { return prebound; }
 
 private:
     void prune_lru();
@@ -127,6 +130,13 @@ private:
     unsigned long realized = 0;
     unsigned long prunes = 0;
     unsigned long overflows = 0;
+    unsigned long fast_rejects = 0;  // lookups answered without a hash probe
+    unsigned long probes = 0;        // lookups that probed the table
+    unsigned long prebound = 0;      // flows realized with a pre-resolved service
+
+    // nodes in the table per key class (see expect_key_class); a probe
+    // whose key falls in an empty class cannot match and is skipped
+    unsigned num_keys[3] = { 0, 0, 0 };
 };
 
 #endif
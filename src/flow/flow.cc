@@ -131,14 +131,20 @@ inline void Flow::clean()
         delete[] mpls_server.start;
         mpls_server.length = 0;
     }
+    // zero in place rather than delete; a zeroed bitop is equivalent to no
+    // bitop and the buffer gets reused when the flow is recycled (set()
+    // regrows it if a reload raised the flowbits count)
     if ( bitop )
-    {
-        delete bitop;
-        bitop = nullptr;
-    }
+        bitop->reset();
+
     filtering_state.clear();
 }
 
+// recycle teardown: this is the hot path for churny traffic, so it only
+// does the security relevant clearing - session and inspector state must
+// not leak across sessions - and keeps the allocations (session, stash,
+// ha_state, bitop) for the next tenant.  excess pruned flows skip even
+// this until reap_deferred() trickles them down.
 void Flow::reset(bool do_cleanup)
 {
     if ( session )
@@ -97,6 +97,7 @@
 
 class BitOp;
 class Session;
+struct PortGroup;
 
 namespace snort
 {
@@ -104,6 +105,7 @@ class FlowHAState;
 struct FlowKey;
 class IpsContext;
 struct Packet;
+struct SnortConfig;
 
 typedef void (* StreamAppDataFree)(void*);
 
@@ -415,6 +417,13 @@ public:  // FIXIT-M privatize if possible
     Inspector* data;
     const char* service;
 
+    // service rule groups resolved at first use (see fpEvalHeaderSvc);
+    // keyed on the config and protocol id so config reloads and service
+    // changes re-resolve
+    const SnortConfig* svc_pg_conf;
+    PortGroup* svc_pg[2];  // 0 = to client, 1 = to server
+    SnortProtocolId svc_pg_id;
+
     uint64_t expire_time;
 
     DeferredWhitelist deferred_whitelist = WHITELIST_DEFER_OFF;
@@ -53,7 +53,9 @@ static const unsigned ALL_FLOWS = 3;
 
 FlowCache::FlowCache(const FlowCacheConfig& cfg) : config(cfg)
 {
-    hash_table = new ZHash(config.max_flows, sizeof(FlowKey));
+    // one lru list per packet type so expiry checks never walk past an
+    // unexpired flow of a longer lived type
+    hash_table = new ZHash(config.max_flows, sizeof(FlowKey), to_utype(PktType::MAX));
     uni_flows = new FlowUniList;
     uni_ip_flows = new FlowUniList;
     flags = 0x0;
@@ -63,6 +65,9 @@ FlowCache::FlowCache(const FlowCacheConfig& cfg) : config(cfg)
 
 FlowCache::~FlowCache()
 {
+    while ( !deferred_flows.empty() )
+        reap_deferred(deferred_flows.size());
+
     delete hash_table;
     delete_uni();
 }
@@ -76,6 +81,22 @@ void FlowCache::delete_uni()
     uni_ip_flows = nullptr;
 }
 
+// a reload can raise or lower max_flows; rebucket the hash table to the
+// new size incrementally so the load factor tracks the cap without ever
+// pausing packet processing for a full rehash
+void FlowCache::set_flow_cache_config(const FlowCacheConfig& cfg)
+{
+    if ( cfg.max_flows != config.max_flows )
+        hash_table->resize(cfg.max_flows);
+
+    config = cfg;
+}
+
+unsigned FlowCache::sweep_resize(unsigned rows)
+{
+    return hash_table->migrate_rows(rows);
+}
+
 void FlowCache::push(Flow* flow)
 {
     void* key = hash_table->push(flow);
@@ -124,22 +145,27 @@ void FlowCache::unlink_uni(Flow* flow)
 Flow* FlowCache::allocate(const FlowKey* key)
 {
     time_t timestamp = packet_time();
-    Flow* flow = (Flow*)hash_table->get(key);
+    const unsigned lru_idx = to_utype(key->pkt_type);
+    Flow* flow = (Flow*)hash_table->get(key, lru_idx);
     if ( !flow )
     {
-        if ( flows_allocated < config.max_flows )
-        {
-            Flow* new_flow = new Flow();
-            push(new_flow);
-            memory::MemoryCap::update_allocations(sizeof(HashNode) + sizeof(FlowKey));
-        }
-        else if ( !prune_stale(timestamp, nullptr) )
+        if ( flows_allocated >= config.max_flows and !prune_stale(timestamp, nullptr) )
         {
             if ( !prune_unis(key->pkt_type) )
                 prune_excess(nullptr);
         }
 
-        flow = (Flow*)hash_table->get(key);
+        flow = (Flow*)hash_table->get(key, lru_idx);
+
+        // no free node: either we were under the limit or excess pruning
+        // deferred its victims (which destroys the node), so add one
+        if ( !flow )
+        {
+            Flow* new_flow = new Flow();
+            push(new_flow);
+            memory::MemoryCap::update_allocations(sizeof(HashNode) + sizeof(FlowKey));
+            flow = (Flow*)hash_table->get(key, lru_idx);
+        }
         assert(flow);
 
         if ( flow->session && flow->pkt_type != key->pkt_type )
@@ -185,41 +211,103 @@ void FlowCache::retire(Flow* flow)
     remove(flow);
 }
 
+// phase one of a two phase prune: take the flow out of the cache so its
+// slot is immediately reusable, but leave session cleanup and destruction
+// to reap_deferred() so the packet that hit the cap doesn't absorb the
+// whole teardown cost.  the hash node is freed here, so the key must be
+// snapshot for the cleanup callbacks that still need it.
+// only called with the lru cursor on this flow.
+void FlowCache::defer_release(Flow* flow, PruneReason reason)
+{
+    if ( flow->next )
+        unlink_uni(flow);
+
+    memory::MemoryCap::update_deallocations(config.proto[to_utype(flow->key->pkt_type)].cap_weight);
+
+    FlowKey* key_copy = new FlowKey(*flow->key);
+    hash_table->remove(to_utype(flow->key->pkt_type));
+    flow->key = key_copy;
+
+    deferred_flows.emplace_back(flow);
+    --flows_allocated;
+
+    prune_stats.update(reason);
+    ++prune_stats.deferred;
+
+    if ( (PegCount)deferred_flows.size() > prune_stats.max_deferred )
+        prune_stats.max_deferred = deferred_flows.size();
+}
+
+unsigned FlowCache::reap_deferred(unsigned max)
+{
+    unsigned reaped = 0;
+
+    while ( reaped < max and !deferred_flows.empty() )
+    {
+        Flow* flow = deferred_flows.back();
+        deferred_flows.pop_back();
+
+        const FlowKey* key = flow->key;
+        flow->reset(true);
+        delete flow;
+        delete key;
+
+        memory::MemoryCap::update_deallocations(sizeof(HashNode) + sizeof(FlowKey));
+        ++reaped;
+    }
+
+    return reaped;
+}
+
+// the flow at each per type lru tail is the oldest of its type, so the
+// globally least recently used flow is the oldest of the tails; leaves
+// the winner's list cursor on it for a subsequent remove or touch
+Flow* FlowCache::oldest_lru(unsigned& lru_idx)
+{
+    Flow* oldest = nullptr;
+
+    for ( unsigned t = 0; t < to_utype(PktType::MAX); ++t )
+    {
+        auto flow = static_cast<Flow*>(hash_table->lru_first(t));
+
+        if ( flow and (!oldest or flow->last_data_seen < oldest->last_data_seen) )
+        {
+            oldest = flow;
+            lru_idx = t;
+        }
+    }
+
+    return oldest;
+}
+
 unsigned FlowCache::prune_stale(uint32_t thetime, const Flow* save_me)
 {
     ActiveSuspendContext act_susp;
 
     unsigned pruned = 0;
-    auto flow = static_cast<Flow*>(hash_table->lru_first());
 
-    while ( flow and pruned <= cleanup_flows )
+    for ( unsigned t = 0; t < to_utype(PktType::MAX) and pruned <= cleanup_flows; ++t )
     {
-#if 0
-        // FIXIT-RC this loops forever if 1 flow in cache
-        if (flow == save_me)
+        auto flow = static_cast<Flow*>(hash_table->lru_first(t));
+
+        while ( flow and pruned <= cleanup_flows )
         {
-            break;
-            if ( hash_table->get_count() == 1 )
+            // Reached the current flow. This *should* be the newest flow
+            if ( flow == save_me )
                 break;
 
-            hash_table->lru_touch();
-        }
-#else
-        // Reached the current flow. This *should* be the newest flow
-        if ( flow == save_me )
-            break;
-#endif
-        if ( flow->is_suspended() )
-            break;
+            if ( flow->is_suspended() )
+                break;
 
-        if ( flow->last_data_seen + config.pruning_timeout >= thetime )
-            break;
+            if ( flow->last_data_seen + config.pruning_timeout >= thetime )
+                break;
 
-        flow->ssn_state.session_flags |= SSNFLAG_TIMEDOUT;
-        release(flow, PruneReason::IDLE);
-        ++pruned;
+            flow->ssn_state.session_flags |= SSNFLAG_TIMEDOUT;
+            release(flow, PruneReason::IDLE);
+            ++pruned;
 
-        flow = static_cast<Flow*>(hash_table->lru_first());
+            flow = static_cast<Flow*>(hash_table->lru_first(t));
+        }
     }
 
     return pruned;
@@ -272,7 +360,8 @@ unsigned FlowCache::prune_excess(const Flow* save_me)
 
     while ( hash_table->get_num_nodes() > max_cap and hash_table->get_num_nodes() > blocks )
     {
-        auto flow = static_cast<Flow*>(hash_table->lru_first());
+        unsigned lru_idx = 0;
+        auto flow = oldest_lru(lru_idx);
         assert(flow); // holds true because hash_table->get_count() > 0
 
         if ( (save_me and flow == save_me) or flow->was_blocked() or
@@ -285,12 +374,12 @@ unsigned FlowCache::prune_excess(const Flow* save_me)
 
             // FIXIT-M we should update last_data_seen upon touch to ensure
             // the hash_table LRU list remains sorted by time
-            hash_table->lru_touch();
+            hash_table->lru_touch(lru_idx);
         }
         else
         {
             flow->ssn_state.session_flags |= SSNFLAG_PRUNED;
-            release(flow, PruneReason::EXCESS);
+            defer_release(flow, PruneReason::EXCESS);
             ++pruned;
         }
         if ( ignore_offloads > 0 )
@@ -312,8 +401,10 @@ bool FlowCache::prune_one(PruneReason reason, bool do_cleanup)
     if ( hash_table->get_num_nodes() <= 1 )
         return false;
 
-    // ZHash returns in LRU order, which is updated per packet via find --> move_to_front call
-    auto flow = static_cast<Flow*>(hash_table->lru_first());
+    // each per type list is in LRU order, updated per packet via find -->
+    // move_to_front; the victim is the oldest of the list tails
+    unsigned lru_idx = 0;
+    auto flow = oldest_lru(lru_idx);
     assert(flow);
 
     flow->ssn_state.session_flags |= SSNFLAG_PRUNED;
@@ -327,34 +418,41 @@ unsigned FlowCache::timeout(unsigned num_flows, time_t thetime)
     ActiveSuspendContext act_susp;
     unsigned retired = 0;
 
-    auto flow = static_cast<Flow*>(hash_table->lru_current());
+    // all flows on one list share a nominal timeout, so each list is in
+    // expiry order and the walk stops at its first unexpired flow; an
+    // idle flow can no longer hide behind a fresh flow of a longer lived
+    // type the way it could at the tail of a single shared lru
+    for ( unsigned t = 0; t < to_utype(PktType::MAX) and retired < num_flows; ++t )
+    {
+        auto flow = static_cast<Flow*>(hash_table->lru_current(t));
 
-    if ( !flow )
-        flow = static_cast<Flow*>(hash_table->lru_first());
+        if ( !flow )
+            flow = static_cast<Flow*>(hash_table->lru_first(t));
 
-    while ( flow and (retired < num_flows) )
-    {
-        if ( flow->is_hard_expiration() )
+        while ( flow and (retired < num_flows) )
         {
-            if ( flow->expire_time > (uint64_t) thetime )
+            if ( flow->is_hard_expiration() )
+            {
+                if ( flow->expire_time > (uint64_t) thetime )
+                    break;
+            }
+            else if ( flow->last_data_seen + config.proto[t].nominal_timeout > thetime )
                 break;
-        }
-        else if ( flow->last_data_seen + config.proto[to_utype(flow->key->pkt_type)].nominal_timeout > thetime )
-            break;
 
-        if ( HighAvailabilityManager::in_standby(flow) or
-            flow->is_suspended() )
-        {
-            flow = static_cast<Flow*>(hash_table->lru_next());
-            continue;
-        }
+            if ( HighAvailabilityManager::in_standby(flow) or
+                flow->is_suspended() )
+            {
+                flow = static_cast<Flow*>(hash_table->lru_next(t));
+                continue;
+            }
 
-        flow->ssn_state.session_flags |= SSNFLAG_TIMEDOUT;
-        release(flow, PruneReason::IDLE);
+            flow->ssn_state.session_flags |= SSNFLAG_TIMEDOUT;
+            release(flow, PruneReason::IDLE);
 
-        ++retired;
+            ++retired;
 
-        flow = static_cast<Flow*>(hash_table->lru_current());
+            flow = static_cast<Flow*>(hash_table->lru_current(t));
+        }
     }
 
     return retired;
@@ -365,17 +463,18 @@ unsigned FlowCache::delete_active_flows(unsigned mode, unsigned num_to_delete, u
     unsigned flows_to_check = hash_table->get_num_nodes();
     while ( num_to_delete && flows_to_check-- )
     {
-        auto flow = static_cast<Flow*>(hash_table->lru_first());
+        unsigned lru_idx = 0;
+        auto flow = oldest_lru(lru_idx);
         assert(flow);
         if ( (mode == ALLOWED_FLOWS_ONLY and (flow->was_blocked() || flow->is_suspended()))
             or (mode == OFFLOADED_FLOWS_TOO and flow->was_blocked()) )
         {
-            hash_table->lru_touch();
+            hash_table->lru_touch(lru_idx);
             continue;
         }
 
         // we have a winner...
-        hash_table->remove();
+        hash_table->remove(lru_idx);
         if ( flow->next )
             unlink_uni(flow);
 
@@ -433,10 +532,16 @@ unsigned FlowCache::purge()
 
     unsigned retired = 0;
 
-    while ( auto flow = static_cast<Flow*>(hash_table->lru_first()) )
+    while ( !deferred_flows.empty() )
+        reap_deferred(deferred_flows.size());
+
+    for ( unsigned t = 0; t < to_utype(PktType::MAX); ++t )
     {
-        retire(flow);
-        ++retired;
+        while ( auto flow = static_cast<Flow*>(hash_table->lru_first(t)) )
+        {
+            retire(flow);
+            ++retired;
+        }
     }
 
     while ( Flow* flow = (Flow*)hash_table->pop() )
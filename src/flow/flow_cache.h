@@ -27,6 +27,7 @@
 
 #include <ctime>
 #include <type_traits>
+#include <vector>
 
 #include "framework/counts.h"
 
@@ -61,6 +62,10 @@ public:
     unsigned timeout(unsigned num_flows, time_t cur_time);
     unsigned delete_flows(unsigned num_to_delete);
 
+    // second phase of excess pruning: destroy flows that were unlinked
+    // by defer_release(), a few at a time, on the owning packet thread
+    unsigned reap_deferred(unsigned max);
+
     unsigned purge();
     unsigned get_count();
 
@@ -73,6 +78,12 @@ public:
     PegCount get_prunes(PruneReason reason) const
     { return prune_stats.get(reason); }
 
+    PegCount get_deferred_prunes() const
+    { return prune_stats.deferred; }
+
+    PegCount get_max_deferred_prunes() const
+    { return prune_stats.max_deferred; }
+
     PegCount get_total_deletes() const
     { return delete_stats.get_total(); }
 
@@ -87,8 +98,10 @@ public:
 
     void unlink_uni(snort::Flow*);
 
-    void set_flow_cache_config(const FlowCacheConfig& cfg)
-    { config = cfg; }
+    void set_flow_cache_config(const FlowCacheConfig& cfg);
+
+    // advance an in-progress hash table resize by up to rows buckets
+    unsigned sweep_resize(unsigned rows);
 
     const FlowCacheConfig& get_flow_cache_config() const
     { return config; }
@@ -98,10 +111,12 @@ public:
 
 private:
     void delete_uni();
+    snort::Flow* oldest_lru(unsigned& lru_idx);
     void push(snort::Flow*);
     void link_uni(snort::Flow*);
     void remove(snort::Flow*);
     void retire(snort::Flow*);
+    void defer_release(snort::Flow*, PruneReason);
     unsigned prune_unis(PktType);
     unsigned delete_active_flows
         (unsigned mode, unsigned num_to_delete, unsigned &deleted);
@@ -118,6 +133,7 @@ private:
 
     PruneStats prune_stats;
     FlowDeleteStats delete_stats;
+    std::vector<snort::Flow*> deferred_flows;
 };
 #endif
 
@@ -68,6 +68,12 @@ PegCount FlowControl::get_total_prunes() const
 PegCount FlowControl::get_prunes(PruneReason reason) const
 { return cache->get_prunes(reason); }
 
+PegCount FlowControl::get_deferred_prunes() const
+{ return cache->get_deferred_prunes(); }
+
+PegCount FlowControl::get_max_deferred_prunes() const
+{ return cache->get_max_deferred_prunes(); }
+
 PegCount FlowControl::get_total_deletes() const
 { return cache->get_total_deletes(); }
 
@@ -78,6 +84,7 @@ void FlowControl::clear_counts()
 {
     cache->reset_stats();
     num_flows = 0;
+    num_promoted = 0;
 }
 
 //-------------------------------------------------------------------------
@@ -123,6 +130,8 @@ void FlowControl::timeout_flows(time_t cur_time)
     ActiveSuspendContext act_susp;
 
     cache->timeout(1, cur_time);
+    cache->reap_deferred(16);
+    cache->sweep_resize(64);
 }
 
 void FlowControl::preemptive_cleanup()
@@ -349,6 +358,18 @@ bool FlowControl::process(PktType type, Packet* p, bool* new_flow)
     if ( !get_proto_session[to_utype(type)] )
         return false;
 
+    {
+        // reaping tears down flows (and may emit active responses), so it
+        // must not redirect them at the current packet's flow
+        ActiveSuspendContext act_susp;
+
+        // spread destruction of excess-pruned flows over subsequent packets
+        cache->reap_deferred(2);
+
+        // likewise, spread any in-progress hash table resize
+        cache->sweep_resize(2);
+    }
+
     FlowKey key;
     set_key(&key, p);
     Flow* flow = cache->find(&key);
@@ -386,7 +407,13 @@ bool FlowControl::process(PktType type, Packet* p, bool* new_flow)
     // FIXIT-M refactor to unlink_uni immediately after session
     // is processed by inspector manager (all flows)
     if ( flow->next && is_bidirectional(flow) )
+    {
+        // the flow graduated from the uni list to a real conversation;
+        // the promotion rate vs flows created shows how much of the
+        // cache is scan noise that never sees a second direction
         cache->unlink_uni(flow);
+        num_promoted++;
+    }
 
     return true;
 }
@@ -89,8 +89,13 @@ public:
     PegCount get_flows()
     { return num_flows; }
 
+    PegCount get_promoted_flows() const
+    { return num_promoted; }
+
     PegCount get_total_prunes() const;
     PegCount get_prunes(PruneReason) const;
+    PegCount get_deferred_prunes() const;
+    PegCount get_max_deferred_prunes() const;
     PegCount get_total_deletes() const;
     PegCount get_deletes(FlowDeleteState state) const;
     void clear_counts();
@@ -104,6 +109,7 @@ private:
 private:
     snort::InspectSsnFunc get_proto_session[to_utype(PktType::MAX)] = {};
     PegCount num_flows = 0;
+    PegCount num_promoted = 0;
     FlowCache* cache = nullptr;
     snort::Flow* mem = nullptr;
     class ExpectCache* exp_cache = nullptr;
@@ -30,8 +30,100 @@
 #include "managers/so_manager.h"
 #include "memory/memory_cap.h"
 
+#include "utils/stats.h"
+
 using namespace snort;
 
+//-------------------------------------------------------------------------
+// pooled allocation
+//
+// chunks are bucketed by size in pool_step increments; since each flow
+// data subclass has one fixed size, a bucket effectively serves the
+// handful of types that round to it.  freed chunks go back on the owning
+// thread's freelist and the next flow of the same shape reuses them
+// without touching the heap.
+//-------------------------------------------------------------------------
+
+static const size_t pool_step = 64;
+static const size_t pool_max_size = 1024;
+static const unsigned pool_max_chunks = 1024;
+static const unsigned pool_buckets = pool_max_size / pool_step;
+
+namespace
+{
+struct FlowDataPool
+{
+    struct Chunk
+    { Chunk* next; };
+
+    Chunk* buckets[pool_buckets] = { };
+    unsigned avail[pool_buckets] = { };
+
+    ~FlowDataPool()
+    {
+        for ( unsigned i = 0; i < pool_buckets; i++ )
+        {
+            while ( Chunk* c = buckets[i] )
+            {
+                buckets[i] = c->next;
+                ::operator delete(c);
+            }
+        }
+    }
+
+    void* get(size_t n)
+    {
+        unsigned i = (unsigned)((n - 1) / pool_step);
+
+        if ( Chunk* c = buckets[i] )
+        {
+            buckets[i] = c->next;
+            avail[i]--;
+            pc.flow_data_pool_hits++;
+            return c;
+        }
+        pc.flow_data_pool_misses++;
+        return ::operator new((i + 1) * pool_step);
+    }
+
+    void put(void* p, size_t n)
+    {
+        unsigned i = (unsigned)((n - 1) / pool_step);
+
+        if ( avail[i] < pool_max_chunks )
+        {
+            Chunk* c = static_cast<Chunk*>(p);
+            c->next = buckets[i];
+            buckets[i] = c;
+            avail[i]++;
+        }
+        else
+            ::operator delete(p);
+    }
+};
+}
+
+static THREAD_LOCAL FlowDataPool s_pool;
+
+void* FlowData::operator new(size_t n)
+{
+    if ( n > pool_max_size )
+        return ::operator new(n);
+
+    return s_pool.get(n);
+}
+
+void FlowData::operator delete(void* p, size_t n)
+{
+    if ( !p )
+        return;
+
+    if ( n > pool_max_size )
+        ::operator delete(p);
+    else
+        s_pool.put(p, n);
+}
+
 unsigned FlowData::flow_data_id = 0;
 
 FlowData::FlowData(unsigned u, Inspector* ph)
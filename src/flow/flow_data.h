@@ -33,6 +33,13 @@ public:
     FlowData(unsigned u, Inspector* = nullptr);
     virtual ~FlowData();
 
+    // flow data comes and goes with every flow, so instances draw fixed
+    // size chunks from per thread freelists instead of hitting the heap;
+    // each subclass has a fixed size (see size_of) so recycled chunks of
+    // the same bucket are reused quickly under churn
+    static void* operator new(size_t);
+    static void operator delete(void*, size_t);
+
     unsigned get_id()
     { return id; }
 
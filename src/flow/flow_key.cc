@@ -91,8 +91,9 @@ static inline void update_icmp6(const SfIp*& srcIP, uint16_t& srcPort,
 //-------------------------------------------------------------------------
 // init foo
 //-------------------------------------------------------------------------
+template <bool mpls_key>
 inline bool FlowKey::init4(
-    const SnortConfig* sc, IpProtocol ip_proto,
+    IpProtocol ip_proto,
     const SfIp *srcIP, uint16_t srcPort,
     const SfIp *dstIP, uint16_t dstPort,
     uint32_t mplsId, bool order)
@@ -139,8 +140,7 @@ inline bool FlowKey::init4(
         port_h = srcPort;
         reversed = true;
     }
-    if (sc->mpls_overlapping_ip() &&
-        ip::isPrivateIP(src) && ip::isPrivateIP(dst))
+    if (mpls_key && ip::isPrivateIP(src) && ip::isPrivateIP(dst))
         mplsLabel = mplsId;
     else
         mplsLabel = 0;
@@ -148,8 +148,9 @@ inline bool FlowKey::init4(
     return reversed;
 }
 
+template <bool mpls_key>
 inline bool FlowKey::init6(
-    const SnortConfig* sc, IpProtocol ip_proto,
+    IpProtocol ip_proto,
     const SfIp *srcIP, uint16_t srcPort,
     const SfIp *dstIP, uint16_t dstPort,
     uint32_t mplsId, bool order)
@@ -193,10 +194,7 @@ inline bool FlowKey::init6(
         reversed = true;
     }
 
-    if (sc->mpls_overlapping_ip())
-        mplsLabel = mplsId;
-    else
-        mplsLabel = 0;
+    mplsLabel = mpls_key ? mplsId : 0;
 
     return reversed;
 }
@@ -240,22 +238,31 @@ bool FlowKey::init(
      * that IP is stored in port_l.
      */
 
+    /* The config predicates are invariant between reloads; resolve the
+       encap profile once here and run a specialized instantiation with no
+       config tests inside the normalization path. */
+    const bool mpls_key = sc->mpls_overlapping_ip();
+
     if (srcIP->is_ip4() && dstIP->is_ip4())
     {
         version = 4;
-        reversed = init4(sc, ip_proto, srcIP, srcPort, dstIP, dstPort, mplsId);
+        reversed = mpls_key ?
+            init4<true>(ip_proto, srcIP, srcPort, dstIP, dstPort, mplsId) :
+            init4<false>(ip_proto, srcIP, srcPort, dstIP, dstPort, mplsId);
     }
     else
     {
         version = 6;
-        reversed = init6(sc, ip_proto, srcIP, srcPort, dstIP, dstPort, mplsId);
+        reversed = mpls_key ?
+            init6<true>(ip_proto, srcIP, srcPort, dstIP, dstPort, mplsId) :
+            init6<false>(ip_proto, srcIP, srcPort, dstIP, dstPort, mplsId);
     }
 
     pkt_type = type;
     ip_protocol = (uint8_t)ip_proto;
 
-    init_vlan(sc, vlanId);
-    init_address_space(sc, addrSpaceId);
+    vlan_tag = sc->get_vlan_agnostic() ? 0 : vlanId;
+    addressSpaceId = sc->address_space_agnostic() ? 0 : addrSpaceId;
     padding = 0;
 
     return reversed;
@@ -273,23 +280,31 @@ bool FlowKey::init(
     uint16_t srcPort = id & 0xFFFF;
     uint16_t dstPort = id >> 16;
 
+    const bool mpls_key = sc->mpls_overlapping_ip();
+
     if (srcIP->is_ip4() && dstIP->is_ip4())
     {
         version = 4;
-        init4(sc, ip_proto, srcIP, srcPort, dstIP, dstPort, mplsId, false);
+        if (mpls_key)
+            init4<true>(ip_proto, srcIP, srcPort, dstIP, dstPort, mplsId, false);
+        else
+            init4<false>(ip_proto, srcIP, srcPort, dstIP, dstPort, mplsId, false);
         ip_protocol = (uint8_t)ip_proto;
     }
     else
     {
         version = 6;
-        init6(sc, ip_proto, srcIP, srcPort, dstIP, dstPort, mplsId, false);
+        if (mpls_key)
+            init6<true>(ip_proto, srcIP, srcPort, dstIP, dstPort, mplsId, false);
+        else
+            init6<false>(ip_proto, srcIP, srcPort, dstIP, dstPort, mplsId, false);
         ip_protocol = 0;
     }
 
     pkt_type = type;
 
-    init_vlan(sc, vlanId);
-    init_address_space(sc, addrSpaceId);
+    vlan_tag = sc->get_vlan_agnostic() ? 0 : vlanId;
+    addressSpaceId = sc->address_space_agnostic() ? 0 : addrSpaceId;
     padding = 0;
 
     return false;
@@ -303,41 +318,60 @@ bool FlowKey::is_equal(const void* s1, const void* s2, size_t)
 {
     const uint64_t* a = (const uint64_t*)s1;
     const uint64_t* b = (const uint64_t*)s2;
-    if (*a - *b)
-        return false;               /* Compares IPv4 lo/hi
-                                   Compares IPv6 low[0,1] */
-
-    a++;
-    b++;
-    if (*a - *b)
-        return false;               /* Compares port lo/hi, vlan, protocol, version
-                                   Compares IPv6 low[2,3] */
-
-    a++;
-    b++;
-    if (*a - *b)
-        return false;               /* Compares IPv6 hi[0,1] */
-
-    a++;
-    b++;
-    if (*a - *b)
-        return false;               /* Compares IPv6 hi[2,3] */
-
-    a++;
-    b++;
-    if (*a - *b)
-        return false;               /* Compares MPLS label, port lo/hi */
-
-    a++;
-    b++;
-    if (*a - *b)
-        return false;               /* Compares vlan,AddressSpace ID,ip_proto,type,version,8 bit pad */
-
-    return true;
+
+    // most compares are against the matching node in the bucket, so all
+    // 48 bytes get read anyway; a branchless fold lets the compiler issue
+    // the loads together and vectorize instead of branching per word
+    uint64_t diff =
+        (a[0] ^ b[0]) |   // IPv4 lo/hi or IPv6 low[0,1]
+        (a[1] ^ b[1]) |   // IPv6 low[2,3]
+        (a[2] ^ b[2]) |   // IPv6 hi[0,1]
+        (a[3] ^ b[3]) |   // IPv6 hi[2,3]
+        (a[4] ^ b[4]) |   // mpls label, port lo/hi
+        (a[5] ^ b[5]);    // vlan, address space id, ip_proto, type, version, pad
+
+    return diff == 0;
+}
+
+// hardware crc32c covers the 48 byte key in 6 instructions and hashes
+// well enough for bucket selection; only used where the compiler supports
+// per function targets and the cpu check, with the classic mix as both
+// the fallback and the portable path
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define FLOW_KEY_HW_HASH
+
+__attribute__((target("sse4.2")))
+static unsigned crc32c_hash(const unsigned char* k, unsigned seed)
+{
+    const uint64_t* d = (const uint64_t*)k;
+    uint64_t c = seed;
+
+    for ( int i = 0; i < 6; ++i )
+        c = __builtin_ia32_crc32di(c, d[i]);
+
+    return (unsigned)c;
+}
+
+static bool have_crc32c()
+{ return __builtin_cpu_supports("sse4.2"); }
+
+#else
+static bool have_crc32c()
+{ return false; }
+#endif
+
+FlowHashKeyOps::FlowHashKeyOps(int rows)
+    : HashKeyOperations(rows)
+{
+    hw_hash = have_crc32c();
 }
 
 unsigned FlowHashKeyOps::do_hash(const unsigned char* k, int)
 {
+#ifdef FLOW_KEY_HW_HASH
+    if ( hw_hash )
+        return crc32c_hash(k, hardener);
+#endif
     uint32_t a, b, c;
     a = b = c = hardener;
 
@@ -376,3 +410,25 @@ bool FlowHashKeyOps::key_compare(const void* k1, const void* k2, size_t len)
 }
 
 
+
+#ifdef BENCHMARK_TEST
+
+#include "catch/snort_catch.h"
+
+TEST_CASE("flow key hash speed", "[benchmark]")
+{
+    FlowHashKeyOps ops(4096);
+
+    FlowKey key;
+    memset(&key, 0, sizeof(key));
+    key.port_l = 1234;
+    key.port_h = 53;
+    key.ip_protocol = 17;
+    key.pkt_type = PktType::UDP;
+    key.version = 4;
+
+    BENCHMARK("do_hash")
+    { return ops.do_hash((const unsigned char*)&key, sizeof(key)); };
+}
+
+#endif
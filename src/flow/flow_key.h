@@ -39,12 +39,13 @@ struct SnortConfig;
 class FlowHashKeyOps : public HashKeyOperations
 {
 public:
-    FlowHashKeyOps(int rows)
-        : HashKeyOperations(rows)
-    { }
+    FlowHashKeyOps(int rows);
 
     unsigned do_hash(const unsigned char* k, int len) override;
     bool key_compare(const void* k1, const void* k2, size_t) override;
+
+private:
+    bool hw_hash;  // hardware crc32c available on this cpu
 };
 
 
@@ -87,14 +88,19 @@ struct SO_PUBLIC FlowKey
     static bool is_equal(const void* k1, const void* k2, size_t);
 
 private:
+    // instantiated per encap profile: mpls_key selects at compile time
+    // whether the mpls label participates in the key (overlapping ip
+    // config), so the hot normalization path carries no config tests
+    template <bool mpls_key>
     bool init4(
-        const SnortConfig*, IpProtocol,
+        IpProtocol,
         const snort::SfIp *srcIP, uint16_t srcPort,
         const snort::SfIp *dstIP, uint16_t dstPort,
         uint32_t mplsId, bool order = true);
 
+    template <bool mpls_key>
     bool init6(
-        const SnortConfig*, IpProtocol,
+        IpProtocol,
         const snort::SfIp *srcIP, uint16_t srcPort,
         const snort::SfIp *dstIP, uint16_t dstPort,
         uint32_t mplsId, bool order = true);
@@ -38,11 +38,21 @@ FlowStash::~FlowStash()
 
 void FlowStash::reset()
 {
-    for(map<string, StashItem*>::iterator it = container.begin(); it != container.end(); ++it)
+    for (auto& entry : container)
+        delete entry.second;
+
+    container.clear();
+}
+
+StashItem** FlowStash::find(const string& key)
+{
+    for (auto& entry : container)
     {
-        delete it->second;
+        if (entry.first == key)
+            return &entry.second;
     }
-    container.clear();
+
+    return nullptr;
 }
 
 bool FlowStash::get(const string& key, int32_t& val)
@@ -91,17 +101,19 @@ void FlowStash::store(const string& key, StashGenericObject* &val, StashItemType
     UNUSED(type);
 #endif
     auto item = new StashItem(val);
-    auto it_and_status = container.emplace(make_pair(key, item));
+    StashItem** slot = find(key);
 
-    if (!it_and_status.second)
+    if (slot)
     {
         StashGenericObject* stored_object;
-        assert(it_and_status.first->second->get_type() == type);
-        it_and_status.first->second->get_val(stored_object);
+        assert((*slot)->get_type() == type);
+        (*slot)->get_val(stored_object);
         assert(stored_object->get_object_type() == val->get_object_type());
-        delete it_and_status.first->second;
-        it_and_status.first->second = item;
+        delete *slot;
+        *slot = item;
     }
+    else
+        container.emplace_back(key, item);
 
     StashEvent e(item);
     DataBus::publish(key.c_str(), e);
@@ -118,12 +130,12 @@ bool FlowStash::get(const string& key, T& val, StashItemType type)
 #ifdef NDEBUG
     UNUSED(type);
 #endif
-    auto it = container.find(key);
+    StashItem** slot = find(key);
 
-    if (it != container.end())
+    if (slot)
     {
-        assert(it->second->get_type() == type);
-        it->second->get_val(val);
+        assert((*slot)->get_type() == type);
+        (*slot)->get_val(val);
         return true;
     }
     return false;
@@ -136,14 +148,16 @@ void FlowStash::store(const string& key, T& val, StashItemType type)
     UNUSED(type);
 #endif
     auto item = new StashItem(val);
-    auto it_and_status = container.emplace(make_pair(key, item));
+    StashItem** slot = find(key);
 
-    if (!it_and_status.second)
+    if (slot)
     {
-        assert(it_and_status.first->second->get_type() == type);
-        delete it_and_status.first->second;
-        it_and_status.first->second = item;
+        assert((*slot)->get_type() == type);
+        delete *slot;
+        *slot = item;
     }
+    else
+        container.emplace_back(key, item);
 
     StashEvent e(item);
     DataBus::publish(key.c_str(), e);
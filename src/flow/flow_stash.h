@@ -21,8 +21,9 @@
 #ifndef FLOW_STASH_H
 #define FLOW_STASH_H
 
-#include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "main/snort_types.h"
 
@@ -47,7 +48,11 @@ public:
     void store(const std::string& key, StashGenericObject* val);
 
 private:
-    std::map<std::string, StashItem*> container;
+    // a flow stashes only a handful of items, so a flat vector beats a
+    // node based map for both lookup and footprint
+    std::vector<std::pair<std::string, StashItem*>> container;
+
+    StashItem** find(const std::string& key);
 
     template<typename T>
     bool get(const std::string& key, T& val, StashItemType type);
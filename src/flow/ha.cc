@@ -23,6 +23,8 @@
 
 #include "ha.h"
 
+#include <zlib.h>
+
 #include "framework/counts.h"
 #include "log/messages.h"
 #include "packet_io/active.h"
@@ -42,7 +44,9 @@ using namespace snort;
 enum HAEvent
 {
     HA_DELETE_EVENT = 1,
-    HA_UPDATE_EVENT = 2
+    HA_UPDATE_EVENT = 2,
+    // wrapper whose payload is one deflated update or deletion message
+    HA_COMPRESSED_EVENT = 3
 };
 
 struct __attribute__((__packed__)) HAMessageHeader
@@ -56,6 +60,7 @@ struct __attribute__((__packed__)) HAMessageHeader
 struct __attribute__((__packed__)) HAClientHeader
 {
     uint8_t client;
+    uint8_t version;
     uint8_t length;
 };
 
@@ -69,7 +74,7 @@ typedef std::array<FlowHAClient*, MAX_CLIENTS> ClientMap;
 class HighAvailability
 {
 public:
-    HighAvailability(PortBitSet*,bool);
+    HighAvailability(PortBitSet*, bool, bool);
     ~HighAvailability();
 
     void process_update(Flow*, Packet*);
@@ -87,9 +92,10 @@ public:
 private:
     SideChannel* sc = nullptr;
     bool use_daq_channel;
+    bool use_compression;
 };
 
-static constexpr uint8_t HA_MESSAGE_VERSION = 3;
+static constexpr uint8_t HA_MESSAGE_VERSION = 4;
 
 // define message size and content constants.
 static constexpr uint8_t KEY_SIZE_IP6 = sizeof(FlowKey);
@@ -107,6 +113,10 @@ static constexpr uint8_t SESSION_HA_CLIENT_INDEX = 0;
 
 PortBitSet* HighAvailabilityManager::ports = nullptr;
 bool HighAvailabilityManager::use_daq_channel = false;
+bool HighAvailabilityManager::compress_msgs = false;
+
+// messages below this size are not worth a deflate call
+static constexpr uint16_t COMPRESS_THRESHOLD = 128;
 
 struct timeval FlowHAState::min_session_lifetime;
 struct timeval FlowHAState::min_sync_interval;
@@ -309,9 +319,10 @@ static uint16_t calculate_msg_header_length(Flow& flow)
     return sizeof(HAMessageHeader) + key_size(flow);
 }
 
-// Calculate the UPDATE message content length based on the
-// set of active clients.  The Session client is always present.
-static uint16_t calculate_update_msg_content_length(Flow& flow, bool full)
+// Calculate the UPDATE message content length based on the set of active
+// clients.  Delta updates omit the session section along with any other
+// unchanged sections.
+static uint16_t calculate_update_msg_content_length(Flow& flow, bool full, bool include_session)
 {
     assert(ha->client_map[0]);
 
@@ -320,7 +331,7 @@ static uint16_t calculate_update_msg_content_length(Flow& flow, bool full)
     for (int i = 0; i < ha->handle_counter; i++)
     {
         // Don't check 'i' against SESSION_HA_CLIENT_INDEX (==0), as this creates a false positive with cppcheck
-        if ((i == 0) || full || flow.ha_state->check_pending(1 << (i - 1)))
+        if ((i == 0) ? include_session : (full || flow.ha_state->check_pending(1 << (i - 1))))
         {
             assert(ha->client_map[i]);
             length += (ha->client_map[i]->get_message_size(flow) + sizeof(HAClientHeader));
@@ -361,6 +372,7 @@ static void write_update_msg_client(FlowHAClient* client, Flow& flow, HAMessage&
     uint8_t* original_cursor = msg.cursor;
     HAClientHeader* header = (HAClientHeader*) original_cursor;
     header->client = client->index;
+    header->version = client->version;
     msg.advance_cursor(sizeof(HAClientHeader));
     if (!client->produce(flow, msg))
     {
@@ -371,12 +383,12 @@ static void write_update_msg_client(FlowHAClient* client, Flow& flow, HAMessage&
     header->length = (uint32_t) (msg.cursor - original_cursor - sizeof(HAClientHeader));
 }
 
-static void write_update_msg_content(Flow& flow, HAMessage& msg, bool full)
+static void write_update_msg_content(Flow& flow, HAMessage& msg, bool full, bool include_session)
 {
     for (int i = 0; i < ha->handle_counter; i++)
     {
         // Don't check 'i' against SESSION_HA_CLIENT_INDEX (==0), as this creates a false positive with cppcheck
-        if ((i == 0) || full || flow.ha_state->check_pending(1 << (i - 1)))
+        if ((i == 0) ? include_session : (full || flow.ha_state->check_pending(1 << (i - 1))))
             write_update_msg_client(ha->client_map[i], flow, msg);
     }
 }
@@ -426,9 +438,27 @@ static Flow* consume_ha_update_message(HAMessage& msg, const FlowKey& key, Packe
             break;
         }
 
+        // The peer encodes this section differently than our client does;
+        // skip just this section and keep the ones we understand.
+        if (header->version != ha->client_map[header->client]->version)
+        {
+            ha_stats.section_version_mismatch++;
+            msg.advance_cursor(header->length);
+            continue;
+        }
+
+        // A delta update for a flow we don't have carries no session
+        // section to anchor its creation; skip the content and wait for
+        // the peer's next full update.
+        if (!flow && (header->client != SESSION_HA_CLIENT_INDEX))
+        {
+            msg.advance_cursor(header->length);
+            continue;
+        }
+
         // If the Flow does not exist in the caches, flow will be nullptr
         // upon entry into this message processing loop.  Since the session
-        // client is always the first segment of the message, the consume()
+        // client is always the first segment of a full message, the consume()
         // invocation for the session client will create the flow.  This
         // flow can in turn be used by subsequent FlowHAClient's.
         if (!ha->client_map[header->client]->consume(flow, &key, msg, header->length))
@@ -474,6 +504,28 @@ static Flow* consume_ha_message(HAMessage& msg, Packet* p = nullptr)
         return nullptr;
     }
 
+    if (hdr->event == HA_COMPRESSED_EVENT)
+    {
+        static THREAD_LOCAL uint8_t inflate_buffer[UINT16_MAX];
+        uLongf plain_len = sizeof(inflate_buffer);
+
+        if (uncompress(inflate_buffer, &plain_len,
+                msg.buffer + sizeof(HAMessageHeader),
+                msg.buffer_length - sizeof(HAMessageHeader)) != Z_OK ||
+            plain_len < sizeof(HAMessageHeader) ||
+            ((HAMessageHeader*) inflate_buffer)->event == HA_COMPRESSED_EVENT)
+        {
+            ha_stats.decompress_errors++;
+            return nullptr;
+        }
+
+        // count the logical message once, not the wrapper too
+        ha_stats.msgs_recv--;
+
+        HAMessage plain_msg(inflate_buffer, (uint32_t) plain_len);
+        return consume_ha_message(plain_msg, p);
+    }
+
     msg.advance_cursor(sizeof(HAMessageHeader));
 
     FlowKey key;
@@ -513,7 +565,7 @@ static void ha_sc_receive_handler(SCMessage* sc_msg)
     sc_msg->sc->discard_message(sc_msg);
 }
 
-HighAvailability::HighAvailability(PortBitSet* ports, bool daq_channel)
+HighAvailability::HighAvailability(PortBitSet* ports, bool daq_channel, bool compress)
 {
     using namespace std::placeholders;
 
@@ -541,6 +593,7 @@ HighAvailability::HighAvailability(PortBitSet* ports, bool daq_channel)
         }
     }
     use_daq_channel = daq_channel;
+    use_compression = compress;
 }
 
 HighAvailability::~HighAvailability()
@@ -549,19 +602,74 @@ HighAvailability::~HighAvailability()
         sc->unregister_receive_handler();
 }
 
-static void send_sc_update_message(Flow& flow, SideChannel& sc)
+static void send_sc_compressed_message(const uint8_t* plain, uint32_t plain_len, SideChannel& sc)
+{
+    static THREAD_LOCAL uint8_t packed_buffer[UINT16_MAX];
+
+    uLongf packed_len = sizeof(packed_buffer) - sizeof(HAMessageHeader);
+
+    // level 1 favors speed over ratio; state that is already dense goes
+    // out uncompressed when deflate cannot beat the original size
+    if (compress2(packed_buffer + sizeof(HAMessageHeader), &packed_len,
+            plain, plain_len, 1) == Z_OK &&
+        sizeof(HAMessageHeader) + packed_len < plain_len)
+    {
+        const uint32_t wire_len = (uint32_t) (sizeof(HAMessageHeader) + packed_len);
+
+        HAMessageHeader* hdr = (HAMessageHeader*) packed_buffer;
+        hdr->event = HA_COMPRESSED_EVENT;
+        hdr->version = HA_MESSAGE_VERSION;
+        hdr->total_length = (uint16_t) wire_len;
+        hdr->key_type = 0;
+
+        SCMessage* sc_msg = sc.alloc_transmit_message(wire_len);
+        assert(sc_msg);
+        memcpy(sc_msg->content, packed_buffer, wire_len);
+        sc.transmit_message(sc_msg);
+        ha_stats.compressed_msgs_sent++;
+    }
+    else
+    {
+        SCMessage* sc_msg = sc.alloc_transmit_message(plain_len);
+        assert(sc_msg);
+        memcpy(sc_msg->content, plain, plain_len);
+        sc.transmit_message(sc_msg);
+        ha_stats.compress_skips++;
+    }
+}
+
+static void send_sc_update_message(Flow& flow, SideChannel& sc, bool include_session, bool compress)
 {
     const uint16_t header_len = calculate_msg_header_length(flow);
-    const uint16_t content_len = calculate_update_msg_content_length(flow, false);
+    const uint16_t content_len =
+        calculate_update_msg_content_length(flow, false, include_session);
+    const uint32_t total_len = (uint32_t) (header_len + content_len);
 
-    SCMessage* sc_msg = sc.alloc_transmit_message((uint32_t) (header_len + content_len));
-    assert(sc_msg);
-    HAMessage ha_msg(sc_msg->content, sc_msg->content_length);
+    if (compress && total_len >= COMPRESS_THRESHOLD)
+    {
+        static THREAD_LOCAL uint8_t plain_buffer[UINT16_MAX];
 
-    write_msg_header(flow, HA_UPDATE_EVENT, header_len + content_len, ha_msg);
-    write_update_msg_content(flow, ha_msg, false);
-    update_msg_header_length(ha_msg);
-    sc.transmit_message(sc_msg);
+        HAMessage ha_msg(plain_buffer, total_len);
+        write_msg_header(flow, HA_UPDATE_EVENT, (uint16_t) total_len, ha_msg);
+        write_update_msg_content(flow, ha_msg, false, include_session);
+        const uint32_t plain_len = update_msg_header_length(ha_msg);
+
+        send_sc_compressed_message(plain_buffer, plain_len, sc);
+    }
+    else
+    {
+        SCMessage* sc_msg = sc.alloc_transmit_message(total_len);
+        assert(sc_msg);
+        HAMessage ha_msg(sc_msg->content, sc_msg->content_length);
+
+        write_msg_header(flow, HA_UPDATE_EVENT, (uint16_t) total_len, ha_msg);
+        write_update_msg_content(flow, ha_msg, false, include_session);
+        update_msg_header_length(ha_msg);
+        sc.transmit_message(sc_msg);
+    }
+
+    if (!include_session)
+        ha_stats.delta_updates_sent++;
 }
 
 static void send_daq_update_message(Flow& flow, Packet& p)
@@ -571,7 +679,7 @@ static void send_daq_update_message(Flow& flow, Packet& p)
     HAMessage ha_msg(daq_io_buffer, sizeof(daq_io_buffer));
 
     write_msg_header(flow, HA_UPDATE_EVENT, 0, ha_msg);
-    write_update_msg_content(flow, ha_msg, true);
+    write_update_msg_content(flow, ha_msg, true, true);
     uint32_t len = update_msg_header_length(ha_msg);
 
     DIOCTL_FlowHAState fhs;
@@ -592,13 +700,21 @@ void HighAvailability::process_update(Flow* flow, Packet* p)
     // We must have the map array and the session client
     assert(client_map[0]);
 
-    if ( !client_map[0]->is_update_required(flow) &&
+    const bool session_required = client_map[0]->is_update_required(flow);
+
+    if ( !session_required &&
         ( !flow->ha_state->check_pending(ALL_CLIENTS) ||
             flow->ha_state->check_any(FlowHAState::NEW) ) )
         return;
 
+    // pending-only updates are deltas; the session section is only needed
+    // when the session client itself has changes or the peer has yet to
+    // learn of the flow
+    const bool include_session =
+        session_required || flow->ha_state->check_any(FlowHAState::NEW);
+
     if (sc)
-        send_sc_update_message(*flow, *sc);
+        send_sc_update_message(*flow, *sc, include_session, use_compression);
 
     if (use_daq_channel && p && p->daq_msg)
         send_daq_update_message(*flow, *p);
@@ -638,7 +754,13 @@ void HighAvailability::process_deletion(Flow& flow)
 void HighAvailability::process_receive()
 {
     if (sc)
+    {
         sc->process(DISPATCH_ALL_RECEIVE);
+
+        // this is also our periodic service point, so push out any update
+        // messages the connector has batched
+        sc->flush_transmit();
+    }
 }
 
 Flow* HighAvailability::process_daq_import(Packet& p, FlowKey& key)
@@ -713,6 +835,7 @@ void HighAvailabilityManager::configure(HighAvailabilityConfig* config)
     FlowHAState::config_timers(config->min_session_lifetime, config->min_sync_interval);
 
     use_daq_channel = config->daq_channel;
+    compress_msgs = config->compress;
 }
 
 // Called within the packet thread prior to packet processing
@@ -720,7 +843,7 @@ void HighAvailabilityManager::thread_init()
 {
     // create a a thread local instance iff we are configured to operate.
     if (ports || use_daq_channel)
-        ha = new HighAvailability(ports, use_daq_channel);
+        ha = new HighAvailability(ports, use_daq_channel, compress_msgs);
     else
         ha = nullptr;
 }
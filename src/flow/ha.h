@@ -133,6 +133,8 @@ public:
     FlowHAClientHandle handle;  // Actual handle for the instance
     uint8_t index;
     uint8_t max_length;
+    uint8_t version = 1;  // produce()/consume() content format version;
+                          // peers skip sections with a different version
 
 protected:
     FlowHAClient(uint8_t length, bool session_client);
@@ -170,6 +172,7 @@ private:
 
     HighAvailabilityManager() = delete;
     static bool use_daq_channel;
+    static bool compress_msgs;
     static PortBitSet* ports;
 };
 }
@@ -41,6 +41,9 @@ static const Parameter ha_params[] =
     { "enable", Parameter::PT_BOOL, nullptr, "false",
       "enable high availability" },
 
+    { "compress", Parameter::PT_BOOL, nullptr, "false",
+      "compress large side channel messages (both peers must enable this)" },
+
     { "daq_channel", Parameter::PT_BOOL, nullptr, "false",
       "enable use of daq data plane channel" },
 
@@ -71,6 +74,11 @@ static const PegInfo ha_pegs[] =
     { CountType::SUM, "unknown_key_type", "messages received with an unknown flow key type" },
     { CountType::SUM, "unknown_client_idx", "messages received with an unknown client index" },
     { CountType::SUM, "client_consume_errors", "client data consume failure count" },
+    { CountType::SUM, "delta_updates_sent", "update messages sent without unchanged sections" },
+    { CountType::SUM, "section_version_mismatch", "client sections skipped due to a version mismatch" },
+    { CountType::SUM, "compressed_msgs_sent", "update messages sent compressed" },
+    { CountType::SUM, "compress_skips", "messages sent uncompressed because deflate did not shrink them" },
+    { CountType::SUM, "decompress_errors", "compressed messages dropped due to inflate failure" },
     { CountType::END, nullptr, nullptr }
 };
 
@@ -126,6 +134,10 @@ bool HighAvailabilityModule::set(const char*, Value& v, SnortConfig*)
     {
         config->enabled = v.get_bool();
     }
+    else if ( v.is("compress") )
+    {
+        config->compress = v.get_bool();
+    }
     else if ( v.is("daq_channel") )
     {
         config->daq_channel = v.get_bool();
@@ -35,6 +35,7 @@ struct HighAvailabilityConfig
 
     bool enabled;
     bool daq_channel;
+    bool compress = false;
     PortBitSet* ports = nullptr;
     struct timeval min_session_lifetime;
     struct timeval min_sync_interval;
@@ -77,6 +78,11 @@ struct HAStats
     PegCount unknown_key_type;
     PegCount unknown_client_idx;
     PegCount client_consume_errors;
+    PegCount delta_updates_sent;
+    PegCount section_version_mismatch;
+    PegCount compressed_msgs_sent;
+    PegCount compress_skips;
+    PegCount decompress_errors;
 };
 
 extern THREAD_LOCAL HAStats ha_stats;
@@ -62,6 +62,11 @@ struct PruneStats
 
     void update(PruneReason reason)
     { ++get(reason); }
+
+    // two phase prune bookkeeping; depth is tracked so spikes in the
+    // reclaim backlog are visible even after it drains
+    PegCount deferred = 0;
+    PegCount max_deferred = 0;
 };
 
 enum class FlowDeleteState : uint8_t
@@ -74,12 +74,13 @@ static struct __attribute__((__packed__)) TestUpdateMessage {
     {
         HA_UPDATE_EVENT,
         HA_MESSAGE_VERSION,
-        0x41,
+        0x42,
         KEY_TYPE_IP6
     },
     s_test_key,
     {
         0,
+        1,
         10
     },
     { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }
@@ -464,6 +465,39 @@ TEST(high_availability_test, transmit_update_both_update)
     CHECK(s_transmit_message_called == true);
 }
 
+TEST(high_availability_test, transmit_update_pending_only_delta)
+{
+    s_transmit_message_called = false;
+    s_stream_update_required = false;
+    s_other_update_required = false;
+    s_pkt.active = &active;
+    s_flow.ha_state->clear(FlowHAState::NEW | FlowHAState::NEW_SESSION);
+    s_flow.ha_state->set_pending(s_other_ha_client->handle);
+    HighAvailabilityManager::process_update(&s_flow, &s_pkt);
+    CHECK(s_transmit_message_called == true);
+    // the delta carries only the other client's section, not the session section
+    CHECK(s_message_length ==
+        sizeof(HAMessageHeader) + KEY_SIZE_IP6 + sizeof(HAClientHeader) + 5);
+    CHECK(ha_stats.delta_updates_sent == 1);
+}
+
+TEST(high_availability_test, consume_section_version_mismatch)
+{
+    struct __attribute__((__packed__))
+    {
+        HAClientHeader chdr = { 0, 2, 10 };
+        uint8_t cmsg[10] = { };
+    } input;
+    HAMessage msg((uint8_t*) &input, sizeof(input));
+    FlowKey key;
+
+    s_stream_consume_called = false;
+    consume_ha_update_message(msg, key, &s_pkt);
+    CHECK(s_stream_consume_called == false);
+    CHECK(ha_stats.section_version_mismatch == 1);
+    CHECK(ha_stats.update_msgs_consumed == 1);
+}
+
 TEST(high_availability_test, read_flow_key_error_v4)
 {
     HAMessageHeader hdr = { 0, 0, 0, KEY_TYPE_IP4 };
@@ -507,7 +541,7 @@ TEST(high_availability_test, consume_error_truncated_client_hdr)
 
 TEST(high_availability_test, consume_error_invalid_client_idx)
 {
-    HAClientHeader chdr = { 0x42, 0 };
+    HAClientHeader chdr = { 0x42, 1, 0 };
     HAMessage msg((uint8_t*) &chdr, sizeof(chdr));
     FlowKey key;
 
@@ -520,7 +554,7 @@ TEST(high_availability_test, consume_error_truncated_client_msg)
 {
     struct __attribute__((__packed__))
     {
-        HAClientHeader chdr = { 0, 0x42 };
+        HAClientHeader chdr = { 0, 1, 0x42 };
         uint8_t cmsg[0x42 / 2] = { };
     } input;
     HAMessage msg((uint8_t*) &input, sizeof(input));
@@ -535,7 +569,7 @@ TEST(high_availability_test, consume_error_client_consume)
 {
     struct __attribute__((__packed__))
     {
-        HAClientHeader chdr = { 0, 10 };
+        HAClientHeader chdr = { 0, 1, 10 };
         uint8_t cmsg[0x42 / 2] = { };
     } input;
     HAMessage msg((uint8_t*) &input, sizeof(input));
@@ -23,9 +23,14 @@
 
 #include "codec.h"
 
+#include <daq.h>
+
+#include <cstring>
+
 #include "codecs/codec_module.h"
 #include "detection/detection_engine.h"
 #include "events/event_queue.h"
+#include "main/thread.h"
 
 #ifdef UNIT_TEST
 #include "catch/snort_catch.h"
@@ -33,6 +38,22 @@
 
 using namespace snort;
 
+RawData::RawData(const struct _daq_msg* msg, const uint8_t* data, uint32_t len) :
+    daq_msg(msg), data(data), len(len)
+{
+    if ( msg )
+    {
+        pkt_decode_data =
+            (const DAQ_PktDecodeData_t*) daq_msg_get_meta(msg, DAQ_PKT_META_DECODE_DATA);
+        napt_info = (const DAQ_NAPTInfo_t*) daq_msg_get_meta(msg, DAQ_PKT_META_NAPT_INFO);
+    }
+    else
+    {
+        pkt_decode_data = nullptr;
+        napt_info = nullptr;
+    }
+}
+
 EncState::EncState(const ip::IpApi& api, EncodeFlags f, IpProtocol pr,
     uint8_t t, uint16_t data_size) :
     ip_api(api),
@@ -88,6 +109,23 @@ void Codec::codec_event(const CodecData&, CodecSid sid)
     DetectionEngine::queue_event(GID_DECODE, sid);
 }
 
+static constexpr uint32_t IP6_OPT_CACHE_LEN = 64;
+
+namespace
+{
+/* The last hop-by-hop / destination option region that walked clean.  Flows
+ * carry stable extension chains, so repeating regions (and regions shared by
+ * stacks emitting the same options) skip the per-option TLV walk.  Only clean
+ * walks are cached; anything alertable is re-walked so events still fire. */
+struct Ip6OptionsCache
+{
+    uint32_t len;
+    uint8_t opts[IP6_OPT_CACHE_LEN];
+};
+}
+
+static THREAD_LOCAL Ip6OptionsCache ip6_options_cache = { 0, {} };
+
 bool Codec::CheckIPV6HopOptions(const RawData& raw, CodecData& codec)
 {
     const ip::IP6Extension* const exthdr =
@@ -99,10 +137,15 @@ bool Codec::CheckIPV6HopOptions(const RawData& raw, CodecData& codec)
     const uint32_t total_octets = (exthdr->ip6e_len * 8) + 8;
     const uint8_t* hdr_end = pkt + total_octets;
     uint8_t oplen;
+    bool clean = true;
 
     if (raw.len < total_octets)
         codec_event(codec, DECODE_IPV6_TRUNCATED_EXT);
 
+    else if ((total_octets == ip6_options_cache.len) and
+        (memcmp(pkt, ip6_options_cache.opts, total_octets) == 0))
+        return true;
+
     /* Skip to the options */
     pkt += 2;
 
@@ -117,6 +160,7 @@ bool Codec::CheckIPV6HopOptions(const RawData& raw, CodecData& codec)
             break;
 
         default:
+            clean = false;
             if ( !(codec.codec_flags & CODEC_IP6_BAD_OPT) )
             {
                 codec_event(codec, DECODE_IPV6_BAD_OPT_TYPE);
@@ -143,6 +187,13 @@ bool Codec::CheckIPV6HopOptions(const RawData& raw, CodecData& codec)
         }
     }
 
+    if ( clean and (raw.len >= total_octets) and (total_octets <= IP6_OPT_CACHE_LEN) )
+    {
+        memcpy(ip6_options_cache.opts,
+            reinterpret_cast<const uint8_t*>(raw.data), total_octets);
+        ip6_options_cache.len = total_octets;
+    }
+
     return true;
 }
 
@@ -32,6 +32,8 @@
 
 struct TextLog;
 struct _daq_msg;
+struct _daq_pkt_decode_data;
+struct _daq_napt_info;
 
 namespace snort
 {
@@ -63,14 +65,18 @@ struct Layer;
 constexpr uint8_t MIN_TTL = 64;
 constexpr uint8_t MAX_TTL = 255;
 
-struct RawData
+struct SO_PUBLIC RawData
 {
     const struct _daq_msg* daq_msg;
     const uint8_t* data;
     uint32_t len;
 
-    RawData(const struct _daq_msg* daq_msg, const uint8_t* data, uint32_t len) :
-        daq_msg(daq_msg), data(data), len(len) { }
+    // per message DAQ metadata is fetched once here when decode starts so
+    // the codecs down the layer stack don't each repeat the lookups
+    const struct _daq_pkt_decode_data* pkt_decode_data;
+    const struct _daq_napt_info* napt_info;
+
+    RawData(const struct _daq_msg*, const uint8_t* data, uint32_t len);
 };
 
 /*  Decode Flags */
@@ -70,6 +70,17 @@ public:
     virtual void discard_message(ConnectorMsgHandle*) = 0;
     virtual bool transmit_message(ConnectorMsgHandle*) = 0;
     virtual ConnectorMsgHandle* receive_message(bool block) = 0;
+
+    // optional zero-copy transmit path: reserve space in the connector's
+    // transmit buffer, write the message in place, then commit it for
+    // transmission.  at most one reservation may be outstanding; an
+    // uncommitted reservation is simply abandoned.  committed messages may
+    // be batched by the connector until flush_transmit() is called.
+    // connectors without such a buffer return nullptr from reserve and the
+    // caller must fall back to alloc_message() / transmit_message().
+    virtual uint8_t* reserve_message(const uint32_t /*length*/) { return nullptr; }
+    virtual bool commit_message(const uint32_t /*length*/) { return false; }
+    virtual void flush_transmit() { }
     virtual ConnectorMsg* get_connector_msg(ConnectorMsgHandle*) = 0;
     virtual Direction get_connector_direction() = 0;
 
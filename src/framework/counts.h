@@ -29,6 +29,12 @@
 
 typedef uint64_t PegCount;
 
+// live pegs are thread local slabs summed into the module totals only at
+// report time.  hot slabs get their own cache lines so a slab never
+// straddles a line with a neighbor written by another thread; the thread
+// local segment packs unrelated objects back to back.
+#define PEG_SLAB_ALIGN alignas(64)
+
 enum CountType
 {
     END,   // sentinel value
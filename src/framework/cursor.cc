@@ -26,7 +26,9 @@
 #include "cursor.h"
 
 #include "detection/detection_util.h"
+#include "detection/ips_context.h"
 #include "protocols/packet.h"
+#include "utils/stats.h"
 
 using namespace snort;
 
@@ -43,25 +45,54 @@ Cursor::Cursor(const Cursor& rhs)
     buf = rhs.buf;
     sz = rhs.sz;
     pos = rhs.pos;
+    ctx = rhs.ctx;
 
-    if (rhs.data)
+    if (rhs.ndata)
     {
-        data = new CursorDataVec;
+        grow_data(rhs.ndata);
 
-        for (CursorData*& cd : *rhs.data)
-            data->push_back(cd->clone());
+        for (unsigned i = 0; i < rhs.ndata; i++)
+            data[ndata++] = rhs.data[i]->clone();
     }
 }
 
+// the array doubles in place conceptually; the old scratchpad chunk is
+// simply abandoned until the context resets it with the next packet
+void Cursor::grow_data(unsigned need)
+{
+    unsigned cap = data_cap ? data_cap * 2 : 4;
+
+    while (cap < need)
+        cap *= 2;
+
+    CursorData** nd = ctx ?
+        (CursorData**)ctx->scratchpad_alloc(cap * sizeof(CursorData*)) : nullptr;
+    bool on_heap = false;
+
+    if (!nd)
+    {
+        nd = new CursorData*[cap];
+        on_heap = true;
+        ++pc.cursor_scratch_fallbacks;
+    }
+
+    for (unsigned i = 0; i < ndata; i++)
+        nd[i] = data[i];
+
+    if (data_on_heap)
+        delete[] data;
+
+    data = nd;
+    data_cap = cap;
+    data_on_heap = on_heap;
+}
+
 CursorData* Cursor::get_data(unsigned id) const
 {
-    if (data)
+    for (unsigned i = 0; i < ndata; i++)
     {
-        for (CursorData*& cd : *data)
-        {
-            if (cd->get_id() == id)
-                return cd;
-        }
+        if (data[i]->get_id() == id)
+            return data[i];
     }
 
     return nullptr;
@@ -71,40 +102,48 @@ void Cursor::set_data(CursorData* cd)
 {
     assert(cd);
 
-    if (data)
+    unsigned id = cd->get_id();
+
+    for (unsigned i = 0; i < ndata; i++)
     {
-        unsigned id = cd->get_id();
-        for (CursorData*& old : *data)
+        if (data[i]->get_id() == id)
         {
-            if (old->get_id() == id)
-            {
-                delete old;
-                old = cd;
-                return;
-            }
+            delete data[i];
+            data[i] = cd;
+            return;
         }
     }
-    else
-    {
-        data = new CursorDataVec;
-    }
 
-    data->push_back(cd);
+    if (ndata == data_cap)
+        grow_data(ndata + 1);
+
+    data[ndata++] = cd;
 }
 
 void Cursor::reset(Packet* p)
 {
+    ctx = p->context;
+
     InspectionBuffer buf;
+    bool have = false;
 
     // FIXIT-M should this be converted to get_fp_buf()?
-    if ( p->flow and p->flow->gadget and
-        p->flow->gadget->get_buf(buf.IBT_ALT, p, buf) )
+    if ( p->flow and p->flow->gadget )
     {
-        set("alt_data", buf.data, buf.len);
+        // every rule tree resets a cursor, so materialize alt data once
+        // per packet and let subsequent resets hit the context cache
+        if ( ctx->buf_is_cached(buf.IBT_ALT) )
+            have = ctx->get_cached_buf(buf.IBT_ALT, buf);
+        else
+        {
+            have = p->flow->gadget->get_buf(buf.IBT_ALT, p, buf);
+            ctx->cache_buf(buf.IBT_ALT, buf, have);
+        }
     }
+
+    if ( have )
+        set("alt_data", buf.data, buf.len);
     else
-    {
         set("pkt_data", p->data, p->get_detect_limit());
-    }
 }
 
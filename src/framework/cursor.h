@@ -27,10 +27,10 @@
 
 #include <cstdint>
 #include <cstring>
-#include <vector>
 
 namespace snort
 {
+class IpsContext;
 struct Packet;
 }
 
@@ -63,13 +63,11 @@ public:
 
     ~Cursor()
     {
-        if (!data)
-            return;
+        for (unsigned i = 0; i < ndata; i++)
+            delete data[i];
 
-        for (CursorData*& cd : *data)
-            delete cd;
-
-        delete data;
+        if (data_on_heap)
+            delete[] data;
     }
 
     const char* get_name() const
@@ -135,15 +133,23 @@ public:
 
     void set_data(CursorData* cd);
 
-    typedef std::vector<CursorData*> CursorDataVec;
-
 private:
+    void grow_data(unsigned need);
+
     const char* name = nullptr;    // rule option name ("pkt_data", "http_uri", etc.)
     const uint8_t* buf = nullptr;  // start of buffer
     unsigned sz = 0;               // size of buffer
     unsigned pos = 0;              // current pos
     unsigned delta = 0;            // loop offset
-    CursorDataVec* data = nullptr; // data stored on the cursor
+
+    // data stored on the cursor; the pointer array comes from the
+    // context scratchpad so cursor copies during rule eval don't hit
+    // the heap (the data objects themselves belong to their creators)
+    snort::IpsContext* ctx = nullptr;
+    CursorData** data = nullptr;
+    unsigned ndata = 0;
+    unsigned data_cap = 0;
+    bool data_on_heap = false;
 };
 
 #endif
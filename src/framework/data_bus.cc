@@ -68,7 +68,7 @@ DataBus::DataBus() = default;
 DataBus::~DataBus()
 {
     for ( auto& p : map )
-        for ( auto* h : p.second )
+        for ( auto* h : p.second.handlers )
         {
             // If the object is cloned, pass the ownership to the next config.
             // When the object is no further cloned (e.g., the last config), delete it.
@@ -82,7 +82,7 @@ DataBus::~DataBus()
 void DataBus::clone(DataBus& from, const char* exclude_name)
 {
     for ( auto& p : from.map )
-        for ( auto* h : p.second )
+        for ( auto* h : p.second.handlers )
             if ( nullptr == exclude_name || 0 != strcmp(exclude_name, h->module_name) )
             {
                 h->cloned = true;
@@ -138,26 +138,44 @@ void DataBus::publish(const char* key, Packet* p, Flow* f)
     publish(key, e, f);
 }
 
+void DataBus::get_publish_counts(std::map<std::string, PegCount>& sums)
+{
+    const SnortConfig* sc = SnortConfig::get_conf();
+
+    if ( !sc )
+        return;
+
+    for ( unsigned i = 0; i < sc->policy_map->inspection_policy_count(); ++i )
+        sc->policy_map->get_inspection_policy(i)->dbus._sum_publish_counts(sums);
+
+    sc->global_dbus->_sum_publish_counts(sums);
+}
+
 //--------------------------------------------------------------------------
 // private methods
 //--------------------------------------------------------------------------
 
 void DataBus::_subscribe(const char* key, DataHandler* h)
 {
-    DataList& v = map[key];
+    DataList& v = map[key].handlers;
     v.emplace_back(h);
 }
 
 void DataBus::_unsubscribe(const char* key, DataHandler* h)
 {
-    DataList& v = map[key];
+    auto it = map.find(key);
+
+    if ( it == map.end() )
+        return;
+
+    DataList& v = it->second.handlers;
 
     for ( unsigned i = 0; i < v.size(); i++ )
         if ( v[i] == h )
             v.erase(v.begin() + i--);
 
     if ( v.empty() )
-        map.erase(key);
+        map.erase(it);
 }
 
 // notify subscribers of event
@@ -167,8 +185,17 @@ void DataBus::_publish(const char* key, DataEvent& e, Flow* f)
 
     if ( v != map.end() )
     {
-        for ( auto* h : v->second )
+        v->second.publishes.fetch_add(1, std::memory_order_relaxed);
+
+        for ( auto* h : v->second.handlers )
             h->handle(e, f);
     }
 }
 
+void DataBus::_sum_publish_counts(std::map<std::string, PegCount>& sums) const
+{
+    for ( const auto& p : map )
+        if ( PegCount n = p.second.publishes.load(std::memory_order_relaxed) )
+            sums[p.first] += n;
+}
+
@@ -27,11 +27,12 @@
 // at arbitrary points, eg when service is identified, or when a URI is
 // available, or when a flow clears.
 
+#include <atomic>
+#include <map>
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
+#include "framework/counts.h"
 #include "main/snort_types.h"
 
 namespace snort
@@ -82,9 +83,21 @@ protected:
     DataHandler(const char* mod_name) : module_name(mod_name), cloned(false) { }
 };
 
-// FIXIT-P evaluate perf; focus is on correctness
 typedef std::vector<DataHandler*> DataList;
-typedef std::unordered_map<std::string, DataList> DataMap;
+
+struct DataEntry
+{
+    DataList handlers;
+
+    // packet threads publishing the same event share this tally, hence
+    // the relaxed atomic bump in _publish()
+    std::atomic<PegCount> publishes { 0 };
+};
+
+// ordered with a transparent comparator so _publish() can probe with the
+// event key literal - no temporary std::string and no hashing on the per
+// packet / per transaction paths
+typedef std::map<std::string, DataEntry, std::less<>> DataMap;
 
 class SO_PUBLIC DataBus
 {
@@ -110,10 +123,15 @@ public:
     static void publish(const char* key, const uint8_t*, unsigned, Flow* = nullptr);
     static void publish(const char* key, Packet*, Flow* = nullptr);
 
+    // shutdown stats - sums publish counts per event key over all
+    // inspection policies and the global bus
+    static void get_publish_counts(std::map<std::string, PegCount>&);
+
 private:
     void _subscribe(const char* key, DataHandler*);
     void _unsubscribe(const char* key, DataHandler*);
     void _publish(const char* key, DataEvent&, Flow*);
+    void _sum_publish_counts(std::map<std::string, PegCount>&) const;
 
 private:
     DataMap map;
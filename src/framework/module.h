@@ -39,6 +39,7 @@
 // have any defaults applied.
 
 #include <cassert>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -191,6 +192,12 @@ public:
     virtual Usage get_usage() const
     { return CONTEXT; }
 
+    // serializes access to this module's aggregate counts and any globals
+    // its sum_stats override touches; per module so stats sweeps on one
+    // thread don't stall packet processing on the others
+    std::mutex& get_stats_lock()
+    { return stats_lock; }
+
 protected:
     Module(const char* name, const char* help);
     Module(const char* name, const char* help, const Parameter*, bool is_list = false);
@@ -204,6 +211,7 @@ private:
 
     std::vector<PegCount> counts;
     int num_counts = -1;
+    std::mutex stats_lock;
 
     const char* name;
     const char* help;
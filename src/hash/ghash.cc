@@ -84,6 +84,8 @@ GHash::GHash(int nrows_, unsigned keysize, bool userkey, gHashFree userfree)
     count = 0;
     crow = 0;
     cnode = nullptr;
+    flat = nullptr;
+    flat_mask = 0;
 }
 
 GHash::~GHash()
@@ -103,10 +105,51 @@ GHash::~GHash()
             snort_free(onode);
         }
 
+    if ( flat )
+        snort_free(flat);
+
     snort_free(table);
     delete hashfcn;
 }
 
+void GHash::freeze()
+{
+    thaw();
+
+    if ( !count )
+        return;
+
+    // at most half full so every probe run hits an empty slot
+    unsigned slots = (unsigned)hash_nearest_power_of_2((int)(count * 2));
+    flat_mask = slots - 1;
+    flat = (FlatEntry*)snort_calloc(slots, sizeof(FlatEntry));
+
+    for ( int i = 0; i < nrows; i++ )
+        for ( GHashNode* node = table[i]; node; node = node->next )
+        {
+            unsigned hashkey = hashfcn->do_hash(
+                (const unsigned char*)node->key, get_key_length(node->key));
+            unsigned s = hashkey & flat_mask;
+
+            while ( flat[s].key )
+                s = (s + 1) & flat_mask;
+
+            flat[s].hashkey = hashkey;
+            flat[s].key = node->key;
+            flat[s].data = node->data;
+        }
+}
+
+void GHash::thaw()
+{
+    if ( !flat )
+        return;
+
+    snort_free(flat);
+    flat = nullptr;
+    flat_mask = 0;
+}
+
 GHashNode* GHash::find_node(const void* const key, unsigned index)
 {
     assert(key);
@@ -132,6 +175,10 @@ int GHash::insert(const void* const key, void* const data)
 {
     assert(key && data);
 
+    // the flat view caches node key and data pointers, so any mutation
+    // invalidates it; revert to chain probing until the next freeze()
+    thaw();
+
     unsigned index = get_index(key);
     if ( GHashNode* hnode = find_node(key, index) )
     {
@@ -176,6 +223,28 @@ void* GHash::find(const void* const key)
 {
     assert(key);
 
+    if ( flat )
+    {
+        unsigned hashkey = hashfcn->do_hash(
+            (const unsigned char*)key, get_key_length(key));
+
+        for ( unsigned s = hashkey & flat_mask; flat[s].key; s = (s + 1) & flat_mask )
+        {
+            if ( flat[s].hashkey != hashkey )
+                continue;
+
+            if ( keysize == 0 )
+            {
+                if ( !strcmp((const char*)flat[s].key, (const char*)key) )
+                    return flat[s].data;
+            }
+            else if ( hashfcn->key_compare(flat[s].key, key, keysize) )
+                return flat[s].data;
+        }
+
+        return nullptr;
+    }
+
     unsigned index = get_index(key);
     GHashNode* hnode = find_node(key, index);
     if ( hnode )
@@ -219,6 +288,8 @@ int GHash::remove(const void* const key)
 {
     assert(key);
 
+    thaw();
+
     unsigned index = get_index(key);
     if ( GHashNode* hnode = find_node(key, index) )
         return free_node(index, hnode);
@@ -268,6 +339,9 @@ GHashNode* GHash::find_next()
 
 void GHash::set_hashkey_ops(HashKeyOperations* hk)
 {
+    // cached flat hashes came from the old ops
+    thaw();
+
     delete hashfcn;
     hashfcn = hk;
 }
@@ -53,13 +53,30 @@ public:
     GHashNode* find_next();
     void set_hashkey_ops(HashKeyOperations*);
 
+    // repack a loaded table into a read-only open addressed array so finds
+    // probe one contiguous slab instead of chasing chain nodes; call after
+    // config load, before packet threads probe the table.  the chains stay
+    // authoritative and any later insert or remove drops the flat view.
+    void freeze();
+
+    bool is_frozen() const
+    { return flat != nullptr; }
+
     unsigned get_count() const
     { return count; }
 
 private:
+    struct FlatEntry
+    {
+        unsigned hashkey;   // full hash, filters probes without a key compare
+        const void* key;    // nullptr == empty slot, ends the probe run
+        void* data;
+    };
+
     GHashNode* find_node(const void* const key, unsigned index);
     int free_node(unsigned index, GHashNode*);
     void next();
+    void thaw();
 
     unsigned get_key_length(const void* const key)
     { return ( keysize > 0  ) ? keysize : strlen((const char*)key) + 1; }
@@ -79,7 +96,8 @@ private:
     unsigned count;       // total # nodes in table
     int crow;             // findfirst/next row in table
     GHashNode* cnode;     // findfirst/next node ptr
-
+    FlatEntry* flat;      // frozen linear probe array, at most half full
+    unsigned flat_mask;   // flat slot count - 1, slot count is a power of 2
 };
 
 
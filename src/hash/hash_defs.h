@@ -41,6 +41,8 @@ public:
     void* key;
     void* data;
     int rindex;
+    unsigned hashkey; // full hash of key; lets bucket scans skip key compares
+    uint8_t lru_index;  // which HashLruCache list this node is linked on
 };
 }
 #endif
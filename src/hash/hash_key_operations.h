@@ -20,6 +20,8 @@
 #ifndef HASH_KEY_OPERATIONS_H
 #define HASH_KEY_OPERATIONS_H
 
+#include <cstring>
+
 #include "main/snort_types.h"
 
 namespace
@@ -80,6 +82,30 @@ protected:
     unsigned scale;
     unsigned hardener;
 };
+
+// compile time key length variant for tables whose key type is statically
+// known; the constant length lets the compiler flatten the hash and
+// compare loops instead of iterating a runtime keysize
+template <size_t key_len>
+class FixedKeyOps : public HashKeyOperations
+{
+public:
+    FixedKeyOps(int rows) : HashKeyOperations(rows) { }
+
+    unsigned do_hash(const unsigned char* key, int) override
+    {
+        unsigned hash = seed;
+        for ( size_t i = 0; i < key_len; i++ )
+        {
+            hash *= scale;
+            hash += key[i];
+        }
+        return hash ^ hardener;
+    }
+
+    bool key_compare(const void* k1, const void* k2, size_t) override
+    { return memcmp(k1, k2, key_len) == 0; }
+};
 }
 
 #endif
@@ -29,36 +29,44 @@
 
 using namespace snort;
 
-HashLruCache::HashLruCache()
+HashLruCache::HashLruCache(unsigned num_lists)
 {
-    head = nullptr;
-    tail = nullptr;
+    lists = new LruList[num_lists];
+}
+
+HashLruCache::~HashLruCache()
+{
+    delete[] lists;
 }
 
 void HashLruCache::insert(HashNode* hnode)
 {
-    if ( head )
+    LruList& list = lists[hnode->lru_index];
+
+    if ( list.head )
     {
         hnode->gprev = nullptr;
-        hnode->gnext = head;
-        head->gprev = hnode;
-        head = hnode;
+        hnode->gnext = list.head;
+        list.head->gprev = hnode;
+        list.head = hnode;
     }
     else
     {
         hnode->gprev = nullptr;
         hnode->gnext = nullptr;
-        head = hnode;
-        tail = hnode;
+        list.head = hnode;
+        list.tail = hnode;
     }
 }
 
 void HashLruCache::touch(HashNode* hnode)
 {
-    if ( hnode == cursor )
-        cursor = hnode->gprev;
+    LruList& list = lists[hnode->lru_index];
+
+    if ( hnode == list.cursor )
+        list.cursor = hnode->gprev;
 
-    if ( hnode != head )
+    if ( hnode != list.head )
     {
         remove_node(hnode);
         insert(hnode);
@@ -67,14 +75,16 @@ void HashLruCache::touch(HashNode* hnode)
 
 void HashLruCache::remove_node(HashNode* hnode)
 {
-    if ( cursor == hnode )
-        cursor = hnode->gprev;
+    LruList& list = lists[hnode->lru_index];
+
+    if ( list.cursor == hnode )
+        list.cursor = hnode->gprev;
 
-    if ( head == hnode )
+    if ( list.head == hnode )
     {
-        head = head->gnext;
-        if ( head )
-            head->gprev = nullptr;
+        list.head = list.head->gnext;
+        if ( list.head )
+            list.head->gprev = nullptr;
     }
 
     if ( hnode->gprev )
@@ -82,6 +92,6 @@ void HashLruCache::remove_node(HashNode* hnode)
     if ( hnode->gnext )
         hnode->gnext->gprev = hnode->gprev;
 
-    if ( tail == hnode )
-        tail = hnode->gprev;
+    if ( list.tail == hnode )
+        list.tail = hnode->gprev;
 }
@@ -23,40 +23,46 @@
 
 #include "hash_defs.h"
 
+// maintains one or more lru lists over hash nodes; each node records the
+// list it is linked on (HashNode::lru_index) so insert / touch / remove
+// route themselves.  single list users get the original behavior with
+// list 0; the mru / lru user data and remove_lru_node shortcuts are only
+// meaningful for single list users.
 class HashLruCache
 {
 public:
-    HashLruCache();
+    HashLruCache(unsigned num_lists = 1);
+    ~HashLruCache();
 
     void insert(snort::HashNode*);
     void touch(snort::HashNode*);
     void remove_node(snort::HashNode*);
 
-    snort::HashNode* get_lru_node()
+    snort::HashNode* get_lru_node(unsigned list = 0)
     {
-        cursor = tail;
-        return cursor;
+        lists[list].cursor = lists[list].tail;
+        return lists[list].cursor;
     }
 
-    snort::HashNode* get_next_lru_node()
+    snort::HashNode* get_next_lru_node(unsigned list = 0)
     {
-        if ( cursor )
-            cursor = cursor->gprev;
-        return cursor;
+        if ( lists[list].cursor )
+            lists[list].cursor = lists[list].cursor->gprev;
+        return lists[list].cursor;
     }
 
-    snort::HashNode* get_current_node()
-    { return cursor; }
+    snort::HashNode* get_current_node(unsigned list = 0)
+    { return lists[list].cursor; }
 
     void* get_mru_user_data()
-    { return ( head ) ? head->data : nullptr; }
+    { return ( lists[0].head ) ? lists[0].head->data : nullptr; }
 
     void* get_lru_user_data()
-    { return ( tail ) ? tail->data : nullptr; }
+    { return ( lists[0].tail ) ? lists[0].tail->data : nullptr; }
 
     snort::HashNode* remove_lru_node()
     {
-        snort::HashNode* hnode = tail;
+        snort::HashNode* hnode = lists[0].tail;
         if ( hnode )
             remove_node(hnode);
 
@@ -64,9 +70,14 @@ public:
     }
 
 private:
-    snort::HashNode* head = nullptr;
-    snort::HashNode* tail = nullptr;
-    snort::HashNode* cursor = nullptr;
+    struct LruList
+    {
+        snort::HashNode* head = nullptr;
+        snort::HashNode* tail = nullptr;
+        snort::HashNode* cursor = nullptr;
+    };
+
+    LruList* lists;
 };
 
 #endif
@@ -33,5 +33,7 @@ const PegInfo lru_cache_shared_peg_names[] =
     { CountType::SUM, "reload_prunes", "lru cache pruned entry for lower memcap during reload" },
     { CountType::SUM, "removes", "lru cache found entry and removed it" },
     { CountType::SUM, "replaced", "lru cache found entry and replaced it" },
+    { CountType::SUM, "lock_contentions", "lru cache lock acquires that had to wait" },
+    { CountType::SUM, "memory_prunes", "lru cache pruned entry due to memory pressure" },
     { CountType::END, nullptr, nullptr },
 };
@@ -24,6 +24,7 @@
 // LruCacheShared -- Implements a thread-safe unordered map where the
 // least-recently-used (LRU) entries are removed once a fixed size is hit.
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <list>
@@ -46,6 +47,8 @@ struct LruCacheSharedStats
     PegCount reload_prunes = 0; // when an old entry is removed due to lower memcap during reload
     PegCount removes = 0;       // found entry and removed it
     PegCount replaced = 0;      // found entry and replaced it
+    PegCount lock_contentions = 0; // lock acquires that had to wait
+    PegCount memory_prunes = 0; // when an old entry is removed due to memory pressure
 };
 
 template<typename Key, typename Value, typename Hash>
@@ -81,6 +84,13 @@ public:
     // Return all data from the LruCache in order (most recently used to least)
     std::vector<std::pair<Key, Data> > get_all_data();
 
+    // Return all data as above but copy it out in bounded chunks, releasing
+    // the cache lock between chunks so a control channel dump of a large
+    // cache doesn't lock out packet threads for the whole walk.  Entries
+    // added while the walk is unlocked may be skipped; order is by hash
+    // bucket, not LRU.
+    std::vector<std::pair<Key, Data> > get_all_data_chunked(size_t chunk_buckets = 2048);
+
     //  Get current number of elements in the LruCache.
     size_t size()
     {
@@ -104,6 +114,31 @@ public:
     //  the oldest entries are removed. This pruning doesn't utilize reload resource tuner.
     bool set_max_size(size_t newsize);
 
+    //  Remove up to num of the oldest entries regardless of max_size; used
+    //  by the memory prune scheduler to reclaim space under pressure.
+    //  Returns the number of entries removed.
+    size_t prune_oldest(size_t num)
+    {
+        // data must be declared before the lock so removed entries self
+        // destruct after the cache is unlocked
+        std::vector<Data> data;
+        std::lock_guard<std::mutex> cache_lock(cache_mutex);
+
+        size_t removed = 0;
+
+        while ( num-- and !list.empty() )
+        {
+            LruListIter list_iter = --list.end();
+            data.emplace_back(list_iter->second);
+            decrease_size();
+            map.erase(list_iter->first);
+            list.erase(list_iter);
+            ++stats.memory_prunes;
+            ++removed;
+        }
+        return removed;
+    }
+
     //  Remove entry associated with Key.
     //  Returns true if entry existed, false otherwise.
     bool remove(const Key& key);
@@ -153,6 +188,21 @@ protected:
 
     struct LruCacheSharedStats stats;
 
+    // Take the cache lock, counting the acquires that stall behind another
+    // thread. The counter is bumped after the lock is won, so it needs no
+    // synchronization of its own. This is how contention on the shared
+    // cache shows up in the pegs instead of only in profiles.
+    std::unique_lock<std::mutex> acquire()
+    {
+        std::unique_lock<std::mutex> cache_lock(cache_mutex, std::try_to_lock);
+        if ( !cache_lock.owns_lock() )
+        {
+            cache_lock.lock();
+            stats.lock_contentions++;
+        }
+        return cache_lock;
+    }
+
     // The reason for these functions is to allow derived classes to do their
     // size book keeping differently (e.g. host_cache). This effectively
     // decouples the current_size variable from the actual size in memory,
@@ -211,7 +261,7 @@ template<typename Key, typename Value, typename Hash>
 std::shared_ptr<Value> LruCacheShared<Key, Value, Hash>::find(const Key& key)
 {
     LruMapIter map_iter;
-    std::lock_guard<std::mutex> cache_lock(cache_mutex);
+    std::unique_lock<std::mutex> cache_lock = acquire();
 
     map_iter = map.find(key);
     if (map_iter == map.end())
@@ -220,8 +270,9 @@ std::shared_ptr<Value> LruCacheShared<Key, Value, Hash>::find(const Key& key)
         return nullptr;
     }
 
-    //  Move entry to front of LruList
-    list.splice(list.begin(), list, map_iter->second);
+    //  Move entry to front of LruList unless it is already there
+    if (map_iter->second != list.begin())
+        list.splice(list.begin(), list, map_iter->second);
     stats.find_hits++;
     return map_iter->second->second;
 }
@@ -246,13 +297,14 @@ find_else_create(const Key& key, bool* new_data)
     // delete it before we got a chance to return it.
     std::vector<Data> tmp_data;
 
-    std::lock_guard<std::mutex> cache_lock(cache_mutex);
+    std::unique_lock<std::mutex> cache_lock = acquire();
 
     map_iter = map.find(key);
     if (map_iter != map.end())
     {
         stats.find_hits++;
-        list.splice(list.begin(), list, map_iter->second); // update LRU
+        if (map_iter->second != list.begin())
+            list.splice(list.begin(), list, map_iter->second); // update LRU
         return map_iter->second->second;
     }
 
@@ -281,7 +333,7 @@ find_else_insert(const Key& key, std::shared_ptr<Value>& data, bool replace)
     LruMapIter map_iter;
 
     std::vector<Data> tmp_data;
-    std::lock_guard<std::mutex> cache_lock(cache_mutex);
+    std::unique_lock<std::mutex> cache_lock = acquire();
 
     map_iter = map.find(key);
     if (map_iter != map.end())
@@ -291,10 +343,11 @@ find_else_insert(const Key& key, std::shared_ptr<Value>& data, bool replace)
         {
             // Explicitly calling the reset so its more clear that destructor could be called for the object
             map_iter->second->second.reset();
-            map_iter->second->second = data; 
+            map_iter->second->second = data;
             stats.replaced++;
         }
-        list.splice(list.begin(), list, map_iter->second); // update LRU
+        if (map_iter->second != list.begin())
+            list.splice(list.begin(), list, map_iter->second); // update LRU
         return true;
     }
 
@@ -328,6 +381,59 @@ LruCacheShared<Key, Value, Hash>::get_all_data()
     return vec;
 }
 
+template<typename Key, typename Value, typename Hash>
+std::vector< std::pair<Key, std::shared_ptr<Value>> >
+LruCacheShared<Key, Value, Hash>::get_all_data_chunked(size_t chunk_buckets)
+{
+    std::vector<std::pair<Key, Data> > vec;
+
+    unsigned restarts = 0;
+    size_t bucket = 0;
+    size_t num_buckets = 0;
+
+    while ( true )
+    {
+        std::unique_lock<std::mutex> cache_lock = acquire();
+
+        if ( bucket == 0 )
+        {
+            num_buckets = map.bucket_count();
+            vec.reserve(list.size());
+        }
+        else if ( map.bucket_count() != num_buckets )
+        {
+            // A rehash moved entries between buckets while we were
+            // unlocked, so the walk can no longer tell what it has seen.
+            // Start over; if the table keeps growing under us, finish the
+            // copy under one lock rather than looping indefinitely.
+            if ( ++restarts > 3 )
+            {
+                vec.clear();
+                for ( auto& entry : list )
+                    vec.emplace_back(entry);
+                return vec;
+            }
+            vec.clear();
+            bucket = 0;
+            num_buckets = map.bucket_count();
+            continue;
+        }
+
+        const size_t last = std::min(bucket + chunk_buckets, num_buckets);
+
+        for ( ; bucket < last; bucket++ )
+        {
+            for ( auto it = map.begin(bucket); it != map.end(bucket); ++it )
+                vec.emplace_back(*it->second);
+        }
+
+        if ( bucket >= num_buckets )
+            return vec;
+
+        // the lock drops here so packet threads can interleave with the walk
+    }
+}
+
 template<typename Key, typename Value, typename Hash>
 bool LruCacheShared<Key, Value, Hash>::remove(const Key& key)
 {
@@ -346,7 +452,7 @@ bool LruCacheShared<Key, Value, Hash>::remove(const Key& key)
     // data and cache_lock!
     Data data;
 
-    std::lock_guard<std::mutex> cache_lock(cache_mutex);
+    std::unique_lock<std::mutex> cache_lock = acquire();
 
     map_iter = map.find(key);
     if (map_iter == map.end())
@@ -374,7 +480,7 @@ bool LruCacheShared<Key, Value, Hash>::remove(const Key& key, std::shared_ptr<Va
 {
     LruMapIter map_iter;
 
-    std::lock_guard<std::mutex> cache_lock(cache_mutex);
+    std::unique_lock<std::mutex> cache_lock = acquire();
 
     map_iter = map.find(key);
     if (map_iter == map.end())
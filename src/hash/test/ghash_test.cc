@@ -156,6 +156,54 @@ TEST(ghash, collision_test)
     delete t;
 }
 
+// test that a frozen table finds every key and misses correctly, and
+// that a later insert thaws it back to chain probing
+TEST(ghash, freeze_test)
+{
+    int i;
+    char str[256];
+    int num=100;
+
+    // use a small row count so the frozen view replaces long chains
+    GHash* t = new GHash(-10, 0, false, nullptr);
+
+    // add Nodes to the Hash Table
+    for (i=0; i<num; i++)
+    {
+        snprintf(str, sizeof(str), "KeyWord%d",i+1);
+        str[sizeof(str) - 1] = '\0';
+        t->insert(str, (void *)(str + (i+1)));
+    }
+
+    t->freeze();
+    CHECK(t->is_frozen());
+
+    // find those nodes through the flat view
+    for (i=0; i<num; i++)
+    {
+        snprintf(str, sizeof(str), "KeyWord%d",i+1);
+        str[sizeof(str) - 1] = '\0';
+
+        char* p = (char*)t->find(str);
+
+        CHECK(p != nullptr);
+        CHECK(p == (void *)(str + (i+1)));
+    }
+
+    // a key not in the table should still miss
+    snprintf(str, sizeof(str), "NotInTable");
+    str[sizeof(str) - 1] = '\0';
+    CHECK(t->find(str) == nullptr);
+
+    // mutation drops the flat view and reverts to chain probing
+    i = t->insert(str, (void *)str);
+    CHECK(i == HASH_OK);
+    CHECK(!t->is_frozen());
+    CHECK(t->find(str) == (void *)str);
+
+    delete t;
+}
+
 TEST(ghash, userfree_test)
 {
     char str[256];
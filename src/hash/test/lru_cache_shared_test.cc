@@ -80,6 +80,28 @@ TEST(lru_cache_shared, insert_test)
     CHECK(vec[2].second->compare("two") == 0);
 }
 
+//  Test the chunked copy used by control channel dumps.
+TEST(lru_cache_shared, chunked_walk_test)
+{
+    LruCacheShared<int, std::string, std::hash<int> > lru_cache(100);
+
+    for (int i = 0; i < 50; i++)
+        lru_cache[i]->assign(std::to_string(i));
+
+    // tiny chunks force several lock/unlock rounds
+    auto vec = lru_cache.get_all_data_chunked(1);
+    CHECK(vec.size() == 50);
+
+    // every entry is returned exactly once (order is by bucket, not LRU)
+    std::sort(vec.begin(), vec.end(),
+        [](const std::pair<int, std::shared_ptr<std::string>>& a,
+           const std::pair<int, std::shared_ptr<std::string>>& b)
+        { return a.first < b.first; });
+
+    for (int i = 0; i < 50; i++)
+        CHECK(vec[i].first == i and *vec[i].second == std::to_string(i));
+}
+
 // Test set / get max size.
 TEST(lru_cache_shared, max_size)
 {
@@ -144,6 +144,79 @@ TEST(zhash, create_zhash_test)
      }
 }
 
+TEST(zhash, lru_lists_zhash_test)
+{
+    ZHash* mzh = new ZHash(ZHASH_ROWS, ZHASH_KEY_SIZE, 2);
+    CHECK(mzh);
+
+    for (unsigned i = 0; i < MAX_ZHASH_NODES; i++ )
+    {
+        unsigned* data;
+        data = (unsigned*)snort_calloc(sizeof(unsigned));
+        *data = 0;
+        mzh->push(data);
+    }
+
+    std::string key_prefix = "bar";
+    for (unsigned i = 0; i < MAX_ZHASH_NODES; i++ )
+     {
+        std::string key;
+        key = key_prefix + std::to_string(i + 1);
+        memcpy(key_buf, key.c_str(), key.size());
+        unsigned* data = (unsigned*)mzh->get(key_buf, i & 1);
+        CHECK(*data == 0);
+        *data = i + 1;
+     }
+
+    // each list holds only its own nodes, in lru order
+    unsigned nodes_walked = 0;
+    unsigned expected = 1;
+    unsigned* data = (unsigned*)mzh->lru_first(0);
+    while ( data )
+    {
+        CHECK(*data == expected);
+        expected += 2;
+        ++nodes_walked;
+        data = (unsigned*)mzh->lru_next(0);
+    }
+    CHECK(nodes_walked == MAX_ZHASH_NODES / 2);
+
+    expected = 2;
+    data = (unsigned*)mzh->lru_first(1);
+    while ( data )
+    {
+        CHECK(*data == expected);
+        expected += 2;
+        ++nodes_walked;
+        data = (unsigned*)mzh->lru_next(1);
+    }
+    CHECK(nodes_walked == MAX_ZHASH_NODES);
+
+    // removing from one list leaves the other untouched
+    data = (unsigned*)mzh->lru_first(0);
+    CHECK(*data == 1);
+    data = (unsigned*)mzh->remove(0);
+    CHECK(*data == 1);
+    snort_free(data);
+    data = (unsigned*)mzh->lru_first(0);
+    CHECK(*data == 3);
+    data = (unsigned*)mzh->lru_first(1);
+    CHECK(*data == 2);
+
+    while ( mzh->lru_first(0) )
+    {
+        data = (unsigned*)mzh->remove(0);
+        snort_free(data);
+    }
+    while ( mzh->lru_first(1) )
+    {
+        data = (unsigned*)mzh->remove(1);
+        snort_free(data);
+    }
+
+    delete mzh;
+}
+
 int main(int argc, char** argv)
 {
     return CommandLineTestRunner::RunAllTests(argc, argv);
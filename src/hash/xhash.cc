@@ -108,7 +108,7 @@ void XHash::initialize(HashKeyOperations* hk_ops)
 {
     hashkey_ops = hk_ops;
     table = (HashNode**)snort_calloc(sizeof(HashNode*) * nrows);
-    lru_cache = new HashLruCache();
+    lru_cache = new HashLruCache(num_lru_lists);
     mem_allocator = new MemCapAllocator(mem_cap, sizeof(HashNode) + keysize + datasize);
 }
 
@@ -117,6 +117,13 @@ void XHash::initialize()
     initialize(new HashKeyOperations(nrows));
 }
 
+void XHash::set_key_operations(HashKeyOperations* ops)
+{
+    assert(ops);
+    delete hashkey_ops;
+    hashkey_ops = ops;
+}
+
 void XHash::set_number_of_rows (int rows)
 {
     if ( rows > 0 )
@@ -141,6 +148,9 @@ XHash::XHash(int rows, int keysize, int datasize, unsigned long memcap)
 
 XHash::~XHash()
 {
+    if ( old_table )
+        migrate_rows(old_nrows);
+
     if ( table )
     {
         for (unsigned i = 0; i < nrows; i++)
@@ -165,6 +175,9 @@ void XHash::delete_hash_table()
 {
     assert( table );
 
+    if ( old_table )
+        migrate_rows(old_nrows);
+
     for (unsigned i = 0; i < nrows; i++)
         for (HashNode* node = table[i]; node;)
         {
@@ -183,6 +196,7 @@ void XHash::initialize_node(HashNode *hnode, const void *key, void *data, int in
 {
     hnode->key = (char*) (hnode) + sizeof(HashNode);
     memcpy(hnode->key, key, keysize);
+    hnode->hashkey = hashkey_ops->do_hash((const unsigned char*)key, keysize);
     if ( datasize )
     {
         hnode->data = (char*) (hnode) + sizeof(HashNode) + keysize;
@@ -193,6 +207,7 @@ void XHash::initialize_node(HashNode *hnode, const void *key, void *data, int in
         hnode->data = data;
 
     hnode->rindex = index;
+    hnode->lru_index = 0;
     link_node(hnode);
     lru_cache->insert(hnode);
 }
@@ -340,10 +355,14 @@ int XHash::release_node(const void* key)
 
     unsigned hashkey = hashkey_ops->do_hash((const unsigned char*)key, keysize);
 
+    if ( old_table )
+        migrate_bucket(hashkey & (old_nrows - 1));
+
     unsigned index = hashkey & (nrows - 1);
     for (HashNode* hnode = table[index]; hnode; hnode = hnode->next)
     {
-        if ( hashkey_ops->key_compare(hnode->key, key, keysize) )
+        if ( hnode->hashkey == hashkey and
+            hashkey_ops->key_compare(hnode->key, key, keysize) )
             return release_node(hnode);
     }
 
@@ -375,6 +394,13 @@ void XHash::unlink_node(HashNode* hnode)
         if ( hnode->next )
             hnode->next->prev = hnode->prev;
     }
+    else if ( old_table and old_table[hnode->rindex] == hnode )
+    {
+        // head of a bucket that has not been rebucketed yet
+        old_table[hnode->rindex] = hnode->next;
+        if ( hnode->next )
+            hnode->next->prev = nullptr;
+    }
     else if ( table[hnode->rindex] )
     {
         table[hnode->rindex] = table[hnode->rindex]->next;
@@ -398,11 +424,24 @@ HashNode* XHash::find_node_row(const void* key, int& rindex)
 {
     unsigned hashkey = hashkey_ops->do_hash((const unsigned char*)key, keysize);
 
+    // pull the key's old bucket over first so the walk below sees every node
+    if ( old_table )
+        migrate_bucket(hashkey & (old_nrows - 1));
+
     /* Modulus is slow. Switched to a table size that is a power of 2. */
     rindex  = hashkey & (nrows - 1);
     for (HashNode* hnode = table[rindex]; hnode; hnode = hnode->next )
     {
-        if ( hashkey_ops->key_compare(hnode->key, key, keysize) )
+#ifdef __GNUC__
+        // start pulling in the next node while this one is compared so a
+        // chained bucket walk overlaps its memory latency
+        if ( hnode->next )
+            __builtin_prefetch(hnode->next);
+#endif
+        // the full hash filters out colliding nodes without a trip to the
+        // key bytes; only bits masked by nrows are guaranteed equal here
+        if ( hnode->hashkey == hashkey and
+            hashkey_ops->key_compare(hnode->key, key, keysize) )
         {
             move_to_front(hnode);
             return hnode;
@@ -412,6 +451,75 @@ HashNode* XHash::find_node_row(const void* key, int& rindex)
     return nullptr;
 }
 
+// Incremental resize: the row array is swapped up front and the nodes are
+// rebucketed a row at a time - on touch by lookups and in bounded sweeps
+// via migrate_rows() - so no single packet pays for a full rehash.  Node
+// memory never moves, so key and user data pointers stay valid throughout.
+// Caveat: find_first_node() iteration only sees rebucketed nodes while a
+// resize is in progress; the lru list is unaffected.
+bool XHash::resize(int rows)
+{
+    unsigned new_rows;
+
+    if ( rows > 0 )
+        new_rows = hash_nearest_power_of_2(rows);
+    else
+        new_rows = -rows;
+
+    if ( new_rows == nrows )
+        return false;
+
+    // a back to back resize finishes the prior one first
+    if ( old_table )
+        migrate_rows(old_nrows);
+
+    old_table = table;
+    old_nrows = nrows;
+    sweep_row = 0;
+
+    nrows = new_rows;
+    table = (HashNode**)snort_calloc(sizeof(HashNode*) * nrows);
+    return true;
+}
+
+void XHash::migrate_bucket(unsigned row)
+{
+    HashNode* hnode = old_table[row];
+    old_table[row] = nullptr;
+
+    while ( hnode )
+    {
+        HashNode* next = hnode->next;
+        hnode->rindex = hnode->hashkey & (nrows - 1);
+        link_node(hnode);
+        hnode = next;
+    }
+}
+
+unsigned XHash::migrate_rows(unsigned count)
+{
+    unsigned migrated = 0;
+
+    while ( old_table and count-- )
+    {
+        migrate_bucket(sweep_row++);
+        ++migrated;
+
+        if ( sweep_row >= old_nrows )
+            finish_resize();
+    }
+
+    return migrated;
+}
+
+void XHash::finish_resize()
+{
+    snort_free(old_table);
+    old_table = nullptr;
+    old_nrows = 0;
+    sweep_row = 0;
+}
+
 void XHash::save_free_node(HashNode* hnode)
 {
     if ( fhead )
@@ -468,6 +576,9 @@ void XHash::purge_free_list()
 
 void XHash::clear_hash()
 {
+    if ( old_table )
+        migrate_rows(old_nrows);
+
     for (unsigned i = 0; i < nrows; i++)
         for (HashNode* node = table[i]; node;)
         {
@@ -494,6 +605,7 @@ void* XHash::get_lru_user_data()
 
 HashNode* XHash::release_lru_node()
 {
+    unsigned tries = 0;
     HashNode* hnode = lru_cache->get_lru_node();
     while ( hnode )
     {
@@ -506,6 +618,10 @@ HashNode* XHash::release_lru_node()
             ++stats.memcap_prunes;
             break;
         }
+        // when every stale node is protected the walk can cover the whole
+        // lru list; a subclass can cap it and fail the allocation instead
+        else if ( max_anr_tries and ++tries >= max_anr_tries )
+            return nullptr;
         else
             hnode = lru_cache->get_next_lru_node ();
     }
@@ -552,3 +668,27 @@ int XHash::tune_memory_resources(unsigned work_limit, unsigned& num_freed)
 }
 
 } // namespace snort
+
+#ifdef BENCHMARK_TEST
+
+#include "catch/snort_catch.h"
+
+TEST_CASE("xhash probe speed", "[benchmark]")
+{
+    const uint32_t nkeys = 4096;
+    XHash t(nkeys, sizeof(uint32_t));
+
+    for ( uint32_t i = 0; i < nkeys; i++ )
+        t.insert(&i, nullptr);
+
+    uint32_t present = nkeys / 2;
+    uint32_t absent = nkeys * 2;
+
+    BENCHMARK("hit probe")
+    { return t.find_node(&present); };
+
+    BENCHMARK("miss probe")
+    { return t.find_node(&absent); };
+}
+
+#endif
@@ -26,6 +26,7 @@
 // (supports memcap and automatic memory recovery when out of memory)
 
 #include "framework/counts.h"
+#include "hash/hash_key_operations.h"
 #include "main/snort_types.h"
 #include "utils/memcap_allocator.h"
 
@@ -33,7 +34,6 @@ class HashLruCache;
 
 namespace snort
 {
-class HashKeyOperations;
 class HashNode;
 
 struct XHashStats
@@ -58,6 +58,10 @@ public:
     HashNode* find_next_node();
     void* get_user_data();
     void* get_user_data(const void* key);
+
+    // node last found or inserted, nullptr before any lookup
+    HashNode* get_last_node()
+    { return cursor; }
     void release();
     int release_node(const void* key);
     int release_node(HashNode* node);
@@ -67,6 +71,15 @@ public:
     void clear_hash();
     bool full() const { return !fhead; }
 
+    // incrementally rebucket into a table sized for rows; old buckets are
+    // pulled over on touch and by bounded migrate_rows() sweeps so lookups
+    // never pause for a full rehash
+    bool resize(int rows);
+    unsigned migrate_rows(unsigned count);
+
+    bool is_resizing() const
+    { return old_table != nullptr; }
+
     // set max hash nodes, 0 == no limit
     void set_max_nodes(int max)
     { max_nodes = max; }
@@ -92,6 +105,10 @@ protected:
     void initialize(HashKeyOperations*);
     void initialize();
 
+    // swap in specialized key operations after initialize() has installed
+    // the defaults, e.g. by subclasses built on the 4 arg constructor
+    void set_key_operations(HashKeyOperations*);
+
     void initialize_node (HashNode*, const void* key, void* data, int index);
     HashNode* allocate_node(const void* key, void* data, int index);
     HashNode* find_node_row(const void* key, int& rindex);
@@ -110,15 +127,17 @@ protected:
 
     MemCapAllocator* mem_allocator = nullptr;
     HashLruCache* lru_cache = nullptr;
+    HashKeyOperations* hashkey_ops = nullptr;
+    unsigned num_lru_lists = 1;  // set before initialize() to shard the lru
     unsigned nrows = 0;
     unsigned keysize = 0;
     unsigned num_nodes = 0;
     bool recycle_nodes = true;
     bool anr_enabled = true;
+    unsigned max_anr_tries = 0;  // lru candidates tested per recovery, 0 == unlimited
 
 private:
     HashNode** table = nullptr;
-    HashKeyOperations* hashkey_ops = nullptr;
     HashNode* cursor = nullptr;
     HashNode* fhead = nullptr;
     unsigned datasize = 0;
@@ -127,7 +146,13 @@ private:
     unsigned crow = 0;
     XHashStats stats;
 
+    HashNode** old_table = nullptr;
+    unsigned old_nrows = 0;
+    unsigned sweep_row = 0;
+
     void set_number_of_rows(int nrows);
+    void migrate_bucket(unsigned row);
+    void finish_resize();
     void move_to_front(HashNode*);
     bool delete_free_node();
     HashNode* release_lru_node();
@@ -135,6 +160,18 @@ private:
     void purge_free_list();
 };
 
+// fixed key size variant; generates specialized probe and compare code
+// for tables whose key type is statically known.  plugins and tables
+// with runtime key sizes keep using XHash directly.
+template <size_t key_len>
+class TXHash : public XHash
+{
+public:
+    TXHash(int rows, int datasize, unsigned long memcap)
+        : XHash(rows, key_len, datasize, memcap)
+    { set_key_operations(new FixedKeyOps<key_len>(nrows)); }
+};
+
 } // namespace snort
 #endif
 
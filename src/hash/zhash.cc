@@ -41,14 +41,21 @@ using namespace snort;
 //-------------------------------------------------------------------------
 
 
-ZHash::ZHash(int rows, int key_len)
+ZHash::ZHash(int rows, int key_len, unsigned lru_lists)
     : XHash(rows, key_len)
 {
+    num_lru_lists = lru_lists ? lru_lists : 1;
     initialize(new FlowHashKeyOps(nrows));
     anr_enabled = false;
+
+    // the flow cache allocates up to one node per row, so provision them
+    // all up front in one contiguous slab; node walks and key compares
+    // then stay within one dense arena
+    if ( rows > 0 )
+        mem_allocator->reserve(rows);
 }
 
-void* ZHash::get(const void* key)
+void* ZHash::get(const void* key, unsigned lru_idx)
 {
     assert(key);
 
@@ -62,16 +69,18 @@ void* ZHash::get(const void* key)
         return nullptr;
 
     memcpy(node->key, key, keysize);
+    node->hashkey = hashkey_ops->do_hash((const unsigned char*)key, keysize);
     node->rindex = index;
+    node->lru_index = (uint8_t)lru_idx;
     link_node(node);
     lru_cache->insert(node);
     num_nodes++;
     return node->data;
 }
 
-void* ZHash::remove()
+void* ZHash::remove(unsigned lru_idx)
 {
-    HashNode* node = lru_cache->get_current_node();
+    HashNode* node = lru_cache->get_current_node(lru_idx);
     assert(node);
     void* pv = node->data;
 
@@ -103,27 +112,27 @@ void* ZHash::pop()
     return pv;
 }
 
-void* ZHash::lru_first()
+void* ZHash::lru_first(unsigned lru_idx)
 {
-    HashNode* node = lru_cache->get_lru_node();
+    HashNode* node = lru_cache->get_lru_node(lru_idx);
     return node ? node->data : nullptr;
 }
 
-void* ZHash::lru_next()
+void* ZHash::lru_next(unsigned lru_idx)
 {
-    HashNode* node = lru_cache->get_next_lru_node();
+    HashNode* node = lru_cache->get_next_lru_node(lru_idx);
     return node ? node->data : nullptr;
 }
 
-void* ZHash::lru_current()
+void* ZHash::lru_current(unsigned lru_idx)
 {
-    HashNode* node = lru_cache->get_current_node();
+    HashNode* node = lru_cache->get_current_node(lru_idx);
     return node ? node->data : nullptr;
 }
 
-void ZHash::lru_touch()
+void ZHash::lru_touch(unsigned lru_idx)
 {
-    HashNode* node = lru_cache->get_current_node();
+    HashNode* node = lru_cache->get_current_node(lru_idx);
     assert(node);
     lru_cache->touch(node);
 }
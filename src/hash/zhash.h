@@ -24,10 +24,13 @@
 
 #include "hash/xhash.h"
 
+// zhash can shard its lru into multiple lists; the caller assigns each
+// key to a list on get() and walks / touches / removes per list.  with
+// the default single list this is the classic global lru.
 class ZHash : public snort::XHash
 {
 public:
-    ZHash(int nrows, int keysize);
+    ZHash(int nrows, int keysize, unsigned lru_lists = 1);
 
     ZHash(const ZHash&) = delete;
     ZHash& operator=(const ZHash&) = delete;
@@ -35,13 +38,13 @@ public:
     void* push(void* p);
     void* pop();
 
-    void* get(const void* key);
-    void* remove();
+    void* get(const void* key, unsigned lru_idx = 0);
+    void* remove(unsigned lru_idx = 0);
 
-    void* lru_first();
-    void* lru_next();
-    void* lru_current();
-    void lru_touch();
+    void* lru_first(unsigned lru_idx = 0);
+    void* lru_next(unsigned lru_idx = 0);
+    void* lru_current(unsigned lru_idx = 0);
+    void lru_touch(unsigned lru_idx = 0);
 };
 
 #endif
@@ -29,6 +29,11 @@
 
 #include <cassert>
 
+#if defined(__x86_64__) && defined(__GNUC__)
+#define B64_ENCODE_SIMD
+#include <tmmintrin.h>
+#endif
+
 using namespace snort;
 
 static inline char b64(uint8_t idx)
@@ -39,6 +44,54 @@ static inline char b64(uint8_t idx)
     return encoding[idx];
 }
 
+#ifdef B64_ENCODE_SIMD
+// encode whole 12 byte blocks to 16 output characters per step with the
+// shuffle scheme the mime decoder uses in reverse; the tail and any state
+// carried across calls go through the scalar stepper below.  the load
+// reads 16 input bytes so the loop stops 16 short of the end.
+__attribute__((target("ssse3")))
+static void b64_encode_wide(const uint8_t*& data, const uint8_t* const data_end, char*& p)
+{
+    const __m128i in_shuf = _mm_setr_epi8(
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m128i mask_ac = _mm_set1_epi32(0x0fc0fc00);
+    const __m128i mask_bd = _mm_set1_epi32(0x003f03f0);
+    const __m128i mult_ac = _mm_set1_epi32(0x04000040);
+    const __m128i mult_bd = _mm_set1_epi32(0x01000010);
+
+    /* maps a 6 bit index range to the distance from its alphabet entry */
+    const __m128i offsets = _mm_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+        '/' - 63, 'A', 0, 0);
+
+    while ( data + 16 <= data_end )
+    {
+        __m128i in = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)data), in_shuf);
+
+        __m128i indices = _mm_or_si128(
+            _mm_mulhi_epu16(_mm_and_si128(in, mask_ac), mult_ac),
+            _mm_mullo_epi16(_mm_and_si128(in, mask_bd), mult_bd));
+
+        __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+        range = _mm_or_si128(range, _mm_and_si128(less, _mm_set1_epi8(13)));
+
+        _mm_storeu_si128((__m128i*)p,
+            _mm_add_epi8(_mm_shuffle_epi8(offsets, range), indices));
+
+        data += 12;
+        p += 16;
+    }
+}
+
+static bool have_b64_wide()
+{
+    static const bool ssse3 = __builtin_cpu_supports("ssse3");
+    return ssse3;
+}
+#endif
+
 unsigned Base64Encoder::encode(
     const uint8_t* plain_text, unsigned length, char* buf)
 {
@@ -46,6 +99,11 @@ unsigned Base64Encoder::encode(
     const uint8_t* const data_end = plain_text + length;
     char* p = buf;
 
+#ifdef B64_ENCODE_SIMD
+    if ( step == step_A and have_b64_wide() )
+        b64_encode_wide(data, data_end, p);
+#endif
+
     switch (step)
     {
         while (true)
@@ -43,6 +43,11 @@ public:
     bool is_set(unsigned int bit) const;
     void clear(unsigned int bit);
 
+    // clear all bits but keep the buffer so a recycled owner
+    // doesn't reallocate
+    void reset()
+    { bit_buf.assign(bit_buf.size(), 0); }
+
 private:
     size_t size() const
     { return bit_buf.size(); }
@@ -37,6 +37,40 @@ BoyerMooreSearch::BoyerMooreSearch(const uint8_t* pattern, unsigned pattern_len)
     last = pattern_len - 1;
 
     make_skip();
+    pick_anchors();
+}
+
+// crude byte commonness for anchor selection: letters and digits are
+// everywhere in traffic, other printables less so, control bytes rare
+static inline unsigned byte_rarity(uint8_t c)
+{
+    if ( isalpha(c) )
+        return 3;
+
+    if ( isdigit(c) or c == ' ' )
+        return 2;
+
+    if ( isprint(c) )
+        return 1;
+
+    return 0;
+}
+
+// choose the two rarest pattern positions as anchors so that at most
+// alignments the comparison loop is skipped after two byte tests
+void BoyerMooreSearch::pick_anchors()
+{
+    rare1 = last;
+
+    for ( unsigned i = 0; i < last; i++ )
+        if ( byte_rarity(pattern[i]) < byte_rarity(pattern[rare1]) )
+            rare1 = i;
+
+    rare2 = ( rare1 == last ) ? 0 : last;
+
+    for ( unsigned i = 0; i < pattern_len; i++ )
+        if ( i != rare1 and byte_rarity(pattern[i]) < byte_rarity(pattern[rare2]) )
+            rare2 = i;
 }
 
 // skip[c] is the distance between the last character of the
@@ -57,9 +91,12 @@ int BoyerMooreSearchCase::search(const uint8_t* buffer, unsigned buffer_len) con
 
     while ( buffer_len >= pattern_len )
     {
-        for ( unsigned pos = last; buffer[pos] == pattern[pos]; pos-- )
-            if ( pos == 0 )
-                return buffer - start;
+        if ( buffer[rare1] == pattern[rare1] and buffer[rare2] == pattern[rare2] )
+        {
+            for ( unsigned pos = last; buffer[pos] == pattern[pos]; pos-- )
+                if ( pos == 0 )
+                    return buffer - start;
+        }
 
         buffer_len -= skip[buffer[last]];
         buffer += skip[buffer[last]];
@@ -68,18 +105,47 @@ int BoyerMooreSearchCase::search(const uint8_t* buffer, unsigned buffer_len) con
     return -1;
 }
 
+// callers hand us an upper cased pattern
+BoyerMooreSearchNoCase::BoyerMooreSearchNoCase(const uint8_t* pat, unsigned pat_len)
+    : BoyerMooreSearch(pat, pat_len)
+{
+    fold_pat = new uint8_t[pat_len];
+    fold_mask = new uint8_t[pat_len];
+
+    for ( unsigned i = 0; i < pat_len; i++ )
+    {
+        fold_mask[i] = isalpha(pat[i]) ? 0x20 : 0x00;
+        fold_pat[i] = pat[i] | fold_mask[i];
+    }
+
+    // fold the skip table too so lookups need no toupper()
+    for ( unsigned c = 'A'; c <= 'Z'; c++ )
+        skip[c + 0x20] = skip[c];
+}
+
+BoyerMooreSearchNoCase::~BoyerMooreSearchNoCase()
+{
+    delete[] fold_pat;
+    delete[] fold_mask;
+}
+
 int BoyerMooreSearchNoCase::search(const uint8_t* buffer, unsigned buffer_len) const
 {
     const uint8_t* start = buffer;
 
     while ( buffer_len >= pattern_len )
     {
-        for ( unsigned pos = last; toupper(buffer[pos]) == pattern[pos]; pos-- )
-            if ( pos == 0 )
-                return buffer - start;
+        if ( (buffer[rare1] | fold_mask[rare1]) == fold_pat[rare1] and
+            (buffer[rare2] | fold_mask[rare2]) == fold_pat[rare2] )
+        {
+            for ( unsigned pos = last; (buffer[pos] | fold_mask[pos]) == fold_pat[pos];
+                pos-- )
+                if ( pos == 0 )
+                    return buffer - start;
+        }
 
-        buffer_len -= skip[toupper(buffer[last])];
-        buffer += skip[toupper(buffer[last])];
+        buffer_len -= skip[buffer[last]];
+        buffer += skip[buffer[last]];
     }
 
     return -1;
@@ -36,11 +36,17 @@ protected:
 
 protected:
     void make_skip();
+    void pick_anchors();
 
     const uint8_t* pattern;
     unsigned pattern_len;
     unsigned last;
 
+    // the two pattern positions least likely to occur in scanned data;
+    // checked before the full comparison loop to reject most alignments
+    unsigned rare1;
+    unsigned rare2;
+
     unsigned skip[256];
 };
 
@@ -59,13 +65,19 @@ public:
 class SO_PUBLIC BoyerMooreSearchNoCase : public BoyerMooreSearch
 {
 public:
-    BoyerMooreSearchNoCase(const uint8_t* pat, unsigned pat_len) :
-        BoyerMooreSearch(pat, pat_len) { }
+    BoyerMooreSearchNoCase(const uint8_t* pat, unsigned pat_len);
+    ~BoyerMooreSearchNoCase() override;
 
     int search(const uint8_t* buffer, unsigned buffer_len) const;
 
     int search(void*, const uint8_t* buffer, unsigned buffer_len) const override
     { return search(buffer, buffer_len); }
+
+private:
+    // case-folded image of the pattern: (byte | fold_mask) == fold_pat
+    // matches either case variant in one branchless test
+    uint8_t* fold_pat;
+    uint8_t* fold_mask;
 };
 
 }
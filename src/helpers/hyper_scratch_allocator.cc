@@ -22,11 +22,39 @@
 #endif
 
 #include "hyper_scratch_allocator.h"
+
+#include <cassert>
+
 #include "log/messages.h"
 
 namespace snort
 {
 
+// ctors and dtors of the sharing modules all run in the main thread,
+// so plain counting suffices
+static HyperScratchAllocator* s_shared = nullptr;
+static unsigned s_shared_refs = 0;
+
+HyperScratchAllocator* HyperScratchAllocator::shared()
+{
+    if ( !s_shared )
+        s_shared = new HyperScratchAllocator;
+
+    s_shared_refs++;
+    return s_shared;
+}
+
+void HyperScratchAllocator::drop()
+{
+    assert(s_shared_refs > 0);
+
+    if ( --s_shared_refs == 0 )
+    {
+        delete s_shared;
+        s_shared = nullptr;
+    }
+}
+
 HyperScratchAllocator::~HyperScratchAllocator()
 {
     if ( scratch )
@@ -42,6 +42,15 @@ class SO_PUBLIC HyperScratchAllocator : public ScratchAllocator
 public:
     ~HyperScratchAllocator() override;
 
+    // All hyperscan scratch users should share one allocator:
+    // hs_alloc_scratch() grows a single prototype to the maximum
+    // requirement across databases, and the engines never run
+    // concurrently within a packet thread, so one per-thread clone
+    // serves regex, sd_pattern, and literal search alike.  Each
+    // shared() must be balanced by a drop().
+    static HyperScratchAllocator* shared();
+    static void drop();
+
     bool setup(SnortConfig*) override;
     void cleanup(SnortConfig*) override;
 
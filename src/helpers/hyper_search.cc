@@ -40,13 +40,10 @@ namespace snort
 {
 
 LiteralSearch::Handle* HyperSearch::setup()
-{ return new HyperScratchAllocator; }
+{ return HyperScratchAllocator::shared(); }
 
-void HyperSearch::cleanup(LiteralSearch::Handle* h)
-{
-    HyperScratchAllocator* scratcher = (HyperScratchAllocator*)h;
-    delete scratcher;
-}
+void HyperSearch::cleanup(LiteralSearch::Handle*)
+{ HyperScratchAllocator::drop(); }
 
 //--------------------------------------------------------------------------
 
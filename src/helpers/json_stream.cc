@@ -26,6 +26,21 @@
 #include <cassert>
 #include <iomanip>
 
+// same escaping as std::quoted, done once
+JsonKey::JsonKey(const char* name)
+{
+    token += '"';
+
+    for ( const char* p = name; *p; p++ )
+    {
+        if ( *p == '"' or *p == '\\' )
+            token += '\\';
+
+        token += *p;
+    }
+    token += "\": ";
+}
+
 void JsonStream::open(const char* key)
 {
     split();
@@ -70,7 +85,7 @@ void JsonStream::put(const char* key, long val)
     if ( key )
         out << std::quoted(key) << ": ";
 
-    out << val;
+    put_int(val);
 }
 
 void JsonStream::put(const char* key, const std::string& val)
@@ -86,6 +101,50 @@ void JsonStream::put(const char* key, const std::string& val)
     out << std::quoted(val);
 }
 
+void JsonStream::put(const JsonKey& key, long val)
+{
+    split();
+    out.write(key.data(), key.size());
+    put_int(val);
+}
+
+void JsonStream::put(const JsonKey& key, const std::string& val)
+{
+    if ( val.empty() )
+        return;
+
+    split();
+    out.write(key.data(), key.size());
+    out << std::quoted(val);
+}
+
+void JsonStream::put_raw(const char* span, size_t len)
+{
+    split();
+    out.write(span, len);
+}
+
+// format digits directly; ostream insertion drags in locale-aware
+// formatting that shows up in serialization profiles
+void JsonStream::put_int(long val)
+{
+    char buf[24];
+    char* p = buf + sizeof(buf);
+    unsigned long mag = ( val < 0 ) ? -(unsigned long)val : (unsigned long)val;
+
+    do
+    {
+        *--p = '0' + (mag % 10);
+        mag /= 10;
+    }
+    while ( mag );
+
+    if ( val < 0 )
+        *--p = '-';
+
+    out.write(p, buf + sizeof(buf) - p);
+}
+
 void JsonStream::split()
 {
     if ( sep )
@@ -94,3 +153,26 @@ void JsonStream::split()
         sep = true;
 }
 
+
+#ifdef BENCHMARK_TEST
+
+#include <sstream>
+
+#include "catch/snort_catch.h"
+
+TEST_CASE("json stream speed", "[benchmark]")
+{
+    std::ostringstream ss;
+    JsonStream js(ss);
+    static const JsonKey key("pkts");
+
+    BENCHMARK("int record")
+    {
+        js.open();
+        js.put(key, 123456789L);
+        js.close();
+        ss.str("");
+    };
+}
+
+#endif
@@ -23,6 +23,24 @@
 // Simple output stream for outputting JSON data.
 
 #include <iostream>
+#include <string>
+
+// a key escaped and rendered ("key": ) once at construction so writers
+// emitting the same fields repeatedly don't re-escape them per record
+class JsonKey
+{
+public:
+    JsonKey(const char* name);
+
+    const char* data() const
+    { return token.c_str(); }
+
+    size_t size() const
+    { return token.size(); }
+
+private:
+    std::string token;
+};
 
 class JsonStream
 {
@@ -39,8 +57,15 @@ public:
     void put(const char* key, long val);
     void put(const char* key, const std::string& val);
 
+    void put(const JsonKey& key, long val);
+    void put(const JsonKey& key, const std::string& val);
+
+    // splice a pre-rendered fragment; caller guarantees valid JSON
+    void put_raw(const char* span, size_t len);
+
 private:
     void split();
+    void put_int(long val);
 
 private:
     std::ostream& out;
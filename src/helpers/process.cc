@@ -23,6 +23,7 @@
 #include "process.h"
 
 #include <fcntl.h>
+#include <unistd.h>
 
 #ifdef HAVE_LIBUNWIND
 #define UNW_LOCAL_ONLY
@@ -35,6 +36,7 @@
 #endif
 
 #include <csignal>
+#include <cstdio>
 #include <iostream>
 
 #include "log/messages.h"
@@ -556,3 +558,20 @@ void trim_heap()
     malloc_trim(0);
 #endif
 }
+
+size_t get_process_rss()
+{
+    size_t rss = 0;
+    FILE* f = fopen("/proc/self/statm", "r");
+
+    if ( f )
+    {
+        unsigned long long total, resident;
+
+        if ( fscanf(f, "%llu %llu", &total, &resident) == 2 )
+            rss = (size_t)resident * (size_t)sysconf(_SC_PAGESIZE);
+
+        fclose(f);
+    }
+    return rss;
+}
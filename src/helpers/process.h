@@ -19,6 +19,8 @@
 #ifndef PROCESS_H
 #define PROCESS_H
 
+#include <cstddef>
+
 // process oriented services like signal handling, heap info, etc.
 
 enum PigSignal
@@ -47,5 +49,8 @@ void set_main_thread();
 
 void trim_heap();
 
+// current resident set size in bytes; 0 if not supported on this platform
+size_t get_process_rss();
+
 #endif
 
@@ -89,5 +89,18 @@ TEST_CASE( "bitop", "[bitop]" )
 
         CHECK( (is_clear(bitop, k + 2) == true) );
     }
+
+    SECTION( "reset" )
+    {
+        bitop.set(3);
+        bitop.set(max - 1);
+
+        bitop.reset();
+        CHECK( (is_clear(bitop, max) == true) );
+
+        // still usable after reset
+        bitop.set(3);
+        CHECK(bitop.is_set(3));
+    }
 }
 
@@ -21,6 +21,7 @@
 #include "config.h"
 #endif
 
+#include <cstring>
 #include <sstream>
 
 #include "catch/catch.hpp"
@@ -106,6 +107,31 @@ TEST_CASE("basic", "[json_stream]")
         CHECK(ss.str() == x);
     }
 
+    SECTION("negative int")
+    {
+        js.put("i", -42);
+        const char* x = R"-("i": -42)-";
+        CHECK(ss.str() == x);
+    }
+
+    SECTION("cached key")
+    {
+        static const JsonKey k("k\"ey");
+        js.put(k, 1);
+        js.put(k, "v");
+        const char* x = R"-("k\"ey": 1, "k\"ey": "v")-";
+        CHECK(ss.str() == x);
+    }
+
+    SECTION("raw span")
+    {
+        const char* frag = R"-("r": [ 1, 2 ])-";
+        js.put("i", 0);
+        js.put_raw(frag, strlen(frag));
+        const char* x = R"-("i": 0, "r": [ 1, 2 ])-";
+        CHECK(ss.str() == x);
+    }
+
     SECTION("array list")
     {
         js.open();
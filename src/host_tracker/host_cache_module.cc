@@ -158,7 +158,9 @@ void HostCacheModule::log_host_cache(const char* file_name, bool verbose)
 
     string str;
     SfIpString ip_str;
-    const auto&& lru_data = host_cache.get_all_data();
+    // chunked walk so a dump of a large cache doesn't stall packet threads;
+    // trackers added mid-dump may be missed
+    const auto&& lru_data = host_cache.get_all_data_chunked();
     // The current size may not exactly correspond to the number of trackers seen here
     // as packet threads may continue to update cache, except when dumping upon exit or pause
     out_stream << "Current host cache size: " << host_cache.mem_size() << " bytes, "
@@ -36,14 +36,12 @@ const uint8_t snort::zero_mac[MAC_SIZE] = {0, 0, 0, 0, 0, 0};
 
 void HostTracker::update_last_seen()
 {
-    std::lock_guard<std::mutex> lck(host_tracker_lock);
     last_seen = (uint32_t) packet_time();
 }
 
 void HostTracker::update_last_event(uint32_t time)
 {
-    std::lock_guard<std::mutex> lck(host_tracker_lock);
-    last_event = time ? time : last_seen;
+    last_event = time ? time : last_seen.load();
 }
 
 bool HostTracker::add_mac(const uint8_t* mac, uint8_t ttl, uint8_t primary)
@@ -84,38 +82,75 @@ bool HostTracker::add_service(Port port, IpProtocol proto, AppId appid, bool inf
     host_tracker_stats.service_adds++;
     std::lock_guard<std::mutex> lck(host_tracker_lock);
 
-    for ( auto& s : services )
+    auto cur = std::atomic_load(&services);
+
+    if ( cur )
     {
-        if ( s.port == port and s.proto == proto )
+        for ( const auto& s : *cur )
         {
-            if ( s.appid != appid and appid != APP_ID_NONE )
+            if ( s.port == port and s.proto == proto )
             {
-                s.appid = appid;
-                s.inferred_appid = inferred_appid;
-                if (added)
-                    *added = true;
+                if ( s.appid == appid or appid == APP_ID_NONE )
+                    return true;  // nothing to change, keep the snapshot
+                break;
             }
+        }
+    }
+
+    // copy on write: readers scan the current snapshot without the lock,
+    // so changes go into a copy that is published whole
+    auto next = std::make_shared<Services>();
+
+    // size class the snapshot buffers: rounding capacity to a power of
+    // two keeps the per host vectors in a handful of allocation sizes the
+    // heap can recycle, instead of one odd sized block per service count
+    // slowly fragmenting a long uptime; it also covers the append below
+    // without a second allocation
+    size_t cap = 4;
+    const size_t need = ( cur ? cur->size() : 0 ) + 1;
+    while ( cap < need )
+        cap <<= 1;
+    next->reserve(cap);
+
+    if ( cur )
+        next->assign(cur->begin(), cur->end());
+
+    for ( auto& s : *next )
+    {
+        if ( s.port == port and s.proto == proto )
+        {
+            s.appid = appid;
+            s.inferred_appid = inferred_appid;
+            if (added)
+                *added = true;
+            std::atomic_store(&services, std::shared_ptr<const Services>(next));
             return true;
         }
     }
 
-    services.emplace_back( HostApplication{port, proto, appid, inferred_appid} );
+    next->emplace_back( HostApplication{port, proto, appid, inferred_appid} );
     if (added)
         *added = true;
 
+    std::atomic_store(&services, std::shared_ptr<const Services>(next));
     return true;
 }
 
 AppId HostTracker::get_appid(Port port, IpProtocol proto, bool inferred_only, bool allow_port_wildcard)
 {
     host_tracker_stats.service_finds++;
-    std::lock_guard<std::mutex> lck(host_tracker_lock);
 
-    for ( const auto& s : services )
+    // lock-free: scan the current published snapshot
+    const auto snap = std::atomic_load(&services);
+
+    if ( snap )
     {
-        bool matched = (s.port == port and s.proto == proto and (!inferred_only or s.inferred_appid == inferred_only));
-        if ( matched or ( allow_port_wildcard and s.inferred_appid ) )
-            return s.appid;
+        for ( const auto& s : *snap )
+        {
+            bool matched = (s.port == port and s.proto == proto and (!inferred_only or s.inferred_appid == inferred_only));
+            if ( matched or ( allow_port_wildcard and s.inferred_appid ) )
+                return s.appid;
+        }
     }
 
     return APP_ID_NONE;
@@ -156,10 +191,11 @@ void HostTracker::stringify(string& str)
         }
     }
 
-    if ( !services.empty() )
+    const auto snap = std::atomic_load(&services);
+    if ( snap and !snap->empty() )
     {
-        str += "\nservices size: " + to_string(services.size());
-        for ( const auto& s : services )
+        str += "\nservices size: " + to_string(snap->size());
+        for ( const auto& s : *snap )
         {
             str += "\n    port: " + to_string(s.port)
                 + ", proto: " + to_string((uint8_t) s.proto);
@@ -25,7 +25,9 @@
 // configuration or dynamic discovery).  It provides a thread-safe API to
 // set/get the host data.
 
+#include <atomic>
 #include <cstring>
+#include <memory>
 #include <mutex>
 #include <list>
 #include <vector>
@@ -85,17 +87,11 @@ public:
 
     void update_last_seen();
     uint32_t get_last_seen() const
-    {
-        std::lock_guard<std::mutex> lck(host_tracker_lock);
-        return last_seen;
-    }
+    { return last_seen; }
 
     void update_last_event(uint32_t time = 0);
     uint32_t get_last_event() const
-    {
-        std::lock_guard<std::mutex> lck(host_tracker_lock);
-        return last_event;
-    }
+    { return last_event; }
 
     // Returns true if a new mac entry is added, false otherwise
     bool add_mac(const uint8_t* mac, uint8_t ttl, uint8_t primary);
@@ -114,12 +110,17 @@ public:
     void stringify(std::string& str);
 
 private:
-    mutable std::mutex host_tracker_lock; // ensure that updates to a shared object are safe
+    mutable std::mutex host_tracker_lock; // serialize updates to a shared object
     uint8_t hops;                 // hops from the snort inspector, e.g., zero for ARP
-    uint32_t last_seen;           // the last time this host was seen
-    uint32_t last_event;          // the last time an event was generated
+    std::atomic<uint32_t> last_seen;   // the last time this host was seen
+    std::atomic<uint32_t> last_event;  // the last time an event was generated
     std::list<HostMac, HostMacAllocator> macs;
-    std::vector<HostApplication, HostAppAllocator> services;
+
+    // the service list is copy on write: writers build a new vector under
+    // the lock and publish it whole, so get_appid() and other readers scan
+    // the current snapshot without taking the lock
+    typedef std::vector<HostApplication, HostAppAllocator> Services;
+    std::shared_ptr<const Services> services;
 
     // Hide / delete the constructor from the outside world. We don't want to
     // have zombie host trackers, i.e. host tracker objects that live outside
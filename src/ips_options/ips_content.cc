@@ -53,6 +53,12 @@ static IpsOption::EvalStatus CheckANDPatternMatch(class ContentData*, Cursor&);
 // instance data
 //-------------------------------------------------------------------------
 
+// anchored contents verify a single candidate position, so the skip
+// table machinery is pure overhead.  for patterns up to 32 bytes a
+// branchless masked compare vectorizes into one or two wide compares
+// (SSE2/AVX2/NEON), which covers the overwhelmingly common case.
+#define CMP_MAX_SIZE 32
+
 class ContentData
 {
 public:
@@ -62,10 +68,24 @@ public:
     void setup_bm();
     void set_max_jump_size();
 
+    bool compare(const uint8_t* buf) const
+    {
+        uint8_t diff = 0;
+
+        for ( unsigned i = 0; i < pmd.pattern_size; i++ )
+            diff |= (uint8_t)((buf[i] | cmp_mask[i]) ^ cmp_pat[i]);
+
+        return diff == 0;
+    }
+
     PatternMatchData pmd = {};
 
     LiteralSearch* searcher;
 
+    uint8_t cmp_pat[CMP_MAX_SIZE];   /* case folded pattern for anchored compare */
+    uint8_t cmp_mask[CMP_MAX_SIZE];  /* 0x20 at caseless alpha positions */
+    bool cmp_ok;
+
     int8_t offset_var;      /* byte_extract variable indices for offset, */
     int8_t depth_var;       /* depth, distance, within */
 
@@ -75,6 +95,7 @@ public:
 ContentData::ContentData()
 {
     searcher = nullptr;
+    cmp_ok = false;
     offset_var = IPS_OPTIONS_NO_VAR;
     depth_var = IPS_OPTIONS_NO_VAR;
     match_delta = 0;
@@ -96,6 +117,22 @@ void ContentData::setup_bm()
 {
     const uint8_t* pattern = (const uint8_t*)pmd.pattern_buf;
     searcher = LiteralSearch::instantiate(search_handle, pattern, pmd.pattern_size, pmd.is_no_case());
+
+    cmp_ok = pmd.pattern_size <= CMP_MAX_SIZE;
+
+    if ( !cmp_ok )
+        return;
+
+    // for caseless alpha positions compare with the 0x20 case bit forced
+    // on both sides, which folds upper onto lower without a table lookup
+    for ( unsigned i = 0; i < pmd.pattern_size; i++ )
+    {
+        uint8_t b = (uint8_t)pmd.pattern_buf[i];
+        uint8_t m = (pmd.is_no_case() and isalpha(b)) ? 0x20 : 0;
+
+        cmp_mask[i] = m;
+        cmp_pat[i] = b | m;
+    }
 }
 
 // find the maximum number of characters we can jump ahead
@@ -334,7 +371,19 @@ static int uniSearchReal(ContentData* cd, Cursor& c)
     }
 
     const uint8_t* base = c.buffer() + pos;
-    int found = cd->searcher->search(search_handle, base, depth);
+    int found;
+
+    if ( cd->cmp_ok and depth == (int)cd->pmd.pattern_size )
+    {
+        // anchored: exactly one candidate position to verify
+        found = cd->compare(base) ? 0 : -1;
+        pc.content_cmp_evals++;
+    }
+    else
+    {
+        found = cd->searcher->search(search_handle, base, depth);
+        pc.content_search_evals++;
+    }
 
     if ( found >= 0 )
     {
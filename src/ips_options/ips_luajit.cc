@@ -185,6 +185,7 @@ IpsOption::EvalStatus LuaJitOption::eval(Cursor& c, Packet*)
     cursor = &c;
 
     lua_State* L = states[get_instance_id()];
+    Lua::DeferredGC::mark(L);
 
     {
         Lua::ManageStack ms(L, 1);
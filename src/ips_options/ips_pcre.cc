@@ -47,7 +47,7 @@ using namespace snort;
 #define PCRE_STUDY_JIT_COMPILE 0
 #endif
 
-#define NO_JIT // uncomment to disable JIT for Xcode
+//#define NO_JIT // uncomment to disable JIT for Xcode
 
 #ifdef NO_JIT
 #define PCRE_STUDY_FLAGS 0
@@ -57,6 +57,11 @@ using namespace snort;
 #define pcre_release(x) pcre_free_study(x)
 #endif
 
+// jit stacks need pcre_jit_exec() and friends (pcre >= 8.32)
+#if !defined(NO_JIT) && defined(PCRE_INFO_JIT)
+#define HAVE_PCRE_JIT_STACK
+#endif
+
 #define SNORT_PCRE_RELATIVE         0x00010 // relative to the end of the last match
 #define SNORT_PCRE_INVERT           0x00020 // invert detect
 #define SNORT_PCRE_ANCHORED         0x00040
@@ -70,6 +75,7 @@ struct PcreData
     pcre* re;           /* compiled regex */
     pcre_extra* pe;     /* studied regex foo */
     bool free_pe;
+    bool jit;           /* pattern was jit compiled by study */
     int options;        /* sp_pcre specific options (relative & inverse) */
     char* expression;
 };
@@ -86,6 +92,11 @@ static int s_ovector_max = -1;
 static unsigned scratch_index;
 static ScratchAllocator* scratcher = nullptr;
 
+#ifdef HAVE_PCRE_JIT_STACK
+static unsigned jit_scratch_index;
+static ScratchAllocator* jit_scratcher = nullptr;
+#endif
+
 static THREAD_LOCAL ProfileStats pcrePerfStats;
 
 //-------------------------------------------------------------------------
@@ -162,6 +173,7 @@ static void pcre_parse(const SnortConfig* sc, const char* data, PcreData* pcre_d
     char delimit = '/';
     int erroffset;
     int compile_flags = 0;
+    int study_flags = sc->pcre_jit_stack_size ? PCRE_STUDY_FLAGS : 0;
 
     if (data == nullptr)
     {
@@ -268,8 +280,8 @@ static void pcre_parse(const SnortConfig* sc, const char* data, PcreData* pcre_d
         return;
     }
 
-    /* now study it... */
-    pcre_data->pe = pcre_study(pcre_data->re, PCRE_STUDY_FLAGS, &error);
+    /* now study it... jit only pays off if we have a stack to run it on */
+    pcre_data->pe = pcre_study(pcre_data->re, study_flags, &error);
 
     if (pcre_data->pe)
     {
@@ -322,6 +334,15 @@ static void pcre_parse(const SnortConfig* sc, const char* data, PcreData* pcre_d
         return;
     }
 
+#ifdef HAVE_PCRE_JIT_STACK
+    if (pcre_data->pe)
+    {
+        int jit = 0;
+        pcre_fullinfo(pcre_data->re, pcre_data->pe, PCRE_INFO_JIT, &jit);
+        pcre_data->jit = (jit != 0);
+    }
+#endif
+
     pcre_capture(pcre_data->re, pcre_data->pe);
     pcre_check_anchored(pcre_data);
 
@@ -357,15 +378,41 @@ static bool pcre_search(
     std::vector<void *> ss = p->context->conf->state[get_instance_id()];
     assert(ss[scratch_index]);
 
-    int result = pcre_exec(
-        pcre_data->re,  /* result of pcre_compile() */
-        pcre_data->pe,  /* result of pcre_study()   */
-        (const char*)buf, /* the subject string */
-        len,            /* the length of the subject string */
-        start_offset,   /* start at offset 0 in the subject */
-        0,              /* options(handled at compile time */
-        (int*)ss[scratch_index], /* vector for substring information */
-        p->context->conf->pcre_ovector_size); /* number of elements in the vector */
+    int result;
+
+#ifdef HAVE_PCRE_JIT_STACK
+    if (pcre_data->jit && ss[jit_scratch_index])
+    {
+        // jit compiled patterns run on the persistent per thread stack
+        // instead of the small one pcre allocates internally per call
+        result = pcre_jit_exec(
+            pcre_data->re,
+            pcre_data->pe,
+            (const char*)buf,
+            len,
+            start_offset,
+            0,
+            (int*)ss[scratch_index],
+            p->context->conf->pcre_ovector_size,
+            (pcre_jit_stack*)ss[jit_scratch_index]);
+
+        pc.pcre_jit_evals++;
+    }
+    else
+#endif
+    {
+        result = pcre_exec(
+            pcre_data->re,  /* result of pcre_compile() */
+            pcre_data->pe,  /* result of pcre_study()   */
+            (const char*)buf, /* the subject string */
+            len,            /* the length of the subject string */
+            start_offset,   /* start at offset 0 in the subject */
+            0,              /* options(handled at compile time */
+            (int*)ss[scratch_index], /* vector for substring information */
+            p->context->conf->pcre_ovector_size); /* number of elements in the vector */
+
+        pc.pcre_interp_evals++;
+    }
 
     if (result >= 0)
     {
@@ -620,6 +667,7 @@ struct PcreStats
     PegCount pcre_to_hyper;
 #endif
     PegCount pcre_native;
+    PegCount pcre_jit;
     PegCount pcre_negated;
 };
 
@@ -630,6 +678,7 @@ const PegInfo pcre_pegs[] =
     { CountType::SUM, "pcre_to_hyper", "total pcre rules by hyperscan engine" },
 #endif
     { CountType::SUM, "pcre_native", "total pcre rules compiled by pcre engine" },
+    { CountType::SUM, "pcre_jit", "total pcre rules jit compiled" },
     { CountType::SUM, "pcre_negated", "total pcre rules using negation syntax" },
     { CountType::END, nullptr, nullptr }
 };
@@ -647,12 +696,20 @@ public:
         data = nullptr;
         scratcher = new SimpleScratchAllocator(scratch_setup, scratch_cleanup);
         scratch_index = scratcher->get_id();
+
+#ifdef HAVE_PCRE_JIT_STACK
+        jit_scratcher = new SimpleScratchAllocator(jit_scratch_setup, jit_scratch_cleanup);
+        jit_scratch_index = jit_scratcher->get_id();
+#endif
     }
 
     ~PcreModule() override
     {
         delete data;
         delete scratcher;
+#ifdef HAVE_PCRE_JIT_STACK
+        delete jit_scratcher;
+#endif
     }
 
 #ifdef HAVE_HYPERSCAN
@@ -682,6 +739,11 @@ private:
 
     static bool scratch_setup(SnortConfig*);
     static void scratch_cleanup(SnortConfig*);
+
+#ifdef HAVE_PCRE_JIT_STACK
+    static bool jit_scratch_setup(SnortConfig*);
+    static void jit_scratch_cleanup(SnortConfig*);
+#endif
 };
 
 PcreData* PcreModule::get_data()
@@ -773,6 +835,36 @@ void PcreModule::scratch_cleanup(SnortConfig* sc)
     }
 }
 
+#ifdef HAVE_PCRE_JIT_STACK
+bool PcreModule::jit_scratch_setup(SnortConfig* sc)
+{
+    if ( sc->pcre_jit_stack_size <= 0 )
+        return false;
+
+    long start_size = 32 * 1024;
+
+    if ( start_size > sc->pcre_jit_stack_size )
+        start_size = sc->pcre_jit_stack_size;
+
+    for ( unsigned i = 0; i < sc->num_slots; ++i )
+    {
+        std::vector<void *>& ss = sc->state[i];
+        ss[jit_scratch_index] = pcre_jit_stack_alloc(start_size, sc->pcre_jit_stack_size);
+    }
+    return true;
+}
+
+void PcreModule::jit_scratch_cleanup(SnortConfig* sc)
+{
+    for ( unsigned i = 0; i < sc->num_slots; ++i )
+    {
+        std::vector<void *>& ss = sc->state[i];
+        pcre_jit_stack_free((pcre_jit_stack*)ss[jit_scratch_index]);
+        ss[jit_scratch_index] = nullptr;
+    }
+}
+#endif
+
 //-------------------------------------------------------------------------
 // api methods
 //-------------------------------------------------------------------------
@@ -803,6 +895,10 @@ static IpsOption* pcre_ctor(Module* p, OptTreeNode* otn)
     {
         pcre_stats.pcre_native++;
         PcreData* d = m->get_data();
+
+        if ( d and d->jit )
+            pcre_stats.pcre_jit++;
+
         return new PcreOption(d);
     }
 }
@@ -226,7 +226,7 @@ class RegexModule : public Module
 {
 public:
     RegexModule() : Module(s_name, s_help, s_params)
-    { scratcher = new HyperScratchAllocator; }
+    { scratcher = HyperScratchAllocator::shared(); }
 
     ~RegexModule() override;
 
@@ -256,7 +256,8 @@ RegexModule::~RegexModule()
     if ( config.db )
         hs_free_database(config.db);
 
-    delete scratcher;
+    HyperScratchAllocator::drop();
+    scratcher = nullptr;
 }
 
 bool RegexModule::begin(const char* name, int, SnortConfig*)
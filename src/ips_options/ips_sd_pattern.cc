@@ -294,10 +294,13 @@ class SdPatternModule : public Module
 {
 public:
     SdPatternModule() : Module(s_name, s_help, s_params)
-    { scratcher = new HyperScratchAllocator; }
+    { scratcher = HyperScratchAllocator::shared(); }
 
     ~SdPatternModule() override
-    { delete scratcher; }
+    {
+        HyperScratchAllocator::drop();
+        scratcher = nullptr;
+    }
 
     bool begin(const char*, int, SnortConfig*) override;
     bool set(const char*, Value& v, SnortConfig*) override;
@@ -61,11 +61,25 @@ static const Parameter s_packet_params[] =
     { nullptr, Parameter::PT_MAX, nullptr, nullptr, nullptr }
 };
 
+static const Parameter s_rule_service_params[] =
+{
+    { "name", Parameter::PT_STRING, nullptr, nullptr,
+        "service name as given in rules" },
+
+    { "max_time", Parameter::PT_INT, "1:max53", "500",
+        "set timeout for rules matching this service (usec)" },
+
+    { nullptr, Parameter::PT_MAX, nullptr, nullptr, nullptr }
+};
+
 static const Parameter s_rule_params[] =
 {
     { "max_time", Parameter::PT_INT, "0:max53", "500",
         "set timeout for rule evaluation (usec)" },
 
+    { "services", Parameter::PT_LIST, s_rule_service_params, nullptr,
+        "per service rule eval timeouts overriding max_time" },
+
     // We could just treat suspend_threshold == 0 as suspend == false
     // but we leave this here for parity with packet latency
     { "suspend", Parameter::PT_BOOL, nullptr, "false",
@@ -183,12 +197,42 @@ const TraceOption* LatencyModule::get_trace_options() const
     return &latency_trace_options;
 }
 
+bool LatencyModule::begin(const char* fqn, int idx, SnortConfig* sc)
+{
+    if ( idx and !strcmp(fqn, "latency.rule.services") )
+        sc->latency->rule_latency.service_budgets.emplace_back("", 0_ticks);
+
+    return true;
+}
+
 bool LatencyModule::set(const char* fqn, Value& v, SnortConfig* sc)
 {
     const char* slp = "latency.packet";
     const char* slr = "latency.rule";
+    const char* sls = "latency.rule.services";
+
+    if ( !strncmp(fqn, sls, strlen(sls)) )
+    {
+        auto& budgets = sc->latency->rule_latency.service_budgets;
+
+        if ( budgets.empty() )
+            return false;
+
+        if ( v.is("name") )
+            budgets.back().first = v.get_string();
+
+        else if ( v.is("max_time") )
+        {
+            long t = clock_ticks(v.get_uint64());
+            budgets.back().second = TO_DURATION(budgets.back().second, t);
+        }
+        else
+            return false;
+
+        return true;
+    }
 
-    if ( !strncmp(fqn, slp, strlen(slp)) )
+    else if ( !strncmp(fqn, slp, strlen(slp)) )
         return latency_set(v, sc->latency->packet_latency);
 
     else if ( !strncmp(fqn, slr, strlen(slr)) )
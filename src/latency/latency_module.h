@@ -28,6 +28,7 @@ class LatencyModule : public snort::Module
 public:
     LatencyModule();
 
+    bool begin(const char*, int, snort::SnortConfig*) override;
     bool set(const char*, snort::Value&, snort::SnortConfig*) override;
 
     const snort::RuleMap* get_rules() const override;
@@ -72,8 +72,9 @@ class RuleTimer : public LatencyTimer<Clock>
 {
 public:
     RuleTimer(typename Clock::duration d, detection_option_tree_root_t* root, Packet* p) :
-        LatencyTimer<Clock>(d), root(root), packet(p) { }
+        LatencyTimer<Clock>(d), budget(d), root(root), packet(p) { }
 
+    typename Clock::duration budget;
     detection_option_tree_root_t* root;
     Packet* packet;
 };
@@ -222,8 +223,12 @@ inline bool Impl<Clock, RuleTree>::push(detection_option_tree_root_t* root, Pack
 {
     assert(root and p);
 
+    // a per service budget stamped on the root overrides the global limit
+    typename Clock::duration budget = (root->latency_budget != DURA_ZERO) ?
+        typename Clock::duration(root->latency_budget) : config->max_time;
+
     // FIXIT-L rule timer is pushed even if rule is not enabled (no visible side-effects)
-    timers.emplace_back(config->max_time, root, p);
+    timers.emplace_back(budget, root, p);
 
     if ( config->allow_reenable() )
     {
@@ -246,7 +251,8 @@ inline bool Impl<Clock, RuleTree>::pop()
 
     bool timed_out = false;
 
-    if ( !RuleTree::is_suspended(*timer.root) )
+    // a zero budget (only some services are limited) never times out
+    if ( timer.budget != DURA_ZERO and !RuleTree::is_suspended(*timer.root) )
     {
         timed_out = timer.timed_out();
 #ifdef REG_TEST
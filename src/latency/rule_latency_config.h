@@ -21,11 +21,20 @@
 #ifndef RULE_LATENCY_CONFIG_H
 #define RULE_LATENCY_CONFIG_H
 
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "time/clock_defs.h"
 
 struct RuleLatencyConfig
 {
     hr_duration max_time = 0_ticks;
+
+    // per service budgets overriding max_time; stamped onto rule tree
+    // roots when fast patterns are compiled, so lookups are free at eval
+    std::vector<std::pair<std::string, hr_duration>> service_budgets;
+
     bool suspend = false;
     unsigned suspend_threshold = 0;
     hr_duration max_suspend_time = 0_ticks;
@@ -39,7 +48,7 @@ struct RuleLatencyConfig
         if ( test_timeout )
             return true;
 #endif
-        return max_time > 0_ticks;
+        return max_time > 0_ticks or !service_budgets.empty();
     }
     bool allow_reenable() const { return max_suspend_time > 0_ticks; }
 };
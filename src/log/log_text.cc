@@ -260,49 +260,37 @@ static void LogIpOptions(TextLog* log, const ip::IP4Hdr* ip4h, const Packet* con
  */
 void LogIpAddrs(TextLog* log, Packet* p)
 {
-    if ( p->is_fragment() || (!p->is_tcp() && !p->is_udp() && !p->is_data()) )
-    {
-        const char* ip_fmt = "%s -> %s";
-        InetBuf src, dst;
-
-        if (p->context->conf->obfuscate())
-        {
-            ObfuscateIpToText(p->ptrs.ip_api.get_src(),
-                p->context->conf->homenet, p->context->conf->obfuscation_net, src);
+    InetBuf src, dst;
 
-            ObfuscateIpToText(p->ptrs.ip_api.get_dst(),
-                p->context->conf->homenet, p->context->conf->obfuscation_net, dst);
+    if (p->context->conf->obfuscate())
+    {
+        ObfuscateIpToText(p->ptrs.ip_api.get_src(),
+            p->context->conf->homenet, p->context->conf->obfuscation_net, src);
 
-            TextLog_Print(log, ip_fmt, src, dst);
-        }
-        else
-        {
-            TextLog_Print(log, ip_fmt,
-                sfip_ntop(p->ptrs.ip_api.get_src(), src, sizeof(src)),
-                sfip_ntop(p->ptrs.ip_api.get_dst(), dst, sizeof(dst)));
-        }
+        ObfuscateIpToText(p->ptrs.ip_api.get_dst(),
+            p->context->conf->homenet, p->context->conf->obfuscation_net, dst);
     }
     else
     {
-        const char* ip_fmt = "%s:%d -> %s:%d";
-        InetBuf src, dst;
-
-        if (p->context->conf->obfuscate())
-        {
-            ObfuscateIpToText(p->ptrs.ip_api.get_src(),
-                p->context->conf->homenet, p->context->conf->obfuscation_net, src);
-
-            ObfuscateIpToText(p->ptrs.ip_api.get_dst(),
-                p->context->conf->homenet, p->context->conf->obfuscation_net, dst);
+        sfip_ntop(p->ptrs.ip_api.get_src(), src, sizeof(src));
+        sfip_ntop(p->ptrs.ip_api.get_dst(), dst, sizeof(dst));
+    }
 
-            TextLog_Print(log, ip_fmt, src, p->ptrs.sp, dst, p->ptrs.dp);
-        }
-        else
-        {
-            TextLog_Print(log, ip_fmt,
-                sfip_ntop(p->ptrs.ip_api.get_src(), src, sizeof(src)), p->ptrs.sp,
-                sfip_ntop(p->ptrs.ip_api.get_dst(), dst, sizeof(dst)), p->ptrs.dp);
-        }
+    if ( p->is_fragment() || (!p->is_tcp() && !p->is_udp() && !p->is_data()) )
+    {
+        TextLog_Puts(log, src);
+        TextLog_Puts(log, " -> ");
+        TextLog_Puts(log, dst);
+    }
+    else
+    {
+        TextLog_Puts(log, src);
+        TextLog_Putc(log, ':');
+        TextLog_PutUnsigned(log, p->ptrs.sp);
+        TextLog_Puts(log, " -> ");
+        TextLog_Puts(log, dst);
+        TextLog_Putc(log, ':');
+        TextLog_PutUnsigned(log, p->ptrs.dp);
     }
 }
 
@@ -343,13 +331,17 @@ void LogIPHeader(TextLog* log, Packet* p)
         const ip::IP6Hdr* const ip6h = p->ptrs.ip_api.get_ip6h(); // nullptr if ipv4
         const ip::IP6Frag* const ip6_frag = layer::get_inner_ip6_frag();
 
-        TextLog_Print(log, "%s TTL:%u TOS:0x%X ID:%u IpLen:%u DgmLen:%u",
-            protocol_names[to_utype(p->get_ip_proto_next())],
-            ip6h->hop_lim(),
-            ip6h->tos(),
-            (ip6_frag ? ip6_frag->id() : 0),
-            ip::IP6_HEADER_LEN,
-            (ip6h->len() + ip::IP6_HEADER_LEN));
+        TextLog_Puts(log, protocol_names[to_utype(p->get_ip_proto_next())]);
+        TextLog_Puts(log, " TTL:");
+        TextLog_PutUnsigned(log, ip6h->hop_lim());
+        TextLog_Puts(log, " TOS:");
+        TextLog_PutHex(log, ip6h->tos());
+        TextLog_Puts(log, " ID:");
+        TextLog_PutUnsigned(log, ip6_frag ? ip6_frag->id() : 0);
+        TextLog_Puts(log, " IpLen:");
+        TextLog_PutUnsigned(log, ip::IP6_HEADER_LEN);
+        TextLog_Puts(log, " DgmLen:");
+        TextLog_PutUnsigned(log, ip6h->len() + ip::IP6_HEADER_LEN);
 
         if (!ip6_frag)
         {
@@ -368,13 +360,17 @@ void LogIPHeader(TextLog* log, Packet* p)
     }
     else
     {
-        TextLog_Print(log, "%s TTL:%u TOS:0x%X ID:%u IpLen:%u DgmLen:%u",
-            protocol_names[to_utype(ip4h->proto())],
-            ip4h->ttl(),
-            ip4h->tos(),
-            ip4h->id(),
-            ip4h->hlen(),
-            ip4h->len());
+        TextLog_Puts(log, protocol_names[to_utype(ip4h->proto())]);
+        TextLog_Puts(log, " TTL:");
+        TextLog_PutUnsigned(log, ip4h->ttl());
+        TextLog_Puts(log, " TOS:");
+        TextLog_PutHex(log, ip4h->tos());
+        TextLog_Puts(log, " ID:");
+        TextLog_PutUnsigned(log, ip4h->id());
+        TextLog_Puts(log, " IpLen:");
+        TextLog_PutUnsigned(log, ip4h->hlen());
+        TextLog_Puts(log, " DgmLen:");
+        TextLog_PutUnsigned(log, ip4h->len());
 
         if (ip4h->rb())
             TextLog_Puts(log, " RB");
@@ -469,7 +465,8 @@ static void LogTcpOptions(TextLog* log, const tcp::TcpOptIterator& opt_iter)
         switch (opt.code)
         {
         case tcp::TcpOptCode::MAXSEG:
-            TextLog_Print(log, " MSS: %u", extract_16_bits(opt.data));
+            TextLog_Puts(log, " MSS: ");
+            TextLog_PutUnsigned(log, extract_16_bits(opt.data));
             break;
 
         case tcp::TcpOptCode::EOL:
@@ -481,7 +478,8 @@ static void LogTcpOptions(TextLog* log, const tcp::TcpOptIterator& opt_iter)
             break;
 
         case tcp::TcpOptCode::WSCALE:
-            TextLog_Print(log, " WS: %u", opt.data[0]);
+            TextLog_Puts(log, " WS: ");
+            TextLog_PutUnsigned(log, opt.data[0]);
             break;
 
         case tcp::TcpOptCode::SACK:
@@ -505,7 +503,10 @@ static void LogTcpOptions(TextLog* log, const tcp::TcpOptIterator& opt_iter)
                 val2 = 0;
             }
 
-            TextLog_Print(log, " Sack: %u@%u", val1, val2);
+            TextLog_Puts(log, " Sack: ");
+            TextLog_PutUnsigned(log, val1);
+            TextLog_Putc(log, '@');
+            TextLog_PutUnsigned(log, val2);
             break;
         }
         case tcp::TcpOptCode::SACKOK:
@@ -521,8 +522,10 @@ static void LogTcpOptions(TextLog* log, const tcp::TcpOptIterator& opt_iter)
             break;
 
         case tcp::TcpOptCode::TIMESTAMP:
-            TextLog_Print(log, " TS: %u %u", extract_32_bits(opt.data),
-                extract_32_bits(opt.data + 4));
+            TextLog_Puts(log, " TS: ");
+            TextLog_PutUnsigned(log, extract_32_bits(opt.data));
+            TextLog_Putc(log, ' ');
+            TextLog_PutUnsigned(log, extract_32_bits(opt.data + 4));
             break;
 
         case tcp::TcpOptCode::CC:
@@ -585,19 +588,21 @@ void LogTCPHeader(TextLog* log, Packet* p)
     TextLog_Puts(log, tcpFlags); /* We don't care about the NULL */
 
     /* print other TCP info */
-    TextLog_Print(log, " Seq: 0x%lX  Ack: 0x%lX  Win: 0x%X  TcpLen: %d",
-        (u_long)ntohl(tcph->th_seq),
-        (u_long)ntohl(tcph->th_ack),
-        ntohs(tcph->th_win), tcph->off());
+    TextLog_Puts(log, " Seq: ");
+    TextLog_PutHex(log, ntohl(tcph->th_seq));
+    TextLog_Puts(log, "  Ack: ");
+    TextLog_PutHex(log, ntohl(tcph->th_ack));
+    TextLog_Puts(log, "  Win: ");
+    TextLog_PutHex(log, ntohs(tcph->th_win));
+    TextLog_Puts(log, "  TcpLen: ");
+    TextLog_PutUnsigned(log, tcph->off());
 
     if ((tcph->th_flags & TH_URG) != 0)
     {
-        TextLog_Print(log, "  UrgPtr: 0x%X\n", tcph->urp());
-    }
-    else
-    {
-        TextLog_NewLine(log);
+        TextLog_Puts(log, "  UrgPtr: ");
+        TextLog_PutHex(log, tcph->urp());
     }
+    TextLog_NewLine(log);
 
     /* dump the TCP options */
     if (tcph->has_options())
@@ -786,7 +791,11 @@ void LogICMPHeader(TextLog* log, Packet* p)
         return;
     }
 
-    TextLog_Print(log, "Type:%d  Code:%d  ", p->ptrs.icmph->type, p->ptrs.icmph->code);
+    TextLog_Puts(log, "Type:");
+    TextLog_PutUnsigned(log, p->ptrs.icmph->type);
+    TextLog_Puts(log, "  Code:");
+    TextLog_PutUnsigned(log, p->ptrs.icmph->code);
+    TextLog_Puts(log, "  ");
 
     switch (p->ptrs.icmph->type)
     {
@@ -1330,13 +1339,10 @@ void LogPayload(TextLog* log, Packet* p)
         {
             if ( p->obfuscator )
             {
-                // FIXIT-P avoid string copy
-                std::string buf((const char*)p->data, p->dsize);
-
-                for ( const auto& b : *p->obfuscator )
-                    buf.replace(b.offset, b.length, b.length, p->obfuscator->get_mask_char());
-
-                LogNetData(log, (const uint8_t*)buf.c_str(), p->dsize, p);
+                char* buf = (char*)snort_alloc(p->dsize);
+                p->obfuscator->apply(buf, (const char*)p->data, p->dsize);
+                LogNetData(log, (const uint8_t*)buf, p->dsize, p);
+                snort_free(buf);
             }
             else
             {
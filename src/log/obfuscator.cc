@@ -24,6 +24,8 @@
 
 #include "obfuscator.h"
 
+#include <cstring>
+
 using namespace snort;
 
 bool Obfuscator::first(ObfuscatorBlock &b)
@@ -47,3 +49,23 @@ bool Obfuscator::next(ObfuscatorBlock &b)
     return true;
 }
 
+void Obfuscator::apply(char* dst, const char* src, size_t len) const
+{
+    memcpy(dst, src, len);
+
+    // the set keeps blocks sorted by offset so one forward pass covers
+    // everything; memset gives us a vectorized fill for each masked run
+    for ( const auto& b : blocks )
+    {
+        if ( b.offset >= len )
+            break;
+
+        size_t n = b.length;
+
+        if ( b.offset + n > len )
+            n = len - b.offset;
+
+        memset(dst + b.offset, mask_char, n);
+    }
+}
+
@@ -68,6 +68,10 @@ public:
     bool first(ObfuscatorBlock &b);
     bool next(ObfuscatorBlock &b);
 
+    // copy src to dst and mask all blocks intersecting [0, len)
+    // in one pass; blocks beyond len are clamped or skipped
+    void apply(char* dst, const char* src, size_t len) const;
+
     char get_mask_char()
     { return mask_char; }
 
@@ -210,6 +210,59 @@ TEST(ObfuscatorTests, Overlaps)
     }
 }
 
+TEST(ObfuscatorTests, Apply_Blocks_with_Gaps)
+{
+    char buf[70];
+    memset(buf, 'A', sizeof(buf)-1);
+    buf[ sizeof(buf)-1 ] = '\0';
+
+    Obfuscator ob;
+
+    ob.push(0, 10);
+    ob.push(20, 10);
+    ob.push(40, sizeof(buf)-40-1);
+
+    char out[sizeof(buf)];
+    ob.apply(out, buf, sizeof(buf));
+
+    const char buf2[70] = "XXXXXXXXXXAAAAAAAAAAXXXXXXXXXXAAAAAAAAAAXXXXXXXXXXXXXXXXXXXXXXXXXXXXX";
+    CHECK_TRUE(memcmp(out, buf2, sizeof(out)) == 0);
+}
+
+TEST(ObfuscatorTests, Apply_Clamps_to_Length)
+{
+    char buf[70];
+    memset(buf, 'A', sizeof(buf)-1);
+    buf[ sizeof(buf)-1 ] = '\0';
+
+    Obfuscator ob;
+
+    ob.push(60, 100);   // runs past the buffer; masked to the end only
+    ob.push(100, 10);   // entirely beyond the buffer; skipped
+
+    char out[sizeof(buf)];
+    ob.apply(out, buf, sizeof(buf));
+
+    CHECK_TRUE(memcmp(out, buf, 60) == 0);
+
+    for ( unsigned i = 60; i < sizeof(out); i++ )
+        CHECK_TRUE(out[i] == 'X');
+}
+
+TEST(ObfuscatorTests, Apply_Empty)
+{
+    char buf[70];
+    memset(buf, 'A', sizeof(buf)-1);
+    buf[ sizeof(buf)-1 ] = '\0';
+
+    Obfuscator ob;
+
+    char out[sizeof(buf)];
+    ob.apply(out, buf, sizeof(buf));
+
+    CHECK_TRUE(memcmp(out, buf, sizeof(out)) == 0);
+}
+
 int main(int argc, char* argv[])
 {
     return CommandLineTestRunner::RunAllTests(argc, argv);
@@ -198,6 +198,80 @@ bool TextLog_Flush(TextLog* const txt)
     return false;
 }
 
+/*-------------------------------------------------------------------
+ * TextLog_Reserve/Commit: format directly into the buffer
+ *-------------------------------------------------------------------
+ */
+char* TextLog_Reserve(TextLog* const txt, unsigned n)
+{
+    if ( (int)n > TextLog_Avail(txt) )
+    {
+        TextLog_Flush(txt);
+
+        if ( (int)n > TextLog_Avail(txt) )
+            return nullptr;
+    }
+    return txt->buf + txt->pos;
+}
+
+void TextLog_Commit(TextLog* const txt, unsigned n)
+{
+    txt->pos += n;
+    txt->buf[txt->pos] = '\0';
+}
+
+/*-------------------------------------------------------------------
+ * TextLog_PutUnsigned/PutHex: emit numbers w/o printf parsing
+ *-------------------------------------------------------------------
+ */
+bool TextLog_PutUnsigned(TextLog* const txt, uint64_t n)
+{
+    const unsigned max_digits = 20;
+    char* out = TextLog_Reserve(txt, max_digits);
+
+    if ( !out )
+        return false;
+
+    char tmp[max_digits];
+    unsigned i = max_digits;
+
+    do
+    {
+        tmp[--i] = '0' + (n % 10);
+        n /= 10;
+    }
+    while ( n );
+
+    memcpy(out, tmp + i, max_digits - i);
+    TextLog_Commit(txt, max_digits - i);
+    return true;
+}
+
+bool TextLog_PutHex(TextLog* const txt, uint64_t n)
+{
+    const unsigned max_digits = 16;
+    char* out = TextLog_Reserve(txt, max_digits + 2);
+
+    if ( !out )
+        return false;
+
+    char tmp[max_digits];
+    unsigned i = max_digits;
+
+    do
+    {
+        tmp[--i] = "0123456789ABCDEF"[n & 0xf];
+        n >>= 4;
+    }
+    while ( n );
+
+    out[0] = '0';
+    out[1] = 'x';
+    memcpy(out + 2, tmp + i, max_digits - i);
+    TextLog_Commit(txt, max_digits - i + 2);
+    return true;
+}
+
 /*-------------------------------------------------------------------
  * TextLog_Putc: append char to buffer
  *-------------------------------------------------------------------
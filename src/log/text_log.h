@@ -34,6 +34,7 @@
  * name plus a timestamp.
  */
 
+#include <cstdint>
 #include <cstring>
 
 #include "main/snort_types.h"
@@ -60,6 +61,16 @@ SO_PUBLIC bool TextLog_Print(TextLog* const, const char* format, ...);
 SO_PUBLIC bool TextLog_Flush(TextLog* const);
 SO_PUBLIC int TextLog_Avail(TextLog* const);
 SO_PUBLIC void TextLog_Reset(TextLog* const);
+
+// fast path for hot dumpers: reserve n bytes of buffer space to format
+// into directly, then commit however much was actually used (<= n);
+// reserve returns nullptr only if n exceeds the whole buffer
+SO_PUBLIC char* TextLog_Reserve(TextLog* const, unsigned n);
+SO_PUBLIC void TextLog_Commit(TextLog* const, unsigned n);
+
+// formatting helpers that skip printf format parsing
+SO_PUBLIC bool TextLog_PutUnsigned(TextLog* const, uint64_t);
+SO_PUBLIC bool TextLog_PutHex(TextLog* const, uint64_t);  // as 0x%X
 } // namespace snort
 
 /*-------------------------------------------------------------------
@@ -42,6 +42,7 @@
 #define UNIFIED2_IDS_EVENT_IPV6_VLAN 105  // legacy_events
 #define UNIFIED2_EXTRA_DATA          110
 #define UNIFIED2_EVENT3              114
+#define UNIFIED2_EVENT3_COMPACT      115  // compact = true
 
 #define MAX_EVENT_APPNAME_LEN         64
 
@@ -92,6 +93,29 @@ struct Unified2Event
     char app_name[MAX_EVENT_APPNAME_LEN];
 };
 
+// UNIFIED2_EVENT3_COMPACT = type 115
+//
+// same fields as Unified2Event but variable length.  varints are LEB128
+// (low 7 bits first, high bit continues); "delta" fields are the zigzag
+// encoded difference from the same field of the previous compact record
+// in the same file (zero before the first record and after rotation), so
+// repeated values like snort_id and the policy ids cost one byte.
+//
+// body layout:
+//   delta:  snort_id, event_id, event_second
+//   varint: event_microsecond
+//   delta:  rule_gid, rule_sid
+//   varint: rule_rev, rule_class, rule_priority
+//   delta:  policy_id_context, policy_id_inspect, policy_id_detect
+//   byte:   pkt_ip_ver
+//   raw:    src addr (16 bytes if src nybble is 6, else 4), dst addr same
+//   varint: src_port_itype, dst_port_icode, vlan_id, mpls_label
+//   byte:   pkt_ip_proto, snort_status, snort_action
+//   varint: app_name length, followed by that many bytes (no terminator)
+//
+// multibyte raw values keep the network byte order of Unified2Event;
+// varint and delta fields are encoded from host order values.
+
 // UNIFIED2_IDS_EVENT_VLAN = type 104
 struct Unified2IDSEvent
 {
@@ -69,20 +69,20 @@ struct Args
     Packet* pkt;
     const char* msg;
     const Event& event;
-    bool comma;
+    const char* label;
 };
 
-static void print_label(const Args& a, const char* label)
+// labels are compiled at config time into the full key prefix (leading
+// comma included for all but the first field) so emitting one is a single
+// buffer copy instead of per-event printf formatting
+static void print_label(const Args& a)
 {
-    if ( a.comma )
-        TextLog_Print(json_log, ",");
-
-    TextLog_Print(json_log, " \"%s\" : ", label);
+    TextLog_Puts(json_log, a.label);
 }
 
 static bool ff_action(const Args& a)
 {
-    print_label(a, "action");
+    print_label(a);
     TextLog_Quote(json_log, a.pkt->active->get_action_string());
     return true;
 }
@@ -94,7 +94,7 @@ static bool ff_class(const Args& a)
     if ( a.event.sig_info->class_type and !a.event.sig_info->class_type->text.empty() )
         cls = a.event.sig_info->class_type->text.c_str();
 
-    print_label(a, "class");
+    print_label(a);
     TextLog_Quote(json_log, cls);
     return true;
 }
@@ -111,7 +111,7 @@ static bool ff_b64_data(const Args& a)
     unsigned nin = 0;
     Base64Encoder b64;
 
-    print_label(a, "b64_data");
+    print_label(a);
     TextLog_Putc(json_log, '"');
 
     while ( nin < a.pkt->dsize )
@@ -133,7 +133,7 @@ static bool ff_client_bytes(const Args& a)
 {
     if (a.pkt->flow)
     {
-        print_label(a, "client_bytes");
+        print_label(a);
         TextLog_Print(json_log, "%" PRIu64, a.pkt->flow->flowstats.client_bytes);
         return true;
     }
@@ -144,7 +144,7 @@ static bool ff_client_pkts(const Args& a)
 {
     if (a.pkt->flow)
     {
-        print_label(a, "client_pkts");
+        print_label(a);
         TextLog_Print(json_log, "%" PRIu64, a.pkt->flow->flowstats.client_pkts);
         return true;
     }
@@ -162,7 +162,7 @@ static bool ff_dir(const Args& a)
     else
         dir = "UNK";
 
-    print_label(a, "dir");
+    print_label(a);
     TextLog_Quote(json_log, dir);
     return true;
 }
@@ -172,7 +172,7 @@ static bool ff_dst_addr(const Args& a)
     if ( a.pkt->has_ip() or a.pkt->is_data() )
     {
         SfIpString ip_str;
-        print_label(a, "dst_addr");
+        print_label(a);
         TextLog_Quote(json_log, a.pkt->ptrs.ip_api.get_dst()->ntop(ip_str));
         return true;
     }
@@ -190,7 +190,7 @@ static bool ff_dst_ap(const Args& a)
     if ( a.pkt->proto_bits & (PROTO_BIT__TCP|PROTO_BIT__UDP) )
         port = a.pkt->ptrs.dp;
 
-    print_label(a, "dst_ap");
+    print_label(a);
     TextLog_Print(json_log, "\"%s:%u\"", addr, port);
     return true;
 }
@@ -199,7 +199,7 @@ static bool ff_dst_port(const Args& a)
 {
     if ( a.pkt->proto_bits & (PROTO_BIT__TCP|PROTO_BIT__UDP) )
     {
-        print_label(a, "dst_port");
+        print_label(a);
         TextLog_Print(json_log, "%u", a.pkt->ptrs.dp);
         return true;
     }
@@ -211,7 +211,7 @@ static bool ff_eth_dst(const Args& a)
     if ( !(a.pkt->proto_bits & PROTO_BIT__ETH) )
         return false;
 
-    print_label(a, "eth_dst");
+    print_label(a);
     const eth::EtherHdr* eh = layer::get_eth_layer(a.pkt);
 
     TextLog_Print(json_log, "\"%02X:%02X:%02X:%02X:%02X:%02X\"", eh->ether_dst[0],
@@ -226,7 +226,7 @@ static bool ff_eth_len(const Args& a)
     if ( !(a.pkt->proto_bits & PROTO_BIT__ETH) )
         return false;
 
-    print_label(a, "eth_len");
+    print_label(a);
     TextLog_Print(json_log, "%u", a.pkt->pkth->pktlen);
     return true;
 }
@@ -236,7 +236,7 @@ static bool ff_eth_src(const Args& a)
     if ( !(a.pkt->proto_bits & PROTO_BIT__ETH) )
         return false;
 
-    print_label(a, "eth_src");
+    print_label(a);
     const eth::EtherHdr* eh = layer::get_eth_layer(a.pkt);
 
     TextLog_Print(json_log, "\"%02X:%02X:%02X:%02X:%02X:%02X\"", eh->ether_src[0],
@@ -252,7 +252,7 @@ static bool ff_eth_type(const Args& a)
 
     const eth::EtherHdr* eh = layer::get_eth_layer(a.pkt);
 
-    print_label(a, "eth_type");
+    print_label(a);
     TextLog_Print(json_log, "\"0x%X\"", ntohs(eh->ether_type));
     return true;
 }
@@ -261,7 +261,7 @@ static bool ff_flowstart_time(const Args& a)
 {
     if (a.pkt->flow)
     {
-        print_label(a, "flowstart_time");
+        print_label(a);
         TextLog_Print(json_log, "%lu", a.pkt->flow->flowstats.start_time.tv_sec);
         return true;
     }
@@ -270,7 +270,7 @@ static bool ff_flowstart_time(const Args& a)
 
 static bool ff_gid(const Args& a)
 {
-    print_label(a, "gid");
+    print_label(a);
     TextLog_Print(json_log, "%u",  a.event.sig_info->gid);
     return true;
 }
@@ -279,7 +279,7 @@ static bool ff_icmp_code(const Args& a)
 {
     if (a.pkt->ptrs.icmph )
     {
-        print_label(a, "icmp_code");
+        print_label(a);
         TextLog_Print(json_log, "%u", a.pkt->ptrs.icmph->code);
         return true;
     }
@@ -290,7 +290,7 @@ static bool ff_icmp_id(const Args& a)
 {
     if (a.pkt->ptrs.icmph )
     {
-        print_label(a, "icmp_id");
+        print_label(a);
         TextLog_Print(json_log, "%u", ntohs(a.pkt->ptrs.icmph->s_icmp_id));
         return true;
     }
@@ -301,7 +301,7 @@ static bool ff_icmp_seq(const Args& a)
 {
     if (a.pkt->ptrs.icmph )
     {
-        print_label(a, "icmp_seq");
+        print_label(a);
         TextLog_Print(json_log, "%u", ntohs(a.pkt->ptrs.icmph->s_icmp_seq));
         return true;
     }
@@ -312,7 +312,7 @@ static bool ff_icmp_type(const Args& a)
 {
     if (a.pkt->ptrs.icmph )
     {
-        print_label(a, "icmp_type");
+        print_label(a);
         TextLog_Print(json_log, "%u", a.pkt->ptrs.icmph->type);
         return true;
     }
@@ -321,7 +321,7 @@ static bool ff_icmp_type(const Args& a)
 
 static bool ff_iface(const Args& a)
 {
-    print_label(a, "iface");
+    print_label(a);
     TextLog_Quote(json_log, SFDAQ::get_input_spec());
     return true;
 }
@@ -330,7 +330,7 @@ static bool ff_ip_id(const Args& a)
 {
     if (a.pkt->has_ip())
     {
-        print_label(a, "ip_id");
+        print_label(a);
         TextLog_Print(json_log, "%u", a.pkt->ptrs.ip_api.id());
         return true;
     }
@@ -341,7 +341,7 @@ static bool ff_ip_len(const Args& a)
 {
     if (a.pkt->has_ip())
     {
-        print_label(a, "ip_len");
+        print_label(a);
         TextLog_Print(json_log, "%u", a.pkt->ptrs.ip_api.pay_len());
         return true;
     }
@@ -350,7 +350,7 @@ static bool ff_ip_len(const Args& a)
 
 static bool ff_msg(const Args& a)
 {
-    print_label(a, "msg");
+    print_label(a);
     TextLog_Puts(json_log, a.msg);
     return true;
 }
@@ -368,21 +368,21 @@ static bool ff_mpls(const Args& a)
     else
         return false;
 
-    print_label(a, "mpls");
+    print_label(a);
     TextLog_Print(json_log, "%u", ntohl(mpls));
     return true;
 }
 
 static bool ff_pkt_gen(const Args& a)
 {
-    print_label(a, "pkt_gen");
+    print_label(a);
     TextLog_Quote(json_log, a.pkt->get_pseudo_type());
     return true;
 }
 
 static bool ff_pkt_len(const Args& a)
 {
-    print_label(a, "pkt_len");
+    print_label(a);
 
     if (a.pkt->has_ip())
         TextLog_Print(json_log, "%u", a.pkt->ptrs.ip_api.dgram_len());
@@ -394,35 +394,35 @@ static bool ff_pkt_len(const Args& a)
 
 static bool ff_pkt_num(const Args& a)
 {
-    print_label(a, "pkt_num");
+    print_label(a);
     TextLog_Print(json_log, STDu64, a.pkt->context->packet_number);
     return true;
 }
 
 static bool ff_priority(const Args& a)
 {
-    print_label(a, "priority");
+    print_label(a);
     TextLog_Print(json_log, "%u", a.event.sig_info->priority);
     return true;
 }
 
 static bool ff_proto(const Args& a)
 {
-    print_label(a, "proto");
+    print_label(a);
     TextLog_Quote(json_log, a.pkt->get_type());
     return true;
 }
 
 static bool ff_rev(const Args& a)
 {
-    print_label(a, "rev");
+    print_label(a);
     TextLog_Print(json_log, "%u",  a.event.sig_info->rev);
     return true;
 }
 
 static bool ff_rule(const Args& a)
 {
-    print_label(a, "rule");
+    print_label(a);
 
     TextLog_Print(json_log, "\"%u:%u:%u\"",
         a.event.sig_info->gid, a.event.sig_info->sid, a.event.sig_info->rev);
@@ -432,7 +432,7 @@ static bool ff_rule(const Args& a)
 
 static bool ff_seconds(const Args& a)
 {
-    print_label(a, "seconds");
+    print_label(a);
     TextLog_Print(json_log, "%lu",  a.pkt->pkth->ts.tv_sec);
     return true;
 }
@@ -441,7 +441,7 @@ static bool ff_server_bytes(const Args& a)
 {
     if (a.pkt->flow)
     {
-        print_label(a, "server_bytes");
+        print_label(a);
         TextLog_Print(json_log, "%" PRIu64, a.pkt->flow->flowstats.server_bytes);
         return true;
     }
@@ -452,7 +452,7 @@ static bool ff_server_pkts(const Args& a)
 {
     if (a.pkt->flow)
     {
-        print_label(a, "server_pkts");
+        print_label(a);
         TextLog_Print(json_log, "%" PRIu64, a.pkt->flow->flowstats.server_pkts);
         return true;
     }
@@ -466,7 +466,7 @@ static bool ff_service(const Args& a)
     if ( a.pkt->flow and a.pkt->flow->service )
         svc = a.pkt->flow->service;
 
-    print_label(a, "service");
+    print_label(a);
     TextLog_Quote(json_log, svc);
     return true;
 }
@@ -476,7 +476,7 @@ static bool ff_sgt(const Args& a)
     if (a.pkt->proto_bits & PROTO_BIT__CISCO_META_DATA)
     {
         const cisco_meta_data::CiscoMetaDataHdr* cmdh = layer::get_cisco_meta_data_layer(a.pkt);
-        print_label(a, "sgt");
+        print_label(a);
         TextLog_Print(json_log, "%hu", cmdh->sgt_val());
         return true;
     }
@@ -485,7 +485,7 @@ static bool ff_sgt(const Args& a)
 
 static bool ff_sid(const Args& a)
 {
-    print_label(a, "sid");
+    print_label(a);
     TextLog_Print(json_log, "%u",  a.event.sig_info->sid);
     return true;
 }
@@ -495,7 +495,7 @@ static bool ff_src_addr(const Args& a)
     if ( a.pkt->has_ip() or a.pkt->is_data() )
     {
         SfIpString ip_str;
-        print_label(a, "src_addr");
+        print_label(a);
         TextLog_Quote(json_log, a.pkt->ptrs.ip_api.get_src()->ntop(ip_str));
         return true;
     }
@@ -513,7 +513,7 @@ static bool ff_src_ap(const Args& a)
     if ( a.pkt->proto_bits & (PROTO_BIT__TCP|PROTO_BIT__UDP) )
         port = a.pkt->ptrs.sp;
 
-    print_label(a, "src_ap");
+    print_label(a);
     TextLog_Print(json_log, "\"%s:%u\"", addr, port);
     return true;
 }
@@ -522,7 +522,7 @@ static bool ff_src_port(const Args& a)
 {
     if ( a.pkt->proto_bits & (PROTO_BIT__TCP|PROTO_BIT__UDP) )
     {
-        print_label(a, "src_port");
+        print_label(a);
         TextLog_Print(json_log, "%u", a.pkt->ptrs.sp);
         return true;
     }
@@ -542,7 +542,7 @@ static bool ff_target(const Args& a)
     else
         return false;
 
-    print_label(a, "target");
+    print_label(a);
     TextLog_Quote(json_log, addr);
     return true;
 }
@@ -551,7 +551,7 @@ static bool ff_tcp_ack(const Args& a)
 {
     if (a.pkt->ptrs.tcph )
     {
-        print_label(a, "tcp_ack");
+        print_label(a);
         TextLog_Print(json_log, "%u", ntohl(a.pkt->ptrs.tcph->th_ack));
         return true;
     }
@@ -565,7 +565,7 @@ static bool ff_tcp_flags(const Args& a)
         char tcpFlags[9];
         CreateTCPFlagString(a.pkt->ptrs.tcph, tcpFlags);
 
-        print_label(a, "tcp_flags");
+        print_label(a);
         TextLog_Quote(json_log, tcpFlags);
         return true;
     }
@@ -576,7 +576,7 @@ static bool ff_tcp_len(const Args& a)
 {
     if (a.pkt->ptrs.tcph )
     {
-        print_label(a, "tcp_len");
+        print_label(a);
         TextLog_Print(json_log, "%u", (a.pkt->ptrs.tcph->off()));
         return true;
     }
@@ -587,7 +587,7 @@ static bool ff_tcp_seq(const Args& a)
 {
     if (a.pkt->ptrs.tcph )
     {
-        print_label(a, "tcp_seq");
+        print_label(a);
         TextLog_Print(json_log, "%u", ntohl(a.pkt->ptrs.tcph->th_seq));
         return true;
     }
@@ -598,7 +598,7 @@ static bool ff_tcp_win(const Args& a)
 {
     if (a.pkt->ptrs.tcph )
     {
-        print_label(a, "tcp_win");
+        print_label(a);
         TextLog_Print(json_log, "%u", ntohs(a.pkt->ptrs.tcph->th_win));
         return true;
     }
@@ -607,7 +607,7 @@ static bool ff_tcp_win(const Args& a)
 
 static bool ff_timestamp(const Args& a)
 {
-    print_label(a, "timestamp");
+    print_label(a);
     TextLog_Putc(json_log, '"');
     LogTimeStamp(json_log, a.pkt);
     TextLog_Putc(json_log, '"');
@@ -618,7 +618,7 @@ static bool ff_tos(const Args& a)
 {
     if (a.pkt->has_ip())
     {
-        print_label(a, "tos");
+        print_label(a);
         TextLog_Print(json_log, "%u", a.pkt->ptrs.ip_api.tos());
         return true;
     }
@@ -629,7 +629,7 @@ static bool ff_ttl(const Args& a)
 {
     if (a.pkt->has_ip())
     {
-        print_label(a, "ttl");
+        print_label(a);
         TextLog_Print(json_log, "%u",a.pkt->ptrs.ip_api.ttl());
         return true;
     }
@@ -640,7 +640,7 @@ static bool ff_udp_len(const Args& a)
 {
     if (a.pkt->ptrs.udph )
     {
-        print_label(a, "udp_len");
+        print_label(a);
         TextLog_Print(json_log, "%u", ntohs(a.pkt->ptrs.udph->uh_len));
         return true;
     }
@@ -649,7 +649,7 @@ static bool ff_udp_len(const Args& a)
 
 static bool ff_vlan(const Args& a)
 {
-    print_label(a, "vlan");
+    print_label(a);
     TextLog_Print(json_log, "%hu", a.pkt->get_flow_vlan_id());
     return true;
 }
@@ -660,6 +660,22 @@ static bool ff_vlan(const Args& a)
 
 typedef bool (*JsonFunc)(const Args&);
 
+// the fields config is compiled into a serializer program: the formatting
+// function resolved to a pointer and the key prefix rendered once up front
+struct JsonField
+{
+    JsonFunc fn;
+    string label;
+};
+
+static void compile_field(vector<JsonField>& fields, JsonFunc fn, const string& name)
+{
+    string label = fields.empty() ? " \"" : ", \"";
+    label += name;
+    label += "\" : ";
+    fields.push_back({ fn, label });
+}
+
 static const JsonFunc json_func[] =
 {
     ff_action, ff_class, ff_b64_data, ff_client_bytes, ff_client_pkts, ff_dir,
@@ -720,7 +736,7 @@ public:
     bool file = false;
     size_t limit = 0;
     string sep;
-    vector<JsonFunc> fields;
+    vector<JsonField> fields;
 };
 
 bool JsonModule::set(const char*, Value& v, SnortConfig*)
@@ -738,7 +754,7 @@ bool JsonModule::set(const char*, Value& v, SnortConfig*)
         {
             int i = Parameter::index(json_range, tok.c_str());
             if ( i >= 0 )
-                fields.emplace_back(json_func[i]);
+                compile_field(fields, json_func[i], tok);
         }
     }
 
@@ -770,7 +786,7 @@ bool JsonModule::begin(const char*, int, SnortConfig*)
         {
             int i = Parameter::index(json_range, tok.c_str());
             if ( i >= 0 )
-                fields.emplace_back(json_func[i]);
+                compile_field(fields, json_func[i], tok);
         }
     }
     return true;
@@ -793,7 +809,7 @@ public:
 public:
     string file;
     unsigned long limit;
-    vector<JsonFunc> fields;
+    vector<JsonField> fields;
     string sep;
 };
 
@@ -818,13 +834,13 @@ void JsonLogger::close()
 
 void JsonLogger::alert(Packet* p, const char* msg, const Event& event)
 {
-    Args a = { p, msg, event, false };
+    Args a = { p, msg, event, nullptr };
     TextLog_Putc(json_log, '{');
 
-    for ( JsonFunc f : fields )
+    for ( const JsonField& f : fields )
     {
-        f(a);
-        a.comma = true;
+        a.label = f.label.c_str();
+        f.fn(a);
     }
 
     TextLog_Print(json_log, " }\n");
@@ -174,6 +174,7 @@ void LuaJitLogger::alert(Packet* p, const char*, const Event& e)
     event = &e;
 
     lua_State* L = states[get_instance_id()];
+    Lua::DeferredGC::mark(L);
 
     Lua::ManageStack ms(L, 1);
 
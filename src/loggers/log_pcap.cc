@@ -48,6 +48,10 @@ using namespace std;
 #define PCAP_FILE_HDR_SZ (24)
 #define PCAP_PKT_HDR_SZ  (16)
 
+// each packet thread dumps to its own file, so a big stream buffer batches
+// many packets per write() without any cross-thread coordination
+#define PCAP_IO_BUF_SZ (256*1024)
+
 struct LtdConfig
 {
     string file;
@@ -57,6 +61,7 @@ struct LtdConfig
 struct LtdContext
 {
     char* file;
+    char* io_buf;
     pcap_dumper_t* dumpd;
     time_t lastTime;
     size_t size;
@@ -193,6 +198,16 @@ static void TcpdumpInitLogFile(LtdConfig*, bool no_timestamp)
     }
     pcap_close(pcap);
 
+    // the buffer outlives rollovers; each new dumper stream adopts it
+    if ( !context.io_buf )
+        context.io_buf = (char*)snort_alloc(PCAP_IO_BUF_SZ);
+
+    if ( setvbuf(pcap_dump_file(context.dumpd), context.io_buf, _IOFBF, PCAP_IO_BUF_SZ) != 0 )
+    {
+        ErrorMessage("%s: could not set I/O buffer: %s. Using system default.\n",
+            S_NAME, get_error(errno));
+    }
+
     context.file = snort_strdup(file.c_str());
     context.size = PCAP_FILE_HDR_SZ;
 }
@@ -287,6 +302,12 @@ void PcapLogger::close()
     }
     if ( context.file )
         snort_free(context.file);
+
+    if ( context.io_buf )
+    {
+        snort_free(context.io_buf);
+        context.io_buf = nullptr;
+    }
 }
 
 void PcapLogger::log(Packet* p, const char* msg, Event* event)
@@ -63,8 +63,25 @@ using namespace std;
 struct Unified2Config
 {
     size_t limit;
+    size_t flush_size;
+    uint32_t flush_interval;
     int nostamp;
     bool legacy_events;
+    bool compact;
+};
+
+// previous record values for the compact event encoding; deltas are per
+// file, so this is zeroed whenever a file is opened
+struct U2CompactState
+{
+    uint32_t snort_id;
+    uint32_t event_id;
+    uint32_t event_second;
+    uint32_t rule_gid;
+    uint32_t rule_sid;
+    uint32_t policy_id_context;
+    uint32_t policy_id_inspect;
+    uint32_t policy_id_detect;
 };
 
 struct U2
@@ -74,6 +91,17 @@ struct U2
     int base_proto;
     uint32_t timestamp;
     char filepath[STD_BUF];
+
+    /* When flush_size is set, whole records accumulate here and are written in
+     * one batch when the threshold is passed, when a trickle of alerts leaves
+     * records older than flush_interval, or when the file is rotated or
+     * closed. Records are only flushed whole so spoolers still see complete
+     * records. */
+    uint8_t* agg_buffer;
+    uint32_t agg_len;
+    time_t agg_first_time;
+
+    U2CompactState compact;
 };
 
 /* -------------------- Global Variables ----------------------*/
@@ -102,6 +130,8 @@ static THREAD_LOCAL char* io_buffer = nullptr;
 /* -------------------- Local Functions -----------------------*/
 
 static void Unified2Write(uint8_t*, uint32_t, Unified2Config*);
+static void Unified2Flush(Unified2Config*);
+static void Unified2Queue(uint8_t*, uint32_t, Unified2Config*);
 
 static void Unified2InitFile(Unified2Config* config)
 {
@@ -139,10 +169,14 @@ static void Unified2InitFile(Unified2Config* config)
         ErrorMessage("unified2 could not set I/O buffer: %s. "
             "Using system default.\n", get_error(errno));
     }
+
+    // compact record deltas restart with each file
+    memset(&u2.compact, 0, sizeof(u2.compact));
 }
 
 static inline void Unified2RotateFile(Unified2Config* config)
 {
+    Unified2Flush(config);
     fclose(u2.stream);
     u2.current = 0;
     Unified2InitFile(config);
@@ -161,6 +195,125 @@ static inline void copy_addr(const SfIp& src, const SfIp& dst, Unified2Event& e)
     e.pkt_ip_ver = (get_version(src) << 4) | get_version(dst);
 }
 
+//--------------------------------------------------------------------------
+// compact event support - see log/unified2.h for the wire format
+//--------------------------------------------------------------------------
+
+static inline uint8_t* put_varint(uint8_t* p, uint64_t v)
+{
+    while ( v >= 0x80 )
+    {
+        *p++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+static inline uint8_t* put_delta(uint8_t* p, uint32_t v, uint32_t& prev)
+{
+    int64_t d = (int64_t)v - (int64_t)prev;
+    prev = v;
+    return put_varint(p, ((uint64_t)d << 1) ^ (uint64_t)(d >> 63));
+}
+
+static uint32_t encode_compact_event(
+    const Unified2Event& e, uint8_t* body, U2CompactState& cs)
+{
+    uint8_t* p = body;
+
+    p = put_delta(p, ntohl(e.snort_id), cs.snort_id);
+    p = put_delta(p, ntohl(e.event_id), cs.event_id);
+    p = put_delta(p, ntohl(e.event_second), cs.event_second);
+    p = put_varint(p, ntohl(e.event_microsecond));
+
+    p = put_delta(p, ntohl(e.rule_gid), cs.rule_gid);
+    p = put_delta(p, ntohl(e.rule_sid), cs.rule_sid);
+    p = put_varint(p, ntohl(e.rule_rev));
+    p = put_varint(p, ntohl(e.rule_class));
+    p = put_varint(p, ntohl(e.rule_priority));
+
+    p = put_delta(p, ntohl(e.policy_id_context), cs.policy_id_context);
+    p = put_delta(p, ntohl(e.policy_id_inspect), cs.policy_id_inspect);
+    p = put_delta(p, ntohl(e.policy_id_detect), cs.policy_id_detect);
+
+    *p++ = e.pkt_ip_ver;
+
+    if ( (e.pkt_ip_ver >> 4) == 0x6 )
+    {
+        memcpy(p, e.pkt_src_ip, 16);
+        p += 16;
+    }
+    else
+    {
+        memcpy(p, &e.pkt_src_ip[3], 4);
+        p += 4;
+    }
+
+    if ( (e.pkt_ip_ver & 0xF) == 0x6 )
+    {
+        memcpy(p, e.pkt_dst_ip, 16);
+        p += 16;
+    }
+    else
+    {
+        memcpy(p, &e.pkt_dst_ip[3], 4);
+        p += 4;
+    }
+
+    p = put_varint(p, ntohs(e.pkt_src_port_itype));
+    p = put_varint(p, ntohs(e.pkt_dst_port_icode));
+    p = put_varint(p, ntohs(e.pkt_vlan_id));
+    p = put_varint(p, ntohl(e.pkt_mpls_label));
+
+    *p++ = e.pkt_ip_proto;
+    *p++ = e.snort_status;
+    *p++ = e.snort_action;
+
+    size_t name_len = strnlen(e.app_name, sizeof(e.app_name));
+    p = put_varint(p, name_len);
+    memcpy(p, e.app_name, name_len);
+    p += name_len;
+
+    return (uint32_t)(p - body);
+}
+
+static void alert_event_compact(const Unified2Event& u2_event, Unified2Config* config)
+{
+    // worst case is every varint at full width plus the fixed bytes,
+    // comfortably under the fixed record size
+    uint8_t body[2 * sizeof(Unified2Event)];
+
+    // deltas are relative to the previous record in the same file; if
+    // this record triggers rotation it must be re-encoded against the
+    // fresh file's zeroed state
+    U2CompactState state = u2.compact;
+    uint32_t body_len = encode_compact_event(u2_event, body, state);
+
+    Serial_Unified2_Header hdr;
+
+    if ( config->limit && (u2.current + sizeof(hdr) + body_len) > config->limit )
+    {
+        Unified2RotateFile(config);
+        state = u2.compact;
+        body_len = encode_compact_event(u2_event, body, state);
+    }
+
+    u2.compact = state;
+
+    uint32_t write_len = sizeof(hdr) + body_len;
+    hdr.length = htonl(body_len);
+    hdr.type = htonl(UNIFIED2_EVENT3_COMPACT);
+
+    memcpy_s(write_pkt_buffer, u2_buf_sz, &hdr, sizeof(hdr));
+
+    size_t offset = sizeof(hdr);
+
+    memcpy_s(write_pkt_buffer + offset, u2_buf_sz - offset, body, body_len);
+
+    Unified2Queue(write_pkt_buffer, write_len, config);
+}
+
 static void alert_event(Packet* p, const char*, Unified2Config* config, const Event* event)
 {
     Unified2Event u2_event;
@@ -226,6 +379,12 @@ static void alert_event(Packet* p, const char*, Unified2Config* config, const Ev
         u2_event.snort_action = p->active->get_action();
     }
 
+    if ( config->compact )
+    {
+        alert_event_compact(u2_event, config);
+        return;
+    }
+
     Serial_Unified2_Header hdr;
     uint32_t write_len = sizeof(hdr) + sizeof(u2_event);
 
@@ -241,7 +400,7 @@ static void alert_event(Packet* p, const char*, Unified2Config* config, const Ev
 
     memcpy_s(write_pkt_buffer + offset, u2_buf_sz - offset, &u2_event, sizeof(u2_event));
 
-    Unified2Write(write_pkt_buffer, write_len, config);
+    Unified2Queue(write_pkt_buffer, write_len, config);
 }
 
 static void _WriteExtraData(Unified2Config* config,
@@ -297,7 +456,7 @@ static void _WriteExtraData(Unified2Config* config,
 
     memcpy_s(ptr + offset, sizeof(write_buffer) - offset, buffer, len);
 
-    Unified2Write(write_buffer, write_len, config);
+    Unified2Queue(write_buffer, write_len, config);
 }
 
 static void AlertExtraData(
@@ -410,7 +569,7 @@ static void _Unified2LogPacketAlert(
         }
     }
 
-    Unified2Write(write_pkt_buffer, write_len, config);
+    Unified2Queue(write_pkt_buffer, write_len, config);
 }
 
 /******************************************************************************
@@ -577,6 +736,40 @@ static void Unified2Write(uint8_t* buf, uint32_t buf_len, Unified2Config* config
     u2.current += buf_len;
 }
 
+static void Unified2Flush(Unified2Config* config)
+{
+    if (u2.agg_len == 0)
+        return;
+
+    uint32_t len = u2.agg_len;
+    u2.agg_len = 0;
+    Unified2Write(u2.agg_buffer, len, config);
+}
+
+/* Hand a whole record off for writing. With no flush_size configured each
+ * record is written and flushed immediately as before; otherwise records are
+ * batched in the per-thread aggregation buffer to cut the per-record syscall
+ * pair during alert storms. */
+static void Unified2Queue(uint8_t* buf, uint32_t buf_len, Unified2Config* config)
+{
+    if (config->flush_size == 0)
+    {
+        Unified2Write(buf, buf_len, config);
+        return;
+    }
+
+    if (u2.agg_len == 0)
+        u2.agg_first_time = time(nullptr);
+
+    memcpy_s(u2.agg_buffer + u2.agg_len, config->flush_size + u2_buf_sz - u2.agg_len,
+        buf, buf_len);
+    u2.agg_len += buf_len;
+
+    if ((u2.agg_len >= config->flush_size) ||
+        ((uint32_t)(time(nullptr) - u2.agg_first_time) >= config->flush_interval))
+        Unified2Flush(config);
+}
+
 //--------------------------------------------------------------------------
 // legacy event support
 // FIXIT-L encode pseudo packets for buffers and extra data for out of date
@@ -692,7 +885,7 @@ static void _AlertIP4_v2(Packet* p, const char*, Unified2Config* config, const E
 
     memcpy_s(write_pkt_buffer + offset, u2_buf_sz - offset, &alertdata, sizeof(alertdata));
 
-    Unified2Write(write_pkt_buffer, write_len, config);
+    Unified2Queue(write_pkt_buffer, write_len, config);
 }
 
 static void _AlertIP6_v2(Packet* p, const char*, Unified2Config* config, const Event* event)
@@ -780,7 +973,7 @@ static void _AlertIP6_v2(Packet* p, const char*, Unified2Config* config, const E
 
     memcpy_s(write_pkt_buffer + offset, u2_buf_sz - offset, &alertdata, sizeof(alertdata));
 
-    Unified2Write(write_pkt_buffer, write_len, config);
+    Unified2Queue(write_pkt_buffer, write_len, config);
 }
 
 //-------------------------------------------------------------------------
@@ -789,9 +982,19 @@ static void _AlertIP6_v2(Packet* p, const char*, Unified2Config* config, const E
 
 static const Parameter s_params[] =
 {
+    { "compact", Parameter::PT_BOOL, nullptr, "false",
+      "pack events as varint coded records with per file deltas "
+      "(much smaller, but not readable by barnyard2)" },
+
     { "legacy_events", Parameter::PT_BOOL, nullptr, "false",
       "generate Snort 2.X style events for barnyard2 compatibility" },
 
+    { "flush_interval", Parameter::PT_INT, "1:3600", "1",
+      "maximum seconds batched records may wait before being written" },
+
+    { "flush_size", Parameter::PT_INT, "0:maxSZ", "0",
+      "set bytes of records to batch per write (0 writes each record immediately)" },
+
     { "limit", Parameter::PT_INT, "0:maxSZ", "0",
       "set maximum size in MB before rollover (0 is unlimited)" },
 
@@ -817,8 +1020,11 @@ public:
 
 public:
     size_t limit = 0;
+    size_t flush_size = 0;
+    uint32_t flush_interval = 1;
     bool nostamp = true;
     bool legacy_events = false;
+    bool compact = false;
 };
 
 bool U2Module::set(const char*, Value& v, SnortConfig*)
@@ -826,6 +1032,15 @@ bool U2Module::set(const char*, Value& v, SnortConfig*)
     if ( v.is("limit") )
         limit = v.get_size() * 1024 * 1024;
 
+    else if ( v.is("compact") )
+        compact = v.get_bool();
+
+    else if ( v.is("flush_size") )
+        flush_size = v.get_size();
+
+    else if ( v.is("flush_interval") )
+        flush_interval = v.get_uint32();
+
     else if ( v.is("nostamp") )
         nostamp = v.get_bool();
 
@@ -843,6 +1058,7 @@ bool U2Module::begin(const char*, int, SnortConfig* sc)
     limit = 0;
     nostamp = sc->output_no_timestamp();
     legacy_events = false;
+    compact = false;
     return true;
 }
 
@@ -872,8 +1088,18 @@ private:
 U2Logger::U2Logger(U2Module* m)
 {
     config.limit = m->limit;
+    config.flush_size = m->flush_size;
+    config.flush_interval = m->flush_interval;
     config.nostamp = m->nostamp;
     config.legacy_events = m->legacy_events;
+    config.compact = m->compact;
+
+    // legacy records have no compact form
+    if ( config.legacy_events and config.compact )
+    {
+        ParseWarning(WARN_CONF, "unified2 compact is ignored with legacy_events");
+        config.compact = false;
+    }
 }
 
 
@@ -896,6 +1122,12 @@ void U2Logger::open()
     write_pkt_buffer = new uint8_t[u2_buf_sz];
     io_buffer = new char[u2_buf_sz];
 
+    if ( config.flush_size > 0 )
+    {
+        u2.agg_buffer = new uint8_t[config.flush_size + u2_buf_sz];
+        u2.agg_len = 0;
+    }
+
     Unified2InitFile(&config);
 
     Stream::reg_xtra_data_log(AlertExtraData, &config);
@@ -904,13 +1136,18 @@ void U2Logger::open()
 void U2Logger::close()
 {
     if ( u2.stream )
+    {
+        Unified2Flush(&config);
         fclose(u2.stream);
+    }
 
     delete[] write_pkt_buffer;
     delete[] io_buffer;
+    delete[] u2.agg_buffer;
 
     write_pkt_buffer = nullptr;
     io_buffer = nullptr;
+    u2.agg_buffer = nullptr;
 }
 
 void U2Logger::alert_legacy(Packet* p, const char* msg, const Event& event)
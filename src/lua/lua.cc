@@ -25,8 +25,10 @@
 
 #include <cassert>
 #include <utility>
+#include <vector>
 
 #include "log/messages.h"
+#include "time/clock_defs.h"
 
 using namespace snort;
 
@@ -81,5 +83,52 @@ ManageStack::~ManageStack()
     if ( lua_gettop(state) > top )
         lua_settop(state, top);
 }
+
+namespace DeferredGC
+{
+// data to collect per step per state; big enough to keep up with event
+// enrichment rates, small enough to stay off the latency radar
+static const int gc_step_kb = 32;
+
+THREAD_LOCAL Stats stats;
+
+static THREAD_LOCAL std::vector<lua_State*>* marked = nullptr;
+
+void mark(lua_State* L)
+{
+    if ( !marked )
+        marked = new std::vector<lua_State*>;
+
+    for ( auto s : *marked )
+    {
+        if ( s == L )
+            return;
+    }
+
+    // automatic collection stays off; the analyzer steps it between bursts
+    lua_gc(L, LUA_GCSTOP, 0);
+    marked->push_back(L);
+}
+
+void step()
+{
+    if ( !marked or marked->empty() )
+        return;
+
+    const hr_time t = SnortClock::now();
+
+    for ( auto L : *marked )
+    {
+        lua_gc(L, LUA_GCSTEP, gc_step_kb);
+
+        // a completed cycle restarts the collector; keep it off
+        lua_gc(L, LUA_GCSTOP, 0);
+        stats.gc_steps++;
+    }
+    marked->clear();
+
+    stats.gc_usecs += clock_usecs(TO_USECS(SnortClock::now() - t));
+}
+}
 }
 
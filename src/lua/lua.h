@@ -24,7 +24,9 @@
 
 #include <lua.hpp>
 
+#include "framework/counts.h"
 #include "main/snort_types.h"
+#include "main/thread.h"
 
 namespace Lua
 {
@@ -69,6 +71,28 @@ private:
     int top;
 };
 
+// Deferred garbage collection for packet thread lua states (luajit logger
+// and rule option hooks).  Marking a state stops its automatic collector;
+// the analyzer then runs an incremental step on each state marked during a
+// receive burst at the burst boundary, so collection never runs inline
+// while logging an event or evaluating a rule.  Marks only live for one
+// burst, so reload can free a state without leaving a stale pointer here.
+namespace DeferredGC
+{
+struct Stats
+{
+    PegCount gc_steps;
+    PegCount gc_usecs;
+};
+
+SO_PUBLIC extern THREAD_LOCAL Stats stats;
+
+SO_PUBLIC void mark(lua_State*);
+
+// run one incremental collection step on each state marked this burst
+SO_PUBLIC void step();
+}
+
 }
 #endif
 
@@ -198,6 +198,8 @@ void Pig::stop()
         reap_command(analyzer->completed_work_queue.front());
         analyzer->completed_work_queue.pop();
     }
+    while (AnalyzerCommand* ac = analyzer->pending_work_ring.get(nullptr))
+        reap_command(ac);
     while (!analyzer->pending_work_queue.empty())
     {
         reap_command(analyzer->pending_work_queue.front());
@@ -44,6 +44,7 @@
 #include "latency/packet_latency.h"
 #include "latency/rule_latency.h"
 #include "log/messages.h"
+#include "lua/lua.h"
 #include "main/swapper.h"
 #include "main.h"
 #include "managers/action_manager.h"
@@ -365,6 +366,8 @@ void Analyzer::post_process_daq_pkt_msg(Packet* p)
     else
         verdict = distill_verdict(p);
 
+    PacketTracer::record(p, (uint8_t)verdict);
+
     if (PacketTracer::is_active())
     {
         PacketTracer::log("Policies: Network %u, Inspection %u, Detection %u\n",
@@ -771,9 +774,16 @@ void Analyzer::operator()(Swapper* ps, uint16_t run_num)
     thread-safe in relation to interactions with the analyzer thread. */
 void Analyzer::execute(AnalyzerCommand* ac)
 {
-    pending_work_queue_mutex.lock();
-    pending_work_queue.push(ac);
-    pending_work_queue_mutex.unlock();
+    // fast path is the spsc ring; the mutexed queue only catches bursts
+    // beyond the ring.  once anything has overflowed, later commands
+    // must follow it through the queue to preserve delivery order.
+    if ( pending_overflow_count.load() or !pending_work_ring.put(ac) )
+    {
+        pending_work_queue_mutex.lock();
+        pending_work_queue.push(ac);
+        pending_overflow_count++;
+        pending_work_queue_mutex.unlock();
+    }
 
     /* Break out of the DAQ acquire loop so that the command will be processed.
         This is explicitly safe to call from another thread. */
@@ -783,15 +793,21 @@ void Analyzer::execute(AnalyzerCommand* ac)
 
 bool Analyzer::handle_command()
 {
-    AnalyzerCommand* ac = nullptr;
+    // lock free for the packet thread unless commands have overflowed
+    // into the mutexed queue
+    AnalyzerCommand* ac = pending_work_ring.get(nullptr);
 
-    pending_work_queue_mutex.lock();
-    if (!pending_work_queue.empty())
+    if ( !ac and pending_overflow_count.load() )
     {
-        ac = pending_work_queue.front();
-        pending_work_queue.pop();
+        pending_work_queue_mutex.lock();
+        if (!pending_work_queue.empty())
+        {
+            ac = pending_work_queue.front();
+            pending_work_queue.pop();
+            pending_overflow_count--;
+        }
+        pending_work_queue_mutex.unlock();
     }
-    pending_work_queue_mutex.unlock();
 
     if (!ac)
         return false;
@@ -821,8 +837,16 @@ void Analyzer::add_command_to_completed_queue(AnalyzerCommand* ac)
 
 void Analyzer::handle_commands()
 {
-    while (handle_command())
+    // bound the control plane work done in one pass so a burst of
+    // commands can't stall packet pulls; any leftovers re-interrupt the
+    // daq and get picked up after the next receive
+    unsigned quantum = 8;
+
+    while ( quantum-- and handle_command() )
         ;
+
+    if ( (!pending_work_ring.empty() or pending_overflow_count.load()) and daq_instance )
+        daq_instance->interrupt();
 }
 
 void Analyzer::handle_uncompleted_commands()
@@ -882,9 +906,26 @@ DAQ_RecvStatus Analyzer::process_messages()
         process_daq_msg(msg, false);
         DetectionEngine::onload();
         process_retry_queue();
-        handle_uncompleted_commands();
     }
 
+    // Long running analyzer commands are control plane work; polling them
+    // once per batch keeps them off the per message path, which matters at
+    // file readback rates.
+    handle_uncompleted_commands();
+
+    // Burst boundary: opportunistically resend any injects that hit transmit
+    // backpressure while the messages above were being processed.
+    if (daq_instance->have_pending_injects())
+        daq_instance->retry_injects();
+
+    // ... and retire the response coalescing records for this burst.
+    Active::next_burst();
+
+    // Step garbage collection for any lua states exercised this burst so
+    // collection pauses land here instead of inline during event logging
+    // or rule eval.
+    Lua::DeferredGC::step();
+
     if (exit_after_cnt && (exit_after_cnt -= num_recv) == 0)
         stop();
     if (pause_after_cnt && (pause_after_cnt -= num_recv) == 0)
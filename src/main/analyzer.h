@@ -32,6 +32,7 @@
 #include <queue>
 #include <string>
 
+#include "helpers/ring.h"
 #include "thread.h"
 
 class ContextSwitcher;
@@ -133,6 +134,12 @@ private:
 public:
     std::queue<snort::AnalyzerCommand*> completed_work_queue;
     std::mutex completed_work_queue_mutex;
+
+    // commands are delivered through a per analyzer spsc ring (main
+    // thread produces, analyzer thread consumes) so the packet thread
+    // never takes a lock to poll for work; pending_work_queue is the
+    // mutexed overflow for bursts beyond the ring
+    Ring<snort::AnalyzerCommand*> pending_work_ring { 64 };
     std::queue<snort::AnalyzerCommand*> pending_work_queue;
 
 private:
@@ -149,6 +156,7 @@ private:
     OopsHandler* oops_handler = nullptr;
     ContextSwitcher* switcher = nullptr;
     std::mutex pending_work_queue_mutex;
+    std::atomic<unsigned> pending_overflow_count { 0 };
     std::list<UncompletedAnalyzerCommand*> uncompleted_work_queue;
 };
 
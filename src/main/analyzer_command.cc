@@ -78,9 +78,9 @@ bool ACRotate::execute(Analyzer& analyzer, void**)
 bool ACGetStats::execute(Analyzer&, void**)
 {
 
-    // FIXIT-P This incurs locking on all threads to retrieve stats.  It
-    // could be reimplemented to optimize for large thread counts by
-    // retrieving stats in the command and accumulating in the main thread.
+    // each thread sums its own pegs under per module locks with staggered
+    // sweeps, so threads don't serialize behind a global stats mutex or
+    // the main thread's dump
     ModuleManager::accumulate();
     return true;
 }
@@ -41,6 +41,7 @@
 #include "host_tracker/host_cache_module.h"
 #include "latency/latency_module.h"
 #include "log/messages.h"
+#include "lua/lua.h"
 #include "managers/module_manager.h"
 #include "managers/plugin_manager.h"
 #include "memory/memory_module.h"
@@ -192,6 +193,10 @@ static const Parameter search_engine_params[] =
     { "queue_limit", Parameter::PT_INT, "0:max32", "128",
       "maximum number of fast pattern matches to queue per packet (0 means no maximum)" },
 
+    { "compile_threads", Parameter::PT_INT, "0:1024", "0",
+      "number of threads to use compiling rule groups, capped at packet thread count"
+      " (0 means one per packet thread)" },
+
     { nullptr, Parameter::PT_MAX, nullptr, nullptr, nullptr }
 };
 
@@ -305,6 +310,9 @@ bool SearchEngineModule::set(const char*, Value& v, SnortConfig* sc)
     else if ( v.is("queue_limit") )
         fp->set_queue_limit(v.get_uint32());
 
+    else if ( v.is("compile_threads") )
+        fp->set_num_compile_threads(v.get_uint32());
+
     else
         return false;
 
@@ -364,6 +372,10 @@ static const Parameter profiler_rule_params[] =
       "avg_match | avg_no_match",
       "total_time", "sort by given field" },
 
+    { "sample", Parameter::PT_INT, "1:max32", "1",
+      "profile 1 in N packets to cut overhead; results reflect only "
+      "sampled packets (1 = every packet)" },
+
     { nullptr, Parameter::PT_MAX, nullptr, nullptr, nullptr }
 };
 
@@ -439,7 +451,14 @@ bool ProfilerModule::set(const char* fqn, Value& v, SnortConfig* sc)
         return s_profiler_module_set(sc->profiler->memory, v);
 
     else if ( !strncmp(fqn, spr, strlen(spr)) )
+    {
+        if ( v.is("sample") )
+        {
+            sc->profiler->rule.sample = v.get_uint32();
+            return true;
+        }
         return s_profiler_module_set(sc->profiler->rule, v);
+    }
 
     return false;
 }
@@ -448,6 +467,7 @@ bool ProfilerModule::end(const char*, int, SnortConfig* sc)
 {
     TimeProfilerStats::set_enabled(sc->profiler->time.show);
     RuleContext::set_enabled(sc->profiler->rule.show);
+    RuleContext::set_sample(sc->profiler->rule.sample);
     return true;
 }
 
@@ -838,6 +858,8 @@ static PegInfo active_pegs[]
     { CountType::SUM, "holds_denied", "total number of packet hold requests denied" },
     { CountType::SUM, "holds_canceled", "total number of packet hold requests canceled" },
     { CountType::SUM, "holds_allowed", "total number of packet hold requests allowed" },
+    { CountType::SUM, "responses_coalesced",
+        "total duplicate responses to a flow coalesced within a receive burst" },
     { CountType::END, nullptr, nullptr }
 };
 
@@ -880,6 +902,36 @@ bool ActiveModule::set(const char*, Value& v, SnortConfig* sc)
     return true;
 }
 
+//-------------------------------------------------------------------------
+// lua module
+//-------------------------------------------------------------------------
+
+#define lua_help \
+    "manage the lua states used by luajit loggers and rule options"
+
+static PegInfo lua_pegs[]
+{
+    { CountType::SUM, "gc_steps",
+        "total incremental gc steps run on lua states between receive bursts" },
+    { CountType::SUM, "gc_usecs", "total usecs spent in deferred lua gc steps" },
+    { CountType::END, nullptr, nullptr }
+};
+
+class LuaModule : public Module
+{
+public:
+    LuaModule() : Module("lua", lua_help) { }
+
+    const PegInfo* get_pegs() const override
+    { return lua_pegs; }
+
+    PegCount* get_counts() const override
+    { return (PegCount*) &Lua::DeferredGC::stats; }
+
+    Usage get_usage() const override
+    { return GLOBAL; }
+};
+
 //-------------------------------------------------------------------------
 // packets module
 //-------------------------------------------------------------------------
@@ -2016,6 +2068,7 @@ void module_init()
     ModuleManager::add_module(new ClassificationsModule);
     ModuleManager::add_module(new CodecModule);
     ModuleManager::add_module(new DetectionModule);
+    ModuleManager::add_module(new LuaModule);
     ModuleManager::add_module(new MemoryModule);
     ModuleManager::add_module(new PacketTracerModule);
     ModuleManager::add_module(new PacketsModule);
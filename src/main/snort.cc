@@ -54,6 +54,7 @@
 #include "managers/plugin_manager.h"
 #include "managers/script_manager.h"
 #include "memory/memory_cap.h"
+#include "memory/memory_config.h"
 #include "network_inspectors/network_inspectors.h"
 #include "packet_io/active.h"
 #include "packet_io/sfdaq.h"
@@ -83,6 +84,7 @@
 
 #include "build.h"
 #include "snort_config.h"
+#include "startup_phase.h"
 #include "thread_config.h"
 
 using namespace snort;
@@ -134,8 +136,13 @@ void Snort::init(int argc, char** argv)
 
     SideChannelManager::pre_config_init();
 
+    StartupPhase::begin("script load");
     ScriptManager::load_scripts(snort_cmd_line_conf->script_paths);
+    StartupPhase::end();
+
+    StartupPhase::begin("plugin load");
     PluginManager::load_plugins(snort_cmd_line_conf->plugin_path);
+    StartupPhase::end();
 
     /* load_plugins() must be called before init() so that
     TraceModule can properly generate its Parameter table */
@@ -145,7 +152,10 @@ void Snort::init(int argc, char** argv)
     FileService::init();
 
     parser_init();
+
+    StartupPhase::begin("config parse");
     SnortConfig* sc = ParseSnortConf(snort_cmd_line_conf);
+    StartupPhase::end();
 
     /* Merge the command line and config file confs to take care of
      * command line overriding config file.
@@ -157,7 +167,9 @@ void Snort::init(int argc, char** argv)
     // since the first trace call may happen somewhere after this point
     TraceApi::thread_init(sc->trace_config);
 
+    StartupPhase::begin("so plugin load");
     PluginManager::load_so_plugins(sc);
+    StartupPhase::end();
 
     if ( sc->logging_flags & LOGGING_FLAG__SHOW_PLUGINS )
     {
@@ -183,13 +195,19 @@ void Snort::init(int argc, char** argv)
     sc->setup();
 
     if ( !sc->attribute_hosts_file.empty() )
+    {
+        StartupPhase::begin("hosts table load");
         HostAttributes::load_hosts_file(sc, sc->attribute_hosts_file.c_str());
+        StartupPhase::end();
+    }
 
     // Must be after CodecManager::instantiate()
+    StartupPhase::begin("inspector configure");
     if ( !InspectorManager::configure(sc) )
         ParseError("can't initialize inspectors");
     else if ( sc->log_verbose() )
         InspectorManager::print_config(sc);
+    StartupPhase::end();
 
     InspectorManager::prepare_controls(sc);
 
@@ -235,6 +253,8 @@ void Snort::init(int argc, char** argv)
 
     Active::init(sc);
 
+    StartupPhase::report();
+
     LogMessage("%s\n", LOG_DIV);
 
     SFDAQ::init(sc->daq_config, ThreadConfig::get_instance_max());
@@ -518,6 +538,25 @@ SnortConfig* Snort::get_reload_config(const char* fname, const char* plugin_path
         MpseManager::activate_search_engine(sc->fast_pattern_config->get_search_api(), sc);
     }
 
+    // both configs and both search engine sets are resident right now - this
+    // is the transient peak memory.reload_cap bounds.  failing here turns an
+    // OOM kill on sensors sized for steady state into a clean reload failure.
+    const size_t reload_cap = SnortConfig::get_conf()->memory->reload_cap;
+
+    if ( reload_cap )
+    {
+        const size_t rss = get_process_rss();
+
+        if ( rss > reload_cap )
+        {
+            ReloadError("Transient memory %zu exceeds memory.reload_cap %zu.\n",
+                rss, reload_cap);
+            reload_failure_cleanup(sc);
+            trim_heap();
+            return nullptr;
+        }
+    }
+
     InspectorManager::update_policy(sc);
     reloading = false;
     parser_term(sc);
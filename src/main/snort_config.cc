@@ -31,6 +31,7 @@
 #include "detection/detection_engine.h"
 #include "detection/fp_config.h"
 #include "detection/fp_create.h"
+#include "detection/rule_arena.h"
 #include "filters/detection_filter.h"
 #include "filters/rate_filter.h"
 #include "filters/sfrf.h"
@@ -65,6 +66,7 @@
 #include "utils/util_cstring.h"
 
 #include "analyzer.h"
+#include "startup_phase.h"
 #include "thread_config.h"
 
 using namespace snort;
@@ -176,6 +178,7 @@ void SnortConfig::init(const SnortConfig* const other_conf, ProtocolReference* p
         memset(evalOrder, 0, sizeof(evalOrder));
         proto_ref = new ProtocolReference(protocol_reference);
         so_rules = new SoRules;
+        rule_arena = new RuleArena;
         trace_config = new TraceConfig;
     }
     else
@@ -270,6 +273,7 @@ SnortConfig::~SnortConfig()
     delete daq_config;
     delete proto_ref;
     delete so_rules;
+    delete rule_arena;
     if ( plugins )
         delete plugins;
     reload_tuners.clear();
@@ -286,8 +290,11 @@ void SnortConfig::setup()
         thiszone = gmt2local(0);
 
     init_policies(this);
+
+    StartupPhase::begin("rule parse");
     ParseRules(this);
     OrderRuleLists(this);
+    StartupPhase::end();
 
     if ( rule_states )
     {
@@ -302,7 +309,13 @@ void SnortConfig::setup()
     IpsManager::verify(this);
     ModuleManager::load_commands(policy_map->get_shell());
 
+    StartupPhase::begin("fp compile");
     fpCreateFastPacketDetection(this);
+    StartupPhase::end();
+
+    // no more threshold objects will be added; flatten the lookup tables
+    // probed per event
+    ThresholdConfigFreeze(threshold_config);
 }
 
 void SnortConfig::post_setup()
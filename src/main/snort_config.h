@@ -154,6 +154,7 @@ namespace snort
 {
 class GHash;
 class ProtocolReference;
+class RuleArena;
 class ThreadConfig;
 class XHash;
 struct ProfilerConfig;
@@ -240,12 +241,14 @@ public:
 
     int pcre_ovector_size = 0;
     bool pcre_override = true;
+    long int pcre_jit_stack_size = 512 * 1024;
 
     int asn1_mem = 0;
     uint32_t run_flags = 0;
 
     unsigned offload_limit = 99999;  // disabled
     unsigned offload_threads = 0;    // disabled
+    unsigned onload_quantum = 8;     // completions drained per onload pass
 
 #ifdef HAVE_HYPERSCAN
     bool hyperscan_literals = false;
@@ -423,6 +426,10 @@ public:
     bool cloned = false;
     Plugins* plugins = nullptr;
     SoRules* so_rules = nullptr;
+
+    // parse time bump allocator for rule tree nodes; freed wholesale
+    // when this config is deleted
+    RuleArena* rule_arena = nullptr;
 private:
     std::list<ReloadResourceTuner*> reload_tuners;
 
@@ -639,6 +646,9 @@ public:
     long int get_pcre_match_limit_recursion() const
     { return pcre_match_limit_recursion; }
 
+    long int get_pcre_jit_stack_size() const
+    { return pcre_jit_stack_size; }
+
     const ProfilerConfig* get_profiler() const
     { return profiler; }
 
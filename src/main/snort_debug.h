@@ -199,9 +199,21 @@ static inline void trace_print(const snort::Trace* trace, const snort::Packet* p
 #define trace_printf trace_printf<snort::trace_vprintf>
 #define trace_uprintf trace_uprintf<snort::trace_vprintf>
 
-#define trace_log(...) trace_print(__VA_ARGS__)
-#define trace_logf(...) trace_printf(__VA_ARGS__)
-#define trace_ulogf(...) trace_uprintf(__VA_ARGS__)
+// the g_trace_active test keeps disabled trace sites from evaluating
+// their arguments; building with DISABLE_SNORT_TRACE removes them
+// entirely
+#ifdef NO_TRACE
+#define trace_log(...)
+#define trace_logf(...)
+#define trace_ulogf(...)
+#else
+#define trace_log(...) \
+    do { if ( snort::g_trace_active ) trace_print(__VA_ARGS__); } while (0)
+#define trace_logf(...) \
+    do { if ( snort::g_trace_active ) trace_printf(__VA_ARGS__); } while (0)
+#define trace_ulogf(...) \
+    do { if ( snort::g_trace_active ) trace_uprintf(__VA_ARGS__); } while (0)
+#endif
 
 #ifdef DEBUG_MSGS
 #define debug_log trace_log
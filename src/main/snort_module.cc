@@ -549,6 +549,11 @@ static const Parameter s_params[] =
     { "--treat-drop-as-alert", Parameter::PT_IMPLIED, nullptr, nullptr,
       "converts drop, block, and reset rules into alert rules when loaded" },
 
+    { "--trough-shard", Parameter::PT_STRING, nullptr, nullptr,
+      "<i/n> process shard i (0 based) of the pcap inputs split n ways; "
+      "cooperating processes write per shard stats files and the last one "
+      "merges them" },
+
     { "--treat-drop-as-ignore", Parameter::PT_IMPLIED, nullptr, nullptr,
       "use drop, block, and reset rules to ignore session traffic when not inline" },
 
@@ -1059,6 +1064,16 @@ bool SnortModule::set(const char*, Value& v, SnortConfig* sc)
     else if ( v.is("--treat-drop-as-alert") )
         sc->set_treat_drop_as_alert(true);
 
+    else if ( v.is("--trough-shard") )
+    {
+        unsigned idx, cnt;
+
+        if ( sscanf(v.get_string(), "%u/%u", &idx, &cnt) != 2 || !cnt || idx >= cnt )
+            ParseError("--trough-shard format is i/n with 0 <= i < n");
+        else
+            Trough::set_shard(idx, cnt);
+    }
+
     else if ( v.is("--treat-drop-as-ignore") )
         sc->set_treat_drop_as_ignore(true);
 
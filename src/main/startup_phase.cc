@@ -0,0 +1,111 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2020-2020 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "startup_phase.h"
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "log/messages.h"
+#include "utils/stats.h"
+
+using namespace snort;
+
+// only interesting module times are reported; module config is cheap
+// across the board except for a few heavyweights
+static const double min_module_seconds = 0.010;
+static const unsigned max_modules_reported = 10;
+
+static std::vector<std::pair<std::string, double>> s_phases;
+static std::map<std::string, double> s_mod_times;
+static const char* s_phase = nullptr;
+static hr_time s_phase_start;
+static bool s_done = false;
+
+static double seconds_since(const hr_time& start)
+{ return TO_USECS(SnortClock::now() - start) / 1e6; }
+
+void StartupPhase::begin(const char* name)
+{
+    if ( s_done )
+        return;
+
+    s_phase = name;
+    s_phase_start = SnortClock::now();
+}
+
+void StartupPhase::end()
+{
+    if ( s_done or !s_phase )
+        return;
+
+    s_phases.emplace_back(s_phase, seconds_since(s_phase_start));
+    s_phase = nullptr;
+}
+
+void StartupPhase::charge(const char* module_name, const hr_time& start)
+{
+    if ( s_done )
+        return;
+
+    s_mod_times[module_name] += seconds_since(start);
+}
+
+void StartupPhase::report()
+{
+    if ( s_done )
+        return;
+
+    s_done = true;
+
+    if ( s_phases.empty() )
+        return;
+
+    LogLabel("startup");
+
+    for ( const auto& phase : s_phases )
+        LogMessage("%25.25s: %.3f seconds\n", phase.first.c_str(), phase.second);
+
+    std::vector<std::pair<std::string, double>> mods;
+
+    for ( const auto& mod : s_mod_times )
+        if ( mod.second >= min_module_seconds )
+            mods.emplace_back(mod);
+
+    std::sort(mods.begin(), mods.end(),
+        [](const std::pair<std::string, double>& a, const std::pair<std::string, double>& b)
+        { return a.second > b.second; });
+
+    if ( mods.size() > max_modules_reported )
+        mods.resize(max_modules_reported);
+
+    if ( !mods.empty() )
+        LogMessage("%25.25s:\n", "slowest modules");
+
+    for ( const auto& mod : mods )
+        LogMessage("%25.25s: %.3f seconds\n", mod.first.c_str(), mod.second);
+
+    s_phases.clear();
+    s_mod_times.clear();
+}
@@ -0,0 +1,44 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2020-2020 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+
+#ifndef STARTUP_PHASE_H
+#define STARTUP_PHASE_H
+
+// wall clock attribution for the config load and compile phases so a slow
+// startup can be traced to a phase or module.  phases are flat (they do
+// not nest); per module config time is charged separately by the module
+// manager.  the report is printed once when init completes and further
+// charges are ignored so reloads don't accumulate into stale numbers.
+
+#include "time/clock_defs.h"
+
+namespace snort
+{
+class StartupPhase
+{
+public:
+    static void begin(const char* name);
+    static void end();
+
+    // accumulate time since start against a module's config callbacks
+    static void charge(const char* module_name, const hr_time& start);
+
+    static void report();
+};
+}
+#endif
@@ -157,6 +157,28 @@ void ThreadConfig::set_named_thread_affinity(const std::string& name, CpuSet* cp
         ParseWarning(WARN_CONF, "This platform does not support setting thread affinity.\n");
 }
 
+// Bind the calling thread's memory allocations to the locality of its
+// cpuset so that first-touch allocations (flow cache, reassembly buffers,
+// inspection scratch) land on the thread's own NUMA node.  When the cpuset
+// spans all nodes (the unpinned default) this is equivalent to the system
+// policy, so it is safe to apply unconditionally.  Memory binding is best
+// effort; unlike cpu binding, failure is not fatal.
+static void implement_thread_membind(hwloc_const_cpuset_t cpuset)
+{
+    if (!topology_support->membind->set_thisthread_membind ||
+        !topology_support->membind->bind_membind)
+        return;
+
+    if (hwloc_set_membind(topology, cpuset, HWLOC_MEMBIND_BIND, HWLOC_MEMBIND_THREAD))
+    {
+        char* s;
+        hwloc_bitmap_list_asprintf(&s, cpuset);
+        LogMessage("Could not bind thread memory to %s: %s (%d)\n",
+            s, get_error(errno), errno);
+        free(s);
+    }
+}
+
 void ThreadConfig::implement_thread_affinity(SThreadType type, unsigned id)
 {
     if (!topology_support->cpubind->set_thisthread_cpubind)
@@ -188,6 +210,8 @@ void ThreadConfig::implement_thread_affinity(SThreadType type, unsigned id)
             id, type, s, get_error(errno), errno);
     }
 
+    implement_thread_membind(desired_cpuset);
+
     free(s);
 }
 
@@ -216,6 +240,8 @@ void ThreadConfig::implement_named_thread_affinity(const std::string& name)
                 name.c_str(), s, get_error(errno), errno);
         }
 
+        implement_thread_membind(desired_cpuset);
+
         free(s);
     }
     else
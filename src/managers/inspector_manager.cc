@@ -182,11 +182,30 @@ struct PHVector
     PHInstance** vec;
     unsigned num;
 
+    // subsets of vec keyed by packet type, precomputed once the list is
+    // final so steady state dispatch is a tight loop with no per
+    // inspector proto bits tests (see ::execute); PktType::NONE packets
+    // still filter on proto_bits
+    PHInstance** typed[to_utype(PktType::MAX)];
+    unsigned typed_num[to_utype(PktType::MAX)];
+
     PHVector()
-    { vec = nullptr; num = 0; }
+    {
+        vec = nullptr;
+        num = 0;
+        memset(typed, 0, sizeof(typed));
+        memset(typed_num, 0, sizeof(typed_num));
+    }
 
     ~PHVector()
-    { if ( vec ) delete[] vec; }
+    {
+        if ( vec )
+            delete[] vec;
+
+        for ( unsigned t = 0; t < to_utype(PktType::MAX); t++ )
+            if ( typed[t] )
+                delete[] typed[t];
+    }
 
     void alloc(unsigned max)
     { vec = new PHInstance*[max]; }
@@ -195,8 +214,31 @@ struct PHVector
     { vec[num++] = p; }
 
     void add_control(PHInstance*);
+    void index_types();
 };
 
+void PHVector::index_types()
+{
+    for ( unsigned t = 1; t < to_utype(PktType::MAX); t++ )
+    {
+        if ( typed[t] )
+        {
+            delete[] typed[t];
+            typed[t] = nullptr;
+        }
+        typed_num[t] = 0;
+
+        if ( !num )
+            continue;
+
+        typed[t] = new PHInstance*[num];
+
+        for ( unsigned i = 0; i < num; i++ )
+            if ( BIT(t) & vec[i]->pp_class.api.proto_bits )
+                typed[t][typed_num[t]++] = vec[i];
+    }
+}
+
 // FIXIT-L a more sophisticated approach to handling controls etc. may be
 // warranted such as a configuration or priority scheme (a la 2X).  for
 // now we only require that appid run first among controls.
@@ -293,6 +335,13 @@ void FrameworkPolicy::vectorize(SnortConfig* sc)
             break;
         }
     }
+
+    // probes accumulate into the default policy across all policies and
+    // controls may be pruned later, so those are (re)indexed separately
+    packet.index_types();
+    network.index_types();
+    session.index_types();
+    control.index_types();
 }
 
 //-------------------------------------------------------------------------
@@ -995,6 +1044,12 @@ bool InspectorManager::configure(SnortConfig* sc, bool cloned)
     set_inspection_policy(sc);
     SearchTool::set_conf(nullptr);
 
+    // probes accumulate into the default policy as each policy above is
+    // vectorized, so their type index is built after the whole walk
+    if ( FrameworkPolicy* fp =
+        sc->policy_map->get_inspection_policy(0)->framework_policy )
+        fp->probe.index_types();
+
     return ok;
 }
 
@@ -1015,6 +1070,7 @@ void InspectorManager::prepare_controls(SnortConfig* sc)
             fp->control.vec[c++] = fp->control.vec[i];
     }
     fp->control.num = c;
+    fp->control.index_types();
 }
 
 void InspectorManager::print_config(SnortConfig* sc)
@@ -1058,7 +1114,7 @@ void InspectorManager::print_config(SnortConfig* sc)
 // packet handling
 //-------------------------------------------------------------------------
 
-template<bool T>
+template<bool T, bool F = false>
 static inline void execute(
     Packet* p, PHInstance** prep, unsigned num)
 {
@@ -1087,7 +1143,9 @@ static inline void execute(
 
         // FIXIT-L ideally we could eliminate PktType and just use
         // proto_bits but things like teredo need to be fixed up.
-        if ( p->type() == PktType::NONE )
+        if ( F )
+            (*prep)->handler->eval(p);  // prefiltered by PHVector::index_types
+        else if ( p->type() == PktType::NONE )
         {
             if ( p->proto_bits & ppc.api.proto_bits )
                 (*prep)->handler->eval(p);
@@ -1101,6 +1159,17 @@ static inline void execute(
     }
 }
 
+template<bool T>
+static inline void execute(Packet* p, const PHVector& v)
+{
+    const unsigned t = (unsigned)p->type();
+
+    if ( t and v.typed[t] )
+        execute<T, true>(p, v.typed[t], v.typed_num[t]);
+    else
+        execute<T>(p, v.vec, v.num);
+}
+
 // FIXIT-L use inspection events instead of exec
 void InspectorManager::bumble(Packet* p)
 {
@@ -1186,7 +1255,7 @@ void InspectorManager::internal_execute(Packet* p)
         // be elevated from inspector to framework component (it is just
         // a flow control wrapper) and use eval() instead of process()
         // for stream_*.
-        ::execute<T>(p, fp->session.vec, fp->session.num);
+        ::execute<T>(p, fp->session);
         fp = get_inspection_policy()->framework_policy;
     }
     // must check between each ::execute()
@@ -1194,7 +1263,7 @@ void InspectorManager::internal_execute(Packet* p)
         return;
 
     if ( !p->is_cooked() )
-        ::execute<T>(p, fp->packet.vec, fp->packet.num);
+        ::execute<T>(p, fp->packet);
 
     if ( p->disable_inspect )
         return;
@@ -1205,24 +1274,31 @@ void InspectorManager::internal_execute(Packet* p)
     if ( !p->flow )
     {
         if (fp_dft != fp)
-            ::execute<T>(p, fp_dft->network.vec, fp_dft->network.num);
-        ::execute<T>(p, fp->network.vec, fp->network.num);
+            ::execute<T>(p, fp_dft->network);
+        ::execute<T>(p, fp->network);
 
         if ( p->disable_inspect )
             return;
 
-        ::execute<T>(p, fp_dft->control.vec, fp_dft->control.num);
+        ::execute<T>(p, fp_dft->control);
     }
     else
     {
+        // Trusted flows have been handed off to the DAQ - every interest has
+        // been released and inspection disabled - so don't walk the chains
+        // below just to re-test the same flags on each inspector
+        if ( p->flow->flow_state == Flow::FlowState::ALLOW and
+            p->flow->is_inspection_disabled() )
+            return;
+
         if ( !p->has_paf_payload() and p->flow->flow_state == Flow::FlowState::INSPECT )
             p->flow->session->process(p);
 
         if ( !p->flow->service )
         {
             if (fp_dft != fp)
-                ::execute<T>(p, fp_dft->network.vec, fp_dft->network.num);
-            ::execute<T>(p, fp->network.vec, fp->network.num);
+                ::execute<T>(p, fp_dft->network);
+            ::execute<T>(p, fp->network);
         }
 
         if ( p->disable_inspect )
@@ -1232,7 +1308,7 @@ void InspectorManager::internal_execute(Packet* p)
             full_inspection<T>(p);
 
         if ( !p->disable_inspect and !p->flow->is_inspection_disabled() )
-            ::execute<T>(p, fp_dft->control.vec, fp_dft->control.num);
+            ::execute<T>(p, fp_dft->control);
     }
 
     if ( T )
@@ -1247,7 +1323,7 @@ void InspectorManager::probe(Packet* p)
     FrameworkPolicy* fp = policy->framework_policy;
 
     if ( !trace_enabled(snort_trace, TRACE_INSPECTOR_MANAGER, DEFAULT_TRACE_LOG_LEVEL, p) )
-        ::execute<false>(p, fp->probe.vec, fp->probe.num);
+        ::execute<false>(p, fp->probe);
     else
     {
         Stopwatch<SnortClock> timer;
@@ -1258,7 +1334,7 @@ void InspectorManager::probe(Packet* p)
 
         timer.start();
 
-        ::execute<true>(p, fp->probe.vec, fp->probe.num);
+        ::execute<true>(p, fp->probe);
 
         trace_ulogf(snort_trace, TRACE_INSPECTOR_MANAGER, p,
             "end inspection, %s, packet %" PRId64", context %" PRId64", total time: %" PRId64" usec\n",
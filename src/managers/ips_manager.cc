@@ -313,7 +313,7 @@ IpsOption* IpsManager::option_end(
         ips = (IpsOption*)prev;
     }
 
-    OptFpList* fpl = AddOptFuncToList(fp_eval_option, otn);
+    OptFpList* fpl = AddOptFuncToList(fp_eval_option, otn, sc);
     fpl->ips_opt = ips;
     fpl->type = ips->get_type();
 
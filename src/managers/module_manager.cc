@@ -41,6 +41,8 @@
 #include "main/shell.h"
 #include "main/snort.h"
 #include "main/snort_config.h"
+#include "main/startup_phase.h"
+#include "main/thread.h"
 #include "parser/parse_conf.h"
 #include "parser/parser.h"
 #include "parser/vars.h"
@@ -75,7 +77,6 @@ static std::unordered_map<std::string, const Parameter*> s_pmap;
 static unsigned s_errors = 0;
 
 set<uint32_t> ModuleManager::gids;
-mutex ModuleManager::stats_mutex;
 
 static string s_current;
 static string s_name;
@@ -443,9 +444,35 @@ static bool set_var(const char* fqn, Value& val)
     return true;
 }
 
+// time the module's config callbacks so startup cost can be charged to
+// the module that incurred it
+static bool mod_set(Module* m, const char* fqn, Value& v)
+{
+    hr_time start = SnortClock::now();
+    bool ok = m->verified_set(fqn, v, s_config);
+    StartupPhase::charge(m->get_name(), start);
+    return ok;
+}
+
+static bool mod_begin(Module* m, const char* fqn, int idx)
+{
+    hr_time start = SnortClock::now();
+    bool ok = m->verified_begin(fqn, idx, s_config);
+    StartupPhase::charge(m->get_name(), start);
+    return ok;
+}
+
+static bool mod_end(Module* m, const char* fqn, int idx)
+{
+    hr_time start = SnortClock::now();
+    bool ok = m->verified_end(fqn, idx, s_config);
+    StartupPhase::charge(m->get_name(), start);
+    return ok;
+}
+
 static bool set_param(Module* mod, const char* fqn, Value& val)
 {
-    if ( !mod->verified_set(fqn, val, s_config) )
+    if ( !mod_set(mod, fqn, val) )
     {
         ParseError("%s is invalid", fqn);
         ++s_errors;
@@ -564,7 +591,7 @@ static bool begin(Module* m, const Parameter* p, const char* s, int idx, int dep
     // Module::(verified_)begin() will be called for top-level tables, lists, and list items only
     if ( top_level(s) )
     {
-        if ( !m->verified_begin(s, idx, s_config) )
+        if ( !mod_begin(m, s, idx) )
             return false;
         // don't set list defaults
         if ( m->is_list() and !idx )
@@ -581,7 +608,7 @@ static bool begin(Module* m, const Parameter* p, const char* s, int idx, int dep
         if ( (!idx and p->type == Parameter::PT_LIST) or
              (idx and p->type != Parameter::PT_LIST) )
         {
-            if ( !m->verified_begin(s, idx, s_config) )
+            if ( !mod_begin(m, s, idx) )
                 return false;
         }
         if ( p->type == Parameter::PT_LIST )
@@ -672,7 +699,7 @@ static bool end(Module* m, const Parameter* p, const char* s, int idx)
          (!idx and p->type == Parameter::PT_LIST) or
          (idx and p->type != Parameter::PT_LIST) )
     {
-        return m->verified_end(s, idx, s_config);
+        return mod_end(m, s, idx);
     }
     return true;
 }
@@ -1366,7 +1393,7 @@ void ModuleManager::dump_stats(const char* skip, bool dynamic)
     {
         if ( !skip || !strstr(skip, mh->mod->get_name()) )
         {
-            lock_guard<mutex> lock(stats_mutex);
+            lock_guard<mutex> lock(mh->mod->get_stats_lock());
             if ( dynamic )
                 mh->mod->show_dynamic_stats();
             else
@@ -1378,10 +1405,19 @@ void ModuleManager::dump_stats(const char* skip, bool dynamic)
 void ModuleManager::accumulate()
 {
     auto mod_hooks = get_all_modhooks();
+    vector<ModHook*> hooks(mod_hooks.begin(), mod_hooks.end());
 
-    for ( auto* mh : mod_hooks )
+    if ( hooks.empty() )
+        return;
+
+    // stagger each thread's sweep so concurrent get_stats requests take a
+    // given module's lock in passing instead of convoying module by module
+    const unsigned start = get_instance_id() % hooks.size();
+
+    for ( unsigned i = 0; i < hooks.size(); ++i )
     {
-        lock_guard<mutex> lock(stats_mutex);
+        ModHook* mh = hooks[(start + i) % hooks.size()];
+        lock_guard<mutex> lock(mh->mod->get_stats_lock());
         mh->mod->prep_counts();
         mh->mod->sum_stats(true);
     }
@@ -1392,7 +1428,7 @@ void ModuleManager::accumulate_offload(const char* name)
     ModHook* mh = get_hook(name);
     if ( mh )
     {
-        lock_guard<mutex> lock(stats_mutex);
+        lock_guard<mutex> lock(mh->mod->get_stats_lock());
         mh->mod->prep_counts();
         mh->mod->sum_stats(true);
     }
@@ -1404,7 +1440,7 @@ void ModuleManager::reset_stats(SnortConfig*)
 
     for ( auto* mh : mod_hooks )
     {
-        lock_guard<mutex> lock(stats_mutex);
+        lock_guard<mutex> lock(mh->mod->get_stats_lock());
         mh->mod->reset_stats();
     }
 }
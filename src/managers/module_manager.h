@@ -25,7 +25,6 @@
 
 #include <cstdint>
 #include <list>
-#include <mutex>
 #include <set>
 
 #include "main/snort_types.h"
@@ -90,7 +89,6 @@ public:
     static void reset_stats(SnortConfig*);
 
     static std::set<uint32_t> gids;
-    SO_PUBLIC static std::mutex stats_mutex;
 };
 }
 
@@ -22,7 +22,11 @@
 #include "config.h"
 #endif
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cinttypes>
+#include <vector>
 
 #include "memory_cap.h"
 
@@ -74,6 +78,99 @@ struct Tracker
 
 static Tracker s_tracker;
 
+// -----------------------------------------------------------------------------
+// global accounting
+//
+// per-thread usage is batched into a shared total in epochs: a thread
+// publishes only when its unpublished delta exceeds the quantum, so the
+// allocation fast path never touches shared state and the soft global cap
+// can overshoot by at most threads * quantum.  a thread's own unpublished
+// delta is included in its view of the total, so its frees are visible to
+// its own cap checks immediately.
+// -----------------------------------------------------------------------------
+
+static constexpr ssize_t epoch_quantum = 256 * 1024;
+
+static std::atomic<ssize_t> s_global_used { 0 };
+static THREAD_LOCAL ssize_t s_unpublished = 0;
+
+static inline void global_update(ssize_t delta)
+{
+    s_unpublished += delta;
+
+    if ( s_unpublished >= epoch_quantum or s_unpublished <= -epoch_quantum )
+    {
+        s_global_used.fetch_add(s_unpublished, std::memory_order_relaxed);
+        s_unpublished = 0;
+        ++mem_stats.epoch_syncs;
+    }
+}
+
+struct GlobalTracker
+{
+    size_t used() const
+    {
+        ssize_t total = s_global_used.load(std::memory_order_relaxed) + s_unpublished;
+        return total > 0 ? (size_t)total : 0;
+    }
+};
+
+static GlobalTracker s_global_tracker;
+
+// -----------------------------------------------------------------------------
+// allocation site sampling
+//
+// every Nth tracked allocation records the address of the call site that
+// invoked update_allocations().  a single return-address frame keeps the
+// sampled path to a few instructions and avoids stack unwinds, which are
+// unreliable in hardened builds; addresses resolve to source lines with
+// addr2line against the same binary.  sampled hits are rare by
+// construction, so a small shared table with relaxed atomics suffices.
+// -----------------------------------------------------------------------------
+
+static size_t s_sample_interval = 0;
+static THREAD_LOCAL size_t s_sample_countdown = 0;
+
+struct AllocSite
+{
+    std::atomic<uintptr_t> site { 0 };
+    std::atomic<uint64_t> samples { 0 };
+    std::atomic<uint64_t> sampled_bytes { 0 };
+};
+
+static constexpr size_t site_table_size = 256;  // must be a power of two
+
+static AllocSite s_sites[site_table_size];
+static std::atomic<uint64_t> s_site_drops { 0 };
+
+static void record_site(void* ra, size_t n)
+{
+    const uintptr_t site = (uintptr_t)ra;
+    const size_t start = (site >> 4) & (site_table_size - 1);
+
+    for ( size_t probe = 0; probe < site_table_size; ++probe )
+    {
+        AllocSite& slot = s_sites[(start + probe) & (site_table_size - 1)];
+        uintptr_t cur = slot.site.load(std::memory_order_relaxed);
+
+        if ( !cur )
+        {
+            // losing the claim to another thread inserting the same site is
+            // fine; anything else means the slot is taken - keep probing
+            if ( !slot.site.compare_exchange_strong(cur, site,
+                    std::memory_order_relaxed) and cur != site )
+                continue;
+        }
+        else if ( cur != site )
+            continue;
+
+        slot.samples.fetch_add(1, std::memory_order_relaxed);
+        slot.sampled_bytes.fetch_add(n, std::memory_order_relaxed);
+        return;
+    }
+    s_site_drops.fetch_add(1, std::memory_order_relaxed);
+}
+
 // -----------------------------------------------------------------------------
 // helpers
 // -----------------------------------------------------------------------------
@@ -118,6 +215,7 @@ inline size_t calculate_threshold(size_t cap, size_t threshold)
 // -----------------------------------------------------------------------------
 
 size_t MemoryCap::thread_cap = 0;
+size_t MemoryCap::global_cap = 0;
 size_t MemoryCap::preemptive_threshold = 0;
 
 // -----------------------------------------------------------------------------
@@ -129,7 +227,7 @@ bool MemoryCap::free_space(size_t n)
     if ( !is_packet_thread() )
         return true;
 
-    if ( !thread_cap )
+    if ( !thread_cap and !global_cap )
         return true;
 
     static THREAD_LOCAL bool entered = false;
@@ -139,7 +237,13 @@ bool MemoryCap::free_space(size_t n)
         return false;
 
     entered = true;
-    bool avail = memory::free_space(n, thread_cap, s_tracker, prune_handler);
+    bool avail = !thread_cap or memory::free_space(n, thread_cap, s_tracker, prune_handler);
+
+    // the global cap is soft: other threads' usage is only as current as
+    // their last epoch sync, so pruning may start a little late
+    if ( avail and global_cap )
+        avail = memory::free_space(n, global_cap, s_global_tracker, prune_handler);
+
     entered = false;
 
     return avail;
@@ -162,6 +266,13 @@ void MemoryCap::update_allocations(size_t n)
     auto in_use = s_tracker.used();
     if ( in_use > mem_stats.max_in_use )
         mem_stats.max_in_use = in_use;
+    if ( global_cap )
+        global_update(n);
+    if ( s_sample_interval and ++s_sample_countdown >= s_sample_interval )
+    {
+        s_sample_countdown = 0;
+        record_site(__builtin_return_address(0), n);
+    }
     mp_active_context.update_allocs(n);
 }
 
@@ -172,6 +283,8 @@ void MemoryCap::update_deallocations(size_t n)
 
     n = fudge_it(n);
     s_tracker.deallocate(n);
+    if ( global_cap )
+        global_update(-(ssize_t)n);
     mp_active_context.update_deallocs(n);
 }
 
@@ -193,6 +306,8 @@ void MemoryCap::calculate()
     const MemoryConfig& config = *SnortConfig::get_conf()->memory;
 
     thread_cap = config.cap;
+    global_cap = config.global_cap;
+    s_sample_interval = config.sample_interval;
     preemptive_threshold = memory::calculate_threshold(thread_cap, config.threshold);
 }
 
@@ -209,6 +324,7 @@ void MemoryCap::print()
     if ( verbose )
     {
         LogMessage("    thread cap: %zu\n", thread_cap);
+        LogMessage("    global cap: %zu\n", global_cap);
         LogMessage("    thread preemptive threshold: %zu\n", preemptive_threshold);
     }
 
@@ -220,6 +336,49 @@ void MemoryCap::print()
     }
 }
 
+void MemoryCap::dump_sites()
+{
+    LogLabel("memory allocation sites (sampled)");
+
+    if ( !s_sample_interval )
+    {
+        LogMessage("    sampling disabled; set memory.sample_interval\n");
+        return;
+    }
+
+    // snapshot while packet threads keep sampling; counters only grow, so
+    // the worst case is a slightly stale line
+    std::vector<const AllocSite*> sites;
+
+    for ( const AllocSite& slot : s_sites )
+        if ( slot.site.load(std::memory_order_relaxed) )
+            sites.push_back(&slot);
+
+    std::sort(sites.begin(), sites.end(),
+        [](const AllocSite* a, const AllocSite* b)
+        {
+            return a->sampled_bytes.load(std::memory_order_relaxed) >
+                b->sampled_bytes.load(std::memory_order_relaxed);
+        });
+
+    LogMessage("    sample interval: %zu\n", s_sample_interval);
+
+    for ( const AllocSite* slot : sites )
+    {
+        const uint64_t samples = slot->samples.load(std::memory_order_relaxed);
+        const uint64_t bytes = slot->sampled_bytes.load(std::memory_order_relaxed);
+
+        LogMessage("    %p: samples: %" PRIu64 ", sampled bytes: %" PRIu64
+            ", estimated bytes: %" PRIu64 "\n", (void*)slot->site.load(std::memory_order_relaxed),
+            samples, bytes, bytes * s_sample_interval);
+    }
+
+    const uint64_t drops = s_site_drops.load(std::memory_order_relaxed);
+
+    if ( drops )
+        LogMessage("    samples dropped (site table full): %" PRIu64 "\n", drops);
+}
+
 } // namespace memory
 
 #ifdef UNIT_TEST
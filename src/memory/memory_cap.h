@@ -43,8 +43,12 @@ public:
     // call from main thread
     static void print();
 
+    // call from main thread; logs sampled allocation sites
+    static void dump_sites();
+
 private:
     static size_t thread_cap;
+    static size_t global_cap;
     static size_t preemptive_threshold;
 };
 
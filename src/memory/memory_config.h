@@ -26,6 +26,9 @@
 struct MemoryConfig
 {
     size_t cap = 0;
+    size_t global_cap = 0;
+    size_t reload_cap = 0;
+    size_t sample_interval = 0;
     unsigned threshold = 0;
 
     constexpr MemoryConfig() = default;
@@ -26,10 +26,29 @@
 
 #include "main/snort_config.h"
 
+#include "memory_cap.h"
 #include "memory_config.h"
 
 using namespace snort;
 
+//-----------------------------------------------------------------------------
+// commands
+//-----------------------------------------------------------------------------
+
+static int memory_dump_sites(lua_State*)
+{
+    memory::MemoryCap::dump_sites();
+    return 0;
+}
+
+static const Command memory_cmds[] =
+{
+    { "dump_sites", memory_dump_sites, nullptr,
+        "dump sampled allocation sites (requires sample_interval)" },
+
+    { nullptr, nullptr, nullptr, nullptr }
+};
+
 // -----------------------------------------------------------------------------
 // memory attributes
 // -----------------------------------------------------------------------------
@@ -43,6 +62,18 @@ static const Parameter s_params[] =
     { "cap", Parameter::PT_INT, "0:maxSZ", "0",
         "set the per-packet-thread cap on memory (bytes, 0 to disable)" },
 
+    { "global_cap", Parameter::PT_INT, "0:maxSZ", "0",
+        "set a soft cap on total memory across packet threads (bytes, 0 to disable); "
+        "usage is reconciled in epochs so overshoot is bounded, not zero" },
+
+    { "reload_cap", Parameter::PT_INT, "0:maxSZ", "0",
+        "fail a config reload if process resident memory exceeds this while "
+        "both configs are resident (bytes, 0 to disable)" },
+
+    { "sample_interval", Parameter::PT_INT, "0:maxSZ", "0",
+        "record the call site of every Nth tracked allocation "
+        "(0 to disable); dump with memory.dump_sites()" },
+
     { "threshold", Parameter::PT_INT, "0:100", "0",
         "set the per-packet-thread threshold for preemptive cleanup actions "
         "(percent, 0 to disable)" },
@@ -63,6 +94,11 @@ const PegInfo mem_pegs[] =
     { CountType::NOW, "reap_failures", "failures to reclaim memory" },
     { CountType::MAX, "max_in_use", "highest allocated - deallocated" },
     { CountType::NOW, "total_fudge", "sum of all adjustments" },
+    { CountType::NOW, "epoch_syncs", "reconciliations of this thread's usage into the global total" },
+    { CountType::NOW, "flow_prunes", "flow cache prunes under memory pressure" },
+    { CountType::NOW, "flow_prune_bytes", "tracked bytes freed by flow cache prunes" },
+    { CountType::NOW, "host_prunes", "host cache prunes under memory pressure" },
+    { CountType::NOW, "host_prune_bytes", "bytes freed by host cache prunes" },
     { CountType::END, nullptr, nullptr }
 };
 
@@ -81,6 +117,15 @@ bool MemoryModule::set(const char*, Value& v, SnortConfig* sc)
     if ( v.is("cap") )
         sc->memory->cap = v.get_size();
 
+    else if ( v.is("global_cap") )
+        sc->memory->global_cap = v.get_size();
+
+    else if ( v.is("reload_cap") )
+        sc->memory->reload_cap = v.get_size();
+
+    else if ( v.is("sample_interval") )
+        sc->memory->sample_interval = v.get_size();
+
     else if ( v.is("threshold") )
         sc->memory->threshold = v.get_uint8();
 
@@ -99,6 +144,9 @@ bool MemoryModule::end(const char*, int, SnortConfig*)
 bool MemoryModule::is_active()
 { return configured; }
 
+const Command* MemoryModule::get_commands() const
+{ return memory_cmds; }
+
 const PegInfo* MemoryModule::get_pegs() const
 { return mem_pegs; }
 
@@ -33,6 +33,11 @@ struct MemoryCounts
     PegCount reap_failures;
     PegCount max_in_use;
     PegCount total_fudge;
+    PegCount epoch_syncs;
+    PegCount flow_prunes;
+    PegCount flow_prune_bytes;
+    PegCount host_prunes;
+    PegCount host_prune_bytes;
 };
 
 extern THREAD_LOCAL MemoryCounts mem_stats;
@@ -42,6 +47,7 @@ class MemoryModule : public snort::Module
 public:
     MemoryModule();
 
+    const snort::Command* get_commands() const override;
     const PegInfo* get_pegs() const override;
     PegCount* get_counts() const override;
 
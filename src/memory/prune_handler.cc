@@ -24,16 +24,94 @@
 
 #include "prune_handler.h"
 
+#include "host_tracker/host_cache.h"
+#include "main/thread.h"
 #include "stream/stream.h"
+#include "time/clock_defs.h"
+
+#include "memory_module.h"
 
 using namespace snort;
 
 namespace memory
 {
 
-void prune_handler()
+// directs pruning to the target currently yielding the most bytes per
+// microsecond of prune work.  yields are learned per thread by timing
+// each call and smoothing with an ewma, and are observable as the
+// per-target prune and byte pegs.  the flow cache is special: it is the
+// only target whose memory counts against the caps being enforced, so it
+// is always pruned so the caller's retry loop sees tracked usage fall;
+// cheaper caches are drained ahead of it while they out-yield it.
+
+static const size_t host_prune_batch = 16;
+static const unsigned host_probe_interval = 64;
+
+static THREAD_LOCAL double s_flow_yield = 0.0;
+
+// optimistic start so the first squeeze drains the host cache before
+// paying for flow teardown
+static THREAD_LOCAL double s_host_yield = 1.0;
+static THREAD_LOCAL unsigned s_since_host_probe = 0;
+
+static inline size_t tracked_used()
+{
+    return mem_stats.allocated > mem_stats.deallocated ?
+        mem_stats.allocated - mem_stats.deallocated : 0;
+}
+
+static inline double measure_yield(size_t freed, const hr_time& start)
+{
+    int64_t usec = TO_USECS(SnortClock::now() - start);
+
+    if ( usec < 1 )
+        usec = 1;
+
+    return (double)freed / (double)usec;
+}
+
+static void prune_hosts()
 {
+    hr_time start = SnortClock::now();
+    size_t before = host_cache.mem_size();
+
+    host_cache.prune_oldest(host_prune_batch);
+
+    size_t after = host_cache.mem_size();
+    size_t freed = before > after ? before - after : 0;
+
+    s_host_yield = (7 * s_host_yield + measure_yield(freed, start)) / 8;
+    ++mem_stats.host_prunes;
+    mem_stats.host_prune_bytes += freed;
+}
+
+static void prune_flow_cache()
+{
+    hr_time start = SnortClock::now();
+    size_t before = tracked_used();
+
     Stream::prune_flows();
+
+    size_t after = tracked_used();
+    size_t freed = before > after ? before - after : 0;
+
+    s_flow_yield = (7 * s_flow_yield + measure_yield(freed, start)) / 8;
+    ++mem_stats.flow_prunes;
+    mem_stats.flow_prune_bytes += freed;
+}
+
+void prune_handler()
+{
+    // cheap gigabytes first: drain the host cache while it out-yields the
+    // flow cache, and probe it periodically after its yield decays so a
+    // refilled cache is rediscovered
+    if ( s_host_yield > s_flow_yield or ++s_since_host_probe >= host_probe_interval )
+    {
+        s_since_host_probe = 0;
+        prune_hosts();
+    }
+
+    prune_flow_cache();
 }
 
 } // namespace memory
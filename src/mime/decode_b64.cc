@@ -28,6 +28,11 @@
 
 #include "decode_buffer.h"
 
+#if defined(__x86_64__) && defined(__GNUC__)
+#define B64_DECODE_SIMD
+#include <tmmintrin.h>
+#endif
+
 using namespace snort;
 
 void B64Decode::reset_decode_state()
@@ -36,6 +41,13 @@ void B64Decode::reset_decode_state()
     buffer->reset_saved();
 }
 
+void B64Decode::reset()
+{
+    reset_decode_state();
+    decode_bytes_read = 0;
+    buffer->reset();
+}
+
 DecodeResult B64Decode::decode_data(const uint8_t* start, const uint8_t* end, uint8_t* decode_buf)
 {
     uint32_t act_encode_size = 0, act_decode_size = 0;
@@ -120,6 +132,68 @@ uint8_t sf_decode64tab[256] =
     100,100,100,100,100,100,100,100,100,100,100,100,100,100,100,100
 };
 
+#ifdef B64_DECODE_SIMD
+// decode whole 16 character blocks to 12 output bytes per step using the
+// nibble lookup classification scheme; stops at the first block holding a
+// pad or a stray character and lets the scalar loop pick up from there,
+// which is where pads normally sit - at the very end of the attachment.
+// the store writes 16 bytes but only 12 are kept, so the caller guard
+// leaves 16 bytes of slack in the output buffer.
+__attribute__((target("ssse3")))
+static void sf_base64decode_wide(uint8_t*& cursor, const uint8_t* endofinbuf,
+    uint8_t*& outbuf_ptr, uint32_t outbuf_size, uint32_t* bytes_written,
+    uint32_t& n, uint32_t max_base64_chars)
+{
+    const __m128i lut_lo = _mm_setr_epi8(
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+        0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i lut_hi = _mm_setr_epi8(
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lut_roll = _mm_setr_epi8(
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i mask_2f = _mm_set1_epi8(0x2F);
+    const __m128i mask_0f = _mm_set1_epi8(0x0F);
+    const __m128i pack_ab = _mm_set1_epi32(0x01400140);
+    const __m128i pack_cd = _mm_set1_epi32(0x00011000);
+    const __m128i out_shuf = _mm_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+    while ((cursor + 16 <= endofinbuf) && (n + 16 <= max_base64_chars)
+        && (*bytes_written + 16 <= outbuf_size))
+    {
+        __m128i in = _mm_loadu_si128((const __m128i*)cursor);
+        __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(in, 4), mask_0f);
+        __m128i lo_nibbles = _mm_and_si128(in, mask_0f);
+        __m128i lo = _mm_shuffle_epi8(lut_lo, lo_nibbles);
+        __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+
+        /* any byte outside the base64 alphabet classifies non zero */
+        if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi),
+            _mm_setzero_si128())))
+            return;
+
+        __m128i eq_2f = _mm_cmpeq_epi8(in, mask_2f);
+        __m128i roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(eq_2f, hi_nibbles));
+        __m128i values = _mm_add_epi8(in, roll);
+        __m128i merged = _mm_madd_epi16(_mm_maddubs_epi16(values, pack_ab), pack_cd);
+
+        _mm_storeu_si128((__m128i*)outbuf_ptr, _mm_shuffle_epi8(merged, out_shuf));
+
+        cursor += 16;
+        outbuf_ptr += 12;
+        *bytes_written += 12;
+        n += 16;
+    }
+}
+
+static bool have_b64_wide()
+{
+    static const bool ssse3 = __builtin_cpu_supports("ssse3");
+    return ssse3;
+}
+#endif
+
 namespace snort
 {
 /* base64decode assumes the input data terminates with '=' and/or at the end of the input buffer
@@ -155,6 +229,13 @@ int sf_base64decode(uint8_t* inbuf, uint32_t inbuf_size, uint8_t* outbuf, uint32
     *bytes_written = 0;
     cursor = inbuf;
     outbuf_ptr = outbuf;
+
+#ifdef B64_DECODE_SIMD
+    if (have_b64_wide())
+        sf_base64decode_wide(cursor, endofinbuf, outbuf_ptr, outbuf_size,
+            bytes_written, n, max_base64_chars);
+#endif
+
     while ((cursor < endofinbuf) && (n < max_base64_chars))
     {
         if (sf_decode64tab[*cursor] != 100)
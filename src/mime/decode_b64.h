@@ -36,6 +36,8 @@ public:
 
     void reset_decode_state() override;
 
+    void reset() override;
+
 private:
     class DecodeBuffer* buffer = nullptr;
 };
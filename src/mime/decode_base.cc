@@ -36,6 +36,12 @@ void DataDecode::reset_decode_state()
     decode_bytes_read = 0;
 }
 
+void DataDecode::reset()
+{
+    reset_decode_state();
+    decode_bytes_read = 0;
+}
+
 int DataDecode::get_detection_depth()
 {
     // unlimited
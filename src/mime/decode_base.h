@@ -47,6 +47,10 @@ public:
 
     virtual void reset_decode_state();
 
+    // Full reset, including depth tracking, so one decoder can be reused
+    // across attachment sections of the same encoding
+    virtual void reset();
+
     // Used to limit number of bytes examined for rule evaluation
     int get_detection_depth();
 
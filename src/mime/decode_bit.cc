@@ -29,6 +29,12 @@ void BitDecode::reset_decode_state()
     reset_decoded_bytes();
 }
 
+void BitDecode::reset()
+{
+    reset_decode_state();
+    decode_bytes_read = 0;
+}
+
 DecodeResult BitDecode::decode_data(const uint8_t* start, const uint8_t* end, uint8_t*)
 {
     uint32_t bytes_avail = 0;
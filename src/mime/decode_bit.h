@@ -34,6 +34,8 @@ public:
 
     void reset_decode_state() override;
 
+    void reset() override;
+
 private:
     int decode_depth;
 };
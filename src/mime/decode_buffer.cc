@@ -32,6 +32,12 @@ void DecodeBuffer::reset_saved()
     prev_encoded_buf = nullptr;
 }
 
+void DecodeBuffer::reset()
+{
+    encode_bytes_read = decode_bytes_read = 0;
+    reset_saved();
+}
+
 bool DecodeBuffer::check_restore_buffer()
 {
     // 1. Stop decoding when we have reached either the decode depth or encode depth.
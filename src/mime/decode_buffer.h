@@ -40,6 +40,9 @@ public:
     void update_buffer(uint32_t act_encode_size, uint32_t act_decode_size);
 
     void reset_saved();
+
+    // Restart depth tracking for a new attachment
+    void reset();
     uint8_t* get_encode_buff() { return encodeBuf; }
     uint32_t get_decode_bytes_read() { return decode_bytes_read; }
     uint32_t get_decode_avail();
@@ -26,6 +26,7 @@
 
 #include <cctype>
 #include <cstdlib>
+#include <cstring>
 
 #include "utils/util_unfold.h"
 
@@ -39,6 +40,13 @@ void QPDecode::reset_decode_state()
     buffer->reset_saved();
 }
 
+void QPDecode::reset()
+{
+    reset_decode_state();
+    decode_bytes_read = 0;
+    buffer->reset();
+}
+
 DecodeResult QPDecode::decode_data(const uint8_t* start, const uint8_t* end, uint8_t *decode_buf)
 {
     uint32_t act_encode_size = 0, act_decode_size = 0, bytes_read = 0;
@@ -99,6 +107,30 @@ QPDecode::~QPDecode()
         delete buffer;
 }
 
+/* Bytes copied through unchanged - printable, blank, CR and LF - in table
+ * form so the plain text fast path below can test and bulk copy runs */
+struct QPCopyTable
+{
+    bool ok[256] = {};
+
+    QPCopyTable()
+    {
+        for (int c = 0; c < 256; c++)
+            ok[c] = ((c < 0x80) && (isprint(c) || isblank(c))) || c == '\r' || c == '\n';
+    }
+};
+
+static const QPCopyTable qp_copy;
+
+/* Only called after isxdigit() has accepted ch */
+static inline uint8_t qp_hex_value(char ch)
+{
+    if (isdigit((int)ch))
+        return ch - '0';
+
+    return toupper((int)ch) - 'A' + 10;
+}
+
 int sf_qpdecode(const char* src, uint32_t slen, char* dst, uint32_t dlen, uint32_t* bytes_read,
     uint32_t* bytes_copied)
 {
@@ -111,51 +143,64 @@ int sf_qpdecode(const char* src, uint32_t slen, char* dst, uint32_t dlen, uint32
     while ( (*bytes_read < slen) && (*bytes_copied < dlen))
     {
         char ch = src[*bytes_read];
+
+        if ( ch != '=' )
+        {
+            /* Plain text: copy the run up to the next '=' in one shot.
+             * Bytes failing the copy test are dropped one at a time as the
+             * per byte loop did. */
+            uint32_t in_avail = slen - *bytes_read;
+            uint32_t out_avail = dlen - *bytes_copied;
+            uint32_t run = (in_avail < out_avail) ? in_avail : out_avail;
+            const char* p = src + *bytes_read;
+            const char* eq = (const char*)memchr(p, '=', run);
+
+            if (eq)
+                run = (uint32_t)(eq - p);
+
+            uint32_t copied = 0;
+            while ((copied < run) && qp_copy.ok[(uint8_t)p[copied]])
+                copied++;
+
+            memcpy(dst + *bytes_copied, p, copied);
+            *bytes_copied += copied;
+            *bytes_read += copied;
+
+            if (copied < run)
+                *bytes_read += 1;
+
+            continue;
+        }
+
         *bytes_read += 1;
 
-        if ( ch == '=' )
+        /* Soft line break or escaped byte */
+        if ( (*bytes_read < slen))
         {
-            if ( (*bytes_read < slen))
+            if (src[*bytes_read] == '\n')
+            {
+                *bytes_read += 1;
+                continue;
+            }
+            else if ( *bytes_read < (slen - 1) )
             {
-                if (src[*bytes_read] == '\n')
+                char ch1 = src[*bytes_read];
+                char ch2 = src[*bytes_read + 1];
+                if ( ch1 == '\r' && ch2 == '\n')
                 {
-                    *bytes_read += 1;
+                    *bytes_read += 2;
                     continue;
                 }
-                else if ( *bytes_read < (slen - 1) )
+                if (isxdigit((int)ch1) && isxdigit((int)ch2))
                 {
-                    char ch1 = src[*bytes_read];
-                    char ch2 = src[*bytes_read + 1];
-                    if ( ch1 == '\r' && ch2 == '\n')
-                    {
-                        *bytes_read += 2;
-                        continue;
-                    }
-                    if (isxdigit((int)ch1) && isxdigit((int)ch2))
-                    {
-                        char hexBuf[3];
-                        char* eptr;
-                        hexBuf[0] = ch1;
-                        hexBuf[1] = ch2;
-                        hexBuf[2] = '\0';
-                        dst[*bytes_copied]= (char)strtoul(hexBuf, &eptr, 16);
-                        if ((*eptr != '\0'))
-                        {
-                            return -1;
-                        }
-                        *bytes_read += 2;
-                        *bytes_copied +=1;
-                        continue;
-                    }
-                    dst[*bytes_copied] = ch;
+                    dst[*bytes_copied] = (char)((qp_hex_value(ch1) << 4) | qp_hex_value(ch2));
+                    *bytes_read += 2;
                     *bytes_copied +=1;
                     continue;
                 }
-                else
-                {
-                    *bytes_read -= 1;
-                    return 0;
-                }
+                dst[*bytes_copied] = ch;
+                *bytes_copied +=1;
+                continue;
             }
             else
             {
@@ -163,10 +208,10 @@ int sf_qpdecode(const char* src, uint32_t slen, char* dst, uint32_t dlen, uint32
                 return 0;
             }
         }
-        else if ( isprint(ch) || isblank(ch) || ch == '\r' || ch == '\n' )
+        else
         {
-            dst[*bytes_copied] = ch;
-            *bytes_copied +=1;
+            *bytes_read -= 1;
+            return 0;
         }
     }
 
@@ -45,6 +45,15 @@ void UUDecode::reset_decode_state()
     begin_found = end_found = false;
 }
 
+void UUDecode::reset()
+{
+    reset_decode_state();
+    decode_bytes_read = 0;
+
+    if (buffer)
+        buffer->reset();
+}
+
 DecodeResult UUDecode::decode_data(const uint8_t* start, const uint8_t* end, uint8_t* decode_buf)
 {
     uint32_t act_encode_size = 0, act_decode_size = 0, bytes_read = 0;
@@ -35,6 +35,8 @@ public:
 
     void reset_decode_state() override;
 
+    void reset() override;
+
 private:
     bool begin_found = false;
     bool end_found = false;
@@ -53,72 +53,82 @@ void MimeDecode::clear_decode_state()
 void MimeDecode::process_decode_type(const char* start, int length, bool cnt_xf,
     MimeStats* mime_stats)
 {
-    if (decoder)
-        delete decoder;
-
-    decoder = nullptr;
+    DecodeType new_type = DECODE_NONE;
 
     if (cnt_xf)
     {
-        if (config->get_b64_depth() > -1)
-        {
-            const char* tmp = SnortStrcasestr(start, length, "base64");
-
-            if ( tmp )
-            {
-                decode_type = DECODE_B64;
-                if (mime_stats)
-                    mime_stats->b64_attachments++;
-                decoder = new B64Decode(config->get_max_depth(config->get_b64_depth()),
-                        config->get_b64_depth());
-                file_decomp_reset();
-                return;
-            }
-        }
+        if ((config->get_b64_depth() > -1) && SnortStrcasestr(start, length, "base64"))
+            new_type = DECODE_B64;
 
-        if (config->get_qp_depth() > -1)
-        {
-            const char* tmp = SnortStrcasestr(start, length, "quoted-printable");
-
-            if ( tmp )
-            {
-                decode_type = DECODE_QP;
-                if (mime_stats)
-                    mime_stats->qp_attachments++;
-                decoder = new QPDecode(config->get_max_depth(config->get_qp_depth()),
-                        config->get_qp_depth());
-                file_decomp_reset();
-                return;
-            }
-        }
+        else if ((config->get_qp_depth() > -1) &&
+            SnortStrcasestr(start, length, "quoted-printable"))
+            new_type = DECODE_QP;
+
+        else if ((config->get_uu_depth() > -1) && SnortStrcasestr(start, length, "uuencode"))
+            new_type = DECODE_UU;
+    }
 
-        if (config->get_uu_depth() > -1)
+    if ((new_type == DECODE_NONE) && (config->get_bitenc_depth() > -1))
+        new_type = DECODE_BITENC;
+
+    if (new_type == DECODE_NONE)
+    {
+        if (decoder)
+            delete decoder;
+        decoder = nullptr;
+        return;
+    }
+
+    if (mime_stats)
+    {
+        switch (new_type)
         {
-            const char* tmp = SnortStrcasestr(start, length, "uuencode");
-
-            if ( tmp )
-            {
-                decode_type = DECODE_UU;
-                if (mime_stats)
-                    mime_stats->uu_attachments++;
-                decoder = new UUDecode(config->get_max_depth(config->get_uu_depth()),
-                        config->get_uu_depth());
-                file_decomp_reset();
-                return;
-            }
+        case DECODE_B64: mime_stats->b64_attachments++; break;
+        case DECODE_QP: mime_stats->qp_attachments++; break;
+        case DECODE_UU: mime_stats->uu_attachments++; break;
+        case DECODE_BITENC: mime_stats->bitenc_attachments++; break;
+        default: break;
         }
     }
 
-    if (config->get_bitenc_depth() > -1)
+    /* Same encoding as the previous section: reuse the decoder and its
+     * buffers instead of reallocating them for every attachment */
+    if (decoder && (new_type == decode_type))
     {
-        decode_type = DECODE_BITENC;
-        if (mime_stats)
-            mime_stats->bitenc_attachments++;
-        decoder = new BitDecode(config->get_max_depth(config->get_bitenc_depth()),
-            config->get_bitenc_depth());
+        decoder->reset();
         file_decomp_reset();
         return;
     }
+
+    if (decoder)
+        delete decoder;
+
+    decode_type = new_type;
+
+    switch (new_type)
+    {
+    case DECODE_B64:
+        decoder = new B64Decode(config->get_max_depth(config->get_b64_depth()),
+            config->get_b64_depth());
+        break;
+    case DECODE_QP:
+        decoder = new QPDecode(config->get_max_depth(config->get_qp_depth()),
+            config->get_qp_depth());
+        break;
+    case DECODE_UU:
+        decoder = new UUDecode(config->get_max_depth(config->get_uu_depth()),
+            config->get_uu_depth());
+        break;
+    case DECODE_BITENC:
+        decoder = new BitDecode(config->get_max_depth(config->get_bitenc_depth()),
+            config->get_bitenc_depth());
+        break;
+    default:
+        decoder = nullptr;
+        break;
+    }
+
+    file_decomp_reset();
 }
 
 DecodeResult MimeDecode::decode_data(const uint8_t* start, const uint8_t* end)
@@ -210,8 +220,8 @@ void MimeDecode::file_decomp_init()
         (decompress_zip ? FILE_ZIP_DEFL_BIT : 0);
     fd_state->Alert_Callback = nullptr;
     fd_state->Alert_Context = nullptr;
-    fd_state->Compr_Depth = 0;
-    fd_state->Decompr_Depth = 0;
+    fd_state->Compr_Depth = FILE_DECOMP_DEFAULT_COMPR_BUDGET;
+    fd_state->Decompr_Depth = FILE_DECOMP_DEFAULT_DECOMPR_BUDGET;
 
     (void)File_Decomp_Init(fd_state);
 }
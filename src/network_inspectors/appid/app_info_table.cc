@@ -120,6 +120,13 @@ AppId AppInfoManager::get_static_app_info_entry(AppId appid)
     return 0;
 }
 
+static void add_info_table_entry(AppInfoTable& table, AppId dense_id, AppInfoTableEntry* entry)
+{
+    if (table.size() <= (size_t)dense_id)
+        table.resize(dense_id + 1, nullptr);
+    table[dense_id] = entry;
+}
+
 char* AppInfoManager::strdup_to_lower(const char* source)
 {
     char* dest = snort_strdup(source);
@@ -142,18 +149,16 @@ AppInfoTableEntry* AppInfoManager::get_app_info_entry(AppId appId,
     const AppInfoTable& lookup_table)
 {
     AppId tmp;
-    AppInfoTable::const_iterator app;
     AppInfoTableEntry* entry = nullptr;
 
     if ((tmp = get_static_app_info_entry(appId)))
     {
-        app = lookup_table.find(tmp);
-        if (app != lookup_table.end())
-            entry = app->second;
+        if ((size_t)tmp < lookup_table.size())
+            entry = lookup_table[tmp];
     }
     else
     {
-        app = custom_app_info_table.find(appId);
+        auto app = custom_app_info_table.find(appId);
         if (app != custom_app_info_table.end())
             entry = app->second;
     }
@@ -190,9 +195,12 @@ AppInfoTableEntry* AppInfoManager::add_dynamic_app_entry(const char* app_name)
 
 void AppInfoManager::cleanup_appid_info_table()
 {
-    for (auto& kv: app_info_table)
-        delete(kv.second);
-    app_info_table.erase(app_info_table.begin(), app_info_table.end());
+    for (auto entry: app_info_table)
+        delete entry;
+    app_info_table.clear();
+    app_info_service_table.clear();
+    app_info_client_table.clear();
+    app_info_payload_table.clear();
 
     for (auto& kv: custom_app_info_table)
         delete(kv.second);
@@ -204,9 +212,10 @@ void AppInfoManager::cleanup_appid_info_table()
 void AppInfoManager::dump_app_info_table()
 {
     LogMessage("Cisco provided detectors:\n");
-    for (auto& kv: app_info_table)
-        LogMessage("%s\t%d\t%s\n", kv.second->app_name, kv.second->appId,
-            (kv.second->flags & APPINFO_FLAG_ACTIVE) ? "active" : "inactive");
+    for (auto entry: app_info_table)
+        if (entry)
+            LogMessage("%s\t%d\t%s\n", entry->app_name, entry->appId,
+                (entry->flags & APPINFO_FLAG_ACTIVE) ? "active" : "inactive");
 
     LogMessage("User provided detectors:\n");
     for (auto& kv: custom_app_info_table)
@@ -318,6 +327,20 @@ void AppInfoManager::load_odp_config(OdpContext& odp_ctxt, const char* path)
                     odp_ctxt.max_tp_flow_depth = max_tp_flow_depth;
                 }
             }
+            else if (!(strcasecmp(conf_key, "max_candidate_evals_per_packet")))
+            {
+                int max_candidate_evals_per_packet = atoi(conf_val);
+                if (max_candidate_evals_per_packet < 0)
+                {
+                    ParseWarning(WARN_CONF,
+                        "AppId: invalid max_candidate_evals_per_packet %d, must be 0 or more\n.",
+                        max_candidate_evals_per_packet);
+                }
+                else
+                {
+                    odp_ctxt.max_candidate_evals_per_packet = max_candidate_evals_per_packet;
+                }
+            }
             else if (!(strcasecmp(conf_key, "host_port_app_cache_lookup_interval")))
             {
                 int host_port_app_cache_lookup_interval = atoi(conf_val);
@@ -707,16 +730,16 @@ void AppInfoManager::init_appid_info_table(const AppIdConfig& config,
 
             if ((app_id = get_static_app_info_entry(entry->appId)))
             {
-                app_info_table[app_id] = entry;
+                add_info_table_entry(app_info_table, app_id, entry);
                 AppIdPegCounts::add_app_peg_info(entry->app_name_key, app_id);
             }
 
             if ((app_id = get_static_app_info_entry(entry->serviceId)))
-                app_info_service_table[app_id] = entry;
+                add_info_table_entry(app_info_service_table, app_id, entry);
             if ((app_id = get_static_app_info_entry(entry->clientId)))
-                app_info_client_table[app_id] = entry;
+                add_info_table_entry(app_info_client_table, app_id, entry);
             if ((app_id = get_static_app_info_entry(entry->payloadId)))
-                app_info_payload_table[app_id] = entry;
+                add_info_table_entry(app_info_payload_table, app_id, entry);
 
             if (!add_entry_to_app_info_name_table(entry->app_name_key, entry))
                 delete entry;
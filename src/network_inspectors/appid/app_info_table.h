@@ -83,7 +83,12 @@ public:
     char* app_name_key = nullptr;
 };
 
-typedef std::unordered_map<AppId, AppInfoTableEntry*> AppInfoTable;
+// Static AppIds compress into a small dense range (see get_static_app_info_entry),
+// so the lookup tables are contiguous vectors indexed by dense id and a hot-path
+// lookup is a bounds-checked array access instead of a hash probe. Custom appids
+// (>= SF_APPID_DYNAMIC_MIN) are sparse and stay in a map.
+typedef std::vector<AppInfoTableEntry*> AppInfoTable;
+typedef std::unordered_map<AppId, AppInfoTableEntry*> CustomAppInfoTable;
 typedef std::unordered_map<std::string, AppInfoTableEntry*> AppInfoNameTable;
 
 class AppInfoManager
@@ -153,7 +158,7 @@ private:
     AppInfoTable app_info_payload_table;
     AppInfoNameTable app_info_name_table;
     AppId next_custom_appid = SF_APPID_DYNAMIC_MIN;
-    AppInfoTable custom_app_info_table;
+    CustomAppInfoTable custom_app_info_table;
 };
 
 #endif
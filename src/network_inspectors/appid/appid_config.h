@@ -97,6 +97,9 @@ public:
     uint32_t chp_body_collection_max = 0;
     uint32_t rtmp_max_packets = 15;
     uint32_t max_tp_flow_depth = 5;
+    // Maximum candidate detector evaluations per packet; unfinished candidate
+    // lists stay in the session and resume on later packets. 0 = unlimited.
+    uint32_t max_candidate_evals_per_packet = 0;
     bool tp_allow_probes = false;
     uint32_t host_port_app_cache_lookup_interval = 10;
     uint32_t host_port_app_cache_lookup_range = 100000;
@@ -125,6 +125,9 @@ void AppIdDiscovery::do_application_discovery(Packet* p, AppIdInspector& inspect
     if (!do_pre_discovery(p, asd, inspector, protocol, outer_protocol, direction))
         return;
 
+    asd->candidate_evals_remaining =
+        asd->ctxt.get_odp_ctxt().max_candidate_evals_per_packet;
+
     AppId service_id = APP_ID_NONE;
     AppId client_id = APP_ID_NONE;
     AppId payload_id = APP_ID_NONE;
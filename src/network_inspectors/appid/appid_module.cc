@@ -268,6 +268,9 @@ static const PegInfo appid_pegs[] =
     { CountType::SUM, "service_cache_prunes", "number of times the service cache was pruned" },
     { CountType::SUM, "service_cache_adds", "number of times an entry was added to the service cache" },
     { CountType::SUM, "service_cache_removes", "number of times an item was removed from the service cache" },
+    { CountType::SUM, "deferred_service_candidates", "number of service candidate evaluations deferred to a later packet by the per-packet budget" },
+    { CountType::SUM, "deferred_client_candidates", "number of client candidate evaluations deferred to a later packet by the per-packet budget" },
+    { CountType::SUM, "wizard_seeded_services", "service discoveries seeded from a prior wizard match instead of a pattern scan" },
     { CountType::END, nullptr, nullptr },
 };
 
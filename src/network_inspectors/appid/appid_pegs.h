@@ -33,6 +33,9 @@ struct AppIdStats
     PegCount service_cache_prunes;
     PegCount service_cache_adds;
     PegCount service_cache_removes;
+    PegCount deferred_service_candidates;
+    PegCount deferred_client_candidates;
+    PegCount wizard_seeded_services;
 };
 
 #endif
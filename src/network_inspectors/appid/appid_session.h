@@ -268,6 +268,9 @@ public:
     ServiceDetector* service_detector = nullptr;
     AppIdServiceSubtype* subtype = nullptr;
     std::vector<ServiceDetector*> service_candidates;
+    // candidate detector evaluations left for the current packet; reset from
+    // max_candidate_evals_per_packet at the start of each discovery pass
+    uint32_t candidate_evals_remaining = 0;
     ServiceAppDescriptor service;
 
     // Following three fields are used only for non-http sessions. For HTTP traffic,
@@ -283,6 +286,7 @@ public:
     ClientDetector* client_detector = nullptr;
     std::map<std::string, ClientDetector*> client_candidates;
     bool tried_reverse_service = false;
+    bool tried_wizard_service = false;
 
     // FIXIT-RC netbios_name is never set to a valid value; set when netbios_domain is set?
     char* netbios_name = nullptr;
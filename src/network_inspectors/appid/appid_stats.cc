@@ -162,7 +162,7 @@ AppIdStatistics::~AppIdStatistics()
         TextLog_Term(log);
 
     if ( logBuckets )
-        snort_free(logBuckets);
+        sflist_free(logBuckets);
 
     if ( currBuckets )
     {
@@ -171,7 +171,7 @@ AppIdStatistics::~AppIdStatistics()
             fwAvlDeleteTree(bucket->appsTree, delete_record);
             snort_free(bucket);
         }
-        snort_free(currBuckets);
+        sflist_free(currBuckets);
     }
 }
 
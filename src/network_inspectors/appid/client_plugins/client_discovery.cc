@@ -25,11 +25,14 @@
 
 #include "client_discovery.h"
 
+#include <iterator>
+
 #include "profiler/profiler.h"
 #include "protocols/packet.h"
 
 #include "app_info_table.h"
 #include "appid_debug.h"
+#include "appid_module.h"
 #include "appid_session.h"
 #include "client_app_aim.h"
 #include "client_app_bit_tracker.h"
@@ -254,10 +257,23 @@ void ClientDiscovery::exec_client_detectors(AppIdSession& asd, Packet* p,
     }
     else
     {
+        const uint32_t eval_budget =
+            asd.ctxt.get_odp_ctxt().max_candidate_evals_per_packet;
         for ( auto kv = asd.client_candidates.begin(); kv != asd.client_candidates.end(); )
         {
+            if ( eval_budget and !asd.candidate_evals_remaining )
+            {
+                // Out of budget for this packet. The surviving candidates stay in
+                // the session and resume with the next packet.
+                appid_stats.deferred_client_candidates +=
+                    std::distance(kv, asd.client_candidates.end());
+                break;
+            }
+
             AppIdDiscoveryArgs disco_args(p->data, p->dsize, direction, asd, p, change_bits);
             int result = kv->second->validate(disco_args);
+            if ( eval_budget )
+                asd.candidate_evals_remaining--;
             if (appidDebug->is_active())
                 LogMessage("AppIdDbg %s %s client candidate returned %s (%d)\n",
                     appidDebug->get_debug_session(), kv->second->get_log_name().c_str(),
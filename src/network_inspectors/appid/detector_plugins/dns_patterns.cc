@@ -25,6 +25,8 @@
 #include "dns_patterns.h"
 #include "utils/util.h"
 
+#include "pattern_scan_cache.h"
+
 using namespace snort;
 
 void DnsPatternMatchers::add_host_pattern(uint8_t* pattern_str, size_t pattern_size, uint8_t type, AppId app_id)
@@ -57,6 +59,7 @@ void DnsPatternMatchers::finalize_patterns()
     }
 
     dns_host_matcher.prep();
+    generation = PatternScanCache::next_generation();
 }
 
 DnsPatternMatchers::~DnsPatternMatchers()
@@ -90,14 +93,14 @@ static int dns_host_pattern_match(void* id, void*, int, void* data, void*)
     return 0;
 }
 
-int DnsPatternMatchers::scan_hostname(const uint8_t* pattern, size_t size, AppId& client_id,
-    AppId& payload_id)
+static int scan_host_patterns(snort::SearchTool& matcher, const uint8_t* pattern, size_t size,
+    AppId& client_id, AppId& payload_id)
 {
     MatchedDnsPatterns* mp = nullptr;
     MatchedDnsPatterns* tmp_mp;
     DnsHostPattern* best_match;
 
-    dns_host_matcher.find_all((const char*)pattern, size, dns_host_pattern_match, false, &mp);
+    matcher.find_all((const char*)pattern, size, dns_host_pattern_match, false, &mp);
 
     if (!mp)
         return 0;
@@ -134,3 +137,17 @@ int DnsPatternMatchers::scan_hostname(const uint8_t* pattern, size_t size, AppId
 
     return 1;
 }
+
+int DnsPatternMatchers::scan_hostname(const uint8_t* pattern, size_t size, AppId& client_id,
+    AppId& payload_id)
+{
+    bool found;
+    if (PatternScanCache::find(SCAN_CACHE_DNS_HOST, generation, pattern, size, found,
+            client_id, payload_id))
+        return found ? 1 : 0;
+
+    found = scan_host_patterns(dns_host_matcher, pattern, size, client_id, payload_id) != 0;
+    PatternScanCache::add(SCAN_CACHE_DNS_HOST, generation, pattern, size, found,
+        client_id, payload_id);
+    return found ? 1 : 0;
+}
@@ -55,6 +55,7 @@ public:
 private:
     DnsHostPatternList* dns_host_pattern_list = nullptr;
     snort::SearchTool dns_host_matcher = snort::SearchTool();
+    uint32_t generation = 0;    // invalidates per-thread scan caches on reload
 };
 
 #endif
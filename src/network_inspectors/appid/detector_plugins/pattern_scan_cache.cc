@@ -0,0 +1,94 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2020-2020 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+
+// pattern_scan_cache.cc author Shravan Rangaraju <shrarang@cisco.com>
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "pattern_scan_cache.h"
+
+#include <atomic>
+#include <cstring>
+
+THREAD_LOCAL PatternScanCache::Entry
+    PatternScanCache::entries[SCAN_CACHE_NUM_MATCHERS][ROWS][WAYS];
+THREAD_LOCAL uint8_t PatternScanCache::lru_way[SCAN_CACHE_NUM_MATCHERS][ROWS];
+
+static uint32_t hash_text(const uint8_t* text, size_t size)
+{
+    uint32_t hash = 0;
+    for (size_t k = 0; k < size; k++)
+        hash = hash * 31 + text[k];
+    return hash;
+}
+
+bool PatternScanCache::find(ScanCacheMatcher matcher, uint32_t generation, const uint8_t* text,
+    size_t size, bool& found, AppId& client_id, AppId& payload_id)
+{
+    if (size == 0 or size > TEXT_MAX)
+        return false;
+
+    const size_t row = hash_text(text, size) & (ROWS - 1);
+
+    for (size_t way = 0; way < WAYS; way++)
+    {
+        const Entry& entry = entries[matcher][row][way];
+        if (entry.generation == generation and entry.size == size and
+            memcmp(entry.text, text, size) == 0)
+        {
+            found = entry.found;
+            if (found)
+            {
+                client_id = entry.client_id;
+                payload_id = entry.payload_id;
+            }
+            lru_way[matcher][row] = (uint8_t)(way ^ 1);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void PatternScanCache::add(ScanCacheMatcher matcher, uint32_t generation, const uint8_t* text,
+    size_t size, bool found, AppId client_id, AppId payload_id)
+{
+    if (size == 0 or size > TEXT_MAX)
+        return;
+
+    const size_t row = hash_text(text, size) & (ROWS - 1);
+    const size_t way = lru_way[matcher][row];
+    Entry& entry = entries[matcher][row][way];
+
+    entry.generation = generation;
+    entry.size = (uint8_t)size;
+    entry.found = found;
+    entry.client_id = found ? client_id : APP_ID_NONE;
+    entry.payload_id = found ? payload_id : APP_ID_NONE;
+    memcpy(entry.text, text, size);
+
+    lru_way[matcher][row] = (uint8_t)(way ^ 1);
+}
+
+uint32_t PatternScanCache::next_generation()
+{
+    static std::atomic<uint32_t> generation { 0 };
+    return ++generation;
+}
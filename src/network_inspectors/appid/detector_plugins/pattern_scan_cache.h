@@ -0,0 +1,79 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2020-2020 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+
+// pattern_scan_cache.h author Shravan Rangaraju <shrarang@cisco.com>
+
+#ifndef PATTERN_SCAN_CACHE_H
+#define PATTERN_SCAN_CACHE_H
+
+#include "main/thread.h"
+
+#include "application_ids.h"
+
+// Per-thread cache of hostname pattern scan results. Real traffic repeats the
+// same SNI, certificate and DNS names constantly, so most scans can be
+// answered here without walking a SearchTool. A hit is confirmed against the
+// full scanned text, not just its hash, and every entry is stamped with the
+// owning matcher's generation so results from detectors removed by a reload
+// are never returned. Each cache row is a two-way set with LRU replacement.
+
+enum ScanCacheMatcher : uint8_t
+{
+    SCAN_CACHE_SSL_HOST = 0,
+    SCAN_CACHE_SSL_CNAME,
+    SCAN_CACHE_DNS_HOST,
+    SCAN_CACHE_NUM_MATCHERS
+};
+
+class PatternScanCache
+{
+public:
+    // Returns true on a cache hit. found is the result of the original scan;
+    // client_id and payload_id are only written when found is true, matching
+    // the behavior of an actual scan that finds nothing.
+    static bool find(ScanCacheMatcher, uint32_t generation, const uint8_t* text, size_t size,
+        bool& found, AppId& client_id, AppId& payload_id);
+    static void add(ScanCacheMatcher, uint32_t generation, const uint8_t* text, size_t size,
+        bool found, AppId client_id, AppId payload_id);
+
+    // Stamped into each matcher when its patterns are finalized
+    static uint32_t next_generation();
+
+private:
+    PatternScanCache() = delete;
+
+    static const size_t TEXT_MAX = 95;  // longer names are always scanned directly
+    static const size_t ROWS = 128;     // must be a power of two
+    static const size_t WAYS = 2;
+
+    // Zero-initialized per thread; generation 0 never matches a live matcher
+    struct Entry
+    {
+        uint32_t generation;
+        uint8_t size;
+        bool found;
+        AppId client_id;
+        AppId payload_id;
+        uint8_t text[TEXT_MAX];
+    };
+
+    static THREAD_LOCAL Entry entries[SCAN_CACHE_NUM_MATCHERS][ROWS][WAYS];
+    static THREAD_LOCAL uint8_t lru_way[SCAN_CACHE_NUM_MATCHERS][ROWS];
+};
+
+#endif
@@ -26,6 +26,8 @@
 
 #include "utils/util.h"
 
+#include "pattern_scan_cache.h"
+
 using namespace snort;
 
 static void create_matcher(SearchTool& matcher, SslPatternList* list)
@@ -167,14 +169,31 @@ void SslPatternMatchers::finalize_patterns()
 {
     create_matcher(ssl_host_matcher, cert_pattern_list);
     create_matcher(ssl_cname_matcher, cname_pattern_list);
+    generation = PatternScanCache::next_generation();
 }
 
 bool SslPatternMatchers::scan_hostname(const uint8_t* hostname, size_t size, AppId& client_id, AppId& payload_id)
 {
-    return scan_patterns(ssl_host_matcher, hostname, size, client_id, payload_id);
+    bool found;
+    if (PatternScanCache::find(SCAN_CACHE_SSL_HOST, generation, hostname, size, found,
+            client_id, payload_id))
+        return found;
+
+    found = scan_patterns(ssl_host_matcher, hostname, size, client_id, payload_id);
+    PatternScanCache::add(SCAN_CACHE_SSL_HOST, generation, hostname, size, found,
+        client_id, payload_id);
+    return found;
 }
 
 bool SslPatternMatchers::scan_cname(const uint8_t* common_name, size_t size, AppId& client_id, AppId& payload_id)
 {
-    return scan_patterns(ssl_cname_matcher, common_name, size, client_id, payload_id);
+    bool found;
+    if (PatternScanCache::find(SCAN_CACHE_SSL_CNAME, generation, common_name, size, found,
+            client_id, payload_id))
+        return found;
+
+    found = scan_patterns(ssl_cname_matcher, common_name, size, client_id, payload_id);
+    PatternScanCache::add(SCAN_CACHE_SSL_CNAME, generation, common_name, size, found,
+        client_id, payload_id);
+    return found;
 }
@@ -60,6 +60,7 @@ private:
     SslPatternList* cname_pattern_list = nullptr;
     snort::SearchTool ssl_host_matcher = snort::SearchTool();
     snort::SearchTool ssl_cname_matcher= snort::SearchTool();
+    uint32_t generation = 0;    // invalidates per-thread scan caches on reload
 };
 
 #endif
@@ -27,9 +27,12 @@
 
 #include <glob.h>
 #include <libgen.h>
+#include <sys/stat.h>
 
 #include <cassert>
 #include <fstream>
+#include <mutex>
+#include <unordered_map>
 
 #include "appid_config.h"
 #include "appid_inspector.h"
@@ -50,6 +53,61 @@ using namespace std;
 
 static std::vector<LuaDetectorManager*> lua_detector_mgr_list;
 
+/* Compiling several hundred detector scripts dominates Lua state setup, and every packet
+   thread builds its own state from the same sources. The first thread to compile a file
+   caches the dumped chunk; later threads load the bytecode directly. Entries are validated
+   against file size and mtime so an edited custom detector is recompiled on reload. */
+struct LuaDetectorChunk
+{
+    off_t size = 0;
+    time_t mtime = 0;
+    std::string bytecode;
+};
+
+static std::unordered_map<std::string, LuaDetectorChunk> lua_chunk_cache;
+static std::mutex lua_chunk_cache_mutex;
+
+static int lua_chunk_writer(lua_State*, const void* code, size_t size, void* chunk)
+{
+    static_cast<std::string*>(chunk)->append(static_cast<const char*>(code), size);
+    return 0;
+}
+
+// Equivalent to luaL_loadfile, but repeat loads are served from the bytecode cache
+static int load_detector_chunk(lua_State* L, const char* detector_filename)
+{
+    struct stat sb;
+    if (stat(detector_filename, &sb) != 0)
+        return luaL_loadfile(L, detector_filename);
+
+    const std::string chunk_name = std::string("@") + detector_filename;
+
+    {
+        std::lock_guard<std::mutex> lock(lua_chunk_cache_mutex);
+        auto entry = lua_chunk_cache.find(detector_filename);
+        if (entry != lua_chunk_cache.end() and entry->second.size == sb.st_size and
+            entry->second.mtime == sb.st_mtime)
+        {
+            const std::string& bytecode = entry->second.bytecode;
+            return luaL_loadbuffer(L, bytecode.data(), bytecode.length(), chunk_name.c_str());
+        }
+    }
+
+    const int ret = luaL_loadfile(L, detector_filename);
+    if (ret == 0)
+    {
+        LuaDetectorChunk chunk;
+        chunk.size = sb.st_size;
+        chunk.mtime = sb.st_mtime;
+        if (lua_dump(L, lua_chunk_writer, &chunk.bytecode) == 0)
+        {
+            std::lock_guard<std::mutex> lock(lua_chunk_cache_mutex);
+            lua_chunk_cache[detector_filename] = std::move(chunk);
+        }
+    }
+    return ret;
+}
+
 bool get_lua_field(lua_State* L, int table, const char* field, std::string& out)
 {
     lua_getfield(L, table, field);
@@ -395,7 +453,7 @@ LuaObject* LuaDetectorManager::create_lua_detector(const char* detector_name,
 
 void LuaDetectorManager::load_detector(char* detector_filename, bool isCustom)
 {
-    if (luaL_loadfile(L, detector_filename))
+    if (load_detector_chunk(L, detector_filename))
     {
         if (init(L))
             ErrorMessage("Error - appid: can not load Lua detector, %s\n", lua_tostring(L, -1));
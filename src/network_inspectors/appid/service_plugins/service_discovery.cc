@@ -27,6 +27,7 @@
 
 #include <algorithm>
 
+#include "flow/flow.h"
 #include "profiler/profiler.h"
 #include "protocols/packet.h"
 #include "protocols/tcp.h"
@@ -35,6 +36,7 @@
 #include "appid_config.h"
 #include "appid_debug.h"
 #include "appid_dns_session.h"
+#include "appid_module.h"
 #include "appid_session.h"
 #include "detector_plugins/detector_dns.h"
 #include "detector_plugins/detector_imap.h"
@@ -315,6 +317,25 @@ void ServiceDiscovery::get_port_based_services(IpProtocol protocol, uint16_t por
     }
 }
 
+/* The wizard scans the same first payload bytes our pattern matchers do.  If
+ * it already named this flow's service, the like-named detector is worth a try
+ * before burning a second scan over identical data.  The detector maps are
+ * keyed by the same lowercase service names the wizard publishes, so a plain
+ * lookup suffices; a miss just means the usual pattern search runs. */
+ServiceDetector* ServiceDiscovery::get_service_by_flow_name(const Packet* p, IpProtocol proto)
+{
+    if ( !p->flow or !p->flow->service )
+        return nullptr;
+
+    AppIdDetectors& detectors = (proto == IpProtocol::TCP) ? tcp_detectors : udp_detectors;
+    AppIdDetectors::iterator it = detectors.find(p->flow->service);
+
+    if ( it == detectors.end() )
+        return nullptr;
+
+    return (ServiceDetector*)it->second;
+}
+
 /* This function should be called to find the next service detector to try when
  * we have not yet found a valid detector in the host tracker.  It will try
  * both port and/or pattern (but not brute force - that should be done outside
@@ -371,6 +392,22 @@ void ServiceDiscovery::get_next_service(const Packet* p, const AppidSessionDirec
         }
         else
         {
+            /* If the wizard already named the service at flow setup, seed its
+             * detector as the sole candidate and hold off on rescanning the
+             * same bytes.  Should the candidate fail, the state stays at
+             * PATTERN and the next pass falls through to the full search. */
+            if ( !asd.tried_wizard_service )
+            {
+                asd.tried_wizard_service = true;
+                ServiceDetector* service = get_service_by_flow_name(p, proto);
+
+                if ( service and asd.service_candidates.empty() )
+                {
+                    asd.service_candidates.emplace_back(service);
+                    appid_stats.wizard_seeded_services++;
+                    return;
+                }
+            }
             match_by_pattern(asd, p, proto);
             asd.service_search_state = SESSION_SERVICE_SEARCH_STATE::PENDING;
             return;
@@ -471,13 +508,26 @@ int ServiceDiscovery::identify_service(AppIdSession& asd, Packet* p,
 
         /* Run all of the detectors that we currently have. */
         ret = APPID_INPROCESS;
+        const uint32_t eval_budget =
+            asd.ctxt.get_odp_ctxt().max_candidate_evals_per_packet;
         auto it = asd.service_candidates.begin();
         while ( it != asd.service_candidates.end() )
         {
+            if ( eval_budget and !asd.candidate_evals_remaining )
+            {
+                /* Out of budget for this packet. The surviving candidates stay in
+                   the session and resume with the next packet. */
+                appid_stats.deferred_service_candidates +=
+                    asd.service_candidates.end() - it;
+                break;
+            }
+
             ServiceDetector* service = (ServiceDetector*)*it;
             int result;
 
             result = service->validate(args);
+            if ( eval_budget )
+                asd.candidate_evals_remaining--;
             if ( appidDebug->is_active() )
                 LogMessage("AppIdDbg %s %s service candidate returned %s (%d)\n",
                     appidDebug->get_debug_session(), service->get_log_name().c_str(),
@@ -43,6 +43,8 @@ unsigned get_instance_id() { return 3; }
 
 FlowData::FlowData(unsigned, Inspector*) { }
 FlowData::~FlowData() = default;
+void* FlowData::operator new(size_t n) { return ::operator new(n); }
+void FlowData::operator delete(void* p, size_t) { ::operator delete(p); }
 }
 
 void ApplicationDescriptor::set_id(const Packet&, AppIdSession&, AppidSessionDirection, AppId, AppidChangeBits&) { }
@@ -64,6 +64,8 @@ AppInfoTableEntry* AppInfoManager::get_app_info_entry(AppId)
 class AppIdInspector{};
 FlowData::FlowData(unsigned, Inspector*) {}
 FlowData::~FlowData() = default;
+void* FlowData::operator new(size_t n) { return ::operator new(n); }
+void FlowData::operator delete(void* p, size_t) { ::operator delete(p); }
 
 // Stubs for AppIdDebug
 THREAD_LOCAL AppIdDebug* appidDebug = nullptr;
@@ -46,6 +46,7 @@ static const PegInfo bind_pegs[] =
     { CountType::SUM, "blocks", "block bindings" },
     { CountType::SUM, "allows", "allow bindings" },
     { CountType::SUM, "inspects", "inspect bindings" },
+    { CountType::SUM, "comparisons", "binding when clauses evaluated" },
     { CountType::END, nullptr, nullptr }
 };
 
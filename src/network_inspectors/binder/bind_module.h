@@ -33,6 +33,7 @@ struct BindStats
 {
     PegCount packets;
     PegCount verdicts[BindUse::BA_MAX];
+    PegCount comparisons;
 };
 
 extern THREAD_LOCAL BindStats bstats;
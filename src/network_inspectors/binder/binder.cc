@@ -843,6 +843,7 @@ public:
 
 private:
     void set_binding(SnortConfig*, Binding*);
+    void index_bindings();
     void get_bindings(Flow*, Stuff&, Packet* = nullptr, const char* = nullptr); // may be null when dealing with HA flows
     void apply(Flow*, Stuff&);
     void apply_assistant(Flow*, Stuff&, const char*);
@@ -850,6 +851,13 @@ private:
 
 private:
     vector<Binding*> bindings;
+
+    // lookup lists built at configure time so per-flow evaluation only
+    // walks candidates that can match: policy selections are split out
+    // (they are checked first and separately) and the rest are bucketed
+    // by packet type, the cheapest discriminating field
+    vector<Binding*> policy_bindings;
+    vector<Binding*> flow_bindings[(unsigned)PktType::MAX];
 };
 
 class FlowStateSetupHandler : public DataHandler
@@ -941,6 +949,8 @@ bool Binder::configure(SnortConfig* sc)
             set_binding(sc, pb);
     }
 
+    index_bindings();
+
     DataBus::subscribe(FLOW_STATE_SETUP_EVENT, new FlowStateSetupHandler());
     DataBus::subscribe(FLOW_SERVICE_CHANGE_EVENT, new FlowServiceChangeHandler());
     DataBus::subscribe(STREAM_HA_NEW_FLOW_EVENT, new StreamHANewFlowHandler());
@@ -982,6 +992,7 @@ void Binder::remove_inspector_binding(SnortConfig*, const char* name)
         {
             bindings.erase(it);
             delete pb;
+            index_bindings();
             return;
         }
     }
@@ -1126,30 +1137,47 @@ void Binder::set_binding(SnortConfig* sc, Binding* pb)
         ParseError("can't bind %s", key);
 }
 
-// FIXIT-P this is a simple linear search until functionality is nailed
-// down.  performance should be the focus of the next iteration.
-void Binder::get_bindings(Flow* flow, Stuff& stuff, Packet* p, const char* service)
+void Binder::index_bindings()
 {
-    unsigned sz = bindings.size();
+    policy_bindings.clear();
 
+    for ( unsigned t = 0; t < (unsigned)PktType::MAX; t++ )
+        flow_bindings[t].clear();
+
+    for ( Binding* pb : bindings )
+    {
+        if ( pb->use.ips_index or pb->use.inspection_index )
+        {
+            policy_bindings.emplace_back(pb);
+            continue;
+        }
+
+        // each bucket keeps the original binding order; type NONE can't
+        // be ruled out by the proto mask, the rest mirror check_proto()
+        for ( unsigned t = 0; t < (unsigned)PktType::MAX; t++ )
+            if ( !t or (pb->when.protos & BIT(t)) )
+                flow_bindings[t].emplace_back(pb);
+    }
+}
+
+void Binder::get_bindings(Flow* flow, Stuff& stuff, Packet* p, const char* service)
+{
     // Evaluate policy ID bindings first
-    // FIXIT-P The way these are being used, the policy bindings should be a separate list if not a
-    //          separate table entirely
     // FIXIT-L This will select the first policy ID of each type that it finds and ignore the rest.
     //          It gets potentially hairy if people start specifying overlapping policy types in
     //          overlapping rules.
     bool inspection_set = false, ips_set = false;
     const SnortConfig* sc = SnortConfig::get_conf();
 
-    for ( unsigned i = 0; i < sz; i++ )
+    for ( Binding* pb : policy_bindings )
     {
-        Binding* pb = bindings[i];
-
         // Skip any rules that don't contain an ID for a policy type we haven't set yet.
         if ( (!pb->use.inspection_index or inspection_set) and
              (!pb->use.ips_index or ips_set) )
             continue;
 
+        ++bstats.comparisons;
+
         if ( !pb->check_all(flow, p, service) )
             continue;
 
@@ -1182,12 +1210,9 @@ void Binder::get_bindings(Flow* flow, Stuff& stuff, Packet* p, const char* servi
 
     // If we got here, that means that a sub-policy with a binder was not invoked.
     // Continue using this binder for the rest of processing.
-    for ( unsigned i = 0; i < sz; i++ )
+    for ( Binding* pb : flow_bindings[(unsigned)flow->pkt_type] )
     {
-        Binding* pb = bindings[i];
-
-        if ( pb->use.ips_index or pb->use.inspection_index )
-            continue;
+        ++bstats.comparisons;
 
         if ( !pb->check_all(flow, p, service) )
             continue;
@@ -58,6 +58,8 @@ enum PegCounts
     PC_TCP_REQ_URG,
     PC_TCP_REQ_PAY,
     PC_TCP_REQ_URP,
+    PC_EDITED_PKTS,
+    PC_TOTAL_EDITS,
     PC_MAX
 };
 
@@ -85,6 +87,8 @@ const PegInfo norm_names[] =
     { CountType::SUM, "tcp_req_pay",
         "cleared urgent pointer and urgent flag when there is no payload" },
     { CountType::SUM, "tcp_req_urp", "cleared the urgent flag if the urgent pointer is not set" },
+    { CountType::SUM, "edited_packets", "packets with at least one normalization applied" },
+    { CountType::SUM, "total_edits", "individual field normalizations applied" },
     { CountType::END, nullptr, nullptr }
 };
 
@@ -123,6 +127,10 @@ int Norm_Packet(NormalizerConfig* c, Packet* p)
     if ( changes > 0 )
     {
         p->packet_flags |= PKT_MODIFIED;
+        // edits only accumulate when actually applied, so these count in
+        // the on mode; the per-field pegs cover would-be edits in test mode
+        normStats[PC_EDITED_PKTS][NORM_MODE_ON]++;
+        normStats[PC_TOTAL_EDITS][NORM_MODE_ON] += changes;
         return 1;
     }
     if ( p->packet_flags & (PKT_RESIZED|PKT_MODIFIED) )
@@ -45,6 +45,9 @@ static const Parameter s_capture[] =
     { "filter", Parameter::PT_STRING, nullptr, nullptr,
       "bpf filter to use for packet dump" },
 
+    { "ring", Parameter::PT_INT, "0:8192", "0",
+      "frames to buffer per packet thread for background dumping (0 to dump in line)" },
+
     { nullptr, Parameter::PT_MAX, nullptr, nullptr, nullptr }
 };
 
@@ -59,6 +62,8 @@ static const PegInfo cap_names[] =
 {
     { CountType::SUM, "processed", "packets processed against filter" },
     { CountType::SUM, "captured", "packets matching dumped after matching filter" },
+    { CountType::SUM, "ring_queued", "packets copied to the capture ring" },
+    { CountType::SUM, "ring_drops", "packets dropped because the capture ring was full" },
     { CountType::END, nullptr, nullptr }
 };
 
@@ -119,7 +124,10 @@ bool PacketCaptureDebug::execute(Analyzer&, void**)
 
 CaptureModule::CaptureModule() :
     Module(CAPTURE_NAME, CAPTURE_HELP, s_capture)
-{ config.enabled = false; }
+{
+    config.enabled = false;
+    config.ring_pkts = 0;
+}
 
 bool CaptureModule::set(const char*, Value& v, SnortConfig*)
 {
@@ -129,6 +137,9 @@ bool CaptureModule::set(const char*, Value& v, SnortConfig*)
     else if ( v.is("filter") )
         config.filter = v.get_string();
 
+    else if ( v.is("ring") )
+        config.ring_pkts = v.get_uint32();
+
     else
         return false;
 
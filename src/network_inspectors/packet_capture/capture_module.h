@@ -29,6 +29,7 @@
 struct CaptureConfig
 {
     bool enabled;
+    unsigned ring_pkts;  // 0 = dump in line from the packet thread
     std::string filter;
 };
 
@@ -36,6 +37,8 @@ struct CaptureStats
 {
     PegCount checked;
     PegCount matched;
+    PegCount ring_queued;
+    PegCount ring_drops;
 };
 
 class CaptureModule : public snort::Module
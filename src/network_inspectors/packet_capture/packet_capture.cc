@@ -26,6 +26,14 @@
 
 #include <pcap.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include "framework/inspector.h"
 #include "log/messages.h"
 #include "protocols/packet.h"
@@ -52,6 +60,78 @@ static THREAD_LOCAL pcap_t* pcap = nullptr;
 static THREAD_LOCAL pcap_dumper_t* dumper = nullptr;
 static THREAD_LOCAL struct bpf_program bpf;
 
+// -----------------------------------------------------------------------------
+// ring capture
+// -----------------------------------------------------------------------------
+
+// with ring > 0 the packet thread only copies raw frames into its ring;
+// a single writer thread applies the bpf filter and dumps matches so the
+// capture file i/o never runs in the packet path.  each ring is single
+// producer (its packet thread) / single consumer (the writer).
+
+struct RingSlot
+{
+    struct pcap_pkthdr hdr;
+    uint8_t data[SNAP_LEN];
+};
+
+class CaptureRing
+{
+public:
+    CaptureRing(unsigned n) : size(n + 1)
+    { slots = new RingSlot[size]; }
+
+    ~CaptureRing()
+    { delete[] slots; }
+
+    bool put(const struct timeval& ts, uint32_t caplen, uint32_t len, const uint8_t* pkt)
+    {
+        unsigned h = head.load(std::memory_order_relaxed);
+        unsigned nxt = (h + 1) % size;
+
+        if ( nxt == tail.load(std::memory_order_acquire) )
+            return false;
+
+        RingSlot& s = slots[h];
+        s.hdr.ts = ts;
+        s.hdr.caplen = (caplen > SNAP_LEN) ? SNAP_LEN : caplen;
+        s.hdr.len = len;
+        memcpy(s.data, pkt, s.hdr.caplen);
+
+        head.store(nxt, std::memory_order_release);
+        return true;
+    }
+
+    RingSlot* front()
+    {
+        unsigned t = tail.load(std::memory_order_relaxed);
+
+        if ( t == head.load(std::memory_order_acquire) )
+            return nullptr;
+
+        return slots + t;
+    }
+
+    void pop()
+    { tail.store((tail.load(std::memory_order_relaxed) + 1) % size, std::memory_order_release); }
+
+private:
+    RingSlot* slots;
+    unsigned size;
+    std::atomic<unsigned> head { 0 };
+    std::atomic<unsigned> tail { 0 };
+};
+
+static THREAD_LOCAL CaptureRing* ring = nullptr;
+
+// the registry lock is only taken by the writer and at packet thread
+// init / term; the per-packet path is lock free
+static std::mutex ring_lock;
+static std::vector<CaptureRing*> rings;
+static std::vector<CaptureRing*> retired;  // drained, then freed by the writer
+static std::thread* writer_thread = nullptr;
+static std::atomic<bool> writer_exit { false };
+
 // -----------------------------------------------------------------------------
 // static functions
 // -----------------------------------------------------------------------------
@@ -124,6 +204,103 @@ static void _packet_capture_disable()
     LogMessage("Packet capture disabled\n");
 }
 
+static void drain_ring(CaptureRing* r)
+{
+    while ( RingSlot* s = r->front() )
+    {
+        if ( dumper and (!bpf.bf_insns or
+            bpf_filter(bpf.bf_insns, s->data, s->hdr.caplen, s->hdr.len)) )
+        {
+            pcap_dump((unsigned char*)dumper, &s->hdr, s->data);
+        }
+        r->pop();
+    }
+}
+
+static void writer_loop()
+{
+    // bpf, pcap, and dumper are thread local, so the writer gets its own
+    if ( !bpf_compile_and_validate() or !open_pcap_dumper() )
+        WarningMessage("Ring capture will discard packets\n");
+
+    while ( !writer_exit.load(std::memory_order_acquire) )
+    {
+        {
+            std::lock_guard<std::mutex> lock(ring_lock);
+
+            for ( auto* r : rings )
+                drain_ring(r);
+
+            for ( auto* r : retired )
+            {
+                drain_ring(r);
+                delete r;
+            }
+            retired.clear();
+        }
+        if ( dumper )
+            pcap_dump_flush(dumper);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // final drain before the writer's dumper goes away
+    std::lock_guard<std::mutex> lock(ring_lock);
+
+    for ( auto* r : rings )
+        drain_ring(r);
+
+    for ( auto* r : retired )
+    {
+        drain_ring(r);
+        delete r;
+    }
+    retired.clear();
+
+    _capture_term();
+}
+
+static void ring_init()
+{
+    ring = new CaptureRing(config.ring_pkts);
+
+    std::lock_guard<std::mutex> lock(ring_lock);
+    rings.emplace_back(ring);
+
+    if ( !writer_thread )
+    {
+        writer_exit.store(false, std::memory_order_release);
+        writer_thread = new std::thread(writer_loop);
+    }
+}
+
+static void ring_term()
+{
+    if ( !ring )
+        return;
+
+    std::lock_guard<std::mutex> lock(ring_lock);
+    rings.erase(std::remove(rings.begin(), rings.end(), ring), rings.end());
+    retired.emplace_back(ring);  // the writer drains and frees it
+    ring = nullptr;
+}
+
+static void writer_term()
+{
+    std::thread* t;
+    {
+        std::lock_guard<std::mutex> lock(ring_lock);
+        t = writer_thread;
+        writer_thread = nullptr;
+    }
+    if ( t )
+    {
+        writer_exit.store(true, std::memory_order_release);
+        t->join();
+        delete t;
+    }
+}
+
 // -----------------------------------------------------------------------------
 // non-static functions
 // -----------------------------------------------------------------------------
@@ -170,7 +347,7 @@ public:
     // non-static functions
     void show(const SnortConfig*) const override;
     void eval(Packet*) override;
-    void tterm() override { capture_term(); }
+    void tterm() override { ring_term(); capture_term(); }
 
 protected:
     virtual bool capture_init();
@@ -201,7 +378,10 @@ void PacketCapture::show(const SnortConfig*) const
 {
     ConfigLogger::log_flag("enable", config.enabled);
     if ( config.enabled )
+    {
         ConfigLogger::log_value("filter", config.filter.c_str());
+        ConfigLogger::log_value("ring", config.ring_pkts);
+    }
 }
 
 void PacketCapture::eval(Packet* p)
@@ -209,6 +389,24 @@ void PacketCapture::eval(Packet* p)
 
     if ( config.enabled )
     {
+        if ( config.ring_pkts )
+        {
+            if ( p->is_cooked() )
+                return;
+
+            if ( !ring )
+                ring_init();
+
+            // the filter is applied by the writer after the copy
+            if ( ring->put(p->pkth->ts, p->pktlen, p->pkth->pktlen, p->pkt) )
+                cap_count_stats.ring_queued++;
+            else
+                cap_count_stats.ring_drops++;
+
+            cap_count_stats.checked++;
+            return;
+        }
+
         if ( !capture_initialized() )
             if ( !capture_init() )
                 return;
@@ -225,8 +423,14 @@ void PacketCapture::eval(Packet* p)
 
         cap_count_stats.checked++;
     }
-    else if ( capture_initialized() )
-        capture_term();
+    else
+    {
+        if ( ring )
+            ring_term();
+
+        if ( capture_initialized() )
+            capture_term();
+    }
 }
 
 void PacketCapture::write_packet(Packet* p)
@@ -249,6 +453,9 @@ static Module* mod_ctor()
 static void mod_dtor(Module* m)
 { delete m; }
 
+static void pc_pterm()
+{ writer_term(); }
+
 static Inspector* pc_ctor(Module* m)
 { return new PacketCapture((CaptureModule*)m); }
 
@@ -274,7 +481,7 @@ static const InspectApi pc_api =
     nullptr, // buffers
     nullptr, // service
     nullptr, // pinit
-    nullptr, // pterm
+    pc_pterm,
     nullptr, // tinit
     nullptr, // tterm
     pc_ctor,
@@ -58,6 +58,7 @@ static THREAD_LOCAL struct{ unsigned val = 0; } global_mutes;
 
 static std::string log_file = "-";
 static bool config_status = false;
+static unsigned config_recorder_pkts = 0;
 
 // -----------------------------------------------------------------------------
 // static functions
@@ -75,6 +76,12 @@ template<typename T> void PacketTracer::_thread_init()
     s_pkt_trace->mutes.resize(global_mutes.val, false);
     s_pkt_trace->open_file();
     s_pkt_trace->user_enabled = config_status;
+
+    if ( config_recorder_pkts )
+    {
+        s_pkt_trace->flight_size = config_recorder_pkts;
+        s_pkt_trace->flight_ring = new PtFlightRecord[config_recorder_pkts];
+    }
 }
 template void PacketTracer::_thread_init<PacketTracer>();
 
@@ -167,11 +174,77 @@ void PacketTracer::set_constraints(const PacketConstraints* constraints)
         s_pkt_trace->update_constraints(constraints);
 }
 
-void PacketTracer::configure(bool status, const std::string& file_name)
+void PacketTracer::configure(bool status, const std::string& file_name,
+    unsigned recorder_pkts)
 {
 
     log_file = file_name;
     config_status = status;
+    config_recorder_pkts = recorder_pkts;
+}
+
+void PacketTracer::record(const Packet* p, uint8_t verdict)
+{
+    if ( !s_pkt_trace or !s_pkt_trace->flight_ring )
+        return;
+
+    PtFlightRecord& r = s_pkt_trace->flight_ring[s_pkt_trace->flight_next];
+
+    r.ts = p->pkth->ts;
+    r.packet_number = p->context->packet_number;
+    r.flow_id = p->pkth->flow_id;
+
+    if ( p->ptrs.ip_api.is_ip() )
+    {
+        memcpy(r.src_ip, p->ptrs.ip_api.get_src()->get_ip6_ptr(), sizeof(r.src_ip));
+        memcpy(r.dst_ip, p->ptrs.ip_api.get_dst()->get_ip6_ptr(), sizeof(r.dst_ip));
+        r.src_port = p->ptrs.sp;
+        r.dst_port = p->ptrs.dp;
+        r.ip_proto = static_cast<uint8_t>(p->get_ip_proto_next());
+    }
+    else
+    {
+        memset(r.src_ip, 0, sizeof(r.src_ip));
+        memset(r.dst_ip, 0, sizeof(r.dst_ip));
+        r.src_port = r.dst_port = 0;
+        r.ip_proto = 0;
+    }
+
+    r.pkt_type = static_cast<uint8_t>(p->type());
+    r.action = static_cast<uint8_t>(p->active->get_action());
+    r.verdict = verdict;
+
+    if ( ++s_pkt_trace->flight_next == s_pkt_trace->flight_size )
+    {
+        s_pkt_trace->flight_next = 0;
+        s_pkt_trace->flight_wrapped = true;
+    }
+}
+
+void PacketTracer::dump_flight_recorder()
+{
+    if ( !s_pkt_trace or !s_pkt_trace->flight_ring )
+        return;
+
+    std::string path;
+    const char* fname = get_instance_file(path, "packet_tracer_recorder.bin");
+    FILE* fh = fopen(fname, "w");
+
+    if ( !fh )
+    {
+        WarningMessage("Could not open %s for flight recorder dump\n", fname);
+        return;
+    }
+
+    // oldest first; records are written raw and formatted offline
+    if ( s_pkt_trace->flight_wrapped )
+        fwrite(s_pkt_trace->flight_ring + s_pkt_trace->flight_next,
+            sizeof(PtFlightRecord), s_pkt_trace->flight_size - s_pkt_trace->flight_next, fh);
+
+    fwrite(s_pkt_trace->flight_ring, sizeof(PtFlightRecord), s_pkt_trace->flight_next, fh);
+    fclose(fh);
+
+    LogMessage("Flight recorder dumped to %s\n", fname);
 }
 
 void PacketTracer::pause()
@@ -238,6 +311,8 @@ PacketTracer::~PacketTracer()
         fclose(log_fh);
         log_fh = nullptr;
     }
+
+    delete[] flight_ring;
 }
 
 void PacketTracer::log_va(const char* format, va_list ap)
@@ -41,6 +41,24 @@ namespace snort
 {
 struct Packet;
 
+// compact per packet record kept by the flight recorder; written out raw
+// on demand and formatted offline, so recording is a struct copy with no
+// formatting in the packet path
+struct PtFlightRecord
+{
+    struct timeval ts;
+    uint64_t packet_number;
+    uint32_t flow_id;        // daq flow id, zero if none
+    uint32_t src_ip[4];      // raw ip6 words, v4 in the last word
+    uint32_t dst_ip[4];
+    uint16_t src_port;
+    uint16_t dst_port;
+    uint8_t ip_proto;
+    uint8_t pkt_type;        // PktType
+    uint8_t action;          // ActiveActionType
+    uint8_t verdict;         // DAQ_Verdict
+};
+
 class PacketTracer
 {
 public:
@@ -58,10 +76,15 @@ public:
     static void dump(char* output_buff, unsigned int len);
     static void dump(Packet*);
 
-    static void configure(bool status, const std::string& file_name);
+    static void configure(bool status, const std::string& file_name,
+        unsigned recorder_pkts = 0);
     static void set_constraints(const PacketConstraints* constraints);
     static void activate(const snort::Packet&);
 
+    // flight recorder: cheap enough to leave on; no-op unless configured
+    static SO_PUBLIC void record(const snort::Packet*, uint8_t verdict);
+    static void dump_flight_recorder();
+
     static SO_PUBLIC void pause();
     static SO_PUBLIC void unpause();
     static SO_PUBLIC bool is_paused();
@@ -90,6 +113,11 @@ protected:
     char debug_session[PT_DEBUG_SESSION_ID_SIZE];
     PacketConstraints constraints;
 
+    PtFlightRecord* flight_ring = nullptr;
+    unsigned flight_size = 0;
+    unsigned flight_next = 0;
+    bool flight_wrapped = false;
+
     // static functions
     template<typename T = PacketTracer> static void _thread_init();
 
@@ -38,6 +38,7 @@ using namespace snort;
 
 static int enable(lua_State*);
 static int disable(lua_State*);
+static int dump_recorder(lua_State*);
 
 static const Parameter s_params[] =
 {
@@ -47,6 +48,9 @@ static const Parameter s_params[] =
     {"output", Parameter::PT_ENUM, "console | file", "console",
     "select where to send packet trace"},
 
+    {"recorder", Parameter::PT_INT, "0:65536", "0",
+    "packets remembered per thread by the binary flight recorder (0 to disable)"},
+
     {nullptr, Parameter::PT_MAX, nullptr, nullptr, nullptr}
 };
 
@@ -64,6 +68,8 @@ static const Command packet_tracer_cmds[] =
 {
     {"enable", enable, enable_packet_tracer_params, "enable packet tracer debugging"},
     {"disable", disable, nullptr, "disable packet tracer"},
+    {"dump_recorder", dump_recorder, nullptr,
+        "write each thread's flight recorder ring to its instance file"},
     {nullptr, nullptr, nullptr, nullptr}
 };
 
@@ -158,6 +164,23 @@ static int disable(lua_State*)
     return 0;
 }
 
+class PacketTracerRecorderDump : public AnalyzerCommand
+{
+public:
+    bool execute(Analyzer&, void**) override
+    {
+        PacketTracer::dump_flight_recorder();
+        return true;
+    }
+    const char* stringify() override { return "PACKET_TRACER_RECORDER_DUMP"; }
+};
+
+static int dump_recorder(lua_State*)
+{
+    main_broadcast_command(new PacketTracerRecorderDump(), true);
+    return 0;
+}
+
 PacketTracerModule::PacketTracerModule() :
     Module(PACKET_TRACER_NAME, PACKET_TRACER_HELP, s_params)
 {}
@@ -183,6 +206,9 @@ bool PacketTracerModule::set(const char *, Value &v, SnortConfig*)
                 return false;
         }
     }
+    else if ( v.is("recorder") )
+        config->recorder_pkts = v.get_uint32();
+
     else
         return false;
 
@@ -204,7 +230,7 @@ bool PacketTracerModule::end(const char*, int, SnortConfig*)
 {
     if (config != nullptr)
     {
-        PacketTracer::configure(config->enabled, config->file);
+        PacketTracer::configure(config->enabled, config->file, config->recorder_pkts);
         delete config;
         config = nullptr;
     }
@@ -29,6 +29,7 @@
 struct PacketTracerConfig
 {
     bool enabled;
+    unsigned recorder_pkts;
     std::string file;
 };
 
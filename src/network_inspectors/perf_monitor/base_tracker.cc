@@ -58,7 +58,7 @@ void BaseTracker::process(bool summary)
     {
         for ( const ModuleConfig& mod : modules )
         {
-            lock_guard<mutex> lock(ModuleManager::stats_mutex);
+            lock_guard<mutex> lock(mod.ptr->get_stats_lock());
             mod.ptr->sum_stats(false);
         }
     }
@@ -87,9 +87,12 @@ static const Parameter s_params[] =
     { "flow_ports", Parameter::PT_INT, "0:65535", "1023",
       "maximum ports to track" },
 
-    { "output", Parameter::PT_ENUM, "file | console", "file",
+    { "output", Parameter::PT_ENUM, "file | console | side_channel", "file",
       "output location for stats" },
 
+    { "side_channel_port", Parameter::PT_INT, "0:65535", "0",
+      "side channel to transmit stats over when output = side_channel" },
+
     { "modules", Parameter::PT_LIST, module_params, nullptr,
       "gather statistics from the specified modules" },
 
@@ -290,6 +293,10 @@ bool PerfMonModule::set(const char*, Value& v, SnortConfig*)
     {
         config->output = (PerfOutput)v.get_uint8();
     }
+    else if ( v.is("side_channel_port") )
+    {
+        config->sc_port = v.get_uint16();
+    }
     else if ( v.is("format") )
     {
         config->format = (PerfFormat)v.get_uint8();
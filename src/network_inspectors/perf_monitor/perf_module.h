@@ -54,7 +54,8 @@ enum class PerfFormat
 enum class PerfOutput
 {
     TO_FILE,
-    TO_CONSOLE
+    TO_CONSOLE,
+    TO_SIDE_CHANNEL
 };
 
 struct ModuleConfig
@@ -95,6 +96,7 @@ struct PerfConfig
     size_t flowip_memcap = 0;
     PerfFormat format = PerfFormat::CSV;
     PerfOutput output = PerfOutput::TO_FILE;
+    uint16_t sc_port = 0;  // side channel to transmit on for output = side_channel
     std::vector<ModuleConfig> modules;
     std::vector<snort::Module*> mods_to_prep;
     PerfConstraints* constraints;
@@ -131,6 +131,8 @@ static const char* to_string(const PerfOutput& po)
         return "console";
     case PerfOutput::TO_FILE:
         return "file";
+    case PerfOutput::TO_SIDE_CHANNEL:
+        return "side_channel";
     }
 
     return "";
@@ -27,9 +27,12 @@
 #include <sys/stat.h>
 
 #include <climits>
+#include <cstdlib>
+#include <cstring>
 
 #include "log/messages.h"
 #include "main/snort_config.h"
+#include "side_channel/side_channel.h"
 #include "utils/util.h"
 #include "utils/util_cstring.h"
 
@@ -86,6 +89,21 @@ PerfTracker::PerfTracker(PerfConfig* config, const char* tracker_name)
         tracker_fname += formatter->get_extension();
         get_instance_file(fname, tracker_fname.c_str());
     }
+    else if ( config->output == PerfOutput::TO_SIDE_CHANNEL )
+    {
+        side_channel = SideChannelManager::get_side_channel(config->sc_port);
+
+        if ( side_channel and
+            side_channel->get_direction() == Connector::CONN_RECEIVE )
+            side_channel = nullptr;
+
+        if ( side_channel )
+            side_channel->set_default_port(config->sc_port);
+        else
+            WarningMessage("perfmonitor: No transmit side channel configured "
+                "on port %u; %s stats will go to the console instead.\n",
+                config->sc_port, tracker_name);
+    }
 
     this->tracker_name = tracker_name;
 }
@@ -97,6 +115,9 @@ PerfTracker::~PerfTracker()
 
     if (fh && fh != stdout)
         fclose(fh);
+
+    if (sc_buf)
+        free(sc_buf);
 }
 
 void PerfTracker::close()
@@ -106,11 +127,29 @@ void PerfTracker::close()
         fclose(fh);
         fh = nullptr;
     }
+
+    if (sc_buf)
+    {
+        free(sc_buf);
+        sc_buf = nullptr;
+    }
 }
 
 bool PerfTracker::open(bool append)
 {
-    if (fname.length())
+    if (side_channel)
+    {
+        // formatters only know how to emit to a FILE*, so stage their
+        // output in a memory stream and ship the bytes after each write
+        fh = open_memstream(&sc_buf, &sc_buf_size);
+        if (!fh)
+        {
+            ErrorMessage("perfmonitor: Cannot open side channel staging "
+                "buffer: %s.\n", get_error(errno));
+            return false;
+        }
+    }
+    else if (fname.length())
     {
         // FIXIT-L this should be deleted; was added as 1-time workaround to
         // get around the borked perms due to a bug that has been fixed
@@ -372,4 +411,34 @@ bool PerfTracker::auto_rotate()
 void PerfTracker::write()
 {
     formatter->write(fh, cur_time);
+
+    if (side_channel)
+        side_channel_write();
+}
+
+void PerfTracker::side_channel_write()
+{
+    fflush(fh);
+
+    const uint8_t* data = (const uint8_t*)sc_buf;
+    size_t remaining = sc_buf_size;
+
+    while (remaining)
+    {
+        uint32_t len = (remaining > MAXIMUM_SC_MESSAGE_CONTENT) ?
+            MAXIMUM_SC_MESSAGE_CONTENT : (uint32_t)remaining;
+
+        SCMessage* sc_msg = side_channel->alloc_transmit_message(len);
+        if (!sc_msg)
+            break;
+
+        memcpy(sc_msg->content, data, len);
+        side_channel->transmit_message(sc_msg);
+
+        data += len;
+        remaining -= len;
+    }
+
+    // start the next interval at the front of the staging buffer
+    rewind(fh);
 }
@@ -43,6 +43,8 @@
 #include "perf_formatter.h"
 #include "perf_module.h"
 
+class SideChannel;
+
 namespace snort
 {
 struct Packet;
@@ -76,10 +78,18 @@ protected:
     PerfFormatter* formatter = nullptr;
 
 private:
+    void side_channel_write();
+
     std::string fname;
     std::string tracker_name;
     FILE* fh = nullptr;
     time_t cur_time = 0;
+
+    // when output = side_channel, formatted stats are staged in a memory
+    // stream and each interval's bytes are forwarded over the side channel
+    SideChannel* side_channel = nullptr;
+    char* sc_buf = nullptr;
+    size_t sc_buf_size = 0;
 };
 #endif
 
@@ -58,12 +58,21 @@ struct PS_HASH_KEY
 };
 PADDING_GUARD_END
 
-class PortScanCache : public XHash
+class PortScanCache : public TXHash<sizeof(PS_HASH_KEY)>
 {
 public:
-    PortScanCache(unsigned rows, unsigned key_len, unsigned datasize, unsigned memcap)
-        : XHash(rows, key_len, datasize, memcap)
-    { }
+    PortScanCache(unsigned rows, unsigned datasize, unsigned memcap)
+        : TXHash(rows, datasize, memcap)
+    {
+        /*
+         **  During a genuine scan flood most trackers are in-window
+         **  priority nodes, so an unbounded recovery walk can traverse
+         **  the whole lru list on every new tracker.  Cap the walk; a
+         **  failed allocation just defers the tracker to a later packet,
+         **  which ps_tracker_get already handles.
+         */
+        max_anr_tries = 8;
+    }
 
     bool is_node_recovery_ok(HashNode* hnode) override
     {
@@ -132,8 +141,7 @@ bool ps_init_hash(unsigned long memcap)
     }
 
     int rows = memcap / ps_node_size();
-    portscan_hash = new PortScanCache(rows, sizeof(PS_HASH_KEY), sizeof(PS_TRACKER),
-        memcap);
+    portscan_hash = new PortScanCache(rows, sizeof(PS_TRACKER), memcap);
 
     return false;
 }
@@ -292,20 +300,25 @@ bool PortScan::ps_filter_ignore(PS_PKT* ps_pkt)
 */
 static PS_TRACKER* ps_tracker_get(PS_HASH_KEY* key)
 {
-    PS_TRACKER* ht = (PS_TRACKER*)portscan_hash->get_user_data((void*)key);
+    /*
+    **  One probe covers both cases: insert finds an existing tracker or
+    **  creates one.  A separate find first would pay a second probe for
+    **  every new tracker - the common case during a flood.
+    */
+    auto prev_count = portscan_hash->get_num_nodes();
+    int status = portscan_hash->insert((void*)key, nullptr);
 
-    if ( ht )
-        return ht;
+    if ( status == HASH_INTABLE )
+        return (PS_TRACKER*)portscan_hash->get_user_data();
 
-    auto prev_count = portscan_hash->get_num_nodes();
-    if ( portscan_hash->insert((void*)key, nullptr) != HASH_OK )
+    if ( status != HASH_OK )
         return nullptr;
 
     ++spstats.trackers;
     if ( prev_count == portscan_hash->get_num_nodes() )
         ++spstats.alloc_prunes;
 
-    ht = (PS_TRACKER*)portscan_hash->get_mru_user_data();
+    PS_TRACKER* ht = (PS_TRACKER*)portscan_hash->get_mru_user_data();
 
     if ( ht )
         memset(ht, 0x00, sizeof(PS_TRACKER));
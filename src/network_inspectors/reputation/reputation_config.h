@@ -87,8 +87,11 @@ struct ReputationConfig
     WhiteAction white_action = UNBLACK;
     std::string blacklist_path;
     std::string whitelist_path;
+    std::string delta_list_path;
     bool memcap_reached = false;
     uint8_t* reputation_segment = nullptr;
+    uint32_t segment_size = 0;
+    size_t segment_used = 0;
     table_flat_t* ip_list = nullptr;
     ListFiles list_files;
     std::string list_dir;
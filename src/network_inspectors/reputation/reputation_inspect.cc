@@ -25,6 +25,8 @@
 
 #include "reputation_inspect.h"
 
+#include <atomic>
+
 #include "detection/detect.h"
 #include "detection/detection_engine.h"
 #include "events/event_queue.h"
@@ -384,6 +386,12 @@ static const char* to_string(IPdecision ipd)
 // class stuff
 //-------------------------------------------------------------------------
 
+// the most recently built config; its segment seeds delta reloads. the
+// initial config is built on the main thread and reloads run on the shell
+// thread, so the pointer is published with release semantics after the
+// segment is fully built and consumed with acquire.
+static std::atomic<ReputationConfig*> active_config { nullptr };
+
 Reputation::Reputation(ReputationConfig* pc)
 {
     reputation_id = create_reputation_id();
@@ -393,21 +401,48 @@ Reputation::Reputation(ReputationConfig* pc)
         read_manifest(MANIFEST_FILENAME, conf);
 
     add_black_white_List(conf);
-    estimate_num_entries(conf);
-    if (conf->num_entries <= 0)
+
+    // when only a delta file changed, clone the previous segment instead of
+    // reparsing the full lists; the old inspector keeps serving lookups from
+    // its own segment until the swap
+    bool cloned = false;
+    ReputationConfig* last_config = active_config.load(std::memory_order_acquire);
+    if (!conf->delta_list_path.empty() && last_config &&
+        same_list_files(last_config, conf))
+        cloned = clone_ip_list(last_config, conf);
+
+    if (!cloned)
     {
-        ParseWarning(WARN_CONF,
-            "reputation: can't find any whitelist/blacklist entries; disabled.");
-        return;
+        estimate_num_entries(conf);
+        if (conf->num_entries <= 0)
+        {
+            ParseWarning(WARN_CONF,
+                "reputation: can't find any whitelist/blacklist entries; disabled.");
+            return;
+        }
+
+        ip_list_init(conf->num_entries + 1, conf);
     }
 
-    ip_list_init(conf->num_entries + 1, conf);
+    if (!conf->delta_list_path.empty() && conf->ip_list)
+        apply_delta_list(conf);
+
     reputationstats.memory_allocated = sfrt_flat_usage(conf->ip_list);
+
+    if (conf->ip_list)
+        active_config.store(conf, std::memory_order_release);
+}
+
+Reputation::~Reputation()
+{
+    ReputationConfig* expected = &config;
+    active_config.compare_exchange_strong(expected, nullptr);
 }
 
 void Reputation::show(const SnortConfig*) const
 {
     ConfigLogger::log_value("blacklist", config.blacklist_path.c_str());
+    ConfigLogger::log_value("delta_list", config.delta_list_path.c_str());
     ConfigLogger::log_value("list_dir", config.list_dir.c_str());
     ConfigLogger::log_value("memcap", config.memcap);
     ConfigLogger::log_value("nested_ip", to_string(config.nested_ip));
@@ -27,6 +27,7 @@ class Reputation : public snort::Inspector
 {
 public:
     Reputation(ReputationConfig*);
+    ~Reputation() override;
 
     void show(const snort::SnortConfig*) const override;
     void eval(snort::Packet*) override;
@@ -54,6 +54,9 @@ static const Parameter s_params[] =
     { "blacklist", Parameter::PT_STRING, nullptr, nullptr,
       "blacklist file name with IP lists" },
 
+    { "delta_list", Parameter::PT_STRING, nullptr, nullptr,
+      "file with +/- entries applied to the previously loaded lists on reload" },
+
     { "list_dir", Parameter::PT_STRING, nullptr, nullptr,
       "directory for IP lists and manifest file" },
 
@@ -123,6 +126,9 @@ bool ReputationModule::set(const char*, Value& v, SnortConfig*)
     if ( v.is("blacklist") )
         conf->blacklist_path = v.get_string();
 
+    else if ( v.is("delta_list") )
+        conf->delta_list_path = v.get_string();
+
     else if ( v.is("list_dir") )
         conf->list_dir = v.get_string();
 
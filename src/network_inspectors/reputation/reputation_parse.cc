@@ -74,6 +74,9 @@ unsigned long total_invalids;
 int totalNumEntries = 0;
 
 static void load_list_file(ListFile*, ReputationConfig* config);
+static bool list_image_key(ReputationConfig*, std::vector<uint64_t>&, std::string&);
+static bool load_list_image(ReputationConfig*, const std::vector<uint64_t>&, const char*);
+static void save_list_image(ReputationConfig*, const std::vector<uint64_t>&, const char*);
 
 ReputationConfig::~ReputationConfig()
 {
@@ -111,13 +114,49 @@ static uint32_t estimate_size(uint32_t num_entries, uint32_t memcap)
     return (uint32_t)size;
 }
 
+static void assign_list_info(ReputationConfig* config)
+{
+    for (size_t i = 0; i < config->list_files.size(); i++)
+    {
+        config->list_files[i]->list_index = (uint8_t)i + 1;
+        if (config->list_files[i]->file_type == WHITE_LIST)
+        {
+            if (config->white_action == UNBLACK)
+                config->list_files[i]->list_type = WHITELISTED_UNBLACK;
+            else
+                config->list_files[i]->list_type = WHITELISTED_TRUST;
+        }
+        else if (config->list_files[i]->file_type == BLACK_LIST)
+            config->list_files[i]->list_type = BLACKLISTED;
+        else if (config->list_files[i]->file_type == MONITOR_LIST)
+            config->list_files[i]->list_type = MONITORED;
+    }
+}
+
 void ip_list_init(uint32_t max_entries, ReputationConfig* config)
 {
     if ( !config->ip_list )
     {
         uint32_t mem_size;
+
+        assign_list_info(config);
+
+        /*an unchanged input set restores the previously built list image
+         *and skips the per line parse entirely*/
+        std::vector<uint64_t> hashes;
+        std::string image;
+
+        if (list_image_key(config, hashes, image) &&
+            load_list_image(config, hashes, image.c_str()))
+        {
+            LogMessage("    Reputation: restored %u entries from list image %s\n",
+                sfrt_flat_num_entries(config->ip_list), image.c_str());
+            return;
+        }
+
         mem_size = estimate_size(max_entries, config->memcap);
         config->reputation_segment = (uint8_t*)snort_alloc(mem_size);
+        config->segment_size = mem_size;
 
         segment_meminit(config->reputation_segment, mem_size);
 
@@ -136,24 +175,70 @@ void ip_list_init(uint32_t max_entries, ReputationConfig* config)
         total_duplicates = 0;
         for (size_t i = 0; i < config->list_files.size(); i++)
         {
-            config->list_files[i]->list_index = (uint8_t)i + 1;
-            if (config->list_files[i]->file_type == WHITE_LIST)
-            {
-                if (config->white_action == UNBLACK)
-                    config->list_files[i]->list_type = WHITELISTED_UNBLACK;
-                else
-                    config->list_files[i]->list_type = WHITELISTED_TRUST;
-            }
-            else if (config->list_files[i]->file_type == BLACK_LIST)
-                config->list_files[i]->list_type = BLACKLISTED;
-            else if (config->list_files[i]->file_type == MONITOR_LIST)
-                config->list_files[i]->list_type = MONITORED;
-
             load_list_file(config->list_files[i], config);
         }
+
+        config->segment_used = segment_usedmem();
+
+        /*a list truncated by the memcap would round trip incomplete*/
+        if (!image.empty() && !config->memcap_reached)
+            save_list_image(config, hashes, image.c_str());
     }
 }
 
+bool same_list_files(const ReputationConfig* from, const ReputationConfig* to)
+{
+    if (from->memcap != to->memcap || from->white_action != to->white_action)
+        return false;
+
+    if (from->list_files.size() != to->list_files.size())
+        return false;
+
+    for (size_t i = 0; i < from->list_files.size(); i++)
+    {
+        const ListFile* old_file = from->list_files[i];
+        const ListFile* new_file = to->list_files[i];
+
+        if (old_file->file_name != new_file->file_name ||
+            old_file->file_type != new_file->file_type ||
+            old_file->list_id != new_file->list_id)
+            return false;
+    }
+
+    return true;
+}
+
+bool clone_ip_list(const ReputationConfig* from, ReputationConfig* to)
+{
+    if (!from->ip_list || !from->reputation_segment || !from->segment_size)
+        return false;
+
+    /* The flat table is position independent: the table lives at offset 0
+     * of the segment and all internal references are offsets. Copying the
+     * used part of the segment yields an independent, mutable table.
+     */
+    to->reputation_segment = (uint8_t*)snort_alloc(from->segment_size);
+    to->segment_size = from->segment_size;
+    memcpy(to->reputation_segment, from->reputation_segment, from->segment_used);
+
+    if (!segment_memrestore(to->reputation_segment, to->segment_size, from->segment_used))
+    {
+        snort_free(to->reputation_segment);
+        to->reputation_segment = nullptr;
+        to->segment_size = 0;
+        return false;
+    }
+
+    to->ip_list = (table_flat_t*)to->reputation_segment;
+    to->segment_used = from->segment_used;
+    to->num_entries = from->num_entries;
+    to->memcap_reached = from->memcap_reached;
+
+    total_duplicates = 0;
+    assign_list_info(to);
+    return true;
+}
+
 static inline IPrepInfo* get_last_index(IPrepInfo* rep_info, uint8_t* base, int* last_index)
 {
     int i;
@@ -547,6 +632,189 @@ static int update_path_to_file(char* full_filename, unsigned int max_size, const
     return 1;
 }
 
+/*--------------------------------------------------------------------
+ * list image
+ *
+ * the segment is position independent (the table lives at offset 0 and
+ * all internal references are offsets), so a fully built list can be
+ * written out verbatim and restored on a later start, skipping the per
+ * line parse entirely.  the image is keyed by the content hash of every
+ * input file plus the settings that shape the table, so any change
+ * forces a reparse, which then rewrites the image.
+ *--------------------------------------------------------------------*/
+
+#define LIST_IMAGE_MAGIC    0x52504c49  /* "RPLI" */
+#define LIST_IMAGE_VERSION  1
+
+static const char list_image_suffix[] = ".rli";
+
+struct ListImageHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t memcap;
+    uint32_t white_action;
+    uint32_t num_files;
+    uint32_t segment_size;
+    uint64_t segment_used;
+};
+
+struct ListImageFileRec
+{
+    uint64_t content_hash;
+    int32_t file_type;
+    uint32_t list_id;
+};
+
+static uint64_t hash_file_content(const char* path)
+{
+    FILE* fp = fopen(path, "rb");
+
+    if (!fp)
+        return 0;
+
+    /*fnv-1a over the raw bytes*/
+    uint64_t hash = 14695981039346656037ULL;
+    uint8_t buf[8192];
+    size_t n;
+
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            hash ^= buf[i];
+            hash *= 1099511628211ULL;
+        }
+    }
+    fclose(fp);
+
+    /*reserve 0 for "could not hash"*/
+    return hash ? hash : 1;
+}
+
+static bool list_image_key(ReputationConfig* config,
+    std::vector<uint64_t>& hashes, std::string& image)
+{
+    char full_path_filename[PATH_MAX+1];
+
+    for (size_t i = 0; i < config->list_files.size(); i++)
+    {
+        if (!update_path_to_file(full_path_filename, PATH_MAX,
+                config->list_files[i]->file_name.c_str()))
+            return false;
+
+        uint64_t hash = hash_file_content(full_path_filename);
+
+        if (!hash)
+            return false;
+
+        if (!i)
+            image = std::string(full_path_filename) + list_image_suffix;
+
+        hashes.emplace_back(hash);
+    }
+
+    return !hashes.empty();
+}
+
+static bool load_list_image(ReputationConfig* config,
+    const std::vector<uint64_t>& hashes, const char* path)
+{
+    FILE* fp = fopen(path, "rb");
+
+    if (!fp)
+        return false;
+
+    ListImageHeader hdr;
+
+    bool ok = fread(&hdr, sizeof(hdr), 1, fp) == 1 &&
+        hdr.magic == LIST_IMAGE_MAGIC &&
+        hdr.version == LIST_IMAGE_VERSION &&
+        hdr.memcap == config->memcap &&
+        hdr.white_action == (uint32_t)config->white_action &&
+        hdr.num_files == config->list_files.size() &&
+        hdr.segment_used && hdr.segment_used <= hdr.segment_size;
+
+    for (size_t i = 0; ok && i < hashes.size(); i++)
+    {
+        ListImageFileRec rec;
+
+        ok = fread(&rec, sizeof(rec), 1, fp) == 1 &&
+            rec.content_hash == hashes[i] &&
+            rec.file_type == config->list_files[i]->file_type &&
+            rec.list_id == config->list_files[i]->list_id;
+    }
+
+    if (ok)
+    {
+        config->reputation_segment = (uint8_t*)snort_alloc(hdr.segment_size);
+        config->segment_size = hdr.segment_size;
+
+        ok = fread(config->reputation_segment, 1, hdr.segment_used, fp) == hdr.segment_used &&
+            segment_memrestore(config->reputation_segment, hdr.segment_size, hdr.segment_used);
+
+        if (ok)
+        {
+            config->ip_list = (table_flat_t*)config->reputation_segment;
+            config->segment_used = hdr.segment_used;
+        }
+        else
+        {
+            WarningMessage("Reputation: ignoring unusable list image %s\n", path);
+            snort_free(config->reputation_segment);
+            config->reputation_segment = nullptr;
+            config->segment_size = 0;
+        }
+    }
+
+    fclose(fp);
+    return ok;
+}
+
+static void save_list_image(ReputationConfig* config,
+    const std::vector<uint64_t>& hashes, const char* path)
+{
+    /*write to a temp name and rename so a crashed or concurrent writer
+     *never leaves a partial image behind*/
+    std::string tmp = std::string(path) + "." + std::to_string(getpid());
+    FILE* fp = fopen(tmp.c_str(), "wb");
+
+    if (!fp)
+        return;
+
+    ListImageHeader hdr;
+    hdr.magic = LIST_IMAGE_MAGIC;
+    hdr.version = LIST_IMAGE_VERSION;
+    hdr.memcap = config->memcap;
+    hdr.white_action = (uint32_t)config->white_action;
+    hdr.num_files = (uint32_t)config->list_files.size();
+    hdr.segment_size = config->segment_size;
+    hdr.segment_used = config->segment_used;
+
+    bool ok = fwrite(&hdr, sizeof(hdr), 1, fp) == 1;
+
+    for (size_t i = 0; ok && i < hashes.size(); i++)
+    {
+        ListImageFileRec rec;
+        rec.content_hash = hashes[i];
+        rec.file_type = config->list_files[i]->file_type;
+        rec.list_id = config->list_files[i]->list_id;
+
+        ok = fwrite(&rec, sizeof(rec), 1, fp) == 1;
+    }
+
+    if (ok)
+        ok = fwrite(config->reputation_segment, 1, config->segment_used, fp)
+            == config->segment_used;
+
+    fclose(fp);
+
+    if (ok)
+        rename(tmp.c_str(), path);
+    else
+        unlink(tmp.c_str());
+}
+
 static char* get_list_type_name(ListFile* list_info)
 {
     if (!list_info)
@@ -959,3 +1227,210 @@ int read_manifest(const char* manifest_file, ReputationConfig* config)
     return 0;
 }
 
+/*Like get_file_type(), but only consumes the leading keyword so the
+ *address that follows on the same line is left for the caller*/
+static int get_delta_type(char** line)
+{
+    char* type_name = ignore_start_space(*line);
+    int type = UNKNOWN_LIST;
+
+    if (strncasecmp(type_name, WHITE_TYPE_KEYWORD, strlen(WHITE_TYPE_KEYWORD)) == 0)
+    {
+        type = WHITE_LIST;
+        type_name += strlen(WHITE_TYPE_KEYWORD);
+    }
+    else if (strncasecmp(type_name, BLACK_TYPE_KEYWORD, strlen(BLACK_TYPE_KEYWORD)) == 0)
+    {
+        type = BLACK_LIST;
+        type_name += strlen(BLACK_TYPE_KEYWORD);
+    }
+    else if (strncasecmp(type_name, MONITOR_TYPE_KEYWORD, strlen(MONITOR_TYPE_KEYWORD)) == 0)
+    {
+        type = MONITOR_LIST;
+        type_name += strlen(MONITOR_TYPE_KEYWORD);
+    }
+
+    if ((type != UNKNOWN_LIST) && (*type_name) && !isspace((int)*type_name))
+        type = UNKNOWN_LIST;
+
+    *line = type_name;
+    return type;
+}
+
+static int remove_list_type(SfCidr* address, int file_type, ReputationConfig* config)
+{
+    uint8_t* base = (uint8_t*)config->ip_list;
+    IPrepInfo* rep_info = (IPrepInfo*)sfrt_flat_exact_lookup(address,
+        (unsigned char)address->get_bits(), config->ip_list);
+
+    if (!rep_info)
+        return IP_INVALID;
+
+    /* Collect the indexes that belong to other list types, then rewrite
+     * the info chain packed. An all zero chain means DECISION_NULL, so
+     * the trie entry itself can stay put.
+     */
+    std::vector<char> keep;
+    IPrepInfo* current_info = rep_info;
+    while (current_info)
+    {
+        for (int i = 0; i < NUM_INDEX_PER_ENTRY; i++)
+        {
+            int list_index = current_info->list_indexes[i];
+            if (!list_index)
+                break;
+            if (((size_t)list_index <= config->list_files.size()) &&
+                (config->list_files[list_index - 1]->file_type != file_type))
+                keep.emplace_back((char)list_index);
+        }
+        current_info = current_info->next ? (IPrepInfo*)&base[current_info->next] : nullptr;
+    }
+
+    size_t next_keep = 0;
+    current_info = rep_info;
+    while (current_info)
+    {
+        for (int i = 0; i < NUM_INDEX_PER_ENTRY; i++)
+        {
+            if (next_keep < keep.size())
+                current_info->list_indexes[i] = keep[next_keep++];
+            else
+                current_info->list_indexes[i] = 0;
+        }
+        current_info = current_info->next ? (IPrepInfo*)&base[current_info->next] : nullptr;
+    }
+
+    return IP_INSERT_SUCCESS;
+}
+
+void apply_delta_list(ReputationConfig* config)
+{
+    char linebuf[MAX_ADDR_LINE_LENGTH];
+    char full_path_filename[PATH_MAX+1];
+    int addrline = 0;
+    FILE* fp = nullptr;
+    char* cmt = nullptr;
+    uint8_t* base = (uint8_t*)config->ip_list;
+
+    /*one seed entry per list type, allocated on first use*/
+    MEM_OFFSET type_info[WHITE_LIST+1] = { 0 };
+
+    unsigned int added_count = 0;
+    unsigned int removed_count = 0;
+    unsigned int invalid_count = 0;
+    unsigned int fail_count = 0;
+
+    update_path_to_file(full_path_filename, PATH_MAX, config->delta_list_path.c_str());
+
+    LogMessage("    Processing delta file %s\n", full_path_filename);
+
+    if ((fp = fopen(full_path_filename, "r")) == nullptr)
+    {
+        ErrorMessage("Unable to open address file %s, Error: %s\n", full_path_filename,
+            get_error(errno));
+        return;
+    }
+
+    while ( fgets(linebuf, MAX_ADDR_LINE_LENGTH, fp) )
+    {
+        int ret = IP_INSERT_SUCCESS;
+        addrline++;
+
+        // Remove comments
+        if ( (cmt = strchr(linebuf, '#')) )
+            *cmt = '\0';
+
+        // Remove newline as well, prevent double newline in logging.
+        if ( (cmt = strchr(linebuf, '\n')) )
+            *cmt = '\0';
+
+        char* line = ignore_start_space(linebuf);
+        if ( !*line )
+            continue;
+
+        char op = *line++;
+        int file_type = (op == '+' || op == '-') ? get_delta_type(&line) : UNKNOWN_LIST;
+
+        SfCidr address;
+        if (UNKNOWN_LIST == file_type || snort_pton(line, &address) < 1)
+        {
+            if (invalid_count++ < MAX_MSGS_TO_PRINT)
+                ErrorMessage("      (%d) => Invalid delta line: \'%s\'\n", addrline, linebuf);
+            continue;
+        }
+
+        if (op == '+')
+        {
+            if (!type_info[file_type])
+            {
+                ListFile* list_info = nullptr;
+                for (auto& file : config->list_files)
+                {
+                    if (file->file_type == file_type)
+                    {
+                        list_info = file;
+                        break;
+                    }
+                }
+
+                if (!list_info)
+                {
+                    if (fail_count++ < MAX_MSGS_TO_PRINT)
+                        ErrorMessage("      (%d) => No list of that type configured: \'%s\'\n",
+                            addrline, linebuf);
+                    continue;
+                }
+
+                type_info[file_type] = segment_snort_calloc(1, sizeof(IPrepInfo));
+                if (!type_info[file_type])
+                {
+                    config->memcap_reached = true;
+                    break;
+                }
+                ((IPrepInfo*)&base[type_info[file_type]])->list_indexes[0] =
+                    list_info->list_index;
+            }
+
+            ret = add_ip(&address, type_info[file_type], config);
+            if (IP_INSERT_SUCCESS == ret || IP_INSERT_DUPLICATE == ret)
+                added_count++;
+        }
+        else
+        {
+            ret = remove_list_type(&address, file_type, config);
+            if (IP_INSERT_SUCCESS == ret)
+                removed_count++;
+        }
+
+        if (IP_INSERT_FAILURE == ret && fail_count++ < MAX_MSGS_TO_PRINT)
+        {
+            ErrorMessage("      (%d) => Failed to insert address: \'%s\'\n", addrline, linebuf);
+        }
+        else if (IP_INVALID == ret && invalid_count++ < MAX_MSGS_TO_PRINT)
+        {
+            ErrorMessage("      (%d) => Address not on a list: \'%s\'\n", addrline, linebuf);
+        }
+        else if (IP_MEM_ALLOC_FAILURE == ret)
+        {
+            ErrorMessage(
+                "WARNING: %s(%d) => Memcap %u Mbytes reached when inserting IP Address: %s\n",
+                full_path_filename, addrline, config->memcap, linebuf);
+
+            config->memcap_reached = true;
+            break;
+        }
+    }
+
+    if (fail_count > MAX_MSGS_TO_PRINT)
+        ErrorMessage("    Additional addresses failed insertion but were not listed.\n");
+    if (invalid_count > MAX_MSGS_TO_PRINT)
+        ErrorMessage("    Additional invalid delta lines were not listed.\n");
+
+    LogMessage("    Reputation delta entries added: %u, removed: %u, invalid: %u (from file %s)\n",
+        added_count, removed_count, invalid_count, full_path_filename);
+
+    config->segment_used = segment_usedmem();
+
+    fclose(fp);
+}
+
@@ -28,5 +28,8 @@ void ip_list_init(uint32_t,ReputationConfig *config);
 void estimate_num_entries(ReputationConfig* config);
 int read_manifest(const char* filename, ReputationConfig* config);
 void add_black_white_List(ReputationConfig* config);
+bool same_list_files(const ReputationConfig* from, const ReputationConfig* to);
+bool clone_ip_list(const ReputationConfig* from, ReputationConfig* to);
+void apply_delta_list(ReputationConfig* config);
 
 #endif
@@ -129,6 +129,7 @@ void RnaInspector::tinit()
 void RnaInspector::tterm()
 {
     // thread local cleanup
+    rna_pnd_tterm();
 }
 
 void RnaInspector::load_rna_conf()
@@ -39,6 +39,31 @@
 
 using namespace snort;
 
+namespace
+{
+// The last tracker resolved on this thread.  Busy segments generate runs
+// of flow events for the same source host, and the shared cache lookup
+// under cache_mutex is the expensive part of discovery; reusing the
+// tracker within the same second keeps one locked lookup per host per
+// tick per thread.  The memo expires on the next tick, so a host evicted
+// and re-added to the cache is rediscovered within a second.
+struct TrackerMemo
+{
+    SfIp ip;
+    RnaTracker tracker;
+    time_t sec = 0;
+};
+}
+
+// THREAD_LOCAL may be __thread, so the non-trivial memo lives on the heap
+static THREAD_LOCAL TrackerMemo* tracker_memo = nullptr;
+
+void rna_pnd_tterm()
+{
+    delete tracker_memo;
+    tracker_memo = nullptr;
+}
+
 static inline bool is_eligible_packet(const Packet* p)
 {
     if ( p->has_ip() or
@@ -148,7 +173,23 @@ void RnaPnd::discover_network(const Packet* p, uint8_t ttl)
 {
     bool new_host = false;
     const auto& src_ip = p->ptrs.ip_api.get_src();
-    auto ht = host_cache.find_else_create(*src_ip, &new_host);
+    const time_t sec = packet_time();
+    RnaTracker ht;
+
+    if ( !tracker_memo )
+        tracker_memo = new TrackerMemo;
+
+    if ( tracker_memo->tracker and tracker_memo->sec == sec
+        and tracker_memo->ip == *src_ip )
+        ht = tracker_memo->tracker;
+    else
+    {
+        ht = host_cache.find_else_create(*src_ip, &new_host);
+        tracker_memo->ip = *src_ip;
+        tracker_memo->tracker = ht;
+        tracker_memo->sec = sec;
+    }
+
     if ( !new_host )
         ht->update_last_seen(); // this should be done always and foremost
 
@@ -35,6 +35,9 @@ enum class TcpPacketType
     SYN, SYN_ACK, MIDSTREAM
 };
 
+// releases this thread's tracker memo; called from RnaInspector::tterm()
+void rna_pnd_tterm();
+
 class RnaPnd
 {
 public:
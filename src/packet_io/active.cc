@@ -78,6 +78,21 @@ static THREAD_LOCAL eth_t* s_link = nullptr;
 static THREAD_LOCAL ip_t* s_ipnet = nullptr;
 static THREAD_LOCAL send_t s_send = SFDAQ::inject;
 
+// flows responded to during the current receive burst; entries from older
+// bursts are ignored, so a stale flow pointer is never dereferenced (only
+// compared) and the table never needs explicit clearing
+#define RESPONSE_RECORDS 8
+
+struct ResponseRecord
+{
+    const Flow* flow;
+    uint64_t burst;
+};
+
+static THREAD_LOCAL uint64_t s_burst_id = 0;
+static THREAD_LOCAL unsigned s_response_idx = 0;
+static THREAD_LOCAL ResponseRecord s_response_records[RESPONSE_RECORDS] = {};
+
 static ResetAction default_reset;
 static int default_drop_reason_id = -1;
 
@@ -151,14 +166,53 @@ static uint64_t Strafe(int i, uint64_t flags, const Packet* p)
 
 //--------------------------------------------------------------------
 
+static bool responded_this_burst(const Flow* flow)
+{
+    if ( !flow )
+        return false;
+
+    for ( unsigned i = 0; i < RESPONSE_RECORDS; i++ )
+    {
+        if ( s_response_records[i].flow == flow and
+            s_response_records[i].burst == s_burst_id )
+            return true;
+    }
+    return false;
+}
+
+static void record_response(const Flow* flow)
+{
+    if ( !flow )
+        return;
+
+    s_response_records[s_response_idx] = { flow, s_burst_id };
+    s_response_idx = (s_response_idx + 1) % RESPONSE_RECORDS;
+}
+
+void Active::next_burst()
+{ s_burst_id++; }
+
 void Active::kill_session(Packet* p, EncodeFlags flags)
 {
-    switch ( p->type() )
+    if ( p->type() == PktType::NONE )
     {
-    case PktType::NONE:
         // Can only occur if we have never seen IP
         return;
+    }
+
+    // Mass reset events put several packets of the same dying flow in one
+    // receive burst and each would otherwise trigger a full set of response
+    // injects.  One response per flow per burst is sufficient; coalescing
+    // the rest keeps injection syscalls from throttling the packet thread
+    // just when it is busiest.
+    if ( responded_this_burst(p->flow) )
+    {
+        active_counts.responses_coalesced++;
+        return;
+    }
 
+    switch ( p->type() )
+    {
     case PktType::TCP:
         send_reset(p, 0);
         if ( flags & ENC_FLAG_FWD )
@@ -172,6 +226,8 @@ void Active::kill_session(Packet* p, EncodeFlags flags)
             send_unreach(p, UnreachResponse::PORT);
         break;
     }
+
+    record_response(p->flow);
 }
 
 //--------------------------------------------------------------------
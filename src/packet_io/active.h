@@ -45,6 +45,7 @@ public:
         PegCount holds_denied;
         PegCount holds_canceled;
         PegCount holds_allowed;
+        PegCount responses_coalesced;
     };
 
     enum ActiveStatus : uint8_t
@@ -71,6 +72,10 @@ public:
     static void resume()
     { s_suspend = false; }
 
+    // called by the analyzer at receive burst boundaries; retires the
+    // response coalescing records for the finished burst
+    static void next_burst();
+
     void send_reset(Packet*, EncodeFlags);
     void send_unreach(Packet*, snort::UnreachResponse);
     uint32_t send_data(Packet*, EncodeFlags, const uint8_t* buf, uint32_t len);
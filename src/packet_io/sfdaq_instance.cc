@@ -26,6 +26,8 @@
 
 #include <daq.h>
 
+#include <utility>
+
 #include "log/messages.h"
 #include "main/snort_config.h"
 #include "protocols/packet.h"
@@ -195,6 +197,17 @@ DAQ_RecvStatus SFDAQInstance::receive_messages(unsigned max_recv)
     pool_available -= curr_batch_size;
     curr_batch_idx = 0;
 
+    last_batch_full = (curr_batch_size > 0 and curr_batch_size >= max_recv);
+
+    if (curr_batch_size > 0)
+    {
+        daq_stats.batch_receives++;
+        if (last_batch_full)
+            daq_stats.full_batches++;
+        if (curr_batch_size > daq_stats.max_batch)
+            daq_stats.max_batch = curr_batch_size;
+    }
+
     return rstat;
 }
 
@@ -268,9 +281,19 @@ bool SFDAQInstance::stop()
     return (rval == DAQ_SUCCESS);
 }
 
+constexpr std::chrono::seconds SFDAQInstance::inject_retry_age_out;
+
 int SFDAQInstance::inject(DAQ_Msg_h msg, int rev, const uint8_t* buf, uint32_t len)
 {
     int rval = daq_instance_inject_relative(instance, msg, buf, len, rev);
+
+    if (rval == DAQ_ERROR_AGAIN or rval == DAQ_ERROR_NOMEM)
+    {
+        // transmit side backpressure; hold a copy for a retry at the next
+        // burst boundary rather than stalling or abandoning the frame
+        queue_inject_retry(msg, rev, buf, len);
+        return DAQ_SUCCESS;
+    }
 #ifdef DEBUG_MSGS
     if (rval != DAQ_SUCCESS)
         LogMessage("Couldn't inject on DAQ instance: %s (%d)\n", daq_instance_get_error(instance), rval);
@@ -278,6 +301,65 @@ int SFDAQInstance::inject(DAQ_Msg_h msg, int rev, const uint8_t* buf, uint32_t l
     return rval;
 }
 
+void SFDAQInstance::queue_inject_retry(DAQ_Msg_h msg, int rev, const uint8_t* buf, uint32_t len)
+{
+    if (inject_retries.size() >= max_inject_retries)
+    {
+        inject_retries.pop_front();
+        daq_stats.inject_retries_dropped++;
+    }
+
+    inject_retries.emplace_back();
+    InjectRetry& retry = inject_retries.back();
+
+    // the message is finalized before the retry runs, so a relative inject
+    // is no longer possible; keep a header copy for an absolute inject and
+    // swap the indices so a reverse frame still goes back toward the sender
+    retry.hdr = *daq_msg_get_pkthdr(msg);
+
+    if (rev)
+    {
+        std::swap(retry.hdr.ingress_index, retry.hdr.egress_index);
+        std::swap(retry.hdr.ingress_group, retry.hdr.egress_group);
+    }
+    retry.hdr.pktlen = len;
+    retry.queued = std::chrono::steady_clock::now();
+    retry.data.assign(buf, buf + len);
+
+    daq_stats.inject_retries_queued++;
+}
+
+unsigned SFDAQInstance::retry_injects()
+{
+    auto now = std::chrono::steady_clock::now();
+
+    while (!inject_retries.empty())
+    {
+        InjectRetry& retry = inject_retries.front();
+
+        if (now - retry.queued > inject_retry_age_out)
+        {
+            inject_retries.pop_front();
+            daq_stats.inject_retries_dropped++;
+            continue;
+        }
+
+        int rval = daq_instance_inject(instance, DAQ_MSG_TYPE_PACKET,
+            &retry.hdr, retry.data.data(), retry.data.size());
+
+        if (rval == DAQ_ERROR_AGAIN or rval == DAQ_ERROR_NOMEM)
+            break;  // still backed up; leave the rest for the next boundary
+
+        if (rval == DAQ_SUCCESS)
+            daq_stats.inject_retries_sent++;
+        else
+            daq_stats.inject_retries_dropped++;
+
+        inject_retries.pop_front();
+    }
+    return inject_retries.size();
+}
+
 bool SFDAQInstance::interrupt()
 {
     return (daq_instance_interrupt(instance) == DAQ_SUCCESS);
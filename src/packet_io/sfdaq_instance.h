@@ -24,7 +24,10 @@
 
 #include <daq_common.h>
 
+#include <chrono>
+#include <deque>
 #include <string>
+#include <vector>
 
 #include "main/snort_types.h"
 #include "protocols/protocol_ids.h"
@@ -62,6 +65,10 @@ public:
     int get_base_protocol() const;
     uint32_t get_batch_size() const { return batch_size; }
     uint32_t get_pool_available() const { return pool_available; }
+
+    // true when the last receive returned everything it asked for, which
+    // means more messages were waiting and this thread is running behind
+    bool was_full_batch() const { return last_batch_full; }
     const char* get_input_spec() const;
     const DAQ_Stats_t* get_stats();
 
@@ -72,6 +79,10 @@ public:
     SO_PUBLIC bool can_whitelist() const;
 
     int inject(DAQ_Msg_h, int rev, const uint8_t* buf, uint32_t len);
+
+    bool have_pending_injects() const { return !inject_retries.empty(); }
+    unsigned retry_injects();
+
     bool interrupt();
 
     SO_PUBLIC int ioctl(DAQ_IoctlCmd cmd, void *arg, size_t arglen);
@@ -84,6 +95,20 @@ public:
     bool get_tunnel_bypass(uint16_t proto);
 
 private:
+    // a frame whose inject hit transient transmit backpressure, copied and
+    // held for an opportunistic retry at the next burst boundary
+    struct InjectRetry
+    {
+        DAQ_PktHdr_t hdr;
+        std::chrono::steady_clock::time_point queued;
+        std::vector<uint8_t> data;
+    };
+
+    static const unsigned max_inject_retries = 16;
+    static constexpr std::chrono::seconds inject_retry_age_out { 1 };
+
+    void queue_inject_retry(DAQ_Msg_h, int rev, const uint8_t* buf, uint32_t len);
+
     void get_tunnel_capabilities();
 
     std::string input_spec;
@@ -92,11 +117,13 @@ private:
     DAQ_Msg_h* daq_msgs;
     unsigned curr_batch_size = 0;
     unsigned curr_batch_idx = 0;
+    bool last_batch_full = false;
     uint32_t batch_size;
     uint32_t pool_size = 0;
     uint32_t pool_available = 0;
     int dlt = -1;
     DAQ_Stats_t daq_instance_stats = { };
+    std::deque<InjectRetry> inject_retries;
     uint16_t daq_tunnel_mask = 0;
 };
 }
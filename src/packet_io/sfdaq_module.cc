@@ -200,10 +200,16 @@ const PegInfo daq_names[] =
     { CountType::SUM, "sof_messages", "start of flow messages received from DAQ" },
     { CountType::SUM, "eof_messages", "end of flow messages received from DAQ" },
     { CountType::SUM, "other_messages", "messages received from DAQ with unrecognized message type" },
+    { CountType::SUM, "batch_receives", "receives that returned at least one message" },
+    { CountType::SUM, "full_batches", "receives that returned a full batch of messages" },
+    { CountType::MAX, "max_batch", "most messages returned by one receive" },
+    { CountType::SUM, "inject_retries_queued", "injects queued for retry after transmit backpressure" },
+    { CountType::SUM, "inject_retries_sent", "queued injects sent successfully on retry" },
+    { CountType::SUM, "inject_retries_dropped", "queued injects dropped by age out, overflow, or error" },
     { CountType::END, nullptr, nullptr }
 };
 
-THREAD_LOCAL DAQStats daq_stats;
+PEG_SLAB_ALIGN THREAD_LOCAL DAQStats daq_stats;
 
 const PegInfo* SFDAQModule::get_pegs() const
 {
@@ -77,6 +77,12 @@ struct DAQStats
     PegCount sof_messages;
     PegCount eof_messages;
     PegCount other_messages;
+    PegCount batch_receives;
+    PegCount full_batches;
+    PegCount max_batch;
+    PegCount inject_retries_queued;
+    PegCount inject_retries_sent;
+    PegCount inject_retries_dropped;
 };
 
 extern THREAD_LOCAL DAQStats daq_stats;
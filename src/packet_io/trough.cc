@@ -23,19 +23,128 @@
 
 #include "trough.h"
 
+#include <fcntl.h>
 #include <fnmatch.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
+#include <mutex>
+#include <thread>
 
 #include "helpers/directory.h"
 #include "log/messages.h"
 #include "main/snort_config.h"
+#include "utils/stats.h"
 #include "utils/util.h"
 
 using namespace snort;
 
+//-------------------------------------------------------------------------
+// readahead service
+//
+// while the current pcap is being processed, a helper thread pulls the
+// next few files in the trough through the page cache so the analysis
+// thread doesn't stall on cold reads at the start of every file.  the
+// data is staged rather than handed over directly because the DAQ module
+// owns the actual file input.
+//-------------------------------------------------------------------------
+
+// how many upcoming files to keep warm; the page cache holds the data so
+// this only bounds how far ahead of the analysis thread we read
+static const unsigned readahead_depth = 2;
+
+static std::thread* readahead_thread = nullptr;
+static std::mutex readahead_mutex;
+static std::condition_variable readahead_cond;
+static std::deque<std::string> readahead_requests;
+static bool readahead_exit = false;
+static unsigned readahead_next = 0;
+
+static void readahead_file(const std::string& path)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+
+    if (fd < 0)
+        return;
+
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    static const size_t chunk = 1 << 20;
+    char* buf = new char[chunk];
+    ssize_t n;
+    PegCount total = 0;
+
+    while ((n = read(fd, buf, chunk)) > 0)
+    {
+        total += n;
+
+        std::lock_guard<std::mutex> lock(readahead_mutex);
+        if (readahead_exit)
+            break;
+    }
+    delete[] buf;
+    close(fd);
+
+    proc_stats.pcap_readaheads++;
+    proc_stats.pcap_readahead_bytes += total;
+}
+
+static void readahead_loop()
+{
+    while (true)
+    {
+        std::string path;
+        {
+            std::unique_lock<std::mutex> lock(readahead_mutex);
+            readahead_cond.wait(lock,
+                []() { return readahead_exit || !readahead_requests.empty(); });
+
+            if (readahead_exit)
+                return;
+
+            path = readahead_requests.front();
+            readahead_requests.pop_front();
+        }
+        readahead_file(path);
+    }
+}
+
+static void readahead_request(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(readahead_mutex);
+
+    if (!readahead_thread)
+        readahead_thread = new std::thread(readahead_loop);
+
+    readahead_requests.emplace_back(path);
+    readahead_cond.notify_one();
+}
+
+static void readahead_stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(readahead_mutex);
+        readahead_exit = true;
+        readahead_requests.clear();
+        readahead_cond.notify_one();
+    }
+
+    if (readahead_thread)
+    {
+        readahead_thread->join();
+        delete readahead_thread;
+        readahead_thread = nullptr;
+    }
+    readahead_exit = false;
+    readahead_next = 0;
+}
+
 std::vector<struct Trough::PcapReadObject> Trough::pcap_object_list;
 std::vector<std::string> Trough::pcap_queue;
 std::string Trough::pcap_filter = "*.*cap*";
@@ -43,6 +152,8 @@ std::vector<std::string>::const_iterator Trough::pcap_queue_iter;
 
 unsigned Trough::pcap_loop_count = 0;
 unsigned Trough::file_count = 0;
+unsigned Trough::shard_index = 0;
+unsigned Trough::shard_count = 1;
 
 bool Trough::add_pcaps_dir(const std::string& dirname, const std::string& filter)
 {
@@ -213,6 +324,12 @@ void Trough::set_filter(const char* f)
         pcap_filter.erase();
 }
 
+void Trough::set_shard(unsigned index, unsigned count)
+{
+    shard_index = index;
+    shard_count = count;
+}
+
 void Trough::setup()
 {
     if (!pcap_object_list.empty())
@@ -223,6 +340,21 @@ void Trough::setup()
         if (pcap_queue.empty())
             FatalError("No pcaps found.\n");
 
+        if (shard_count > 1)
+        {
+            /* Every cooperating process builds the same ordered queue, so
+                taking every shard_count-th entry yields a deterministic,
+                disjoint partition without any coordination. */
+            std::vector<std::string> shard_queue;
+            for (size_t i = shard_index; i < pcap_queue.size(); i += shard_count)
+                shard_queue.emplace_back(pcap_queue[i]);
+            pcap_queue.swap(shard_queue);
+
+            if (pcap_queue.empty())
+                FatalError("No pcaps in trough shard %u/%u; use fewer shards.\n",
+                    shard_index, shard_count);
+        }
+
         /* free pcap list used to get params */
         pcap_object_list.clear();
 
@@ -233,6 +365,8 @@ void Trough::setup()
 
 void Trough::cleanup()
 {
+    readahead_stop();
+
     /* clean up pcap queues */
     pcap_queue.clear();
 }
@@ -252,8 +386,17 @@ const char* Trough::get_next()
     {
         pcap_loop_count--;
         pcap_queue_iter = pcap_queue.cbegin();
+        readahead_next = 0;
     }
 
+    /* Keep the next few files coming through the page cache while this
+        one is processed. */
+    unsigned pos = (unsigned)(pcap_queue_iter - pcap_queue.cbegin());
+    if (readahead_next < pos)
+        readahead_next = pos;
+    while (readahead_next < pos + readahead_depth && readahead_next < pcap_queue.size())
+        readahead_request(pcap_queue[readahead_next++]);
+
     file_count++;
     return pcap;
 }
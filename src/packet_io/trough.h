@@ -40,6 +40,7 @@ public:
         pcap_loop_count = c;
     }
     static void set_filter(const char *f);
+    static void set_shard(unsigned index, unsigned count);
     static void add_source(SourceType type, const char *list);
     static void setup();
     static bool has_next();
@@ -56,6 +57,14 @@ public:
     {
         return pcap_loop_count;
     }
+    static unsigned get_shard_index()
+    {
+        return shard_index;
+    }
+    static unsigned get_shard_count()
+    {
+        return shard_count;
+    }
     static void cleanup();
 private:
     struct PcapReadObject
@@ -77,6 +86,8 @@ private:
 
     static unsigned pcap_loop_count;
     static unsigned file_count;
+    static unsigned shard_index;
+    static unsigned shard_count;
 };
 
 #endif
@@ -424,9 +424,15 @@ static int ProcessIP(SnortConfig* sc, const char* addr, RuleTreeNode* rtn, int m
 
     /* Make sure the IP lists provided by the user are valid */
     if (mode == SRC)
+    {
         ValidateIPList(rtn->sip, addr);
+        sfvar_compile(rtn->sip);
+    }
     else
+    {
         ValidateIPList(rtn->dip, addr);
+        sfvar_compile(rtn->dip);
+    }
 
     return 0;
 }
@@ -1326,7 +1332,7 @@ void parse_rule_close(SnortConfig* sc, RuleTreeNode& rtn, OptTreeNode* otn)
     if ( otn->sigInfo.message.empty() )
         otn->sigInfo.message = "\"no msg in rule\"";
 
-    OptFpList* fpl = AddOptFuncToList(OptListEnd, otn);
+    OptFpList* fpl = AddOptFuncToList(OptListEnd, otn, sc);
     fpl->type = RULE_OPTION_TYPE_LEAF_NODE;
 
     if ( is_service_protocol(otn->snort_protocol_id) )
@@ -23,6 +23,8 @@
 
 #include "piglet_output.h"
 
+#include <cinttypes>
+
 #include "piglet_runner.h"
 #include "piglet_utils.h"
 
@@ -203,6 +205,12 @@ const struct Output verbose_output =
         for ( const auto& msg : t.messages )
             printf("    %s\n", msg.c_str());
 
+        if ( t.bench.valid )
+            printf(
+                "  bench: %" PRIu64 " passes, %" PRIu64 " bytes, %.2f ticks/byte\n",
+                t.bench.iterations, t.bench.bytes, t.bench.ticks_per_byte()
+            );
+
         printf("  %s\n", get_result_long(t.result));
     }
 };
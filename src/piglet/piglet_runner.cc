@@ -29,6 +29,9 @@
 #include "lua/lua_table.h"
 #include "lua/lua_util.h"
 
+#include "time/clock_defs.h"
+#include "time/stopwatch.h"
+
 #include "piglet_api.h"
 #include "piglet_manager.h"
 #include "piglet_output.h"
@@ -124,6 +127,61 @@ static bool run_test(lua_State* L, Test& t)
     return false;
 }
 
+// benchmarking is opt in: a chunk that defines plugin.bench gets that
+// function replayed plugin.bench_iterations times against the environment
+// the chunk already set up.  the function exercises one stage (decode,
+// eval, search, ...) and returns the number of bytes it pushed through so
+// the report can be normalized to ticks per byte.
+static bool run_bench(lua_State* L, Test& t)
+{
+    Lua::ManageStack ms(L, 3);
+
+    lua_getglobal(L, "plugin");
+    if ( !lua_istable(L, -1) )
+        return false;
+
+    Lua::Table table(L, -1);
+
+    unsigned iterations;
+    table.get_default("bench_iterations", iterations, 100u);
+
+    if ( !iterations )
+        iterations = 1;
+
+    lua_getfield(L, -1, "bench");
+    if ( !lua_isfunction(L, -1) )
+        return false;
+
+    Stopwatch<SnortClock> watch;
+    uint64_t bytes = 0;
+
+    for ( unsigned i = 0; i < iterations; i++ )
+    {
+        // keep the function on the stack for the next pass
+        lua_pushvalue(L, -1);
+
+        watch.start();
+
+        if ( lua_pcall(L, 0, 1, 0) )
+        {
+            t.set_error(lua_tostring(L, -1));
+            return true;
+        }
+
+        watch.stop();
+
+        bytes += static_cast<uint64_t>(lua_tonumber(L, -1));
+        lua_pop(L, 1);
+    }
+
+    t.bench.valid = true;
+    t.bench.iterations = iterations;
+    t.bench.bytes = bytes;
+    t.bench.ticks = static_cast<uint64_t>(TO_TICKS(watch.get()));
+
+    return false;
+}
+
 // -----------------------------------------------------------------------------
 // Private Methods
 // -----------------------------------------------------------------------------
@@ -153,6 +211,8 @@ void Runner::run(const struct Output& output, Test& t, unsigned i)
             t.set_error("environment setup failed");
         else if ( run_test(state.get_ptr(), t) )
             t.set_error("test function error");
+        else if ( t.result == Test::PASSED and run_bench(state.get_ptr(), t) )
+            t.set_error("bench function error");
 
         Manager::destroy(p);
     }
@@ -23,6 +23,7 @@
 // Miscellaneous data objects used for the piglet test harness
 
 #include <chrono>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -67,6 +68,24 @@ struct Chunk
         filename { f }, target { t }, buffer { b } { }
 };
 
+// -------------------------------------------------------------------------
+// BenchResult
+// -------------------------------------------------------------------------
+// filled in when a chunk defines a plugin.bench function; ticks are tsc
+// cycles when built with ENABLE_TSC_CLOCK, high resolution clock ticks
+// (nanoseconds) otherwise
+struct BenchResult
+{
+    bool valid = false;
+
+    uint64_t iterations = 0;
+    uint64_t bytes = 0;
+    uint64_t ticks = 0;
+
+    inline double ticks_per_byte() const
+    { return bytes ? static_cast<double>(ticks) / bytes : 0.0; }
+};
+
 // -------------------------------------------------------------------------
 // Test
 // -------------------------------------------------------------------------
@@ -82,6 +101,7 @@ struct Test
 
     const Chunk* chunk;
     Timer timer;
+    BenchResult bench;
 
     Result result = NA;
 
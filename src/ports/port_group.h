@@ -80,6 +80,10 @@ struct PortGroup
     unsigned rule_count;
     unsigned nfp_rule_count;
 
+    // set before rules are added; lets fp_create pick a compact engine
+    // for near-empty groups instead of the configured search method
+    unsigned expected_rules;
+
     void add_rule();
     bool add_nfp_rule(void*);
     void delete_nfp_rules();
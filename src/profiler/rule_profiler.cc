@@ -56,6 +56,7 @@ using namespace snort;
 #define s_rule_table_title "rule profile"
 
 bool RuleContext::enabled = false;
+unsigned RuleContext::sample_rate = 1;
 
 static inline OtnState& operator+=(OtnState& lhs, const OtnState& rhs)
 {
@@ -339,7 +340,7 @@ void reset_rule_profiler_stats()
 
 void RuleContext::stop(bool match)
 {
-    if ( !enabled or finished )
+    if ( !enabled or !sampled or finished )
         return;
 
     finished = true;
@@ -23,6 +23,7 @@
 
 #include "time/clock_defs.h"
 #include "time/stopwatch.h"
+#include "utils/stats.h"
 
 struct dot_node_state_t;
 
@@ -42,6 +43,7 @@ struct RuleProfilerConfig
 
     bool show = false;
     unsigned count = 0;
+    unsigned sample = 1;  // profile 1 in N packets; 1 = every packet
 };
 
 class RuleContext
@@ -49,30 +51,52 @@ class RuleContext
 public:
     RuleContext(dot_node_state_t& stats) :
         stats(stats)
-    { start(); }
+    {
+        if ( enabled )
+        {
+            sampled = sample_this_packet();
+            start();
+        }
+    }
 
     ~RuleContext()
     { stop(); }
 
     void start()
-    { if ( enabled ) sw.start(); }
+    { if ( enabled and sampled ) sw.start(); }
 
     void pause()
-    { if ( enabled ) sw.stop(); }
+    { if ( enabled and sampled ) sw.stop(); }
 
     void stop(bool = false);
 
     bool active() const
-    { return enabled and sw.active(); }
+    { return enabled and sampled and sw.active(); }
 
     static void set_enabled(bool b)
     { enabled = b; }
 
+    static void set_sample(unsigned n)
+    { sample_rate = n ? n : 1; }
+
 private:
+    // with a sample rate of N, only every Nth packet pays for the clock
+    // reads; all contexts on one packet make the same choice so subtree
+    // timings stay consistent
+    static bool sample_this_packet()
+    {
+        if ( sample_rate <= 1 )
+            return true;
+
+        return snort::get_packet_number() % sample_rate == 0;
+    }
+
     dot_node_state_t& stats;
     Stopwatch<SnortClock> sw;
     bool finished = false;
+    bool sampled = true;
     static bool enabled;
+    static unsigned sample_rate;
 };
 
 class RulePause
@@ -118,19 +118,29 @@ struct SO_PUBLIC Packet
     Packet(const Packet&) = delete;
     Packet& operator=(const Packet&) = delete;
 
-    Flow* flow;   /* for session tracking */
     Endianness* endianness;
     Obfuscator* obfuscator;
 
+    // the hot fields from flow through filtering_state are kept
+    // contiguous and lean so reset() can clear them as a single block
+    Flow* flow;   /* for session tracking */
+
     uint32_t packet_flags;      /* special flags for the packet */
     uint32_t xtradata_mask;
     uint32_t proto_bits;        /* protocols contained within this packet */
+    uint32_t iplist_id;
+
+    uint32_t user_inspection_policy_id;
+    uint32_t user_ips_policy_id;
+    uint32_t user_network_policy_id;
 
     uint16_t alt_dsize;         /* size for detection (iff PKT_DETECT_LIMIT) */
 
     uint8_t num_layers;         /* index into layers for next encap */
     // FIXIT-M Consider moving ip_proto_next below `pkth`.
     IpProtocol ip_proto_next;      /* the protocol ID after IP and all IP6 extension */
+    uint8_t vlan_idx;
+    uint8_t ts_packet_flags; // FIXIT-M packet flags should always be thread safe
     bool disable_inspect;
     mutable FilteringState filtering_state;
 
@@ -157,14 +167,6 @@ struct SO_PUBLIC Packet
     Layer* layers;    /* decoded encapsulations */
 
     PseudoPacketType pseudo_type;    // valid only when PKT_PSEUDO is set
-    uint32_t iplist_id;
-
-    uint32_t user_inspection_policy_id;
-    uint32_t user_ips_policy_id;
-    uint32_t user_network_policy_id;
-
-    uint8_t vlan_idx;
-    uint8_t ts_packet_flags; // FIXIT-M packet flags should always be thread safe
 
     // IP_MAXPACKET is the minimum allowable max_dsize
     // there is no requirement that all data fit into an IP datagram
@@ -25,6 +25,7 @@
 
 #include <daq.h>
 #include <mutex>
+#include <random>
 
 #include "codecs/codec_module.h"
 #include "codecs/ip/checksum.h"
@@ -36,10 +37,13 @@
 #include "packet_io/sfdaq.h"
 #include "profiler/profiler_defs.h"
 #include "stream/stream.h"
+#include "utils/stats.h"
 
 #include "eth.h"
 #include "icmp4.h"
 #include "icmp6.h"
+#include "ipv4.h"
+#include "tcp.h"
 
 using namespace snort;
 
@@ -116,8 +120,7 @@ void PacketManager::pop_teredo(Packet* p, RawData& raw)
 
 static inline bool payload_offset_from_daq_mismatch(const uint8_t* pkt, const RawData& raw)
 {
-    const DAQ_PktDecodeData_t* pdd =
-        (const DAQ_PktDecodeData_t*) daq_msg_get_meta(raw.daq_msg, DAQ_PKT_META_DECODE_DATA);
+    const DAQ_PktDecodeData_t* pdd = raw.pkt_decode_data;
     if ( !pdd || (pdd->payload_offset == DAQ_PKT_DECODE_OFFSET_INVALID) )
         return false;
     // compare payload offset from DAQ with decoded data offset 
@@ -167,6 +170,13 @@ void PacketManager::decode(
 
     s_stats[total_processed]++;
 
+    // note: caching a per flow "decode plan" (codec pointers + offsets)
+    // does not work here.  flow lookup needs the decoded 5-tuple, so no
+    // flow is available yet, and every codec must still validate its
+    // header per packet (lengths, options, flags differ within a flow),
+    // which is where the time goes - the walk below is already just an
+    // indexed call per layer.
+
     // loop until the protocol id is no longer valid
     while (CodecManager::s_protocols[mapped_prot]->decode(raw, codec_data, p->ptrs))
     {
@@ -387,6 +397,310 @@ static inline uint8_t GetTTL(const Packet* const p, bool forward)
     return ttl;
 }
 
+// ttl selection for the template paths, mirroring EncState::get_ttl:
+// the session ttl is preferred over the triggering packet's, and a
+// reverse direction ttl is clamped to MIN_TTL whichever source it
+// came from
+static inline uint8_t GetTemplateTTL(
+    const Packet* const p, const ip::IP4Hdr* hi_ip, bool fwd)
+{
+    uint8_t ttl = GetTTL(p, fwd);
+
+    if ( fwd )
+        return ttl ? ttl : hi_ip->ip_ttl;
+
+    if ( !ttl )
+        ttl = MAX_TTL - hi_ip->ip_ttl;
+
+    if ( ttl < MIN_TTL )
+        ttl = MIN_TTL;
+
+    return ttl;
+}
+
+//-------------------------------------------------------------------------
+// the note above about reusing an encoding and just tweaking it is
+// implemented here for the dominant case.  a tcp rst over plain
+// eth/ip4 always comes out of the codec walk with the same shape, so
+// each packet thread keeps one preformatted skeleton with the constant
+// fields filled in once and only patches addresses, ports, sequence
+// numbers, ttl, ip id, and checksums before injection.  vlan tags,
+// tunnels, ip6, and payload bearing responses still take the walk.
+//-------------------------------------------------------------------------
+
+static THREAD_LOCAL uint8_t s_rst_template[eth::ETH_HEADER_LEN +
+    ip::IP4_HEADER_LEN + tcp::TCP_MIN_HEADER_LEN];
+static THREAD_LOCAL bool s_rst_template_set = false;
+
+static inline uint16_t RstIpId_Next()
+{
+    // same id source the ip4 codec uses, kept local to the template path
+    static THREAD_LOCAL std::mt19937 id_rand(std::random_device {} ());
+    return (uint16_t)(id_rand() % UINT16_MAX);
+}
+
+static const uint8_t* encode_rst_template(
+    const Packet* p, EncodeFlags flags, uint32_t& len)
+{
+    if ( p->num_layers != 3 or !p->is_eth() or
+        p->layers[0].length != eth::ETH_HEADER_LEN or
+        !p->ptrs.ip_api.is_ip4() or !p->ptrs.tcph )
+        return nullptr;
+
+    eth::EtherHdr* eh = reinterpret_cast<eth::EtherHdr*>(s_rst_template);
+    ip::IP4Hdr* iph = reinterpret_cast<ip::IP4Hdr*>(
+        s_rst_template + eth::ETH_HEADER_LEN);
+    tcp::TCPHdr* tcph = reinterpret_cast<tcp::TCPHdr*>(
+        s_rst_template + eth::ETH_HEADER_LEN + ip::IP4_HEADER_LEN);
+
+    if ( !s_rst_template_set )
+    {
+        memset(s_rst_template, 0, sizeof(s_rst_template));
+
+        eh->ether_type = htons(to_utype(ProtocolId::ETHERTYPE_IPV4));
+
+        iph->ip_verhl = 0x45;
+        iph->ip_len = htons(ip::IP4_HEADER_LEN + tcp::TCP_MIN_HEADER_LEN);
+        iph->ip_proto = IpProtocol::TCP;
+
+        tcph->set_offset(tcp::TCP_MIN_HEADER_LEN >> 2);
+        tcph->th_flags = TH_RST | TH_ACK;
+
+        s_rst_template_set = true;
+    }
+
+    const bool fwd = (flags & ENC_FLAG_FWD) != 0;
+    const eth::EtherHdr* hi_eth =
+        reinterpret_cast<const eth::EtherHdr*>(p->layers[0].start);
+    const ip::IP4Hdr* hi_ip = p->ptrs.ip_api.get_ip4h();
+    const tcp::TCPHdr* hi_tcp = p->ptrs.tcph;
+
+    const SnortConfig* sc = SnortConfig::get_conf();
+
+    if ( fwd )
+        memcpy(eh->ether_src, hi_eth->ether_src, sizeof(eh->ether_src));
+    else
+        memcpy(eh->ether_src, hi_eth->ether_dst, sizeof(eh->ether_src));
+
+    if ( sc->eth_dst )
+        memcpy(eh->ether_dst, sc->eth_dst, sizeof(eh->ether_dst));
+    else if ( fwd )
+        memcpy(eh->ether_dst, hi_eth->ether_dst, sizeof(eh->ether_dst));
+    else
+        memcpy(eh->ether_dst, hi_eth->ether_src, sizeof(eh->ether_dst));
+
+    iph->ip_tos = hi_ip->ip_tos;
+    iph->ip_id = RstIpId_Next();
+    iph->ip_ttl = GetTemplateTTL(p, hi_ip, fwd);
+
+    if ( fwd )
+    {
+        iph->ip_src = hi_ip->ip_src;
+        iph->ip_dst = hi_ip->ip_dst;
+    }
+    else
+    {
+        iph->ip_src = hi_ip->ip_dst;
+        iph->ip_dst = hi_ip->ip_src;
+    }
+
+    iph->ip_csum = 0;
+    iph->ip_csum = checksum::ip_cksum((uint16_t*)iph, ip::IP4_HEADER_LEN);
+
+    const int ctl = (hi_tcp->th_flags & TH_SYN) ? 1 : 0;
+
+    if ( fwd )
+    {
+        tcph->th_sport = hi_tcp->th_sport;
+        tcph->th_dport = hi_tcp->th_dport;
+
+        // th_seq depends on whether the data passes or drops
+        if ( SFDAQ::forwarding_packet(p->pkth) )
+            tcph->th_seq = hi_tcp->th_seq;
+        else
+            tcph->th_seq = htonl(ntohl(hi_tcp->th_seq) + p->dsize + ctl);
+
+        tcph->th_ack = hi_tcp->th_ack;
+    }
+    else
+    {
+        tcph->th_sport = hi_tcp->th_dport;
+        tcph->th_dport = hi_tcp->th_sport;
+
+        tcph->th_seq = hi_tcp->th_ack;
+        tcph->th_ack = htonl(ntohl(hi_tcp->th_seq) + p->dsize + ctl);
+    }
+
+    if ( flags & ENC_FLAG_SEQ )
+    {
+        uint32_t seq = ntohl(tcph->th_seq);
+        seq += (flags & ENC_FLAG_VAL);
+        tcph->th_seq = htonl(seq);
+    }
+
+    checksum::Pseudoheader ps;
+    ps.hdr.sip = iph->ip_src;
+    ps.hdr.dip = iph->ip_dst;
+    ps.hdr.zero = 0;
+    ps.hdr.protocol = IpProtocol::TCP;
+    ps.hdr.len = htons(tcp::TCP_MIN_HEADER_LEN);
+
+    tcph->th_sum = 0;
+    tcph->th_sum = checksum::tcp_cksum(
+        (uint16_t*)tcph, tcp::TCP_MIN_HEADER_LEN, ps);
+
+    pc.response_templates++;
+    len = sizeof(s_rst_template);
+    return s_rst_template;
+}
+
+//-------------------------------------------------------------------------
+// block page injection pushes thousands of payload segments per second
+// during incidents, so the PUSH segments and the trailing FIN reuse the
+// rst skeleton idea: one preformatted header per thread with the payload
+// copied in behind it, and only addresses, lengths, sequence numbers,
+// ip id, and checksums rewritten per segment.
+//-------------------------------------------------------------------------
+
+static constexpr uint32_t DATA_TEMPLATE_HDR_LEN =
+    eth::ETH_HEADER_LEN + ip::IP4_HEADER_LEN + tcp::TCP_MIN_HEADER_LEN;
+
+static THREAD_LOCAL uint8_t s_data_template[eth::ETH_HEADER_LEN + ETHERNET_MTU];
+static THREAD_LOCAL bool s_data_template_set = false;
+
+static const uint8_t* encode_data_template(
+    const Packet* p, EncodeFlags flags, uint32_t& len,
+    const uint8_t* const payload, uint32_t payload_len, bool fin)
+{
+    if ( p->num_layers != 3 or !p->is_eth() or
+        p->layers[0].length != eth::ETH_HEADER_LEN or
+        !p->ptrs.ip_api.is_ip4() or !p->ptrs.tcph )
+        return nullptr;
+
+    if ( payload_len > sizeof(s_data_template) - DATA_TEMPLATE_HDR_LEN )
+        return nullptr;
+
+    eth::EtherHdr* eh = reinterpret_cast<eth::EtherHdr*>(s_data_template);
+    ip::IP4Hdr* iph = reinterpret_cast<ip::IP4Hdr*>(
+        s_data_template + eth::ETH_HEADER_LEN);
+    tcp::TCPHdr* tcph = reinterpret_cast<tcp::TCPHdr*>(
+        s_data_template + eth::ETH_HEADER_LEN + ip::IP4_HEADER_LEN);
+
+    if ( !s_data_template_set )
+    {
+        memset(s_data_template, 0, DATA_TEMPLATE_HDR_LEN);
+
+        eh->ether_type = htons(to_utype(ProtocolId::ETHERTYPE_IPV4));
+
+        iph->ip_verhl = 0x45;
+        iph->ip_proto = IpProtocol::TCP;
+
+        tcph->set_offset(tcp::TCP_MIN_HEADER_LEN >> 2);
+
+        s_data_template_set = true;
+    }
+
+    const bool fwd = (flags & ENC_FLAG_FWD) != 0;
+    const eth::EtherHdr* hi_eth =
+        reinterpret_cast<const eth::EtherHdr*>(p->layers[0].start);
+    const ip::IP4Hdr* hi_ip = p->ptrs.ip_api.get_ip4h();
+    const tcp::TCPHdr* hi_tcp = p->ptrs.tcph;
+
+    const SnortConfig* sc = SnortConfig::get_conf();
+
+    if ( fwd )
+        memcpy(eh->ether_src, hi_eth->ether_src, sizeof(eh->ether_src));
+    else
+        memcpy(eh->ether_src, hi_eth->ether_dst, sizeof(eh->ether_src));
+
+    if ( sc->eth_dst )
+        memcpy(eh->ether_dst, sc->eth_dst, sizeof(eh->ether_dst));
+    else if ( fwd )
+        memcpy(eh->ether_dst, hi_eth->ether_dst, sizeof(eh->ether_dst));
+    else
+        memcpy(eh->ether_dst, hi_eth->ether_src, sizeof(eh->ether_dst));
+
+    iph->ip_tos = hi_ip->ip_tos;
+    iph->ip_id = RstIpId_Next();
+    iph->ip_len = htons((uint16_t)(
+        ip::IP4_HEADER_LEN + tcp::TCP_MIN_HEADER_LEN + payload_len));
+    iph->ip_ttl = GetTemplateTTL(p, hi_ip, fwd);
+
+    if ( fwd )
+    {
+        iph->ip_src = hi_ip->ip_src;
+        iph->ip_dst = hi_ip->ip_dst;
+    }
+    else
+    {
+        iph->ip_src = hi_ip->ip_dst;
+        iph->ip_dst = hi_ip->ip_src;
+    }
+
+    iph->ip_csum = 0;
+    iph->ip_csum = checksum::ip_cksum((uint16_t*)iph, ip::IP4_HEADER_LEN);
+
+    const int ctl = (hi_tcp->th_flags & TH_SYN) ? 1 : 0;
+
+    if ( fwd )
+    {
+        tcph->th_sport = hi_tcp->th_sport;
+        tcph->th_dport = hi_tcp->th_dport;
+
+        // th_seq depends on whether the data passes or drops
+        if ( SFDAQ::forwarding_packet(p->pkth) )
+            tcph->th_seq = hi_tcp->th_seq;
+        else
+            tcph->th_seq = htonl(ntohl(hi_tcp->th_seq) + p->dsize + ctl);
+
+        tcph->th_ack = hi_tcp->th_ack;
+    }
+    else
+    {
+        tcph->th_sport = hi_tcp->th_dport;
+        tcph->th_dport = hi_tcp->th_sport;
+
+        tcph->th_seq = hi_tcp->th_ack;
+        tcph->th_ack = htonl(ntohl(hi_tcp->th_seq) + p->dsize + ctl);
+    }
+
+    if ( flags & ENC_FLAG_SEQ )
+    {
+        uint32_t seq = ntohl(tcph->th_seq);
+        seq += (flags & ENC_FLAG_VAL);
+        tcph->th_seq = htonl(seq);
+    }
+
+    if ( fin )
+    {
+        tcph->th_flags = TH_FIN | TH_ACK;
+        tcph->th_win = 0;
+    }
+    else
+    {
+        tcph->th_flags = TH_PUSH | TH_ACK;
+        tcph->th_win = htons(65535);
+    }
+
+    if ( payload and payload_len )
+        memcpy(s_data_template + DATA_TEMPLATE_HDR_LEN, payload, payload_len);
+
+    checksum::Pseudoheader ps;
+    ps.hdr.sip = iph->ip_src;
+    ps.hdr.dip = iph->ip_dst;
+    ps.hdr.zero = 0;
+    ps.hdr.protocol = IpProtocol::TCP;
+    ps.hdr.len = htons((uint16_t)(tcp::TCP_MIN_HEADER_LEN + payload_len));
+
+    tcph->th_sum = 0;
+    tcph->th_sum = checksum::tcp_cksum(
+        (uint16_t*)tcph, tcp::TCP_MIN_HEADER_LEN + payload_len, ps);
+
+    pc.inject_templates++;
+    len = DATA_TEMPLATE_HDR_LEN + payload_len;
+    return s_data_template;
+}
+
 bool PacketManager::encode(const Packet* p,
     EncodeFlags flags,
     uint8_t lyr_start,
@@ -452,6 +766,26 @@ const uint8_t* PacketManager::encode_response(
     TcpResponse type, EncodeFlags flags, const Packet* p, uint32_t& len,
     const uint8_t* const payload, uint32_t payload_len)
 {
+    if ( type == TcpResponse::RST and !(payload and payload_len) )
+    {
+        // encode() below makes the same substitution for the codec walk
+        if ( Packet* pe = DetectionEngine::get_encode_packet() )
+            p = pe;
+
+        if ( const uint8_t* rsp = encode_rst_template(p, flags, len) )
+            return rsp;
+    }
+    else if ( type == TcpResponse::PUSH or type == TcpResponse::FIN )
+    {
+        // encode() below makes the same substitution for the codec walk
+        if ( Packet* pe = DetectionEngine::get_encode_packet() )
+            p = pe;
+
+        if ( const uint8_t* rsp = encode_data_template(
+            p, flags, len, payload, payload_len, type == TcpResponse::FIN) )
+            return rsp;
+    }
+
     Buffer buf(s_pkt->data(), s_pkt->size());
 
     switch (type)
@@ -1623,29 +1623,48 @@ void acsmx2_print_qinfo()
 *   Perf-Notes:
 *    1) replaced ConvertCaseEx with inline xlatcase - this improves performance 5-10%
 *    2) using 'nocase' improves performance again by 10-15%, since memcmp is not needed
-*    3)
+*    3) the state walk is a serial dependency chain (each transition needs the
+*       previous state), so only the case fold can be vectorized; it is done in
+*       blocks with a branchless loop the compiler turns into SSE2/AVX2/NEON code,
+*       decoupling the byte translation from the table-dependent loads
 */
+#define AC_XLAT_BLOCK 256
+
+static inline void acsm_xlat_block(uint8_t* d, const uint8_t* s, int n)
+{
+    for ( int i = 0; i < n; i++ )
+    {
+        uint8_t c = s[i];
+        d[i] = (uint8_t)(c - (((c >= 'a') & (c <= 'z')) << 5));
+    }
+}
+
 #define AC_SEARCH \
-    for (; T < Tend; T++ ) \
+    while ( T < Tend ) \
     { \
-        ps = NextState[ state ]; \
-        sindex = xlatcase[T[0]]; \
-        if (ps[1]) \
+        int bn = (Tend - T) < AC_XLAT_BLOCK ? (int)(Tend - T) : AC_XLAT_BLOCK; \
+        acsm_xlat_block(Tb, T, bn); \
+        for ( int bi = 0; bi < bn; bi++ ) \
         { \
-            mlist = MatchList[state]; \
-            if (mlist) \
+            ps = NextState[ state ]; \
+            if (ps[1]) \
             { \
-                index = T - Tx; \
-                nfound++; \
-                if (match (mlist->udata, mlist->rule_option_tree, index, context, \
-                    mlist->neg_list) > 0) \
+                mlist = MatchList[state]; \
+                if (mlist) \
                 { \
-                    *current_state = state; \
-                    return nfound; \
+                    index = (T + bi) - Tx; \
+                    nfound++; \
+                    if (match (mlist->udata, mlist->rule_option_tree, index, context, \
+                        mlist->neg_list) > 0) \
+                    { \
+                        *current_state = state; \
+                        return nfound; \
+                    } \
                 } \
             } \
+            state = ps[2u + Tb[bi]]; \
         } \
-        state = ps[2u + sindex]; \
+        T += bn; \
     }
 
 int acsm_search_dfa_full(
@@ -1656,8 +1675,8 @@ int acsm_search_dfa_full(
     ACSM_PATTERN2* mlist;
     const uint8_t* Tend;
     const uint8_t* T;
+    uint8_t Tb[AC_XLAT_BLOCK];
     int index;
-    int sindex;
     int nfound = 0;
     acstate_t state;
     ACSM_PATTERN2** MatchList = acsm->acsmMatchList;
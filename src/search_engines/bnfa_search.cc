@@ -906,11 +906,64 @@ static int _bnfa_conv_list_to_csparse_array(bnfa_struct_t* bnfa)
         return -1;
     }
 
+    /*
+       Order the states breadth-first from the root before packing.  States
+       near the root absorb most of the transitions in steady state, so
+       emitting them first packs the hot rows into the leading cache lines
+       of the transition list instead of scattering them by pattern
+       insertion order.  State ids do not change - only the position of
+       each row in the array - and pi[] resolves ids to offsets as before.
+    */
+    bnfa_state_t* order = BNFA_MALLOC(bnfa->bnfaNumStates*sizeof(bnfa_state_t),
+        bnfa->queue_memory);
+    if ( !order )
+    {
+        BNFA_FREE(pi,bnfa->bnfaNumStates*sizeof(bnfa_state_t),bnfa->nextstate_memory);
+        return -1;
+    }
+
+    {
+        uint8_t* visited = (uint8_t*)snort_calloc(bnfa->bnfaNumStates);
+        int tail = 0;
+
+        order[tail++] = 0;
+        visited[0] = 1;
+
+        for ( int head = 0; head < tail; head++ )
+        {
+            _bnfa_list_conv_row_to_full(bnfa, order[head], full);
+
+            for ( i=0; i<bnfa->bnfaAlphabetSize; i++ )
+            {
+                state = full[i] & BNFA_SPARSE_MAX_STATE;
+                if ( state && !visited[state] )
+                {
+                    visited[state] = 1;
+                    order[tail++] = state;
+                }
+            }
+        }
+
+        /* keep any unreachable states (should not happen) at the end */
+        for ( k=0; k<bnfa->bnfaNumStates; k++ )
+        {
+            if ( !visited[k] )
+                order[tail++] = k;
+        }
+        snort_free(visited);
+    }
+
     /*
         Build the Transition List Array
     */
-    for (k=0; k<bnfa->bnfaNumStates; k++)
+    for (int j=0; j<bnfa->bnfaNumStates; j++)
     {
+        k = order[j];
+
+        /* track how tightly the shallow (hot) states pack */
+        if ( j == 256 )
+            bnfa->bnfaHotStateBytes = ps_index * sizeof(bnfa_state_t);
+
         pi[k] = ps_index; /* save index of start of state 'k' */
 
         ps[ ps_index ] = k; /* save the state were in as the 1st word */
@@ -973,6 +1026,11 @@ static int _bnfa_conv_list_to_csparse_array(bnfa_struct_t* bnfa)
         }
     }
 
+    if ( bnfa->bnfaNumStates <= 256 )
+        bnfa->bnfaHotStateBytes = ps_index * sizeof(bnfa_state_t);
+
+    BNFA_FREE(order,bnfa->bnfaNumStates*sizeof(bnfa_state_t),bnfa->queue_memory);
+
     /* sanity check we have not overflowed our buffer */
     if ( ps_index > nps )
     {
@@ -1660,6 +1718,7 @@ static void bnfaPrintInfoEx(bnfa_struct_t* p)
     LogCount("pattern chars", p->bnfaMaxStates);
     LogCount("num states", p->bnfaNumStates);
     LogCount("num match states", p->bnfaMatchStates);
+    LogCount("hot state bytes", p->bnfaHotStateBytes);
 
     double scale;
 
@@ -1707,6 +1766,7 @@ void bnfaAccumInfo(bnfa_struct_t* p)
     px->bnfaNumStates    += p->bnfaNumStates;
     px->bnfaNumTrans     += p->bnfaNumTrans;
     px->bnfaMatchStates  += p->bnfaMatchStates;
+    px->bnfaHotStateBytes += p->bnfaHotStateBytes;
     px->bnfa_memory      += p->bnfa_memory;
     px->pat_memory       += p->pat_memory;
     px->list_memory      += p->list_memory;
@@ -1715,3 +1775,52 @@ void bnfaAccumInfo(bnfa_struct_t* p)
     px->failstate_memory += p->failstate_memory;
 }
 
+
+#ifdef BENCHMARK_TEST
+
+#include "catch/snort_catch.h"
+
+static const MpseAgent s_bench_agent =
+{
+    [](SnortConfig*, void*, void** ppt) { *ppt = nullptr; return 0; },
+    [](void*, void** ppl) { *ppl = nullptr; return 0; },
+    [](void*) { },
+    [](void**) { },
+    [](void**) { }
+};
+
+static int s_bench_match(void*, void*, int, void*, void*)
+{ return 0; }
+
+TEST_CASE("bnfa search speed", "[benchmark]")
+{
+    bnfa_init_xlatcase();
+    bnfa_struct_t* bnfa = bnfaNew(&s_bench_agent);
+    REQUIRE(bnfa != nullptr);
+
+    const char* pats[] =
+    { "GET ", "POST ", "Content-Length", "Transfer-Encoding", "attack" };
+
+    for ( const char* p : pats )
+        bnfaAddPattern(bnfa, (const uint8_t*)p, strlen(p), true, false, nullptr);
+
+    bnfaCompile(nullptr, bnfa);
+
+    std::string text;
+
+    while ( text.size() < 4096 )
+        text += "PUT /index.html HTTP/1.1\r\nHost: bench.example\r\nAccept: */*\r\n\r\n";
+
+    int state;
+
+    BENCHMARK("4k http text")
+    {
+        state = 0;
+        return _bnfa_search_csparse_nfa(bnfa, (const uint8_t*)text.c_str(),
+            (int)text.size(), s_bench_match, nullptr, 0, &state);
+    };
+
+    bnfaFree(bnfa);
+}
+
+#endif
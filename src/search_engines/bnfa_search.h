@@ -132,6 +132,7 @@ struct bnfa_struct_t
     int bnfaNumStates;
     int bnfaNumTrans;
     int bnfaMatchStates;
+    unsigned bnfaHotStateBytes;  /* span of the 256 shallowest states after bfs packing */
 
     bnfa_pattern_t* bnfaPatterns;
     bnfa_trans_node_t** bnfaTransTable;
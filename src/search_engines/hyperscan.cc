@@ -22,20 +22,38 @@
 #include "config.h"
 #endif
 
-#include <hs_compile.h>
-#include <hs_runtime.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <hs.h>
+
+// pure-literal groups compile through the literal api: no escaping round
+// trip and leaner databases and scratch than the regex compiler produces
+// for the same patterns.  the api appeared in hyperscan 5.2.
+#if defined(HS_MAJOR) && (HS_MAJOR > 5 || (HS_MAJOR == 5 && HS_MINOR >= 2))
+#define HAVE_HS_LITERALS 1
+#endif
 
 #include <cassert>
+#include <cinttypes>
+#include <cstdio>
 #include <cstring>
+#include <mutex>
+#include <unordered_map>
 
 #include "framework/module.h"
 #include "framework/mpse.h"
+#include "framework/mpse_batch.h"
 #include "helpers/scratch_allocator.h"
 #include "log/messages.h"
 #include "main/snort_config.h"
 #include "main/thread.h"
 #include "utils/stats.h"
 
+#include "pat_stats.h"
+
 using namespace snort;
 
 static const char* s_name = "hyperscan";
@@ -44,6 +62,7 @@ static const char* s_help = "intel hyperscan-based mpse with regex support";
 struct Pattern
 {
     std::string pat;
+    std::string raw;  // unescaped bytes for the literal compile path
     unsigned len;
     unsigned flags;
     bool no_case;
@@ -61,6 +80,7 @@ Pattern::Pattern(
     const uint8_t* s, unsigned n, const Mpse::PatternDescriptor& d, void* u)
 {
     escape(s, n, d.literal);
+    raw.assign((const char*)s, n);
 
     len = n;
     no_case = d.no_case;
@@ -107,6 +127,134 @@ static std::vector<hs_scratch_t*> s_scratch;
 static unsigned int scratch_index;
 static ScratchAllocator* scratcher = nullptr;
 
+//-------------------------------------------------------------------------
+// database cache
+//
+// hyperscan databases are relocatable, so compiled tables can be reused
+// across restarts and shared by the co-resident snort processes on a box.
+// the first process to compile a pattern set publishes the serialized
+// database under a content hash; everyone else attaches the file read-only
+// via mmap and deserializes, skipping the (expensive) compile entirely.
+//-------------------------------------------------------------------------
+
+static std::string s_db_cache_dir;
+
+static uint64_t db_cache_hash(const PatternVector& pv, bool lit)
+{
+    std::hash<std::string> h;
+    uint64_t key = pv.size() * 2 + lit;
+
+    for ( const auto& p : pv )
+        key = (key * 1099511628211ULL) ^ h(lit ? p.raw : p.pat) ^ p.flags;
+
+    return key;
+}
+
+static hs_database_t* db_cache_load(const std::string& path)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+
+    if ( fd < 0 )
+        return nullptr;
+
+    struct stat sb;
+
+    if ( fstat(fd, &sb) or !sb.st_size )
+    {
+        close(fd);
+        return nullptr;
+    }
+
+    void* base = mmap(nullptr, sb.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if ( base == MAP_FAILED )
+        return nullptr;
+
+    hs_database_t* db = nullptr;
+
+    if ( hs_deserialize_database((const char*)base, sb.st_size, &db) != HS_SUCCESS )
+        db = nullptr;
+
+    munmap(base, sb.st_size);
+    return db;
+}
+
+// compiled databases are immutable and reference patterns by id only, so
+// configs with identical pattern sets can share one database.  on reload
+// unchanged groups find their database here and skip compilation; the old
+// config's instances release their references as they are deleted.
+struct DbShareEntry
+{
+    hs_database_t* db;
+    unsigned refs;
+};
+
+static std::unordered_map<uint64_t, DbShareEntry> s_db_share;
+static std::mutex s_db_share_mutex;  // compiles may run multi-threaded
+
+static hs_database_t* db_share_get(uint64_t key)
+{
+    std::lock_guard<std::mutex> lock(s_db_share_mutex);
+    auto it = s_db_share.find(key);
+
+    if ( it == s_db_share.end() )
+        return nullptr;
+
+    it->second.refs++;
+    return it->second.db;
+}
+
+static void db_share_put(uint64_t key, hs_database_t* db)
+{
+    std::lock_guard<std::mutex> lock(s_db_share_mutex);
+    s_db_share.emplace(key, DbShareEntry{ db, 1 });
+}
+
+static void db_share_release(uint64_t key, hs_database_t* db)
+{
+    std::lock_guard<std::mutex> lock(s_db_share_mutex);
+    auto it = s_db_share.find(key);
+
+    if ( it == s_db_share.end() or it->second.db != db )
+    {
+        hs_free_database(db);
+        return;
+    }
+
+    if ( !--it->second.refs )
+    {
+        hs_free_database(it->second.db);
+        s_db_share.erase(it);
+    }
+}
+
+static void db_cache_store(const std::string& path, const hs_database_t* db)
+{
+    char* bytes = nullptr;
+    size_t size = 0;
+
+    if ( hs_serialize_database(db, &bytes, &size) != HS_SUCCESS )
+        return;
+
+    // write to a temp name and rename so concurrent processes never
+    // observe a partial database
+    std::string tmp = path + "." + std::to_string(getpid());
+    FILE* f = fopen(tmp.c_str(), "wb");
+
+    if ( f )
+    {
+        size_t n = fwrite(bytes, 1, size, f);
+        fclose(f);
+
+        if ( n == size )
+            rename(tmp.c_str(), path.c_str());
+        else
+            unlink(tmp.c_str());
+    }
+    free(bytes);
+}
+
 struct ScanContext
 {
     class HyperscanMpse* mpse;
@@ -136,7 +284,7 @@ public:
     ~HyperscanMpse() override
     {
         if ( hs_db )
-            hs_free_database(hs_db);
+            db_share_release(db_key, hs_db);
 
         if ( agent )
             user_dtor();
@@ -146,6 +294,12 @@ public:
         const uint8_t* pat, unsigned len, const PatternDescriptor& desc, void* user) override
     {
         Pattern p(pat, len, desc, user);
+
+        // the literal api accepts only case and match-count flags; one
+        // pattern needing more drops the whole group to the regex compiler
+        if ( !desc.literal or (p.flags & ~(HS_FLAG_CASELESS | HS_FLAG_SINGLEMATCH)) )
+            all_literal = false;
+
         pvector.emplace_back(p);
         ++patterns;
         return 0;
@@ -154,6 +308,7 @@ public:
     int prep_patterns(SnortConfig*) override;
 
     int _search(const uint8_t*, int, MpseMatch, void*, int*) override;
+    void _search(MpseBatch&, MpseType) override;
 
     int get_pattern_count() const override
     { return pvector.size(); }
@@ -172,14 +327,18 @@ private:
     PatternVector pvector;
 
     hs_database_t* hs_db = nullptr;
+    uint64_t db_key = 0;
+    bool all_literal = true;
 
 public:
     static uint64_t instances;
     static uint64_t patterns;
+    static uint64_t literal_dbs;
 };
 
 uint64_t HyperscanMpse::instances = 0;
 uint64_t HyperscanMpse::patterns = 0;
+uint64_t HyperscanMpse::literal_dbs = 0;
 
 // other mpse have direct access to their fsm match states and populate
 // user list and tree with each pattern that leads to the same match state.
@@ -228,30 +387,78 @@ int HyperscanMpse::prep_patterns(SnortConfig* sc)
         return -1;
     }
 
+#ifdef HAVE_HS_LITERALS
+    const bool lit = all_literal;
+#else
+    const bool lit = false;
+#endif
+
     hs_compile_error_t* errptr = nullptr;
     std::vector<const char*> pats;
     std::vector<unsigned> flags;
     std::vector<unsigned> ids;
+    std::vector<size_t> lens;
 
     unsigned id = 0;
 
     for ( auto& p : pvector )
     {
-        pats.emplace_back(p.pat.c_str());
+        pats.emplace_back(lit ? p.raw.c_str() : p.pat.c_str());
+        lens.emplace_back(p.raw.size());
         flags.emplace_back(p.flags);
         ids.emplace_back(id++);
     }
 
-    if ( hs_compile_multi(&pats[0], &flags[0], &ids[0], pvector.size(), HS_MODE_BLOCK,
-            nullptr, &hs_db, &errptr) or !hs_db )
+    db_key = db_cache_hash(pvector, lit);
+
+    // an unchanged group (eg across a reload) shares the database already
+    // compiled for this pattern set
+    hs_db = db_share_get(db_key);
+
+    if ( !hs_db )
     {
-        ParseError("can't compile hyperscan pattern database: %s (%d) - '%s'",
-            errptr->message, errptr->expression,
-            errptr->expression >= 0 ? pats[errptr->expression] : "");
-        hs_free_compile_error(errptr);
-        return -2;
+        std::string cache_path;
+
+        if ( !s_db_cache_dir.empty() )
+        {
+            char name[40];
+            snprintf(name, sizeof(name), "/hs_%016" PRIx64 ".db", db_key);
+            cache_path = s_db_cache_dir + name;
+            hs_db = db_cache_load(cache_path);
+        }
+
+        if ( !hs_db )
+        {
+            hs_error_t err;
+
+#ifdef HAVE_HS_LITERALS
+            if ( lit )
+                err = hs_compile_lit_multi(&pats[0], &flags[0], &ids[0], &lens[0],
+                    pvector.size(), HS_MODE_BLOCK, nullptr, &hs_db, &errptr);
+            else
+#endif
+            err = hs_compile_multi(&pats[0], &flags[0], &ids[0], pvector.size(), HS_MODE_BLOCK,
+                    nullptr, &hs_db, &errptr);
+
+            if ( err or !hs_db )
+            {
+                ParseError("can't compile hyperscan pattern database: %s (%d) - '%s'",
+                    errptr->message, errptr->expression,
+                    errptr->expression >= 0 ? pats[errptr->expression] : "");
+                hs_free_compile_error(errptr);
+                return -2;
+            }
+
+            if ( !cache_path.empty() )
+                db_cache_store(cache_path, hs_db);
+        }
+
+        db_share_put(db_key, hs_db);
     }
 
+    if ( lit )
+        ++literal_dbs;
+
     if ( hs_error_t err = hs_alloc_scratch(hs_db, &s_scratch[get_instance_id()]) )
     {
         ParseError("can't allocate search scratch space (%d)", err);
@@ -297,6 +504,55 @@ int HyperscanMpse::_search(
     return scan.nfound;
 }
 
+// batched entry point for the per-packet buffer set collected by fp_detect.
+// hs_scan_vector is not used here because vectored mode treats the buffer
+// set as one logical stream: offsets accumulate across buffers and patterns
+// may match across buffer boundaries, neither of which fits per-buffer fast
+// pattern semantics.  batching still amortizes the per-thread scratch and
+// config resolution over the whole set instead of paying it per buffer.
+void HyperscanMpse::_search(MpseBatch& batch, MpseType mpse_type)
+{
+    hs_scratch_t* ss =
+        (hs_scratch_t*)SnortConfig::get_conf()->state[get_instance_id()][scratch_index];
+
+    for ( auto& item : batch.items )
+    {
+        if (item.second.done)
+            continue;
+
+        item.second.error = false;
+        item.second.matches = 0;
+
+        for ( auto& so : item.second.so )
+        {
+            Mpse* mpse = (mpse_type == MPSE_TYPE_OFFLOAD) ?
+                so->get_offload_mpse() : so->get_normal_mpse();
+
+            if ( mpse != this )
+            {
+                int start_state = 0;
+                item.second.matches += mpse->search(
+                    item.first.buf, item.first.len, batch.mf, batch.context, &start_state);
+                continue;
+            }
+
+            // scratch is null for the degenerate case w/o patterns
+            assert(!hs_db or ss);
+
+            // going around Mpse::search, so do its byte accounting here
+            pmqs.matched_bytes += item.first.len;
+
+            ScanContext scan(this, batch.mf, batch.context);
+
+            hs_scan(hs_db, (const char*)item.first.buf, item.first.len, 0, ss,
+                HyperscanMpse::match, &scan);
+
+            item.second.matches += scan.nfound;
+        }
+        item.second.done = true;
+    }
+}
+
 static bool scratch_setup(SnortConfig* sc)
 {
     // find the largest scratch and clone for all slots
@@ -353,10 +609,19 @@ static void scratch_cleanup(SnortConfig* sc)
     }
 }
 
+static const Parameter hs_params[] =
+{
+    { "db_cache_dir", Parameter::PT_STRING, nullptr, nullptr,
+      "cache serialized pattern databases here for reuse across restarts"
+      " and processes (empty disables caching)" },
+
+    { nullptr, Parameter::PT_MAX, nullptr, nullptr, nullptr }
+};
+
 class HyperscanModule : public Module
 {
 public:
-    HyperscanModule() : Module(s_name, s_help)
+    HyperscanModule() : Module(s_name, s_help, hs_params)
     {
         scratcher = new SimpleScratchAllocator(scratch_setup, scratch_cleanup);
         scratch_index = scratcher->get_id();
@@ -364,6 +629,16 @@ public:
 
     ~HyperscanModule() override
     { delete scratcher; }
+
+    bool set(const char*, Value& v, SnortConfig*) override
+    {
+        if ( v.is("db_cache_dir") )
+            s_db_cache_dir = v.get_string();
+        else
+            return false;
+
+        return true;
+    }
 };
 
 //-------------------------------------------------------------------------
@@ -394,12 +669,14 @@ static void hs_init()
 {
     HyperscanMpse::instances = 0;
     HyperscanMpse::patterns = 0;
+    HyperscanMpse::literal_dbs = 0;
 }
 
 static void hs_print()
 {
     LogCount("instances", HyperscanMpse::instances);
     LogCount("patterns", HyperscanMpse::patterns);
+    LogCount("literal databases", HyperscanMpse::literal_dbs);
 }
 
 static const MpseApi hs_api =
@@ -1507,9 +1507,14 @@ static DCE2_Ret dce_co_handle_frag(DCE2_SsnData* sd, DCE2_CoTracker* cot,
         if (DceRpcCoLastFrag(co_hdr) || (DCE2_BufferLength(frag_buf) == max_frag_data))
             mflag = DCE2_BUFFER_MIN_ADD_FLAG__IGNORE;
 
+        uint32_t prev_size = DCE2_BufferSize(frag_buf);
+
         status = DCE2_BufferAddData(frag_buf, frag_ptr,
             frag_len, DCE2_BufferLength(frag_buf), mflag);
 
+        if ((prev_size != 0) && (DCE2_BufferSize(frag_buf) != prev_size))
+            dce_common_stats->co_reassembly_reallocs++;
+
         if (status != DCE2_RET__SUCCESS)
         {
             /* memcpy failed - reassemble */
@@ -2349,7 +2354,7 @@ static DCE2_Ret DCE2_HandleSegmentation(DCE2_Buffer* seg_buf, const uint8_t* dat
  * buffer object if necessary.
  *
  ********************************************************************/
-static DCE2_Ret DCE2_CoHandleSegmentation(DCE2_SsnData*, DCE2_CoSeg* seg,
+static DCE2_Ret DCE2_CoHandleSegmentation(DCE2_SsnData* sd, DCE2_CoSeg* seg,
     const uint8_t* data_ptr, uint16_t data_len, uint16_t need_len, uint16_t* data_used)
 {
     if (seg == nullptr)
@@ -2366,7 +2371,14 @@ static DCE2_Ret DCE2_CoHandleSegmentation(DCE2_SsnData*, DCE2_CoSeg* seg,
         }
     }
 
-    return DCE2_HandleSegmentation(seg->buf, data_ptr, data_len, need_len, data_used);
+    uint32_t prev_size = DCE2_BufferSize(seg->buf);
+
+    DCE2_Ret status = DCE2_HandleSegmentation(seg->buf, data_ptr, data_len, need_len, data_used);
+
+    if ((prev_size != 0) && (DCE2_BufferSize(seg->buf) != prev_size))
+        dce_get_proto_stats_ptr(sd)->co_reassembly_reallocs++;
+
+    return status;
 }
 
 /********************************************************************
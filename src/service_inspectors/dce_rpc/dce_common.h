@@ -87,6 +87,7 @@ struct dce2CommonStats
     PegCount co_srv_min_frag_size;
     PegCount co_srv_seg_reassembled;
     PegCount co_srv_frag_reassembled;
+    PegCount co_reassembly_reallocs;
 };
 #define DCE2_SARG__POLICY_WIN2000       "Win2000"
 #define DCE2_SARG__POLICY_WINXP         "WinXP"
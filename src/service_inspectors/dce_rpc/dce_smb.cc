@@ -454,6 +454,7 @@ static void dce2_smb_thread_int()
 static void dce_smb_thread_term()
 {
     delete smb2_session_cache;
+    DCE2_BufferPurgeCache();
 }
 
 static Inspector* dce2_smb_ctor(Module* m)
@@ -160,6 +160,7 @@ struct dce2SmbStats
     PegCount co_srv_min_frag_size;
     PegCount co_srv_seg_reassembled;
     PegCount co_srv_frag_reassembled;
+    PegCount co_reassembly_reallocs;
 
     PegCount smb_sessions;
     PegCount smb_pkts;
@@ -230,6 +231,8 @@ struct dce2SmbStats
     PegCount v2_bad_next_cmd_offset;
     PegCount v2_extra_file_data_err;
     PegCount v2_inv_file_ctx_err;
+    PegCount v2_file_passthroughs;
+    PegCount v2_file_bytes_skipped;
     PegCount v2_msgs_uninspected;
     PegCount v2_cmpnd_req_lt_crossed;
     PegCount concurrent_sessions;
@@ -153,6 +153,9 @@ public:
     uint64_t file_size = 0;
     std::string file_name;
     DCE2_SmbPduState smb2_pdu_state;
+    // set when the file API and rule detection are both done with this
+    // file; subsequent read/write payload only updates offsets
+    bool passthrough = false;
 };
 
 
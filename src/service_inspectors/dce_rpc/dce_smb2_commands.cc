@@ -61,6 +61,15 @@ void DCE2_Smb2ProcessFileData(DCE2_Smb2SsnData* ssd, const uint8_t* file_data,
     int64_t file_detection_depth = DCE2_ScSmbFileDepth((dce2SmbProtoConf*)ssd->sd.config);
     int64_t detection_size = 0;
 
+    // Once file inspection has delivered its verdict and the detection
+    // depth is spent there is nothing left to inspect; the callers keep
+    // tracking offsets but the payload itself is skipped.
+    if (ssd->ftracker_tcp->passthrough)
+    {
+        dce2_smb_stats.v2_file_bytes_skipped += data_size;
+        return;
+    }
+
     if (file_detection_depth == 0)
         detection_size = data_size;
     else if ( ssd->ftracker_tcp->file_offset < (uint64_t)file_detection_depth)
@@ -91,8 +100,12 @@ void DCE2_Smb2ProcessFileData(DCE2_Smb2SsnData* ssd, const uint8_t* file_data,
         return;
     }
 
-    file_flows->file_process(p, ssd->ftracker_tcp->file_id, file_data, data_size,
-        ssd->ftracker_tcp->file_offset, dir);
+    if (!file_flows->file_process(p, ssd->ftracker_tcp->file_id, file_data, data_size,
+        ssd->ftracker_tcp->file_offset, dir) and !detection_size)
+    {
+        ssd->ftracker_tcp->passthrough = true;
+        dce2_smb_stats.v2_file_passthroughs++;
+    }
 }
 
 //-------------------------------------------------------------------------
@@ -76,6 +76,8 @@ static const PegInfo dce2_smb_pegs[] =
         "total connection-oriented server segments reassembled" },
     { CountType::SUM, "server_frags_reassembled",
         "total connection-oriented server fragments reassembled" },
+    { CountType::SUM, "reassembly_reallocs",
+        "total reassembly buffer reallocations" },
     { CountType::SUM, "sessions", "total smb sessions" },
     { CountType::SUM, "packets", "total smb packets" },
     { CountType::SUM, "ignored_bytes", "total ignored bytes" },
@@ -172,6 +174,10 @@ static const PegInfo dce2_smb_pegs[] =
         "total number of SMBv2 packets seen with where file data beyond file size is observed" },
     { CountType::SUM, "v2_inv_file_ctx_err",
         "total number of times null file context are seen resulting in not being able to set file size" },
+    { CountType::SUM, "v2_file_passthroughs",
+        "total number of SMBv2 file transfers switched to passthrough after file inspection completed" },
+    { CountType::SUM, "v2_file_bytes_skipped",
+        "total number of SMBv2 read/write payload bytes skipped in passthrough mode" },
     { CountType::SUM, "v2_msgs_uninspected",
         "total number of SMBv2 packets seen where command is not being inspected" },
     { CountType::SUM, "v2_cmpnd_req_lt_crossed",
@@ -1243,9 +1243,14 @@ DCE2_Ret DCE2_SmbHandleSegmentation(DCE2_Buffer** buf,
         *buf = DCE2_BufferNew(alloc_size, alloc_size);
     }
 
+    uint32_t prev_size = DCE2_BufferSize(*buf);
+
     DCE2_Ret status = DCE2_BufferAddData(*buf, data_ptr, add_len,
         DCE2_BufferLength(*buf), DCE2_BUFFER_MIN_ADD_FLAG__IGNORE);
 
+    if ((prev_size != 0) && (DCE2_BufferSize(*buf) != prev_size))
+        dce2_smb_stats.co_reassembly_reallocs++;
+
     return status;
 }
 
@@ -192,6 +192,11 @@ static void dce2_tcp_init()
     DceContextData::init(DCE2_TRANS_TYPE__TCP);
 }
 
+static void dce2_tcp_thread_term()
+{
+    DCE2_BufferPurgeCache();
+}
+
 const InspectApi dce2_tcp_api =
 {
     {
@@ -213,7 +218,7 @@ const InspectApi dce2_tcp_api =
     dce2_tcp_init,
     nullptr, // pterm
     nullptr, // tinit
-    nullptr, // tterm
+    dce2_tcp_thread_term, // tterm
     dce2_tcp_ctor,
     dce2_tcp_dtor,
     nullptr, // ssn
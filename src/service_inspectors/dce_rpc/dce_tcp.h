@@ -65,6 +65,7 @@ struct dce2TcpStats
     PegCount co_srv_min_frag_size;
     PegCount co_srv_seg_reassembled;
     PegCount co_srv_frag_reassembled;
+    PegCount co_reassembly_reallocs;
 
     /*DCE TCP specific*/
     PegCount tcp_sessions;
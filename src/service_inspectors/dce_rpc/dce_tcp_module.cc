@@ -111,6 +111,8 @@ static const PegInfo dce2_tcp_pegs[] =
         "total connection-oriented server segments reassembled" },
     { CountType::SUM, "server_frags_reassembled",
         "total connection-oriented server fragments reassembled" },
+    { CountType::SUM, "reassembly_reallocs",
+        "total reassembly buffer reallocations" },
     { CountType::SUM, "tcp_sessions", "total tcp sessions" },
     { CountType::SUM, "tcp_expected_sessions", "total tcp dynamic endpoint expected sessions" },
     { CountType::SUM, "tcp_expected_realized", "total tcp dynamic endpoint expected realized sessions" },
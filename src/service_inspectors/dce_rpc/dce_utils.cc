@@ -23,6 +23,7 @@
 
 #include "dce_utils.h"
 
+#include "main/thread.h"
 #include "utils/safec.h"
 #include "utils/util.h"
 
@@ -183,12 +184,87 @@ const char* DCE2_UuidToStr(
 }
 
 
+/* Reassembly buffers are torn down and rebuilt for every PDU, so recycle
+ * freed data blocks through a small per thread cache instead of round
+ * tripping each one through the allocator.  Recycled blocks are zeroed on
+ * reuse since callers depend on the calloc'd gaps between out of order
+ * fragments. */
+#define DCE2_BLOCK_CACHE__SIZE 8
+#define DCE2_BLOCK_CACHE__MAX_BLOCK (1 << 20)
+
+struct DCE2_BlockCacheEntry
+{
+    uint8_t* data;
+    uint32_t size;
+};
+
+static THREAD_LOCAL DCE2_BlockCacheEntry dce2_block_cache[DCE2_BLOCK_CACHE__SIZE];
+
+/* Best fit from the cache; size is updated to the size of the block
+ * actually handed out so the caller tracks true capacity */
+static uint8_t* DCE2_BlockAlloc(uint32_t& size)
+{
+    int best = DCE2_SENTINEL;
+
+    for (int i = 0; i < DCE2_BLOCK_CACHE__SIZE; i++)
+    {
+        DCE2_BlockCacheEntry& entry = dce2_block_cache[i];
+
+        if ((entry.data == nullptr) || (entry.size < size))
+            continue;
+
+        if ((best == DCE2_SENTINEL) || (entry.size < dce2_block_cache[best].size))
+            best = i;
+    }
+
+    if (best == DCE2_SENTINEL)
+        return (uint8_t*)snort_calloc(size);
+
+    uint8_t* data = dce2_block_cache[best].data;
+
+    size = dce2_block_cache[best].size;
+    dce2_block_cache[best].data = nullptr;
+    memset(data, 0, size);
+
+    return data;
+}
+
+static void DCE2_BlockFree(uint8_t* data, uint32_t size)
+{
+    if (size <= DCE2_BLOCK_CACHE__MAX_BLOCK)
+    {
+        for (int i = 0; i < DCE2_BLOCK_CACHE__SIZE; i++)
+        {
+            if (dce2_block_cache[i].data == nullptr)
+            {
+                dce2_block_cache[i].data = data;
+                dce2_block_cache[i].size = size;
+                return;
+            }
+        }
+    }
+
+    snort_free((void*)data);
+}
+
+void DCE2_BufferPurgeCache()
+{
+    for (int i = 0; i < DCE2_BLOCK_CACHE__SIZE; i++)
+    {
+        if (dce2_block_cache[i].data != nullptr)
+        {
+            snort_free((void*)dce2_block_cache[i].data);
+            dce2_block_cache[i].data = nullptr;
+        }
+    }
+}
+
 DCE2_Buffer* DCE2_BufferNew(uint32_t initial_size, uint32_t min_add_size)
 {
     DCE2_Buffer* buf = (DCE2_Buffer*)snort_calloc(sizeof(DCE2_Buffer));
 
     if (initial_size != 0)
-        buf->data = (uint8_t*)snort_calloc(initial_size);
+        buf->data = DCE2_BlockAlloc(initial_size);
 
     buf->size = initial_size;
     buf->len = 0;
@@ -241,7 +317,7 @@ DCE2_Ret DCE2_BufferAddData(DCE2_Buffer* buf, const uint8_t* data,
         if ((size < buf->min_add_size) && (mflag == DCE2_BUFFER_MIN_ADD_FLAG__USE))
             size = buf->min_add_size;
 
-        buf->data = (uint8_t*)snort_calloc(size);
+        buf->data = DCE2_BlockAlloc(size);
         buf->size = size;
     }
     else if ((data_offset + data_len) > buf->size)
@@ -253,9 +329,16 @@ DCE2_Ret DCE2_BufferAddData(DCE2_Buffer* buf, const uint8_t* data,
             DCE2_BUFFER_MIN_ADD_FLAG__USE))
             new_size = buf->size + buf->min_add_size;
 
-        tmp = (uint8_t*)DCE2_ReAlloc(buf->data, buf->size, new_size);
-        if (tmp == nullptr)
-            return DCE2_RET__ERROR;
+        /* Grow geometrically - PDUs tend to arrive in many small fragments
+         * and each growth copies everything accumulated so far */
+        if ((buf->size <= (UINT32_MAX / 2)) && (new_size < (buf->size * 2)))
+            new_size = buf->size * 2;
+
+        tmp = DCE2_BlockAlloc(new_size);
+
+        memcpy_s(tmp, new_size, buf->data, buf->size);
+
+        DCE2_BlockFree(buf->data, buf->size);
 
         buf->data = tmp;
         buf->size = new_size;
@@ -278,7 +361,7 @@ void DCE2_BufferDestroy(DCE2_Buffer* buf)
         return;
 
     if (buf->data != nullptr)
-        snort_free((void*)buf->data);
+        DCE2_BlockFree(buf->data, buf->size);
 
     snort_free((void*)buf);
 }
@@ -133,6 +133,7 @@ void* DCE2_ReAlloc(void*, uint32_t, uint32_t);
 DCE2_Ret DCE2_BufferAddData(DCE2_Buffer*, const uint8_t*,
     uint32_t, uint32_t, DCE2_BufferMinAddFlag);
 void DCE2_BufferDestroy(DCE2_Buffer* buf);
+void DCE2_BufferPurgeCache();
 
 #define DCE2_UUID_BUF_SIZE 50
 const char* DCE2_UuidToStr(
@@ -284,6 +284,57 @@ static uint16_t ParseDNSName(
     uint16_t bytes_required = dnsSessionData->curr_txt.txt_len -
         dnsSessionData->curr_txt.txt_bytes_seen;
 
+    /* Fast path - when positioned at a size byte and the rest of the name
+     * is in hand, walk the labels with locals and fold the consumed bytes
+     * into the session state once at the end.  The state machine below is
+     * only needed when a name is split across packets. */
+    if ((dnsSessionData->curr_txt.name_state == DNS_RESP_STATE_NAME_SIZE ||
+        dnsSessionData->curr_txt.name_state == 0) && bytes_unused)
+    {
+        const unsigned char* cur = data;
+        uint16_t avail = bytes_unused;
+        bool complete = false;
+
+        while (avail)
+        {
+            uint8_t len = *cur;
+
+            if (len == 0)
+            {
+                cur++;
+                avail--;
+                complete = true;
+                break;
+            }
+            if ((len & DNS_RR_PTR) == DNS_RR_PTR)
+            {
+                /* A reference to another location... let the state machine
+                 * below finish a pointer that ends at the segment boundary
+                 * so the resume state matches a split name exactly */
+                if (avail <= 2)
+                    break;
+
+                cur += 2;
+                avail -= 2;
+                complete = true;
+                break;
+            }
+            if (avail < (uint16_t)(len + 1))
+                break;
+
+            cur += len + 1;
+            avail -= len + 1;
+        }
+
+        if (complete)
+        {
+            dnsSessionData->bytes_seen_curr_rec += (uint16_t)(cur - data);
+            dnsSessionData->curr_txt.name_state = DNS_RESP_STATE_NAME_COMPLETE;
+            return avail;
+        }
+        /* Partial name - fall through and let the state machine track it */
+    }
+
     while (dnsSessionData->curr_txt.name_state != DNS_RESP_STATE_NAME_COMPLETE)
     {
         if (bytes_unused == 0)
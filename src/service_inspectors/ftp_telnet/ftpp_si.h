@@ -176,6 +176,14 @@ struct FTP_SESSION
     /* Command/data channel encryption */
     int encr_state;
     void *datassn;
+
+    /* Cache of the last command resolved through the server's cmd_lookup.
+     * Bulk transfer sessions repeat the same few commands, so most lines
+     * can skip the lookup trie. */
+    CMD_LOOKUP* last_cmd_lookup;
+    FTP_CMD_CONF* last_cmd_conf;
+    int last_cmd_size;
+    char last_cmd[16];
 };
 
 void FTPFreesession(FTP_SESSION*);
@@ -1437,6 +1437,18 @@ int check_ftp(FTP_SESSION* ftpssn, Packet* p, int iMode)
                     DetectionEngine::queue_event(GID_FTP, FTP_INVALID_CMD);
                     state = FTP_CMD_INV;
                 }
+                else if ((ftpssn->last_cmd_lookup == ftpssn->server_conf->cmd_lookup)
+                    && (ftpssn->last_cmd_size == req->cmd_size)
+                    && (strncasecmp(ftpssn->last_cmd, req->cmd_begin, req->cmd_size) == 0))
+                {
+                    /* Same command as last time through this lookup table,
+                     * compared without case like the lookup itself */
+                    CmdConf = ftpssn->last_cmd_conf;
+                    iRet = FTPP_SUCCESS;
+
+                    /* In case we were encrypted, but aren't now */
+                    ftpssn->encr_state = 0;
+                }
                 else
                 {
                     CmdConf = ftp_cmd_lookup_find(ftpssn->server_conf->cmd_lookup,
@@ -1453,6 +1465,14 @@ int check_ftp(FTP_SESSION* ftpssn, Packet* p, int iMode)
                     {
                         /* In case we were encrypted, but aren't now */
                         ftpssn->encr_state = 0;
+
+                        if (req->cmd_size <= (int)sizeof(ftpssn->last_cmd))
+                        {
+                            ftpssn->last_cmd_lookup = ftpssn->server_conf->cmd_lookup;
+                            ftpssn->last_cmd_conf = CmdConf;
+                            ftpssn->last_cmd_size = req->cmd_size;
+                            memcpy(ftpssn->last_cmd, req->cmd_begin, req->cmd_size);
+                        }
                     }
                 }
             }
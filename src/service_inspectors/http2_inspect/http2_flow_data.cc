@@ -23,6 +23,8 @@
 
 #include "http2_flow_data.h"
 
+#include <algorithm>
+
 #include "service_inspectors/http_inspect/http_inspect.h"
 #include "service_inspectors/http_inspect/http_test_manager.h"
 
@@ -93,6 +95,9 @@ Http2FlowData::~Http2FlowData()
         delete[] frame_data[k];
         delete[] frame_header[k];
     }
+
+    for (Http2Stream* stream : stream_pool)
+        delete stream;
 }
 
 HttpFlowData* Http2FlowData::get_hi_flow_data() const
@@ -140,12 +145,64 @@ class Http2Stream* Http2FlowData::get_stream(uint32_t key)
     class Http2Stream* stream = find_stream(key);
     if (!stream)
     {
-        stream = new Http2Stream(key, this);
+        if (!stream_pool.empty())
+        {
+            stream = stream_pool.back();
+            stream_pool.pop_back();
+            stream->reuse(key);
+        }
+        else
+            stream = new Http2Stream(key, this);
+
+        // a frame on a stream that was recycled after completing must see
+        // closed-stream semantics, not a brand new stream
+        if (std::binary_search(recycled_ids.begin(), recycled_ids.end(), key))
+        {
+            stream->set_state(SRC_CLIENT, STATE_CLOSED);
+            stream->set_state(SRC_SERVER, STATE_CLOSED);
+        }
+
         streams.emplace_front(key, stream);
     }
     return stream;
 }
 
+// Once a stream is closed in both directions and fully through inspection it
+// no longer needs its own state. Release its resources and recycle the object
+// so long-lived flows don't accumulate a stream list entry per exchange.
+void Http2FlowData::recycle_completed_stream(const HttpCommon::SourceId source_id)
+{
+    const uint32_t key = current_stream[source_id];
+
+    if (key == NO_STREAM_ID or key == stream_in_hi)
+        return;
+
+    for (auto it = streams.begin(); it != streams.end(); ++it)
+    {
+        if (it->id != key)
+            continue;
+
+        Http2Stream* stream = it->stream;
+
+        if (stream->get_state(SRC_CLIENT) != STATE_CLOSED or
+            stream->get_state(SRC_SERVER) != STATE_CLOSED or
+            stream->is_partial_buf_pending(SRC_CLIENT) or
+            stream->is_partial_buf_pending(SRC_SERVER) or
+            stream->get_current_frame() != nullptr)
+            return;
+
+        stream->release_resources();
+        it->stream = nullptr;
+        streams.erase(it);
+        stream_pool.push_back(stream);
+
+        const auto pos = std::lower_bound(recycled_ids.begin(), recycled_ids.end(), key);
+        if (pos == recycled_ids.end() or *pos != key)
+            recycled_ids.insert(pos, key);
+        return;
+    }
+}
+
 class Http2Stream* Http2FlowData::get_hi_stream() const
 {
     return find_stream(stream_in_hi);
@@ -90,6 +90,7 @@ public:
     };
     class Http2Stream* get_current_stream(const HttpCommon::SourceId source_id);
     uint32_t get_current_stream_id(const HttpCommon::SourceId source_id);
+    void recycle_completed_stream(const HttpCommon::SourceId source_id);
 
     Http2HpackDecoder* get_hpack_decoder(const HttpCommon::SourceId source_id)
     { return &hpack_decoder[source_id]; }
@@ -125,6 +126,14 @@ protected:
     Http2ConnectionSettings connection_settings[2];
     Http2HpackDecoder hpack_decoder[2];
     std::list<class StreamInfo> streams;
+
+    // completed streams are recycled through a per-flow pool so heavily
+    // multiplexed sessions don't allocate and tear down stream state for
+    // every new stream; the ids of recycled streams are kept (sorted) so
+    // late frames on them still see closed-stream semantics
+    std::vector<class Http2Stream*> stream_pool;
+    std::vector<uint32_t> recycled_ids;
+
     uint32_t concurrent_files = 0;
 
     // Internal to scan()
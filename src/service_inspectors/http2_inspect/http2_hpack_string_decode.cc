@@ -92,62 +92,11 @@ bool Http2HpackStringDecode::get_string(const uint8_t* in_buff, const uint32_t e
     return true;
 }
 
-// return is tail/padding
-bool Http2HpackStringDecode::get_next_byte(const uint8_t* in_buff, const uint32_t last_byte,
-    uint32_t& bytes_consumed, uint8_t& cur_bit, uint8_t match_len, uint8_t& byte,
-    bool& another_search) const
-{
-    another_search = true;
-    cur_bit += match_len;
-
-    if (cur_bit >= 8) // done with current bit
-    {
-        bytes_consumed++;
-        cur_bit -= 8;
-    }
-
-    bool tail = false;
-    uint8_t msb, lsb = 0xff;
-    if (bytes_consumed == last_byte)
-    {
-        // bytes consumed must be bigger than 1 - int length is at least 1
-        msb = in_buff[bytes_consumed-1];
-        another_search = false;
-        tail = true;
-    }
-    else if ((bytes_consumed + 1) == last_byte)
-    {
-        if (cur_bit != 0)
-        {
-            msb = in_buff[bytes_consumed++];
-            tail = true;
-        }
-        else
-        {
-            byte = in_buff[bytes_consumed];
-            return false;
-        }
-    }
-    else
-    {
-        msb = in_buff[bytes_consumed];
-        lsb = in_buff[bytes_consumed+1];
-    }
-
-    const uint16_t tmp = (uint16_t)(msb << 8) | lsb;
-    byte = (tmp & (0xff00 >> cur_bit)) >> (8 - cur_bit);
-    return tail;
-}
-
 bool Http2HpackStringDecode::get_huffman_string(const uint8_t* in_buff, const uint32_t encoded_len,
     uint32_t& bytes_consumed, uint8_t* out_buff, const uint32_t out_len, uint32_t& bytes_written,
     Http2EventGen* const events, Http2Infractions* const infractions) const
 {
-    const uint32_t last_encoded_byte = bytes_consumed + encoded_len;
-    uint8_t byte;
-    uint8_t cur_bit = 0;
     HuffmanEntry result = { 0, 0, HUFFMAN_LOOKUP_1 };
-    bool another_search = false;
     HuffmanState state = HUFFMAN_LOOKUP_1;
 
     // Check length
@@ -159,53 +108,65 @@ bool Http2HpackStringDecode::get_huffman_string(const uint8_t* in_buff, const ui
         return false;
     }
 
-    while (!get_next_byte(in_buff, last_encoded_byte, bytes_consumed, cur_bit, result.len, byte,
-        another_search))
-    {
-        result = huffman_decode[state][byte];
+    const uint8_t* const encoded = in_buff + bytes_consumed;
 
-        switch (result.state) {
+    // Upcoming message bits are kept left-aligned in a bit buffer so each lookup key is just the
+    // top byte. A lookup consumes result.len bits: a whole byte when descending to the next
+    // table, the code length when a symbol matches, so short codes are decoded one per lookup
+    // with no per-bit work.
+    uint32_t bit_buffer = 0;
+    uint32_t bits_held = 0;
+    uint32_t bytes_loaded = 0;
 
-        case HUFFMAN_MATCH:
-            out_buff[bytes_written++] = result.symbol;
-            state = HUFFMAN_LOOKUP_1;
-            break;
+    while (true)
+    {
+        while ((bits_held <= 24) && (bytes_loaded < encoded_len))
+        {
+            bit_buffer |= (uint32_t)encoded[bytes_loaded++] << (24 - bits_held);
+            bits_held += 8;
+        }
 
-        case HUFFMAN_LOOKUP_2:
-        case HUFFMAN_LOOKUP_3:
-        case HUFFMAN_LOOKUP_4:
-        case HUFFMAN_LOOKUP_5:
-        case HUFFMAN_LOOKUP_6:
-        case HUFFMAN_LOOKUP_7:
-        case HUFFMAN_LOOKUP_8:
-        case HUFFMAN_LOOKUP_9:
-        case HUFFMAN_LOOKUP_10:
-        case HUFFMAN_LOOKUP_11:
-        case HUFFMAN_LOOKUP_12:
-        case HUFFMAN_LOOKUP_13:
-        case HUFFMAN_LOOKUP_14:
-        case HUFFMAN_LOOKUP_15:
-            state = result.state;
+        if (bits_held < 8)
             break;
 
-        case HUFFMAN_FAILURE:
+        result = huffman_decode[state][bit_buffer >> 24];
+
+        if (result.state == HUFFMAN_MATCH)
+        {
+            out_buff[bytes_written++] = result.symbol;
+            state = HUFFMAN_LOOKUP_1;
+        }
+        else if (result.state == HUFFMAN_FAILURE)
+        {
+            bytes_consumed += ((bytes_loaded << 3) - bits_held) >> 3;
             *infractions += INF_HUFFMAN_DECODED_EOS;
             events->create_event(EVENT_STRING_DECODE_FAILURE);
             return false;
-            break;
-
-        default:
-            break;
         }
+        else
+            state = result.state;
+
+        bit_buffer <<= result.len;
+        bits_held -= result.len;
     }
 
+    bytes_consumed += encoded_len;
+
+    // Remaining bits of the last byte padded out with 1s, or the whole last byte when the final
+    // in-loop match ended exactly on the byte boundary
+    const uint8_t leftover_len = (uint8_t)bits_held;
+    uint8_t byte;
+    if (leftover_len > 0)
+        byte = (uint8_t)((bit_buffer >> 24) | (0xff >> leftover_len));
+    else
+        byte = encoded[encoded_len-1];
+
     // Tail needs 1 last lookup in case the leftover is big enough for a match.
     // Make sure match length <= available length
-    uint8_t leftover_len = 8 - cur_bit;
     uint8_t old_result_len = result.len;
     HuffmanState old_result_state = result.state;
 
-    if (another_search && (leftover_len >= min_decode_len[state]))
+    if ((leftover_len > 0) && (leftover_len >= min_decode_len[state]))
     {
         result = huffman_decode[state][byte];
         if ((result.state == HUFFMAN_MATCH) && (result.len <= leftover_len))
@@ -177,6 +177,7 @@ void Http2Inspect::clear(Packet* p)
     const SourceId source_id = p->is_from_client() ? SRC_CLIENT : SRC_SERVER;
     Http2Stream* stream = session_data->get_current_stream(source_id);
     stream->clear_frame();
+    session_data->recycle_completed_stream(source_id);
 }
 
 #ifdef REG_TEST
@@ -38,13 +38,39 @@ Http2Stream::Http2Stream(uint32_t stream_id_, Http2FlowData* session_data_) :
 }
 
 Http2Stream::~Http2Stream()
+{
+    release_resources();
+}
+
+// Free everything the stream owns. Called when a completed stream is
+// recycled into the session's pool as well as from the destructor.
+void Http2Stream::release_resources()
 {
     delete current_frame;
+    current_frame = nullptr;
     if (hi_flow_data)
+    {
         session_data->deallocate_hi_memory();
-    delete hi_flow_data;
+        delete hi_flow_data;
+        hi_flow_data = nullptr;
+    }
+    hi_msg_section = nullptr;
     delete data_cutter[SRC_CLIENT];
     delete data_cutter[SRC_SERVER];
+    data_cutter[SRC_CLIENT] = data_cutter[SRC_SERVER] = nullptr;
+}
+
+// Reset a pooled stream object to serve a new stream on the same flow.
+// All per-stream resources must already have been released.
+void Http2Stream::reuse(uint32_t new_stream_id)
+{
+    assert(current_frame == nullptr);
+    assert(hi_flow_data == nullptr);
+
+    stream_id = new_stream_id;
+    partial_buf_pending[SRC_CLIENT] = partial_buf_pending[SRC_SERVER] = false;
+    last_data_flush[SRC_CLIENT] = last_data_flush[SRC_SERVER] = false;
+    state[SRC_CLIENT] = state[SRC_SERVER] = STATE_IDLE;
 }
 
 void Http2Stream::eval_frame(const uint8_t* header_buffer, int32_t header_len,
@@ -36,6 +36,8 @@ class Http2Stream
 public:
     Http2Stream(uint32_t stream_id, Http2FlowData* session_data_);
     ~Http2Stream();
+    void release_resources();
+    void reuse(uint32_t new_stream_id);
     uint32_t get_stream_id() { return stream_id; }
     void eval_frame(const uint8_t* header_buffer, int32_t header_len, const uint8_t* data_buffer,
         int32_t data_len, HttpCommon::SourceId source_id);
@@ -72,7 +74,7 @@ public:
 #endif
 
 private:
-    const uint32_t stream_id;
+    uint32_t stream_id;
     Http2FlowData* const session_data;
     Http2Frame* current_frame = nullptr;
     HttpFlowData* hi_flow_data = nullptr;
@@ -23,6 +23,7 @@
 
 #include "ips_http2.h"
 
+#include "detection/ips_context.h"
 #include "framework/cursor.h"
 #include "protocols/packet.h"
 
@@ -73,8 +74,23 @@ IpsOption::EvalStatus Http2IpsOption::eval(Cursor& c, Packet* p)
 
     InspectionBuffer hb;
 
-    if (! ((Http2Inspect*)(p->flow->gadget))->get_buf((unsigned)buffer_index, p, hb))
-        return NO_MATCH;
+    // rules in a port group commonly reference the same buffer, so each
+    // one is materialized once per packet and shared via the context
+    const unsigned cache_key = InspectionBuffer::IBT_MAX + (unsigned)buffer_index;
+
+    if (p->context->buf_is_cached(cache_key))
+    {
+        if (!p->context->get_cached_buf(cache_key, hb))
+            return NO_MATCH;
+    }
+    else
+    {
+        bool have = ((Http2Inspect*)(p->flow->gadget))->get_buf((unsigned)buffer_index, p, hb);
+        p->context->cache_buf(cache_key, hb, have);
+
+        if (!have)
+            return NO_MATCH;
+    }
 
     c.set(key, hb.data, hb.len);
 
@@ -23,6 +23,7 @@
 
 #include "http_api.h"
 
+#include "http_buffer_pool.h"
 #include "http_context_data.h"
 #include "http_cursor_data.h"
 #include "http_inspect.h"
@@ -47,6 +48,11 @@ void HttpApi::http_init()
     HttpCursorData::init();
 }
 
+void HttpApi::http_tterm()
+{
+    HttpBufferPool::cleanup();
+}
+
 const char* HttpApi::classic_buffer_names[] =
 {
     "http_client_body",
@@ -91,7 +97,7 @@ const InspectApi HttpApi::http_api =
     HttpApi::http_init,
     HttpApi::http_term,
     nullptr,
-    nullptr,
+    HttpApi::http_tterm,
     HttpApi::http_ctor,
     HttpApi::http_dtor,
     nullptr,
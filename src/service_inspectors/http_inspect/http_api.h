@@ -40,6 +40,7 @@ private:
     static const char* http_help;
     static void http_init();
     static void http_term() { }
+    static void http_tterm();
     static snort::Inspector* http_ctor(snort::Module* mod);
     static void http_dtor(snort::Inspector* p) { delete p; }
 };
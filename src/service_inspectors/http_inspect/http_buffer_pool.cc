@@ -0,0 +1,53 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2014-2020 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// http_buffer_pool.cc author Tom Peters <thopeter@cisco.com>
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "http_buffer_pool.h"
+
+#include "http_enum.h"
+
+THREAD_LOCAL uint8_t* HttpBufferPool::pool[MAX_POOLED];
+THREAD_LOCAL int HttpBufferPool::num_pooled = 0;
+
+uint8_t* HttpBufferPool::acquire()
+{
+    if (num_pooled > 0)
+        return pool[--num_pooled];
+    return new uint8_t[HttpEnums::MAX_OCTETS];
+}
+
+void HttpBufferPool::release(const uint8_t* buffer)
+{
+    if (buffer == nullptr)
+        return;
+    if (num_pooled < MAX_POOLED)
+        pool[num_pooled++] = const_cast<uint8_t*>(buffer);
+    else
+        delete[] buffer;
+}
+
+void HttpBufferPool::cleanup()
+{
+    while (num_pooled > 0)
+        delete[] pool[--num_pooled];
+}
+
@@ -0,0 +1,51 @@
+//--------------------------------------------------------------------------
+// Copyright (C) 2014-2020 Cisco and/or its affiliates. All rights reserved.
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License Version 2 as published
+// by the Free Software Foundation.  You may not use, modify or distribute
+// this program under any other version of the GNU General Public License.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//--------------------------------------------------------------------------
+// http_buffer_pool.h author Tom Peters <thopeter@cisco.com>
+
+#ifndef HTTP_BUFFER_POOL_H
+#define HTTP_BUFFER_POOL_H
+
+#include <cstdint>
+
+#include "main/thread.h"
+
+// Recycles the fixed-size MAX_OCTETS buffers used to reassemble and decompress message bodies.
+// Allocating and freeing one or two of these for every body section is a measurable share of
+// inspection time. Buffers are pooled per thread so no locking is needed. Variable-size buffers
+// (headers, normalizations) are not pooled because the Field that ultimately owns a buffer does
+// not know its capacity.
+class HttpBufferPool
+{
+public:
+    static uint8_t* acquire();
+    static void release(const uint8_t* buffer);
+    static void cleanup();
+
+private:
+    HttpBufferPool() = delete;
+
+    // Enough for the reassembly and decompression buffers of sections in flight without holding
+    // excessive idle memory per thread
+    static const int MAX_POOLED = 8;
+
+    static THREAD_LOCAL uint8_t* pool[MAX_POOLED];
+    static THREAD_LOCAL int num_pooled;
+};
+
+#endif
+
@@ -32,7 +32,7 @@ using namespace HttpEnums;
 
 const Field Field::FIELD_NULL { STAT_NO_SOURCE };
 
-void Field::set(int32_t length, const uint8_t* start, bool own_the_buffer_)
+void Field::set(int32_t length, const uint8_t* start, bool own_the_buffer_, bool pooled_buffer_)
 {
     assert(len == STAT_NOT_COMPUTE);
     assert(strt == nullptr);
@@ -42,6 +42,7 @@ void Field::set(int32_t length, const uint8_t* start, bool own_the_buffer_)
     strt = start;
     len = length;
     own_the_buffer = own_the_buffer_;
+    pooled_buffer = pooled_buffer_;
 }
 
 void Field::set(StatusCode stat_code)
@@ -24,6 +24,7 @@
 #include <cstdio>
 #include <cassert>
 
+#include "http_buffer_pool.h"
 #include "http_common.h"
 #include "http_enum.h"
 
@@ -35,14 +36,22 @@ class Field
 public:
     static const Field FIELD_NULL;
 
-    Field(int32_t length, const uint8_t* start, bool own_the_buffer_ = false) : strt(start),
-        len(length), own_the_buffer(own_the_buffer_) { }
+    Field(int32_t length, const uint8_t* start, bool own_the_buffer_ = false,
+        bool pooled_buffer_ = false) : strt(start), len(length), own_the_buffer(own_the_buffer_),
+        pooled_buffer(pooled_buffer_) { }
     explicit Field(int32_t length) : len(length) { assert(length<=0); }
     Field() = default;
-    ~Field() { if (own_the_buffer) delete[] strt; }
+    ~Field()
+    {
+        if (pooled_buffer)
+            HttpBufferPool::release(strt);
+        else if (own_the_buffer)
+            delete[] strt;
+    }
     int32_t length() const { return len; }
     const uint8_t* start() const { return strt; }
-    void set(int32_t length, const uint8_t* start, bool own_the_buffer_ = false);
+    void set(int32_t length, const uint8_t* start, bool own_the_buffer_ = false,
+        bool pooled_buffer_ = false);
     void set(const Field& f);
     void set(HttpCommon::StatusCode stat_code);
     void set(int32_t length) { set(static_cast<HttpCommon::StatusCode>(length)); }
@@ -57,6 +66,7 @@ private:
     const uint8_t* strt = nullptr;
     int32_t len = HttpCommon::STAT_NOT_COMPUTE;
     bool own_the_buffer = false;
+    bool pooled_buffer = false;  // buffer is returned to HttpBufferPool instead of deleted
 };
 
 #endif
@@ -25,6 +25,7 @@
 
 #include "decompress/file_decomp.h"
 
+#include "http_buffer_pool.h"
 #include "http_cutter.h"
 #include "http_common.h"
 #include "http_enum.h"
@@ -84,8 +85,16 @@ HttpFlowData::~HttpFlowData()
     {
         delete infractions[k];
         delete events[k];
-        delete[] section_buffer[k];
-        delete[] partial_buffer[k];
+        if (section_buffer_pooled[k])
+        {
+            HttpBufferPool::release(section_buffer[k]);
+            HttpBufferPool::release(partial_buffer[k]);
+        }
+        else
+        {
+            delete[] section_buffer[k];
+            delete[] partial_buffer[k];
+        }
         HttpTransaction::delete_transaction(transaction[k], nullptr);
         delete cutter[k];
         if (compress_stream[k] != nullptr)
@@ -102,6 +111,7 @@ HttpFlowData::~HttpFlowData()
     delete utf_state;
     if (fd_state != nullptr)
         File_Decomp_StopFree(fd_state);
+    delete js_state;
     delete_pipeline();
 
     while (discard_list != nullptr)
@@ -163,6 +173,8 @@ void HttpFlowData::half_reset(SourceId source_id)
             File_Decomp_StopFree(fd_state);
             fd_state = nullptr;
         }
+        delete js_state;
+        js_state = nullptr;
     }
 }
 
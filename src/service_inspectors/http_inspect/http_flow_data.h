@@ -26,6 +26,7 @@
 
 #include "flow/flow.h"
 #include "mime/file_mime_process.h"
+#include "utils/util_jsnorm.h"
 #include "utils/util_utf.h"
 #include "decompress/file_decomp.h"
 
@@ -96,6 +97,13 @@ private:
 
     // *** StreamSplitter internal data - reassemble()
     uint8_t* section_buffer[2] = { nullptr, nullptr };
+    // section_buffer came from HttpBufferPool (body sections), not new[]. Set whenever
+    // section_buffer is allocated and applies to any partial_buffer stashed from it.
+    bool section_buffer_pooled[2] = { false, false };
+    // Pool buffer most recently handed out of reassemble() at a full flush. The message section
+    // that takes ownership matches against this so it returns the buffer to the pool rather than
+    // deleting it. Buffers from other sources (e.g. http2_inspect data frames) never match.
+    const uint8_t* pooled_detached_buffer[2] = { nullptr, nullptr };
     uint32_t section_offset[2] = { 0, 0 };
     uint32_t chunk_expected_length[2] = { 0, 0 };
     uint32_t running_total[2] = { 0, 0 };
@@ -153,6 +161,7 @@ private:
     snort::MimeSession* mime_state[2] = { nullptr, nullptr };
     snort::UtfDecodeSession* utf_state = nullptr; // SRC_SERVER only
     fd_session_t* fd_state = nullptr; // SRC_SERVER only
+    snort::JSState* js_state = nullptr; // SRC_SERVER only
     int64_t file_depth_remaining[2] = { HttpCommon::STAT_NOT_PRESENT,
         HttpCommon::STAT_NOT_PRESENT };
     int64_t detect_depth_remaining[2] = { HttpCommon::STAT_NOT_PRESENT,
@@ -65,6 +65,26 @@ static int32_t derive_header_content(const uint8_t* value, int32_t length, uint8
     return out_length;
 }
 
+// Check whether derive_header_content() would be an identity transformation: no tab or CR or LF,
+// no leading or trailing white space, and no consecutive spaces. When alert_ws is set any internal
+// white space must go through the full path so the infractions are generated.
+static bool already_normalized(const uint8_t* value, int32_t length, bool alert_ws)
+{
+    if (length <= 0)
+        return false;
+    if (is_sp_tab_cr_lf[value[0]] || is_sp_tab_cr_lf[value[length - 1]])
+        return false;
+    for (int32_t k = 1; k < length - 1; k++)
+    {
+        if (is_sp_tab_cr_lf[value[k]])
+        {
+            if (alert_ws || (value[k] != ' ') || (value[k+1] == ' '))
+                return false;
+        }
+    }
+    return true;
+}
+
 // This method normalizes the header field value for headId.
 void HeaderNormalizer::normalize(const HeaderId head_id, const int count,
     HttpInfractions* infractions, HttpEventGen* events, const HeaderId header_name_id[],
@@ -103,6 +123,29 @@ void HeaderNormalizer::normalize(const HeaderId head_id, const int count,
     assert(num_matches == count);
     buffer_length += num_matches - 1;    // allow space for concatenation commas
 
+    // The common case is a single instance of the header with a value that is already in
+    // canonical form and no normalization functions to apply. The result can alias the message
+    // buffer without copying. The raw header values and the normalized fields belong to the same
+    // message section, so the alias cannot outlive the underlying buffer.
+    if ((count == 1) && (num_normalizers == 0) && already_normalized(
+        header_value[curr_match].start(), header_value[curr_match].length(), alert_ws))
+    {
+        if ((repeat_event != EVENT__NONE) || (repeat_inf != INF__NONE))
+        {
+            for (int32_t k=0; k < header_value[curr_match].length(); k++)
+            {
+                if (header_value[curr_match].start()[k] == ',')
+                {
+                    *infractions += repeat_inf;
+                    events->create_event(repeat_event);
+                    break;
+                }
+            }
+        }
+        result_field.set(header_value[curr_match].length(), header_value[curr_match].start());
+        return;
+    }
+
     // We are allocating two buffers to store the normalized field value. The raw field value will
     // be copied into one of them. Concatenation and white space normalization happen during this
     // step. Next a series of normalization functions will transform the value into final form.
@@ -35,6 +35,7 @@
 #include "protocols/packet.h"
 #include "stream/stream.h"
 
+#include "http_buffer_pool.h"
 #include "http_common.h"
 #include "http_context_data.h"
 #include "http_enum.h"
@@ -527,7 +528,13 @@ bool HttpInspect::process(const uint8_t* data, const uint16_t dsize, Flow* const
         assert(false);
         if (buf_owner)
         {
-            delete[] data;
+            if (data == session_data->pooled_detached_buffer[source_id])
+            {
+                HttpBufferPool::release(data);
+                session_data->pooled_detached_buffer[source_id] = nullptr;
+            }
+            else
+                delete[] data;
         }
         return false;
     }
@@ -75,17 +75,24 @@ void HttpJsNorm::configure()
 }
 
 void HttpJsNorm::normalize(const Field& input, Field& output, HttpInfractions* infractions,
-    HttpEventGen* events) const
+    HttpEventGen* events, JSState*& js_state) const
 {
     bool js_present = false;
     int index = 0;
     const char* ptr = (const char*)input.start();
     const char* const end = ptr + input.length();
 
-    JSState js;
-    js.allowed_spaces = max_javascript_whitespaces;
-    js.allowed_levels = MAX_ALLOWED_OBFUSCATION;
-    js.alerts = 0;
+    // The state persists across the message sections of a body so the obfuscation budgets
+    // apply to the message as a whole and each alert is generated only once per message.
+    if (js_state == nullptr)
+    {
+        js_state = new JSState;
+        js_state->allowed_spaces = max_javascript_whitespaces;
+        js_state->allowed_levels = MAX_ALLOWED_OBFUSCATION;
+        js_state->alerts = 0;
+    }
+    JSState& js = *js_state;
+    const uint16_t prev_alerts = js.alerts;
 
     uint8_t* buffer = new uint8_t[input.length()];
 
@@ -160,19 +167,20 @@ void HttpJsNorm::normalize(const Field& input, Field& output, HttpInfractions* i
         {
             memmove_s(buffer + index, input.length() - index, ptr, end - ptr); index += end - ptr;
         }
-        if (js.alerts)
+        const uint16_t new_alerts = js.alerts & ~prev_alerts;
+        if (new_alerts)
         {
-            if (js.alerts & ALERT_LEVELS_EXCEEDED)
+            if (new_alerts & ALERT_LEVELS_EXCEEDED)
             {
                 *infractions += INF_JS_OBFUSCATION_EXCD;
                 events->create_event(EVENT_JS_OBFUSCATION_EXCD);
             }
-            if (js.alerts & ALERT_SPACES_EXCEEDED)
+            if (new_alerts & ALERT_SPACES_EXCEEDED)
             {
                 *infractions += INF_JS_EXCESS_WS;
                 events->create_event(EVENT_JS_EXCESS_WS);
             }
-            if (js.alerts & ALERT_MIXED_ENCODINGS)
+            if (new_alerts & ALERT_MIXED_ENCODINGS)
             {
                 *infractions += INF_MIXED_ENCODINGS;
                 events->create_event(EVENT_MIXED_ENCODINGS);
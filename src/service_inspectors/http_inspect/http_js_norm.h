@@ -23,6 +23,7 @@
 #include <cstring>
 
 #include "search_engines/search_tool.h"
+#include "utils/util_jsnorm.h"
 
 #include "http_field.h"
 #include "http_event.h"
@@ -38,7 +39,7 @@ public:
     HttpJsNorm(int max_javascript_whitespaces_, const HttpParaList::UriParam& uri_param_);
     ~HttpJsNorm();
     void normalize(const Field& input, Field& output, HttpInfractions* infractions,
-        HttpEventGen* events) const;
+        HttpEventGen* events, snort::JSState*& js_state) const;
     void configure();
 private:
     enum JsSearchId { JS_JAVASCRIPT };
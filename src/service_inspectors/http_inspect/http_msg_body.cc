@@ -26,6 +26,7 @@
 #include "file_api/file_flows.h"
 
 #include "http_api.h"
+#include "http_buffer_pool.h"
 #include "http_common.h"
 #include "http_enum.h"
 #include "http_js_norm.h"
@@ -119,7 +120,7 @@ void HttpMsgBody::do_file_decompression(const Field& input, Field& output)
         output.set(input);
         return;
     }
-    uint8_t* buffer = new uint8_t[MAX_OCTETS];
+    uint8_t* buffer = HttpBufferPool::acquire();
     session_data->fd_alert_context.infractions = transaction->get_infractions(source_id);
     session_data->fd_alert_context.events = session_data->events[source_id];
     session_data->fd_state->Next_In = input.start();
@@ -136,7 +137,7 @@ void HttpMsgBody::do_file_decompression(const Field& input, Field& output)
         // Fall through
     case File_Decomp_NoSig:
     case File_Decomp_Error:
-        delete[] buffer;
+        HttpBufferPool::release(buffer);
         output.set(input);
         File_Decomp_StopFree(session_data->fd_state);
         session_data->fd_state = nullptr;
@@ -146,7 +147,7 @@ void HttpMsgBody::do_file_decompression(const Field& input, Field& output)
         create_event(EVENT_FILE_DECOMPR_OVERRUN);
         // Fall through
     default:
-        output.set(session_data->fd_state->Next_Out - buffer, buffer, true);
+        output.set(session_data->fd_state->Next_Out - buffer, buffer, true, true);
         break;
     }
 }
@@ -195,8 +196,15 @@ void HttpMsgBody::do_js_normalization(const Field& input, Field& output)
         return;
     }
 
+    HttpModule::increment_peg_counts(PEG_JS_NORM_BYTES, input.length());
+    // A partial flush processes bytes that will be normalized again when the full section
+    // is reassembled
+    if (session_data->partial_flush[source_id])
+        HttpModule::increment_peg_counts(PEG_JS_NORM_RENORM_BYTES, input.length());
+
     params->js_norm_param.js_norm->normalize(input, output,
-        transaction->get_infractions(source_id), session_data->events[source_id]);
+        transaction->get_infractions(source_id), session_data->events[source_id],
+        session_data->js_state);
 }
 
 void HttpMsgBody::do_file_processing(const Field& file_data)
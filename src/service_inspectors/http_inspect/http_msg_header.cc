@@ -580,8 +580,8 @@ void HttpMsgHeader::setup_file_decompression()
         (params->decompress_zip ? FILE_ZIP_DEFL_BIT : 0);
     session_data->fd_state->Alert_Callback = HttpMsgBody::fd_event_callback;
     session_data->fd_state->Alert_Context = &session_data->fd_alert_context;
-    session_data->fd_state->Compr_Depth = 0;
-    session_data->fd_state->Decompr_Depth = 0;
+    session_data->fd_state->Compr_Depth = FILE_DECOMP_DEFAULT_COMPR_BUDGET;
+    session_data->fd_state->Decompr_Depth = FILE_DECOMP_DEFAULT_DECOMPR_BUDGET;
 
     (void)File_Decomp_Init(session_data->fd_state);
 }
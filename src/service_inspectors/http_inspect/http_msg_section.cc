@@ -49,7 +49,8 @@ using namespace snort;
 HttpMsgSection::HttpMsgSection(const uint8_t* buffer, const uint16_t buf_size,
        HttpFlowData* session_data_, SourceId source_id_, bool buf_owner, Flow* flow_,
        const HttpParaList* params_) :
-    msg_text(buf_size, buffer, buf_owner),
+    msg_text(buf_size, buffer, buf_owner,
+        buf_owner && (buffer == session_data_->pooled_detached_buffer[source_id_])),
     session_data(session_data_),
     flow(flow_),
     params(params_),
@@ -63,6 +64,10 @@ HttpMsgSection::HttpMsgSection(const uint8_t* buffer, const uint16_t buf_size,
 {
     assert((source_id == SRC_CLIENT) || (source_id == SRC_SERVER));
 
+    // msg_text now owns the detached pool buffer and will release it
+    if (buffer == session_data->pooled_detached_buffer[source_id])
+        session_data->pooled_detached_buffer[source_id] = nullptr;
+
     if (Http2FlowData::inspector_id != 0)
     {
         Http2FlowData* const h2i_flow_data = (Http2FlowData*)flow->get_flow_data(Http2FlowData::inspector_id);
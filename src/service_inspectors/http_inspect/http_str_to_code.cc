@@ -25,18 +25,102 @@
 
 #include <cstring>
 
+#include "main/thread.h"
+
 #include "http_common.h"
 
-// Need to replace this simple algorithm for better performance FIXIT-P
+// Hash index over a StrCode table. Exact-match lookups (header names, methods, content
+// codings) are hot enough that the original linear scan with a strlen() per entry showed
+// up in profiles. Each table gets a small open-addressing index built lazily on first use
+// and cached by table address. The tables are immutable after static initialization so
+// the index never needs invalidation. Everything lives in fixed-size thread-local arrays;
+// no heap allocation.
+namespace
+{
+const int MAX_TABLE_INDEXES = 8;
+const int INDEX_SLOTS = 128;  // power of two, at least double the largest table
+
+struct TableIndex
+{
+    const StrCode* table;
+    uint16_t slot[INDEX_SLOTS];    // 1-based entry number, zero means empty
+    uint8_t name_len[INDEX_SLOTS]; // strlen of the entry name, precomputed
+};
+}
+
+static THREAD_LOCAL TableIndex table_index[MAX_TABLE_INDEXES];
+static THREAD_LOCAL int num_table_indexes = 0;
+
+static uint32_t hash_text(const uint8_t* text, const int32_t text_len)
+{
+    uint32_t hash = 0;
+    for (int32_t k = 0; k < text_len; k++)
+        hash = hash*31 + text[k];
+    return hash;
+}
+
+static const TableIndex* get_table_index(const StrCode table[])
+{
+    for (int k = 0; k < num_table_indexes; k++)
+    {
+        if (table_index[k].table == table)
+            return table_index + k;
+    }
+
+    if (num_table_indexes == MAX_TABLE_INDEXES)
+        return nullptr;
+
+    int32_t num_entries = 0;
+    while (table[num_entries].name != nullptr)
+        num_entries++;
+
+    // Keep the load factor at or below one half so probe chains stay short
+    if (2*num_entries > INDEX_SLOTS)
+        return nullptr;
+
+    TableIndex* index = table_index + num_table_indexes;
+    index->table = table;
+    for (int32_t k = 0; k < num_entries; k++)
+    {
+        const size_t len = strlen(table[k].name);
+        uint32_t probe = hash_text((const uint8_t*)table[k].name, len) & (INDEX_SLOTS-1);
+        while (index->slot[probe] != 0)
+            probe = (probe+1) & (INDEX_SLOTS-1);
+        index->slot[probe] = k+1;
+        index->name_len[probe] = (uint8_t)len;
+    }
+    num_table_indexes++;
+    return index;
+}
+
 int32_t str_to_code(const uint8_t* text, const int32_t text_len, const StrCode table[])
 {
-    for (int32_t k=0; table[k].name != nullptr; k++)
+    const TableIndex* index = get_table_index(table);
+
+    if (index == nullptr)
     {
-        if ((text_len == (int)strlen(table[k].name)) &&
-            (memcmp(text, table[k].name, text_len) == 0))
+        // more distinct tables than expected, fall back to a linear scan
+        for (int32_t k=0; table[k].name != nullptr; k++)
         {
-            return table[k].code;
+            if ((text_len == (int)strlen(table[k].name)) &&
+                (memcmp(text, table[k].name, text_len) == 0))
+            {
+                return table[k].code;
+            }
+        }
+        return HttpCommon::STAT_OTHER;
+    }
+
+    uint32_t probe = hash_text(text, text_len) & (INDEX_SLOTS-1);
+    while (index->slot[probe] != 0)
+    {
+        const StrCode* entry = table + (index->slot[probe] - 1);
+        if ((text_len == index->name_len[probe]) &&
+            (memcmp(text, entry->name, text_len) == 0))
+        {
+            return entry->code;
         }
+        probe = (probe+1) & (INDEX_SLOTS-1);
     }
     return HttpCommon::STAT_OTHER;
 }
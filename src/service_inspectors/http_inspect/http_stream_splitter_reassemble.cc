@@ -23,6 +23,7 @@
 
 #include "protocols/packet.h"
 
+#include "http_buffer_pool.h"
 #include "http_inspect.h"
 #include "http_module.h"
 #include "http_stream_splitter.h"
@@ -373,12 +374,13 @@ const StreamBuffer HttpStreamSplitter::reassemble(Flow* flow, unsigned total,
     {
         // Body sections need extra space to accommodate unzipping
         if (is_body)
-            buffer = new uint8_t[MAX_OCTETS];
+            buffer = HttpBufferPool::acquire();
         else
         {
             const uint32_t buffer_size = (total > 0) ? total : 1;
             buffer = new uint8_t[buffer_size];
         }
+        session_data->section_buffer_pooled[source_id] = is_body;
     }
 
     if (partial_buffer_length > 0)
@@ -387,7 +389,8 @@ const StreamBuffer HttpStreamSplitter::reassemble(Flow* flow, unsigned total,
         memcpy(buffer, partial_buffer, partial_buffer_length);
         session_data->section_offset[source_id] = partial_buffer_length;
         partial_buffer_length = 0;
-        delete[] partial_buffer;
+        // A partial buffer is always a stashed body section buffer and so came from the pool
+        HttpBufferPool::release(partial_buffer);
         partial_buffer = nullptr;
     }
 
@@ -421,7 +424,11 @@ const StreamBuffer HttpStreamSplitter::reassemble(Flow* flow, unsigned total,
             partial_raw_bytes += total;
         }
         else
+        {
             partial_raw_bytes = 0;
+            if (session_data->section_buffer_pooled[source_id])
+                session_data->pooled_detached_buffer[source_id] = buffer;
+        }
 
         http_buf.data = buffer;
         http_buf.length = buf_size;
@@ -424,6 +424,9 @@ const PegInfo HttpModule::peg_names[PEG_COUNT_MAX+1] =
     { CountType::SUM, "excess_parameters", "repeat parameters exceeding max" },
     { CountType::SUM, "parameters", "HTTP parameters inspected" },
     { CountType::SUM, "connect_tunnel_cutovers", "CONNECT tunnel flow cutovers to wizard" },
+    { CountType::SUM, "js_norm_bytes", "body bytes processed by javascript normalization" },
+    { CountType::SUM, "js_norm_renormalized_bytes",
+        "body bytes javascript normalized more than once due to partial inspections" },
     { CountType::END, nullptr, nullptr }
 };
 
@@ -43,6 +43,8 @@ namespace snort
 unsigned FlowData::flow_data_id = 0;
 FlowData::FlowData(unsigned, Inspector*) {}
 FlowData::~FlowData() = default;
+void* FlowData::operator new(size_t n) { return ::operator new(n); }
+void FlowData::operator delete(void* p, size_t) { ::operator delete(p); }
 int DetectionEngine::queue_event(unsigned int, unsigned int, Actions::Type) { return 0; }
 fd_status_t File_Decomp_StopFree(fd_session_t*) { return File_Decomp_OK; }
 size_t str_to_hash(unsigned char const*, size_t) { return 0; }
@@ -123,6 +123,46 @@ SIPbodyField bodyFields[] =
     { nullptr, 0, nullptr }
 };
 
+#define SIP_DISPATCH_NONE 0xFF
+
+/*
+ * First byte dispatch over headerFields so unknown headers - the common
+ * case - are rejected without scanning the whole table.  head maps a
+ * lowercased first byte to the first candidate, chained through next in
+ * table order; single char short forms have their own map.
+ */
+static struct SIPheaderDispatch
+{
+    uint8_t head[256];
+    uint8_t next[sizeof(headerFields) / sizeof(headerFields[0])];
+    uint8_t short_form[256];
+
+    SIPheaderDispatch()
+    {
+        memset(head, SIP_DISPATCH_NONE, sizeof(head));
+        memset(next, SIP_DISPATCH_NONE, sizeof(next));
+        memset(short_form, SIP_DISPATCH_NONE, sizeof(short_form));
+
+        for (uint8_t i = 0; nullptr != headerFields[i].fname; i++)
+        {
+            int c = tolower((unsigned char)headerFields[i].fname[0]);
+
+            if (SIP_DISPATCH_NONE == head[c])
+                head[c] = i;
+            else
+            {
+                int j = head[c];
+                while (SIP_DISPATCH_NONE != next[j])
+                    j = next[j];
+                next[j] = i;
+            }
+
+            if (nullptr != headerFields[i].shortName)
+                short_form[(unsigned char)headerFields[i].shortName[0]] = i;
+        }
+    }
+} headerDispatch;
+
 /********************************************************************
  * Function: sip_process_headField()
  *
@@ -141,7 +181,7 @@ SIPbodyField bodyFields[] =
 static int sip_process_headField(SIPMsg* msg, const char* start, const char* end,
     int* lastFieldIndex, SIP_PROTO_CONF* config)
 {
-    int findex = 0;
+    int findex;
     int length = end -start;
     const char* colonIndex, * newStart, * newEnd;
     char newLength;
@@ -167,25 +207,24 @@ static int sip_process_headField(SIPMsg* msg, const char* start, const char* end
     newLength = newEnd - newStart;
 
     /*Find out whether the field name needs to process*/
-    while (nullptr != headerFields[findex].fname)
+    int c = tolower((unsigned char)newStart[0]);
+
+    if (1 == newLength)
+        findex = headerDispatch.short_form[c];
+    else
     {
-        //Use the full name to check
-        if ((headerFields[findex].fnameLen == newLength)&&
-            (0 == strncasecmp(headerFields[findex].fname, newStart, newLength)))
-        {
-            break;
-        }
-        //Use short name to check
-        else if ((nullptr != headerFields[findex].shortName) &&
-            ( 1 == newLength)&&
-            (0 == strncasecmp(headerFields[findex].shortName, newStart, newLength)))
+        findex = headerDispatch.head[c];
+
+        //Use the full name to check, gated on the length
+        while ((SIP_DISPATCH_NONE != findex) &&
+            ((headerFields[findex].fnameLen != newLength) ||
+            (0 != strncasecmp(headerFields[findex].fname, newStart, newLength))))
         {
-            break;
+            findex = headerDispatch.next[findex];
         }
-        findex++;
     }
 
-    if (nullptr != headerFields[findex].fname)
+    if (SIP_DISPATCH_NONE != findex)
     {
         // Found the field name, evaluate the value
         SIP_TrimSP(colonIndex + 1, end, &newStart, &newEnd);
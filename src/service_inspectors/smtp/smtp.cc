@@ -169,6 +169,8 @@ const PegInfo smtp_peg_names[] =
     { CountType::SUM, "sessions", "total smtp sessions" },
     { CountType::NOW, "concurrent_sessions", "total concurrent smtp sessions" },
     { CountType::MAX, "max_concurrent_sessions", "maximum concurrent smtp sessions" },
+    { CountType::SUM, "cmd_lines_aliased", "total command lines inspected in place" },
+    { CountType::SUM, "cmd_lines_normalized", "total command lines copied for normalization" },
     { CountType::SUM, "b64_attachments", "total base64 attachments decoded" },
     { CountType::SUM, "b64_decoded_bytes", "total base64 decoded bytes" },
     { CountType::SUM, "qp_attachments", "total quoted-printable attachments decoded" },
@@ -667,6 +669,7 @@ static const uint8_t* SMTP_HandleCommand(SmtpProtoConf* config, Packet* p, SMTPD
 {
     const uint8_t* eol;   /* end of line */
     const uint8_t* eolm;  /* end of line marker */
+    const uint8_t* tok_end;  /* end of first token on the line */
     int cmd_line_len;
     int ret;
     int cmd_found;
@@ -693,10 +696,20 @@ static const uint8_t* SMTP_HandleCommand(SmtpProtoConf* config, Packet* p, SMTPD
     // pending state where the first char in the next packet is checked for
     // a space and end of line marker
 
+    /* the substring checks below only ever accept the first token on the
+     * line, so there is no need to run the rest of the line - often a long
+     * MAIL or RCPT argument - through the matcher; commands contain no
+     * whitespace so no match can span the token boundary */
+    tok_end = ptr;
+    while ((tok_end < eolm) && isspace((int)*tok_end))
+        tok_end++;
+    while ((tok_end < eolm) && !isspace((int)*tok_end))
+        tok_end++;
+
     /* do not confine since there could be space chars before command */
     smtp_current_search = &config->cmd_search[0];
     cmd_found = config->cmd_search_mpse->find(
-        (const char*)ptr, eolm - ptr, SMTP_SearchStrFound);
+        (const char*)ptr, tok_end - ptr, SMTP_SearchStrFound);
     /* see if we actually found a command and not a substring */
     if (cmd_found > 0)
     {
@@ -765,7 +778,11 @@ static const uint8_t* SMTP_HandleCommand(SmtpProtoConf* config, Packet* p, SMTPD
                 ret = SMTP_CopyToAltBuffer(p, ptr, eol - ptr);
                 if (ret == -1)
                     return nullptr;
+
+                smtpstats.cmd_lines_normalized++;
             }
+            else
+                smtpstats.cmd_lines_aliased++;
 
             return eol;
         }
@@ -979,6 +996,13 @@ static const uint8_t* SMTP_HandleCommand(SmtpProtoConf* config, Packet* p, SMTPD
             return nullptr;
     }
 
+    /* SMTP_NormalizeCmd only copies a dirty line into the alt buffer, so
+     * smtp_normalizing reflects whether this line was copied or aliased */
+    if (smtp_normalizing)
+        smtpstats.cmd_lines_normalized++;
+    else
+        smtpstats.cmd_lines_aliased++;
+
     return eol;
 }
 
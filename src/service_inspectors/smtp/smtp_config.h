@@ -153,6 +153,8 @@ struct SmtpStats
     PegCount sessions;
     PegCount concurrent_sessions;
     PegCount max_concurrent_sessions;
+    PegCount cmd_lines_aliased;
+    PegCount cmd_lines_normalized;
     snort::MimeStats mime_stats;
 };
 
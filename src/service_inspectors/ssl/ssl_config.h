@@ -26,6 +26,7 @@
 struct SSL_PROTO_CONF
 {
     bool trustservers;
+    bool stop_parse_after_hs;
     int max_heartbeat_len;
 };
 
@@ -49,6 +50,7 @@ struct SslStats
     PegCount bad_handshakes;
     PegCount stopped;
     PegCount disabled;
+    PegCount skipped_bytes;
     PegCount concurrent_sessions;
     PegCount max_concurrent_sessions;
 };
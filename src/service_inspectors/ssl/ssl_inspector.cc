@@ -68,6 +68,7 @@ const PegInfo ssl_peg_names[] =
     { CountType::SUM, "bad_handshakes", "total bad handshakes" },
     { CountType::SUM, "sessions_ignored", "total sessions ignore" },
     { CountType::SUM, "detection_disabled", "total detection disabled" },
+    { CountType::SUM, "skipped_bytes", "total encrypted bytes not decoded after the handshake" },
     { CountType::NOW, "concurrent_sessions", "total concurrent ssl sessions" },
     { CountType::MAX, "max_concurrent_sessions", "maximum concurrent ssl sessions" },
 
@@ -302,6 +303,18 @@ static void snort_ssl(SSL_PROTO_CONF* config, Packet* p)
 
     SSL_CLEAR_TEMPORARY_FLAGS(sd->ssn_flags);
 
+    /* Once the session is encrypted the handshake has yielded everything of
+     * interest and heartbleed checking is the only reason to keep walking
+     * the records; the operator can trade that check for skipping the
+     * decode entirely */
+    if ((sd->ssn_flags & SSL_ENCRYPTED_FLAG) && config->stop_parse_after_hs)
+    {
+        sslstats.skipped_bytes += p->dsize;
+        DetectionEngine::disable_content(p);
+        sslstats.disabled++;
+        return;
+    }
+
     uint8_t dir = (p->is_from_server()) ? 1 : 0;
     uint8_t index = (p->packet_flags & PKT_REBUILT_STREAM) ? 2 : 0;
 
@@ -468,6 +481,7 @@ void Ssl::show(const SnortConfig*) const
         return;
 
     ConfigLogger::log_flag("trust_servers", config->trustservers);
+    ConfigLogger::log_flag("stop_parse_after_handshake", config->stop_parse_after_hs);
     ConfigLogger::log_value("max_heartbeat_length", config->max_heartbeat_len);
 }
 
@@ -42,6 +42,9 @@ static const Parameter s_params[] =
     { "max_heartbeat_length", Parameter::PT_INT, "0:65535", "0",
       "maximum length of heartbeat record allowed" },
 
+    { "stop_parse_after_handshake", Parameter::PT_BOOL, nullptr, "false",
+      "stop decoding records once a session is encrypted; trades post-handshake heartbleed detection for less per packet work" },
+
     { nullptr, Parameter::PT_MAX, nullptr, nullptr, nullptr }
 };
 
@@ -90,6 +93,9 @@ bool SslModule::set(const char*, Value& v, SnortConfig*)
     else if ( v.is("max_heartbeat_length") )
         conf->max_heartbeat_len = v.get_uint16();
 
+    else if ( v.is("stop_parse_after_handshake") )
+        conf->stop_parse_after_hs = v.get_bool();
+
     else
         return false;
 
@@ -127,40 +127,41 @@ bool HexBook::add_spell(const char* key, const char* val)
 }
 
 const MagicPage* HexBook::find_spell(
-    const uint8_t* s, unsigned n, const MagicPage* p, unsigned i) const
+    const uint8_t* s, unsigned n, uint32_t state, unsigned i) const
 {
     while ( i < n )
     {
         int c = s[i];
+        const MagicState& ms = states[state];
 
-        if ( p->next[c] )
+        if ( ms.next[c] )
         {
-            if ( p->any )
+            if ( ms.any )
             {
-                if ( const MagicPage* q = find_spell(s, n, p->next[c], i+1) )
+                if ( const MagicPage* q = find_spell(s, n, ms.next[c], i+1) )
                     return q;
             }
             else
             {
-                p = p->next[c];
+                state = ms.next[c];
                 ++i;
                 continue;
             }
         }
-        if ( p->any )
+        if ( ms.any )
         {
-            if ( const MagicPage* q = find_spell(s, n, p->any, i+1) )
+            if ( const MagicPage* q = find_spell(s, n, ms.any, i+1) )
                 return q;
         }
         break;
     }
-    return p;
+    return states[state].page;
 }
 
 const char* HexBook::find_spell(
     const uint8_t* data, unsigned len, const MagicPage*& p) const
 {
-    p = find_spell(data, len, p, 0);
+    p = find_spell(data, len, p->state, 0);
 
     if ( !p->value.empty() )
         return p->value.c_str();
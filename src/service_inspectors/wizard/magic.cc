@@ -28,6 +28,7 @@ MagicPage::MagicPage(const MagicBook& b) : book(b)
     for ( int i = 0; i < 256; ++i )
         next[i] = nullptr;
     any = nullptr;
+    state = 0;
 }
 
 MagicPage::~MagicPage()
@@ -46,3 +47,51 @@ MagicBook::MagicBook()
 MagicBook::~MagicBook()
 { delete root; }
 
+// number the pages breadth first (index 0 is reserved as the null
+// transition) and copy each into a contiguous state; the root may be its
+// own successor (leading whitespace skip), hence the state checks
+void MagicBook::compile()
+{
+    if ( !states.empty() )
+        return;
+
+    std::vector<MagicPage*> pages;
+    root->state = 1;
+    pages.emplace_back(root);
+
+    for ( size_t i = 0; i < pages.size(); ++i )
+    {
+        MagicPage* p = pages[i];
+
+        for ( int c = 0; c < 256; ++c )
+        {
+            if ( p->next[c] && !p->next[c]->state )
+            {
+                p->next[c]->state = (uint32_t)pages.size() + 1;
+                pages.emplace_back(p->next[c]);
+            }
+        }
+        if ( p->any && !p->any->state )
+        {
+            p->any->state = (uint32_t)pages.size() + 1;
+            pages.emplace_back(p->any);
+        }
+    }
+
+    states.resize(pages.size() + 1);
+
+    for ( size_t i = 0; i < pages.size(); ++i )
+    {
+        const MagicPage* p = pages[i];
+        MagicState& s = states[i + 1];
+
+        for ( int c = 0; c < 256; ++c )
+        {
+            if ( p->next[c] )
+                s.next[c] = p->next[c]->state;
+        }
+        s.any = p->any ? p->any->state : 0;
+        s.page = p;
+    }
+}
+
@@ -20,6 +20,7 @@
 #ifndef MAGIC_H
 #define MAGIC_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -33,12 +34,25 @@ struct MagicPage
     MagicPage* next[256];
     MagicPage* any;
 
+    uint32_t state;  // index into the book's flattened walk table
+
     const MagicBook& book;
 
     MagicPage(const MagicBook&);
     ~MagicPage();
 };
 
+// Flattened copy of a page: transitions are table indices so the per byte
+// walk scans a compact array instead of chasing pointers between pages.
+// Built once by compile() after all spells are added.
+
+struct MagicState
+{
+    uint32_t next[256];  // state indices, 0 means no transition
+    uint32_t any;
+    const MagicPage* page;
+};
+
 typedef std::vector<uint16_t> HexVector;
 
 // MagicBook is a set of MagicPages implementing a trie
@@ -54,12 +68,16 @@ public:
     virtual bool add_spell(const char* key, const char* val) = 0;
     virtual const char* find_spell(const uint8_t*, unsigned len, const MagicPage*&) const = 0;
 
+    // flatten the trie; must be called before find_spell
+    void compile();
+
     const MagicPage* page1()
     { return root; }
 
 protected:
     MagicBook();
     MagicPage* root;
+    std::vector<MagicState> states;  // entry 0 is the null transition
 };
 
 //-------------------------------------------------------------------------
@@ -78,7 +96,7 @@ public:
 private:
     bool translate(const char*, HexVector&);
     void add_spell(const char*, const char*, HexVector&, unsigned, MagicPage*);
-    const MagicPage* find_spell(const uint8_t*, unsigned, const MagicPage*, unsigned) const;
+    const MagicPage* find_spell(const uint8_t*, unsigned, uint32_t, unsigned) const;
 };
 
 //-------------------------------------------------------------------------
@@ -97,7 +115,7 @@ public:
 private:
     bool translate(const char*, HexVector&);
     void add_spell(const char*, const char*, HexVector&, unsigned, MagicPage*);
-    const MagicPage* find_spell(const uint8_t*, unsigned, const MagicPage*, unsigned) const;
+    const MagicPage* find_spell(const uint8_t*, unsigned, uint32_t, unsigned) const;
 };
 
 #endif
@@ -118,39 +118,40 @@ bool SpellBook::add_spell(const char* key, const char* val)
 }
 
 const MagicPage* SpellBook::find_spell(
-    const uint8_t* s, unsigned n, const MagicPage* p, unsigned i) const
+    const uint8_t* s, unsigned n, uint32_t state, unsigned i) const
 {
     while ( i < n )
     {
         int c = toupper(s[i]);
+        const MagicState& ms = states[state];
 
-        if ( p->next[c] )
+        if ( ms.next[c] )
         {
-            if ( p->any )
+            if ( ms.any )
             {
-                if ( const MagicPage* q = find_spell(s, n, p->next[c], i+1) )
+                if ( const MagicPage* q = find_spell(s, n, ms.next[c], i+1) )
                     return q;
             }
             else
             {
-                p = p->next[c];
+                state = ms.next[c];
                 ++i;
                 continue;
             }
         }
-        if ( p->any )
+        if ( ms.any )
         {
             while ( i < n )
             {
-                if ( const MagicPage* q = find_spell(s, n, p->any, i) )
+                if ( const MagicPage* q = find_spell(s, n, ms.any, i) )
                     return q;
                 ++i;
             }
-            return p->any;
+            return states[ms.any].page;
         }
-        return p->value.empty() ? nullptr : p;
+        return ms.page->value.empty() ? nullptr : ms.page;
     }
-    return p;
+    return states[state].page;
 }
 
 const char* SpellBook::find_spell(
@@ -163,7 +164,7 @@ const char* SpellBook::find_spell(
     if ( len > max )
         len = max;
 
-    p = find_spell(data, len, p, 0);
+    p = find_spell(data, len, p->state, 0);
 
     if ( p and !p->value.empty() )
         return p->value.c_str();
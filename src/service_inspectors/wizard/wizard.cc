@@ -45,6 +45,9 @@ struct WizStats
     PegCount udp_hits;
     PegCount user_scans;
     PegCount user_hits;
+    PegCount tcp_bytes_scanned;
+    PegCount udp_bytes_scanned;
+    PegCount user_bytes_scanned;
 };
 
 const PegInfo wiz_pegs[] =
@@ -55,6 +58,9 @@ const PegInfo wiz_pegs[] =
     { CountType::SUM, "udp_hits", "udp identifications" },
     { CountType::SUM, "user_scans", "user payload scans" },
     { CountType::SUM, "user_hits", "user identifications" },
+    { CountType::SUM, "tcp_bytes_scanned", "tcp payload bytes scanned" },
+    { CountType::SUM, "udp_bytes_scanned", "udp payload bytes scanned" },
+    { CountType::SUM, "user_bytes_scanned", "user payload bytes scanned" },
     { CountType::END, nullptr, nullptr }
 };
 
@@ -91,12 +97,18 @@ public:
     bool is_paf() override { return true; }
 
 private:
-    void count_scan(const Flow* f)
+    void count_scan(const Flow* f, uint32_t len)
     {
         if ( f->pkt_type == PktType::TCP )
+        {
             ++tstats.tcp_scans;
+            tstats.tcp_bytes_scanned += len;
+        }
         else
+        {
             ++tstats.user_scans;
+            tstats.user_bytes_scanned += len;
+        }
     }
 
     void count_hit(const Flow* f)
@@ -167,7 +179,7 @@ StreamSplitter::Status MagicSplitter::scan(
     uint32_t, uint32_t*)
 {
     Profile profile(wizPerfStats);
-    count_scan(pkt->flow);
+    count_scan(pkt->flow, len);
 
     if ( wizard->cast_spell(wand, pkt->flow, data, len) )
     {
@@ -195,6 +207,12 @@ Wizard::Wizard(WizardModule* m)
     s2c_spells = m->get_book(false, false);
 
     curses = m->get_curse_book();
+
+    // flatten the tries while still single threaded
+    c2s_hexes->compile();
+    s2c_hexes->compile();
+    c2s_spells->compile();
+    s2c_spells->compile();
 }
 
 Wizard::~Wizard()
@@ -254,6 +272,7 @@ void Wizard::eval(Packet* p)
     }
 
     ++tstats.udp_scans;
+    tstats.udp_bytes_scanned += p->dsize;
 }
 
 StreamSplitter* Wizard::get_splitter(bool c2s)
@@ -31,7 +31,11 @@
 
 #include "sf_ipvar.h"
 
+#include <algorithm>
 #include <cassert>
+#include <vector>
+
+#include "utils/stats.h"
 #include "utils/util.h"
 
 #include "sf_cidr.h"
@@ -50,6 +54,7 @@ using namespace snort;
 static SfIpRet sfvar_list_compare(sfip_node_t*, sfip_node_t*);
 static inline void sfip_node_free(sfip_node_t*);
 static inline void sfip_node_freelist(sfip_node_t*);
+static void sfvar_free_compiled(sfip_var_t*);
 
 static inline sfip_var_t* _alloc_var()
 {
@@ -77,6 +82,7 @@ void sfvar_free(sfip_var_t* var)
         // FIXIT-L SFIP_TABLE free unimplemented
     }
 
+    sfvar_free_compiled(var);
     snort_free(var);
 }
 
@@ -424,6 +430,8 @@ SfIpRet sfvar_add(sfip_var_t* dst, sfip_var_t* src)
 
     assert(dst and src);
 
+    sfvar_free_compiled(dst);
+
     if ((copiedvar = sfvar_deep_copy(src)) == nullptr)
     {
         return SFIP_ALLOC_ERR;
@@ -452,6 +460,8 @@ static SfIpRet sfvar_add_node(sfip_var_t* var, sfip_node_t* node, int negated)
     if (!var || !node)
         return SFIP_ARG_ERR;
 
+    sfvar_free_compiled(var);
+
     // As of this writing, 11/20/06, nodes are always added to
     // the list, regardless of the mode (list or table).
 
@@ -1014,15 +1024,274 @@ sfip_var_t* sfvar_alloc(vartable_t* table, const char* variable, SfIpRet* status
         return nullptr;
     }
 
+    sfvar_compile(ret);
     return ret;
 }
 
+//-------------------------------------------------------------------------
+// compiled lookup form
+//
+// sfvar_ip_in is hot - it runs per rule tree head - so complete variables
+// are compiled into sorted, disjoint, per family interval arrays that are
+// searched with a branch-free lower bound instead of walking node lists.
+//-------------------------------------------------------------------------
+
+static void sfvar_free_compiled(sfip_var_t* var)
+{
+    if (var->pos4)
+        snort_free(var->pos4);
+    if (var->neg4)
+        snort_free(var->neg4);
+    if (var->pos6)
+        snort_free(var->pos6);
+    if (var->neg6)
+        snort_free(var->neg6);
+
+    var->pos4 = var->neg4 = nullptr;
+    var->pos6 = var->neg6 = nullptr;
+    var->pos4_count = var->neg4_count = 0;
+    var->pos6_count = var->neg6_count = 0;
+    var->pos_any = false;
+    var->compiled = false;
+}
+
+static void ival4_from_cidr(const SfCidr* cidr, sfip_ival4_t& iv)
+{
+    uint32_t net = ntohl(cidr->get_addr()->get_ip4_value());
+    uint32_t shift = 128 - cidr->get_bits();
+
+    /* 0.0.0.0 matches anything, as does a prefix shorter than the v4
+       mapped space; see fast_cont4 */
+    if (net == 0 or shift >= 32)
+    {
+        iv.lo = 0;
+        iv.hi = 0xffffffff;
+        return;
+    }
+
+    uint32_t mask = 0xffffffff << shift;
+    iv.lo = net & mask;
+    iv.hi = net | ~mask;
+}
+
+static void ival6_from_cidr(const SfCidr* cidr, sfip_ival6_t& iv)
+{
+    const uint32_t* w = cidr->get_addr()->get_ip6_ptr();
+    uint64_t hi_q = ((uint64_t)ntohl(w[0]) << 32) | ntohl(w[1]);
+    uint64_t lo_q = ((uint64_t)ntohl(w[2]) << 32) | ntohl(w[3]);
+
+    unsigned host = 128 - cidr->get_bits();
+    unsigned host_lo = host > 64 ? 64 : host;
+    unsigned host_hi = host > 64 ? host - 64 : 0;
+
+    uint64_t mask_lo = (host_lo >= 64) ? 0 : (~(uint64_t)0 << host_lo);
+    uint64_t mask_hi = (host_hi >= 64) ? 0 : (~(uint64_t)0 << host_hi);
+
+    iv.lo[0] = hi_q & mask_hi;
+    iv.lo[1] = lo_q & mask_lo;
+    iv.hi[0] = hi_q | ~mask_hi;
+    iv.hi[1] = lo_q | ~mask_lo;
+}
+
+static inline bool ip6_lte(const uint64_t a[2], const uint64_t b[2])
+{
+    return a[0] < b[0] or (a[0] == b[0] and a[1] <= b[1]);
+}
+
+/* Sort and coalesce overlapping intervals in place; returns the packed count */
+static uint32_t ival4_pack(std::vector<sfip_ival4_t>& v)
+{
+    std::sort(v.begin(), v.end(),
+        [](const sfip_ival4_t& a, const sfip_ival4_t& b) { return a.lo < b.lo; });
+
+    uint32_t n = 0;
+
+    for (uint32_t i = 0; i < v.size(); i++)
+    {
+        if (n and v[i].lo <= v[n-1].hi)
+        {
+            if (v[i].hi > v[n-1].hi)
+                v[n-1].hi = v[i].hi;
+        }
+        else
+            v[n++] = v[i];
+    }
+    return n;
+}
+
+static uint32_t ival6_pack(std::vector<sfip_ival6_t>& v)
+{
+    std::sort(v.begin(), v.end(),
+        [](const sfip_ival6_t& a, const sfip_ival6_t& b)
+        { return a.lo[0] < b.lo[0] or (a.lo[0] == b.lo[0] and a.lo[1] < b.lo[1]); });
+
+    uint32_t n = 0;
+
+    for (uint32_t i = 0; i < v.size(); i++)
+    {
+        if (n and ip6_lte(v[i].lo, v[n-1].hi))
+        {
+            if (!ip6_lte(v[i].hi, v[n-1].hi))
+            {
+                v[n-1].hi[0] = v[i].hi[0];
+                v[n-1].hi[1] = v[i].hi[1];
+            }
+        }
+        else
+            v[n++] = v[i];
+    }
+    return n;
+}
+
+static sfip_ival4_t* ival4_dup(const std::vector<sfip_ival4_t>& v, uint32_t n)
+{
+    sfip_ival4_t* a = (sfip_ival4_t*)snort_calloc(n, sizeof(sfip_ival4_t));
+    memcpy(a, v.data(), n * sizeof(sfip_ival4_t));
+    return a;
+}
+
+static sfip_ival6_t* ival6_dup(const std::vector<sfip_ival6_t>& v, uint32_t n)
+{
+    sfip_ival6_t* a = (sfip_ival6_t*)snort_calloc(n, sizeof(sfip_ival6_t));
+    memcpy(a, v.data(), n * sizeof(sfip_ival6_t));
+    return a;
+}
+
+void sfvar_compile(sfip_var_t* var)
+{
+    if (!var)
+        return;
+
+    sfvar_free_compiled(var);
+
+    if (var->mode != SFIP_LIST)
+        return;
+
+    std::vector<sfip_ival4_t> p4, n4;
+    std::vector<sfip_ival6_t> p6, n6;
+
+    for (sfip_node_t* node = var->head; node; node = node->next)
+    {
+        if (!node->ip or !node->ip->is_set())
+            var->pos_any = true;
+
+        else if (node->ip->get_addr()->get_family() == AF_INET)
+        {
+            sfip_ival4_t iv;
+            ival4_from_cidr(node->ip, iv);
+            p4.emplace_back(iv);
+        }
+        else if (node->ip->get_addr()->get_family() == AF_INET6)
+        {
+            sfip_ival6_t iv;
+            ival6_from_cidr(node->ip, iv);
+            p6.emplace_back(iv);
+        }
+    }
+
+    for (sfip_node_t* node = var->neg_head; node; node = node->next)
+    {
+        if (!node->ip)
+            continue;
+
+        if (node->ip->get_addr()->get_family() == AF_INET)
+        {
+            sfip_ival4_t iv;
+            ival4_from_cidr(node->ip, iv);
+            n4.emplace_back(iv);
+        }
+        else if (node->ip->get_addr()->get_family() == AF_INET6)
+        {
+            sfip_ival6_t iv;
+            ival6_from_cidr(node->ip, iv);
+            n6.emplace_back(iv);
+        }
+    }
+
+    if (!p4.empty())
+    {
+        var->pos4_count = ival4_pack(p4);
+        var->pos4 = ival4_dup(p4, var->pos4_count);
+    }
+    if (!n4.empty())
+    {
+        var->neg4_count = ival4_pack(n4);
+        var->neg4 = ival4_dup(n4, var->neg4_count);
+    }
+    if (!p6.empty())
+    {
+        var->pos6_count = ival6_pack(p6);
+        var->pos6 = ival6_dup(p6, var->pos6_count);
+    }
+    if (!n6.empty())
+    {
+        var->neg6_count = ival6_pack(n6);
+        var->neg6 = ival6_dup(n6, var->neg6_count);
+    }
+
+    var->compiled = true;
+}
+
+/* Branch-free lower bound over disjoint sorted intervals; the final
+   candidate is the last interval whose lo is <= key */
+static inline bool ival4_contains(const sfip_ival4_t* ivals, uint32_t n, uint32_t key)
+{
+    const sfip_ival4_t* base = ivals;
+
+    while (n > 1)
+    {
+        uint32_t half = n / 2;
+
+        if (base[half].lo <= key)
+            base += half;
+
+        n -= half;
+    }
+    return base->lo <= key and key <= base->hi;
+}
+
+static inline bool ival6_contains(const sfip_ival6_t* ivals, uint32_t n, const uint64_t key[2])
+{
+    const sfip_ival6_t* base = ivals;
+
+    while (n > 1)
+    {
+        uint32_t half = n / 2;
+
+        if (ip6_lte(base[half].lo, key))
+            base += half;
+
+        n -= half;
+    }
+    return ip6_lte(base->lo, key) and ip6_lte(key, base->hi);
+}
+
 /* Support function for sfvar_ip_in  */
 static inline bool sfvar_ip_in4(sfip_var_t* var, const SfIp* ip)
 {
     int match;
     sfip_node_t* pos_idx, * neg_idx;
 
+    if (var->compiled)
+    {
+        uint32_t key = ntohl(ip->get_ip4_value());
+
+        if (var->neg4_count and ival4_contains(var->neg4, var->neg4_count, key))
+        {
+            ++pc.ipvar_neg_hits;
+            return false;
+        }
+        if (!var->head or var->pos_any or
+            (var->pos4_count and ival4_contains(var->pos4, var->pos4_count, key)))
+        {
+            ++pc.ipvar_pos_hits;
+            return true;
+        }
+        ++pc.ipvar_misses;
+        return false;
+    }
+    ++pc.ipvar_list_walks;
+
     match = 0;
 
     pos_idx = var->head;
@@ -1090,6 +1359,29 @@ static inline bool sfvar_ip_in6(sfip_var_t* var, const SfIp* ip)
     int match;
     sfip_node_t* pos_idx, * neg_idx;
 
+    if (var->compiled)
+    {
+        const uint32_t* w = ip->get_ip6_ptr();
+        uint64_t key[2];
+        key[0] = ((uint64_t)ntohl(w[0]) << 32) | ntohl(w[1]);
+        key[1] = ((uint64_t)ntohl(w[2]) << 32) | ntohl(w[3]);
+
+        if (var->neg6_count and ival6_contains(var->neg6, var->neg6_count, key))
+        {
+            ++pc.ipvar_neg_hits;
+            return false;
+        }
+        if (!var->head or var->pos_any or
+            (var->pos6_count and ival6_contains(var->pos6, var->pos6_count, key)))
+        {
+            ++pc.ipvar_pos_hits;
+            return true;
+        }
+        ++pc.ipvar_misses;
+        return false;
+    }
+    ++pc.ipvar_list_walks;
+
     match = 0;
 
     pos_idx = var->head;
@@ -1415,3 +1707,29 @@ TEST_CASE("SfIpVarAny", "[SfIpVar]")
 
 #endif
 
+
+#ifdef BENCHMARK_TEST
+
+TEST_CASE("sfvar_ip_in speed", "[benchmark]")
+{
+    vartable_t* table = sfvt_alloc_table();
+    sfip_var_t* var = nullptr;
+
+    REQUIRE(SFIP_SUCCESS == sfvt_add_str(table,
+        "bench [ 10.0.0.0/8, 172.16.0.0/12, 192.168.0.0/16, !10.1.2.0/24, 2001:db8::/32 ]",
+        &var));
+
+    SfIp in, out;
+    in.set("192.168.100.1");
+    out.set("8.8.8.8");
+
+    BENCHMARK("contained address")
+    { return sfvar_ip_in(var, &in); };
+
+    BENCHMARK("excluded address")
+    { return sfvar_ip_in(var, &out); };
+
+    sfvt_free_table(table);
+}
+
+#endif
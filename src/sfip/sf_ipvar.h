@@ -64,6 +64,20 @@ typedef struct _ip_node
                     /* Should merge them later */
 } sfip_node_t;
 
+/* Closed address ranges used by the compiled form of a variable,
+ * host byte order.  IPv6 addresses are split into high and low qwords. */
+struct sfip_ival4_t
+{
+    uint32_t lo;
+    uint32_t hi;
+};
+
+struct sfip_ival6_t
+{
+    uint64_t lo[2];
+    uint64_t hi[2];
+};
+
 /* An IP variable onkect */
 struct sfip_var_t
 {
@@ -87,6 +101,20 @@ struct sfip_var_t
     uint32_t id;
     char* name;
     char* value;
+
+    /* Compiled lookup form: sorted, disjoint, per family interval arrays
+     * built by sfvar_compile once the lists are complete.  Any later list
+     * mutation drops these and lookups fall back to walking the lists. */
+    sfip_ival4_t* pos4;
+    sfip_ival4_t* neg4;
+    sfip_ival6_t* pos6;
+    sfip_ival6_t* neg6;
+    uint32_t pos4_count;
+    uint32_t neg4_count;
+    uint32_t pos6_count;
+    uint32_t neg6_count;
+    bool pos_any;   /* positive list matches any address */
+    bool compiled;
 };
 
 /* A variable table for storing and looking up variables
@@ -122,6 +150,10 @@ SfIpRet sfvar_compare(const sfip_var_t* one, const sfip_var_t* two);
 /* Free an allocated variable */
 void sfvar_free(sfip_var_t* var);
 
+/* Builds the compiled interval form searched by sfvar_ip_in; call once a
+   variable will no longer be modified */
+void sfvar_compile(sfip_var_t* var);
+
 // returns true if both args are valid and ip is contained by var
 bool sfvar_ip_in(sfip_var_t* var, const snort::SfIp* ip);
 
@@ -334,6 +334,29 @@ void sfrt_cleanup(table_t* table, sfrt_iterator_callback cleanup_func)
     }
 }
 
+// visit each stored entry; unlike sfrt_cleanup the entries are left in
+// the table
+void sfrt_iterate(table_t* table, sfrt_iterator_callback_arg userfunc, void* arg)
+{
+    uint32_t index, count;
+
+    if (!table)
+        return;
+
+    for (index = 0, count = 0;
+        index < table->max_size;
+        index++)
+    {
+        if (table->data[index])
+        {
+            userfunc(table->data[index], arg);
+
+            if (++count == table->num_ent)
+                break;
+        }
+    }
+}
+
 GENERIC sfrt_search(const SfIp* ip, unsigned char len, table_t* table)
 {
     const uint32_t* addr;
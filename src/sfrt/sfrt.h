@@ -124,6 +124,9 @@ GENERIC sfrt_search(const snort::SfIp*, unsigned char len, table_t*);
 typedef void (* sfrt_iterator_callback)(void*);
 void sfrt_cleanup(table_t*, sfrt_iterator_callback);
 
+typedef void (* sfrt_iterator_callback_arg)(void*, void*);
+void sfrt_iterate(table_t*, sfrt_iterator_callback_arg, void* arg);
+
 int sfrt_insert(snort::SfCidr*, unsigned char len, GENERIC, int behavior, table_t*);
 int sfrt_remove(snort::SfCidr*, unsigned char len, GENERIC*, int behavior, table_t*);
 
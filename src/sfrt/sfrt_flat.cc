@@ -43,16 +43,11 @@ table_flat_t* sfrt_flat_new(char table_flat_type, char ip_type,  long data_size,
     uint8_t* base;
     long data_size_max = 1;
 
+    /* the table is the first allocation, so it lands at offset 0 and
+     * doubles as the base pointer every stored offset resolves against
+     * (see sfrt_flat_dir8x_lookup and the reputation segment casts) */
     table_ptr = segment_snort_alloc(sizeof(table_flat_t));
 
-#if 0
-    /*The first allocation always return 0*/
-    if (!table_ptr)
-    {
-        //  return NULL;
-    }
-#endif
-
     base = (uint8_t*)segment_basePtr();
     table = (table_flat_t*)(&base[table_ptr]);
 
@@ -259,6 +254,56 @@ GENERIC sfrt_flat_lookup(const SfIp* ip, table_flat_t* table)
         return nullptr;
 }
 
+/* Perform a lookup on "ip"/"len", but only match the entry inserted with
+ * exactly that prefix; covering prefixes do not match */
+GENERIC sfrt_flat_exact_lookup(const SfCidr* cidr, unsigned char len, table_flat_t* table)
+{
+    const SfIp* ip;
+    tuple_flat_t tuple;
+    const uint32_t* addr;
+    int numAddrDwords;
+    INFO* data;
+    TABLE_PTR rt;
+    uint8_t* base;
+
+    if (!cidr || !table || !table->data)
+        return nullptr;
+
+    if (len == 0 || len > 128)
+        return nullptr;
+
+    ip = cidr->get_addr();
+    if (ip->is_ip4())
+    {
+        if (len < 96)
+            return nullptr;
+        len -= 96;
+        addr = ip->get_ip4_ptr();
+        numAddrDwords = 1;
+        rt = table->rt;
+    }
+    else if (ip->is_ip6())
+    {
+        addr = ip->get_ip6_ptr();
+        numAddrDwords = 4;
+        rt = table->rt6;
+    }
+    else
+        return nullptr;
+
+    tuple = sfrt_dir_flat_lookup(addr, numAddrDwords, rt);
+
+    if (tuple.length != len || tuple.index >= table->num_ent)
+        return nullptr;
+
+    base = (uint8_t*)segment_basePtr();
+    data = (INFO*)(&base[table->data]);
+    if (data[tuple.index])
+        return (GENERIC)&base[data[tuple.index]];
+    else
+        return nullptr;
+}
+
 /* Insert "ip", of length "len", into "table", and have it point to "ptr" */
 int sfrt_flat_insert(SfCidr* cidr, unsigned char len, INFO ptr,
     int behavior, table_flat_t* table, updateEntryInfoFunc updateEntry)
@@ -399,11 +444,18 @@ uint32_t sfrt_flat_usage(table_flat_t* table)
 
 /* Perform a lookup on value contained in "ip"
  * For performance reason, we use this simplified version instead of sfrt_lookup
- * Note: this only applied to table setting: DIR_8x16 (DIR_16_8_4x2 for IPV4), DIR_8x4*/
+ * Note: this only applied to table setting: DIR_8x16 (DIR_16_8_4x2 for IPV4), DIR_8x4
+ *
+ * All offsets are resolved against the table pointer itself, with no locks
+ * and no bounds rechecks, so the table must be immutable while any packet
+ * thread can reach it. Rebuilds and delta updates must build a separate
+ * segment and publish it with a single pointer swap (the inspector reload
+ * swap); never modify a table in place once it is visible to readers. */
 GENERIC sfrt_flat_dir8x_lookup(const SfIp* ip, table_flat_t* table)
 {
     dir_sub_table_flat_t* subtable;
-    DIR_Entry* entry;
+    MEM_OFFSET* values;
+    uint8_t* lengths;
     uint8_t* base = (uint8_t*)table;
     int i;
     dir_table_flat_t* rt = nullptr;
@@ -416,47 +468,51 @@ GENERIC sfrt_flat_dir8x_lookup(const SfIp* ip, table_flat_t* table)
         subtable = (dir_sub_table_flat_t*)(&base[rt->sub_table]);
         /* 16 bits*/
         index = ntohs(((const uint16_t*) ip->get_ip4_ptr())[0]);
-        entry = (DIR_Entry*)(&base[subtable->entries]);
-        if ( !entry[index].value || entry[index].length)
+        values = (MEM_OFFSET*)(&base[subtable->entries]);
+        lengths = (uint8_t*)(&base[subtable->lengths]);
+        if ( !values[index] || lengths[index])
         {
-            if (data[entry[index].value])
-                return (GENERIC)&base[data[entry[index].value]];
+            if (data[values[index]])
+                return (GENERIC)&base[data[values[index]]];
             else
                 return nullptr;
         }
-        subtable = (dir_sub_table_flat_t*)(&base[entry[index].value]);
+        subtable = (dir_sub_table_flat_t*)(&base[values[index]]);
 
         /* 8 bits*/
         index = ((const uint8_t*) ip->get_ip4_ptr())[2];
-        entry = (DIR_Entry*)(&base[subtable->entries]);
-        if ( !entry[index].value || entry[index].length)
+        values = (MEM_OFFSET*)(&base[subtable->entries]);
+        lengths = (uint8_t*)(&base[subtable->lengths]);
+        if ( !values[index] || lengths[index])
         {
-            if (data[entry[index].value])
-                return (GENERIC)&base[data[entry[index].value]];
+            if (data[values[index]])
+                return (GENERIC)&base[data[values[index]]];
             else
                 return nullptr;
         }
-        subtable = (dir_sub_table_flat_t*)(&base[entry[index].value]);
+        subtable = (dir_sub_table_flat_t*)(&base[values[index]]);
 
         /* 4 bits */
         index = ((const uint8_t*) ip->get_ip4_ptr())[3] >> 4;
-        entry = (DIR_Entry*)(&base[subtable->entries]);
-        if ( !entry[index].value || entry[index].length)
+        values = (MEM_OFFSET*)(&base[subtable->entries]);
+        lengths = (uint8_t*)(&base[subtable->lengths]);
+        if ( !values[index] || lengths[index])
         {
-            if (data[entry[index].value])
-                return (GENERIC)&base[data[entry[index].value]];
+            if (data[values[index]])
+                return (GENERIC)&base[data[values[index]]];
             else
                 return nullptr;
         }
-        subtable = (dir_sub_table_flat_t*)(&base[entry[index].value]);
+        subtable = (dir_sub_table_flat_t*)(&base[values[index]]);
 
         /* 4 bits */
         index = ((const uint8_t*) ip->get_ip4_ptr())[3] & 0xF;
-        entry = (DIR_Entry*)(&base[subtable->entries]);
-        if ( !entry[index].value || entry[index].length)
+        values = (MEM_OFFSET*)(&base[subtable->entries]);
+        lengths = (uint8_t*)(&base[subtable->lengths]);
+        if ( !values[index] || lengths[index])
         {
-            if (data[entry[index].value])
-                return (GENERIC)&base[data[entry[index].value]];
+            if (data[values[index]])
+                return (GENERIC)&base[data[values[index]]];
             else
                 return nullptr;
         }
@@ -468,15 +524,16 @@ GENERIC sfrt_flat_dir8x_lookup(const SfIp* ip, table_flat_t* table)
         for (i = 0; i < 16; i++)
         {
             index = ((const uint8_t*) ip->get_ip6_ptr())[i];
-            entry = (DIR_Entry*)(&base[subtable->entries]);
-            if ( !entry[index].value || entry[index].length)
+            values = (MEM_OFFSET*)(&base[subtable->entries]);
+            lengths = (uint8_t*)(&base[subtable->lengths]);
+            if ( !values[index] || lengths[index])
             {
-                if (data[entry[index].value])
-                    return (GENERIC)&base[data[entry[index].value]];
+                if (data[values[index]])
+                    return (GENERIC)&base[data[values[index]]];
                 else
                     return nullptr;
             }
-            subtable = (dir_sub_table_flat_t*)(&base[entry[index].value]);
+            subtable = (dir_sub_table_flat_t*)(&base[values[index]]);
         }
     }
     return nullptr;
@@ -75,6 +75,7 @@ table_flat_t* sfrt_flat_new(char table_flat_type, char ip_type,
 void sfrt_flat_free(TABLE_PTR table);
 
 GENERIC sfrt_flat_lookup(const snort::SfIp* ip, table_flat_t* table);
+GENERIC sfrt_flat_exact_lookup(const snort::SfCidr* cidr, unsigned char len, table_flat_t* table);
 GENERIC sfrt_flat_dir8x_lookup(const snort::SfIp* ip, table_flat_t* table);
 
 int sfrt_flat_insert(snort::SfCidr* cidr, unsigned char len, INFO ptr, int behavior,
@@ -49,14 +49,15 @@ static TABLE_PTR _sub_table_flat_new(dir_table_flat_t* root, uint32_t dimension,
     dir_sub_table_flat_t* sub;
     TABLE_PTR sub_ptr;
     uint8_t* base;
-    DIR_Entry* entries;
+    MEM_OFFSET* values;
+    uint8_t* lengths;
 
     /* Check if creating this node will exceed the memory cap.
      * The symbols in the conditional (other than cap), come from the
      * allocs below. */
     if ( root->mem_cap < ( root->allocated +
         sizeof(dir_sub_table_flat_t) +
-        sizeof(DIR_Entry) * len ) ||
+        (sizeof(MEM_OFFSET) + sizeof(uint8_t)) * len ) ||
         bit_length > 128)
     {
         return 0;
@@ -84,7 +85,7 @@ static TABLE_PTR _sub_table_flat_new(dir_table_flat_t* root, uint32_t dimension,
      * information if "RT_FAVOR_SPECIFIC" insertions are being performed. */
     sub->num_entries = len;
 
-    sub->entries = segment_snort_alloc(sizeof(DIR_Entry) * sub->num_entries);
+    sub->entries = segment_snort_alloc(sizeof(MEM_OFFSET) * sub->num_entries);
 
     if (!sub->entries)
     {
@@ -92,17 +93,28 @@ static TABLE_PTR _sub_table_flat_new(dir_table_flat_t* root, uint32_t dimension,
         return 0;
     }
 
-    entries = (DIR_Entry*)(&base[sub->entries]);
+    sub->lengths = segment_snort_alloc(sizeof(uint8_t) * sub->num_entries);
+
+    if (!sub->lengths)
+    {
+        segment_free(sub->entries);
+        segment_free(sub_ptr);
+        return 0;
+    }
+
+    values = (MEM_OFFSET*)(&base[sub->entries]);
+    lengths = (uint8_t*)(&base[sub->lengths]);
     /* Can't use memset here since prefill is multibyte */
     for (index = 0; index < sub->num_entries; index++)
     {
-        entries[index].value = prefill;
-        entries[index].length = (uint8_t)bit_length;
+        values[index] = prefill;
+        lengths[index] = (uint8_t)bit_length;
     }
 
     sub->cur_num = 0;
 
-    root->allocated += sizeof(dir_sub_table_flat_t) + sizeof(DIR_Entry) * sub->num_entries;
+    root->allocated += sizeof(dir_sub_table_flat_t) +
+        (sizeof(MEM_OFFSET) + sizeof(uint8_t)) * sub->num_entries;
 
     root->cur_num++;
 
@@ -175,10 +187,11 @@ static void _sub_table_flat_free(uint32_t* allocated, SUB_TABLE_PTR sub_ptr)
     {
         /* The following condition will only be true if
          * this entry is a pointer  */
-        DIR_Entry* entry = (DIR_Entry*)(&base[sub->entries]);
-        if ( !entry[index].length && entry[index].value )
+        MEM_OFFSET* values = (MEM_OFFSET*)(&base[sub->entries]);
+        uint8_t* lengths = (uint8_t*)(&base[sub->lengths]);
+        if ( !lengths[index] && values[index] )
         {
-            _sub_table_flat_free(allocated, entry[index].value);
+            _sub_table_flat_free(allocated, values[index]);
         }
     }
 
@@ -188,8 +201,9 @@ static void _sub_table_flat_free(uint32_t* allocated, SUB_TABLE_PTR sub_ptr)
          * since if it was not allocated, we would have errored out
          * in _sub_table_flat_new */
         segment_free(sub->entries);
+        segment_free(sub->lengths);
 
-        *allocated -= sizeof(DIR_Entry) * sub->num_entries;
+        *allocated -= (sizeof(MEM_OFFSET) + sizeof(uint8_t)) * sub->num_entries;
     }
 
     segment_free(sub_ptr);
@@ -233,14 +247,15 @@ static inline void _dir_fill_all(uint32_t* allocated, uint32_t index, uint32_t f
     {
         /* Before overwriting this entry, verify there's not an existing
          * pointer ... otherwise free it to avoid a huge memory leak. */
-        DIR_Entry* entry = (DIR_Entry*)(&base[subtable->entries]);
-        if ( entry[index].value && !entry[index].length)
+        MEM_OFFSET* values = (MEM_OFFSET*)(&base[subtable->entries]);
+        uint8_t* lengths = (uint8_t*)(&base[subtable->lengths]);
+        if ( values[index] && !lengths[index])
         {
-            _sub_table_flat_free(allocated, entry[index].value);
+            _sub_table_flat_free(allocated, values[index]);
         }
 
-        entry[index].value = val;
-        entry[index].length = (uint8_t)length;
+        values[index] = val;
+        lengths[index] = (uint8_t)length;
     }
 }
 
@@ -267,16 +282,17 @@ static inline void _dir_fill_less_specific(int index, int fill,
          * B.
          *
          * Therefore, recurse to this next level. */
-        DIR_Entry* entry = (DIR_Entry*)(&base[subtable->entries]);
-        if ( entry[index].value && !entry[index].length)
+        MEM_OFFSET* values = (MEM_OFFSET*)(&base[subtable->entries]);
+        uint8_t* lengths = (uint8_t*)(&base[subtable->lengths]);
+        if ( values[index] && !lengths[index])
         {
-            dir_sub_table_flat_t* next = (dir_sub_table_flat_t*)(&base[entry[index].value]);
-            _dir_fill_less_specific(0, 1 << next->width, length, val, entry[index].value);
+            dir_sub_table_flat_t* next = (dir_sub_table_flat_t*)(&base[values[index]]);
+            _dir_fill_less_specific(0, 1 << next->width, length, val, values[index]);
         }
-        else if (length >= (unsigned)entry[index].length)
+        else if (length >= (unsigned)lengths[index])
         {
-            entry[index].value = val;
-            entry[index].length = (char)length;
+            values[index] = val;
+            lengths[index] = (uint8_t)length;
         }
     }
 }
@@ -305,24 +321,25 @@ static inline int64_t _dir_update_info(int index, int fill,
          * B.
          *
          * Therefore, recurse to this next level. */
-        DIR_Entry* entry = (DIR_Entry*)(&base[subtable->entries]);
-        if ( entry[index].value && !entry[index].length)
+        MEM_OFFSET* values = (MEM_OFFSET*)(&base[subtable->entries]);
+        uint8_t* lengths = (uint8_t*)(&base[subtable->lengths]);
+        if ( values[index] && !lengths[index])
         {
             int64_t bytesAllocated;
-            dir_sub_table_flat_t* next = (dir_sub_table_flat_t*)(&base[entry[index].value]);
+            dir_sub_table_flat_t* next = (dir_sub_table_flat_t*)(&base[values[index]]);
             bytesAllocated = _dir_update_info(0, 1 << next->width, length, val,
-                    entry[index].value, updateEntry, data);
+                    values[index], updateEntry, data);
             if (bytesAllocated < 0)
                 return bytesAllocated;
             else
                 bytesAllocatedTotal += bytesAllocated;
         }
-        else if (length > (unsigned)entry[index].length)
+        else if (length > (unsigned)lengths[index])
         {
-            if (entry[index].value)
+            if (values[index])
             {
                 int64_t bytesAllocated;
-                bytesAllocated =  updateEntry(&data[entry[index].value], data[val],
+                bytesAllocated =  updateEntry(&data[values[index]], data[val],
                     SAVE_TO_NEW, base);
                 if (bytesAllocated < 0)
                     return bytesAllocated;
@@ -330,13 +347,13 @@ static inline int64_t _dir_update_info(int index, int fill,
                     bytesAllocatedTotal += bytesAllocated;
             }
 
-            entry[index].value = val;
-            entry[index].length = (uint8_t)length;
+            values[index] = val;
+            lengths[index] = (uint8_t)length;
         }
-        else if (entry[index].value)
+        else if (values[index])
         {
             int64_t bytesAllocated;
-            bytesAllocated = updateEntry(&data[entry[index].value], data[val],
+            bytesAllocated = updateEntry(&data[values[index]], data[val],
                 SAVE_TO_CURRENT,  base);
             if (bytesAllocated < 0)
                 return bytesAllocated;
@@ -431,27 +448,27 @@ static int _dir_sub_insert(IPLOOKUP* ip, int length, int cur_len, INFO ptr,
     /* Need to traverse to a sub-table */
     else
     {
-        DIR_Entry* entry = (DIR_Entry*)(&base[sub_table->entries]);
+        MEM_OFFSET* values = (MEM_OFFSET*)(&base[sub_table->entries]);
+        uint8_t* lengths = (uint8_t*)(&base[sub_table->lengths]);
 
         /* Check if we need to alloc a new sub table.
          * If next_sub was 0/NULL, there's no entry at this index
          * If the length is non-zero, there is an entry */
-        if (!entry[index].value || entry[index].length)
+        if (!values[index] || lengths[index])
         {
             if ( root_table->dim_size <= current_depth )
             {
                 return RT_INSERT_FAILURE;
             }
 
-            entry[index].value =
-                (word)_sub_table_flat_new(root_table, current_depth+1,
-                (word)entry[index].value, entry[index].length);
+            values[index] = _sub_table_flat_new(root_table, current_depth+1,
+                values[index], lengths[index]);
 
             sub_table->cur_num++;
 
-            entry[index].length = 0;
+            lengths[index] = 0;
 
-            if (!entry[index].value)
+            if (!values[index])
             {
                 return MEM_ALLOC_FAILURE;
             }
@@ -461,7 +478,7 @@ static int _dir_sub_insert(IPLOOKUP* ip, int length, int cur_len, INFO ptr,
         ip->bits += sub_table->width;
         return (_dir_sub_insert(ip, length,
                cur_len - sub_table->width, ptr, current_depth+1,
-               behavior, entry[index].value, root_table, updateEntry, data));
+               behavior, values[index], root_table, updateEntry, data));
     }
 
     return RT_SUCCESS;
@@ -523,7 +540,8 @@ static tuple_flat_t _dir_sub_flat_lookup(IPLOOKUP* ip, TABLE_PTR table_ptr)
 {
     word index;
     uint8_t* base = (uint8_t*)segment_basePtr();
-    DIR_Entry* entry;
+    MEM_OFFSET* values;
+    uint8_t* lengths;
     dir_sub_table_flat_t* table = (dir_sub_table_flat_t*)(&base[table_ptr]);
 
     {
@@ -548,18 +566,19 @@ static tuple_flat_t _dir_sub_flat_lookup(IPLOOKUP* ip, TABLE_PTR table_ptr)
         local_index = ip->addr[i] << (ip->bits %32);
         index = local_index >> (ARCH_WIDTH - table->width);
     }
-    entry = (DIR_Entry*)(&base[table->entries]);
+    values = (MEM_OFFSET*)(&base[table->entries]);
+    lengths = (uint8_t*)(&base[table->lengths]);
 
-    if ( !entry[index].value || entry[index].length )
+    if ( !values[index] || lengths[index] )
     {
         tuple_flat_t ret;
-        ret.index = entry[index].value;
-        ret.length = (word)entry[index].length;
+        ret.index = values[index];
+        ret.length = (word)lengths[index];
         return ret;
     }
 
     ip->bits += table->width;
-    return _dir_sub_flat_lookup(ip, entry[index].value);
+    return _dir_sub_flat_lookup(ip, values[index]);
 }
 
 /* Lookup information associated with the value "ip" */
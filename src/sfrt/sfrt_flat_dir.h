@@ -25,12 +25,7 @@
 
 typedef MEM_OFFSET SUB_TABLE_PTR;
 typedef MEM_OFFSET ENTRIES_PTR;
-
-typedef struct
-{
-    MEM_OFFSET value;
-    uint8_t length;
-}DIR_Entry;
+typedef MEM_OFFSET LENGTHS_PTR;
 
 /*******************************************************************/
 /* DIR-n-m data structures
@@ -45,7 +40,11 @@ typedef struct
                       * are used. */
     int cur_num;     /* Present number of used nodes */
 
-    ENTRIES_PTR entries;
+    /* The values and lengths are kept in parallel arrays rather than an
+     * array of structs; a combined entry pads out to 8 bytes while the
+     * split arrays cost 5 per slot, and the tables are all slots. */
+    ENTRIES_PTR entries;  /* array of MEM_OFFSET values */
+    LENGTHS_PTR lengths;  /* array of uint8_t lengths */
 } dir_sub_table_flat_t;
 
 /* Master data structure for the DIR-n-m derivative */
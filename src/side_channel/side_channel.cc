@@ -243,9 +243,22 @@ void SideChannel::unregister_receive_handler()
 SCMessage* SideChannel::alloc_transmit_message(uint32_t content_length)
 {
     SCMessage* msg = new SCMessage;
-    msg->handle = connector_transmit->alloc_message((content_length + sizeof(SCMsgHdr)),
-        (const uint8_t**)&(msg->hdr));
-    assert(msg->handle);
+
+    // prefer the zero-copy path: write in place in the connector's transmit
+    // buffer and commit on transmit.  a null handle marks a reserved message.
+    uint8_t* data = connector_transmit->reserve_message(content_length + sizeof(SCMsgHdr));
+
+    if ( data )
+    {
+        msg->handle = nullptr;
+        msg->hdr = (SCMsgHdr*)data;
+    }
+    else
+    {
+        msg->handle = connector_transmit->alloc_message((content_length + sizeof(SCMsgHdr)),
+            (const uint8_t**)&(msg->hdr));
+        assert(msg->handle);
+    }
 
     msg->sc = this;
     msg->connector = connector_transmit;
@@ -259,9 +272,11 @@ SCMessage* SideChannel::alloc_transmit_message(uint32_t content_length)
 bool SideChannel::discard_message(SCMessage* msg)
 {
     assert(msg);
-    assert(msg->handle);
 
-    msg->connector->discard_message (msg->handle);
+    // reserved messages have no handle; abandoning the reservation is enough
+    if ( msg->handle )
+        msg->connector->discard_message (msg->handle);
+
     delete msg;
     return true;
 }
@@ -270,7 +285,7 @@ bool SideChannel::transmit_message(SCMessage* msg)
 {
     bool return_value = false;
 
-    if ( connector_transmit && msg->handle )
+    if ( connector_transmit )
     {
         struct timeval tm;
         (void)gettimeofday(&tm,nullptr);
@@ -278,13 +293,24 @@ bool SideChannel::transmit_message(SCMessage* msg)
         msg->hdr->time_u_seconds = (uint32_t)tm.tv_usec;
         msg->hdr->sequence = sequence++;
 
-        return_value = connector_transmit->transmit_message(msg->handle);
+        if ( msg->handle )
+            return_value = connector_transmit->transmit_message(msg->handle);
+        else
+            return_value = connector_transmit->commit_message(
+                msg->content_length + sizeof(SCMsgHdr));
+
         delete msg;
     }
 
     return return_value;
 }
 
+void SideChannel::flush_transmit()
+{
+    if ( connector_transmit )
+        connector_transmit->flush_transmit();
+}
+
 Connector::Direction SideChannel::get_direction()
 {
     if ( connector_receive && connector_transmit )
@@ -67,6 +67,7 @@ public:
     SCMessage* alloc_transmit_message(uint32_t content_length);
     bool discard_message(SCMessage* msg);
     bool transmit_message(SCMessage* msg);
+    void flush_transmit();
     void set_message_port(SCMessage* msg, SCPort port);
     void set_default_port(SCPort port);
     snort::Connector::Direction get_direction();
@@ -50,7 +50,7 @@ THREAD_LOCAL ProfileStats s5PerfStats;
 THREAD_LOCAL FlowControl* flow_con = nullptr;
 
 static BaseStats g_stats;
-THREAD_LOCAL BaseStats stream_base_stats;
+PEG_SLAB_ALIGN THREAD_LOCAL BaseStats stream_base_stats;
 
 // FIXIT-L dependency on stats define in another file
 const PegInfo base_pegs[] =
@@ -64,10 +64,16 @@ const PegInfo base_pegs[] =
     { CountType::SUM, "memcap_prunes", "sessions pruned due to memcap" },
     { CountType::SUM, "ha_prunes", "sessions pruned by high availability sync" },
     { CountType::SUM, "stale_prunes", "sessions pruned due to stale connection" },
+    { CountType::SUM, "deferred_prunes", "sessions queued for deferred reclaim" },
+    { CountType::MAX, "max_deferred_prunes", "deepest deferred reclaim backlog" },
+    { CountType::SUM, "promoted_flows", "uni sessions that became bidirectional conversations" },
     { CountType::SUM, "expected_flows", "total expected flows created within snort" },
     { CountType::SUM, "expected_realized", "number of expected flows realized" },
     { CountType::SUM, "expected_pruned", "number of expected flows pruned" },
     { CountType::SUM, "expected_overflows", "number of expected cache overflows" },
+    { CountType::SUM, "expected_fast_rejects", "expected cache lookups answered without a hash probe" },
+    { CountType::SUM, "expected_probes", "expected cache lookups that probed the hash table" },
+    { CountType::SUM, "expected_prebound", "expected flows realized with a pre-resolved service binding" },
     { CountType::SUM, "reload_tuning_idle", "number of times stream resource tuner called while idle" },
     { CountType::SUM, "reload_tuning_packets", "number of times stream resource tuner called while processing packets" },
     { CountType::SUM, "reload_total_adds", "number of flows added by config reloads" },
@@ -94,6 +100,9 @@ void base_prep()
     stream_base_stats.memcap_prunes = flow_con->get_prunes(PruneReason::MEMCAP);
     stream_base_stats.ha_prunes = flow_con->get_prunes(PruneReason::HA);
     stream_base_stats.stale_prunes = flow_con->get_prunes(PruneReason::STALE);
+    stream_base_stats.deferred_prunes = flow_con->get_deferred_prunes();
+    stream_base_stats.max_deferred_prunes = flow_con->get_max_deferred_prunes();
+    stream_base_stats.promoted_flows = flow_con->get_promoted_flows();
     stream_base_stats.reload_freelist_flow_deletes = flow_con->get_deletes(FlowDeleteState::FREELIST);
     stream_base_stats.reload_allowed_flow_deletes = flow_con->get_deletes(FlowDeleteState::ALLOWED);
     stream_base_stats.reload_offloaded_flow_deletes= flow_con->get_deletes(FlowDeleteState::OFFLOADED);
@@ -106,6 +115,9 @@ void base_prep()
         stream_base_stats.expected_realized = exp_cache->get_realized();
         stream_base_stats.expected_pruned = exp_cache->get_prunes();
         stream_base_stats.expected_overflows = exp_cache->get_overflows();
+        stream_base_stats.expected_fast_rejects = exp_cache->get_fast_rejects();
+        stream_base_stats.expected_probes = exp_cache->get_probes();
+        stream_base_stats.expected_prebound = exp_cache->get_prebound();
     }
 }
 
@@ -55,10 +55,16 @@ struct BaseStats
      PegCount memcap_prunes;
      PegCount ha_prunes;
      PegCount stale_prunes;
+     PegCount deferred_prunes;
+     PegCount max_deferred_prunes;
+     PegCount promoted_flows;
      PegCount expected_flows;
      PegCount expected_realized;
      PegCount expected_pruned;
      PegCount expected_overflows;
+     PegCount expected_fast_rejects;
+     PegCount expected_probes;
+     PegCount expected_prebound;
      PegCount reload_tuning_idle;
      PegCount reload_tuning_packets;
      PegCount reload_total_adds;
@@ -43,12 +43,67 @@ using namespace snort;
 const PegInfo icmp_pegs[] =
 {
     SESSION_PEGS("icmp"),
+    { CountType::SUM, "pooled", "session objects recycled from the per-thread pool" },
     { CountType::END, nullptr, nullptr }
 };
 
-THREAD_LOCAL IcmpStats icmpStats;
+PEG_SLAB_ALIGN THREAD_LOCAL IcmpStats icmpStats;
 THREAD_LOCAL ProfileStats icmp_perf_stats;
 
+//------------------------------------------------------------------------
+// session object pool
+//
+// ping and error flows are mostly one packet wonders; recycle the
+// session objects through a per thread free list like udp does
+//------------------------------------------------------------------------
+
+#define ICMP_SSN_POOL_MAX 1024
+
+struct SsnPoolNode
+{
+    SsnPoolNode* next;
+};
+
+static THREAD_LOCAL SsnPoolNode* icmp_ssn_pool = nullptr;
+static THREAD_LOCAL unsigned icmp_ssn_pool_count = 0;
+
+void* IcmpSession::operator new(size_t sz)
+{
+    if ( sz == sizeof(IcmpSession) and icmp_ssn_pool )
+    {
+        SsnPoolNode* n = icmp_ssn_pool;
+        icmp_ssn_pool = n->next;
+        --icmp_ssn_pool_count;
+        icmpStats.pooled++;
+        return n;
+    }
+    return ::operator new(sz);
+}
+
+void IcmpSession::operator delete(void* p, size_t sz)
+{
+    if ( sz == sizeof(IcmpSession) and icmp_ssn_pool_count < ICMP_SSN_POOL_MAX )
+    {
+        SsnPoolNode* n = (SsnPoolNode*)p;
+        n->next = icmp_ssn_pool;
+        icmp_ssn_pool = n;
+        ++icmp_ssn_pool_count;
+        return;
+    }
+    ::operator delete(p);
+}
+
+void release_icmp_session_pool()
+{
+    while ( icmp_ssn_pool )
+    {
+        SsnPoolNode* n = icmp_ssn_pool;
+        icmp_ssn_pool = n->next;
+        ::operator delete(n);
+    }
+    icmp_ssn_pool_count = 0;
+}
+
 //------------------------------------------------------------------------
 // private functions
 //------------------------------------------------------------------------
@@ -28,6 +28,10 @@ public:
     IcmpSession(snort::Flow*);
     ~IcmpSession() override;
 
+    // see the udp session pool; icmp flows are just as short lived
+    static void* operator new(size_t);
+    static void operator delete(void*, size_t);
+
     bool setup(snort::Packet*) override;
     int process(snort::Packet*) override;
     void clear() override;
@@ -39,6 +43,7 @@ public:
 
 void icmp_stats();
 void icmp_reset();
+void release_icmp_session_pool();
 
 #endif
 
@@ -114,6 +114,7 @@ static void icmp_tinit()
 static void icmp_tterm()
 {
     IcmpHAManager::tterm();
+    release_icmp_session_pool();
 }
 
 static void icmp_dtor(Inspector* p)
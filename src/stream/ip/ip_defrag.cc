@@ -121,13 +121,27 @@ using namespace snort;
 
 struct Fragment
 {
+    // node and payload share one allocation; the payload is carved from
+    // the space the class specific operator new reserves past the node
+    void* operator new(size_t n, uint16_t flen)
+    { return snort_alloc(n + flen); }
+
+    void operator delete(void* p)
+    { snort_free(p); }
+
+    void operator delete(void* p, uint16_t)
+    { snort_free(p); }
+
     Fragment(uint16_t flen, const uint8_t* fptr, int ord)
     { init(flen, fptr, ord); }
 
+    // duplicates only the retained span [data, data+size); later overlap
+    // trimming on the copy can only move data forward and shrink size, so
+    // the trimmed-off bytes of the original are never needed again
     Fragment(Fragment* other, int ord)
     {
-        init(other->flen, other->fptr, ord);
-        data = fptr + (other->data - other->fptr);
+        init(other->size, other->data, ord);
+        data = fptr;
         size = other->size;
         offset = other->offset;
         last = other->last;
@@ -135,7 +149,6 @@ struct Fragment
 
     ~Fragment()
     {
-        delete[] fptr;
         ip_stats.nodes_released++;
         memory::MemoryCap::update_deallocations(sizeof(*this) + flen);
     }
@@ -160,7 +173,7 @@ private:
         memory::MemoryCap::update_allocations(sizeof(*this) + flen);
 
         this->flen = flen;
-        this->fptr = new uint8_t[flen];
+        this->fptr = reinterpret_cast<uint8_t*>(this) + sizeof(Fragment);
         this->ord = ord;
 
         memcpy(this->fptr, fptr, flen);
@@ -1797,7 +1810,7 @@ int Defrag::new_tracker(Packet* p, FragTracker* ft)
     /* initialize the fragment list */
     ft->fraglist = nullptr;
 
-    f = new Fragment(fragLength, fragStart, ft->ordinal++);
+    f = new (fragLength) Fragment(fragLength, fragStart, ft->ordinal++);
 
     f->size = fragLength;
     f->offset = frag_off;
@@ -1915,22 +1928,22 @@ int Defrag::add_frag_node(
         return FRAG_INSERT_ANOMALY;
     }
 
-    newfrag = new Fragment(fragLength, fragStart, ft->ordinal++);
+    /* only the span that survives left/right trimming is kept; bytes
+     * shaved by slide/trunc are never referenced again so there is no
+     * point allocating or copying them */
+    newfrag = new (newSize) Fragment(newSize, fragStart + slide, ft->ordinal++);
 
-    /*
-     * twiddle the frag values for overlaps
-     */
-    newfrag->data = newfrag->fptr + slide;
+    newfrag->data = newfrag->fptr;
     newfrag->size = newSize;
     newfrag->offset = frag_offset;
     newfrag->last = lastfrag;
 
     debug_logf(stream_ip_trace, nullptr,
         "[+] Adding new frag, offset %d, size %d\n"
-        "   nf->data = nf->fptr(%p) + slide (%d)\n"
+        "   nf->data = nf->fptr(%p)\n"
         "   nf->size = len(%d) - slide(%d) - trunc(%d)\n",
         newfrag->offset, newfrag->size, newfrag->fptr,
-        slide, fragLength, slide, trunc);
+        fragLength, slide, trunc);
 
     /*
      * insert the new frag into the list
@@ -1966,7 +1979,7 @@ int Defrag::add_frag_node(
  */
 int Defrag::dup_frag_node( FragTracker* ft, Fragment* left, Fragment** retFrag)
 {
-    Fragment* newfrag = new Fragment(left, ft->ordinal++);
+    Fragment* newfrag = new (left->size) Fragment(left, ft->ordinal++);
 
     add_node(ft, left, newfrag);
 
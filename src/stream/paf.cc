@@ -28,6 +28,8 @@
 #include "detection/detection_engine.h"
 #include "protocols/packet.h"
 
+#include "stream/tcp/tcp_module.h"
+
 using namespace snort;
 
 //--------------------------------------------------------------------
@@ -131,14 +133,30 @@ static uint32_t paf_flush (PAF_State* ps, const PafAux& px, uint32_t* flags)
 
 static bool paf_callback (
     StreamSplitter* ss, PAF_State* ps, PafAux& px, Packet* pkt,
-    const uint8_t* data, uint32_t len, uint32_t flags)
+    const uint8_t* data, uint32_t len, uint32_t seq, uint32_t flags)
 {
+    if ( len and SEQ_GT(ps->hwm, seq) )
+    {
+        uint32_t over = ps->hwm - seq;
+        tcpStats.paf_rescanned_bytes += ( over > len ) ? len : over;
+    }
+
     ps->fpt = 0;
     ps->paf = ss->scan(pkt, data, len, flags, &ps->fpt);
 
     if ( ps->paf == StreamSplitter::ABORT )
         return false;
 
+    // the splitter stops examining at a flush point set within this
+    // segment; otherwise it has seen everything it was given
+    uint32_t seen = len;
+
+    if ( ps->paf != StreamSplitter::SEARCH and ps->fpt < len )
+        seen = ps->fpt;
+
+    if ( SEQ_GT(seq + seen, ps->hwm) )
+        ps->hwm = seq + seen;
+
     if ( ps->paf != StreamSplitter::SEARCH )
     {
         ps->fpt += px.idx;
@@ -156,13 +174,13 @@ static bool paf_callback (
 
 static inline bool paf_eval (
     StreamSplitter* ss, PAF_State* ps, PafAux& px, Packet* pkt,
-    uint32_t flags, const uint8_t* data, uint32_t len)
+    uint32_t flags, const uint8_t* data, uint32_t len, uint32_t seq)
 {
     switch ( ps->paf )
     {
     case StreamSplitter::SEARCH:
         if ( px.len > px.idx )
-            return paf_callback(ss, ps, px, pkt, data, len, flags);
+            return paf_callback(ss, ps, px, pkt, data, len, seq, flags);
 
         return false;
 
@@ -202,9 +220,10 @@ static inline bool paf_eval (
 
                 data += delta;
                 len -= delta;
+                seq += delta;
             }
             px.idx = ps->fpt;
-            return paf_callback(ss, ps, px, pkt, data, len, flags);
+            return paf_callback(ss, ps, px, pkt, data, len, seq, flags);
         }
         return false;
 
@@ -255,7 +274,7 @@ int32_t paf_check (
 
     if ( !paf_initialized(ps) )
     {
-        ps->seq = ps->pos = seq;
+        ps->seq = ps->pos = ps->hwm = seq;
         ps->fpt = ps->tot = 0;
         ps->paf = StreamSplitter::SEARCH;
     }
@@ -284,6 +303,7 @@ int32_t paf_check (
         uint32_t shift = ps->seq - seq;
         data += shift;
         len -= shift;
+        seq += shift;
     }
 
     ps->seq += len;
@@ -313,7 +333,7 @@ int32_t paf_check (
         px.ft = FT_NOP;
         uint32_t idx = px.idx;
 
-        const bool cont = paf_eval(ss, ps, px, pkt, *flags, data, len);
+        const bool cont = paf_eval(ss, ps, px, pkt, *flags, data, len, seq);
 
         if ( px.ft != FT_NOP )
         {
@@ -332,6 +352,7 @@ int32_t paf_check (
                 shift = len;
             data += shift;
             len -= shift;
+            seq += shift;
         }
     }
     while ( true );
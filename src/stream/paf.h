@@ -47,6 +47,11 @@ struct PAF_State     // per session direction
     uint32_t fpt;    // current flush point
     uint32_t tot;    // total bytes flushed
 
+    // scan resume point: highest seq examined by the splitter so far.
+    // bytes below it handed to scan again (the tail of a segment that
+    // flushed mid way starts the next pdu) are pegged as rescanned.
+    uint32_t hwm;
+
     snort::StreamSplitter::Status paf;  // current scan state
 };
 
@@ -24,9 +24,12 @@
 #include "stream_splitter.h"
 
 #include "detection/detection_engine.h"
+#include "detection/fp_config.h"
 #include "main/snort_config.h"
 #include "protocols/packet.h"
 
+#include "stream/tcp/tcp_module.h"
+
 #include "flush_bucket.h"
 #include "stream.h"
 
@@ -46,6 +49,22 @@ const StreamBuffer StreamSplitter::reassemble(
     if (n == 0)
         return { nullptr, 0 };
 
+    // a pdu contained in a single segment doesn't need to be copied into
+    // the flush buffer when inspection runs synchronously: the segment
+    // outlives the inspection it feeds, so inspectors can read it in
+    // place.  with offload configured, inspection can still be pending
+    // when the caller purges or recycles flushed segments (offloaded and
+    // suspended contexts complete on onload), so those configs keep the
+    // copy.
+    if ( (flags & PKT_PDU_HEAD) and (flags & PKT_PDU_TAIL) and !offset )
+    {
+        const SnortConfig* sc = SnortConfig::get_conf();
+
+        if ( !sc->offload_threads and
+            !sc->fast_pattern_config->get_offload_search_api() )
+            return { p, n };
+    }
+
     unsigned max;
     uint8_t* pdu_buf = DetectionEngine::get_next_buffer(max);
 
@@ -77,6 +96,13 @@ StreamSplitter::Status AtomSplitter::scan(
 
     if ( segs >= 2 && bytes >= min )
     {
+        // track the typical accumulation per flush so update() can size
+        // the next threshold to the service instead of the global base
+        avg = avg ? (uint16_t)((3u * avg + bytes) / 4) : bytes;
+
+        if ( adapted )
+            tcpStats.adaptive_flushes++;
+
         *fp = len;
         return FLUSH;
     }
@@ -91,7 +117,11 @@ void AtomSplitter::reset()
 void AtomSplitter::update()
 {
     reset();
-    min = base + get_flush_bucket_size();
+
+    // random jitter is kept on top of the learned size so flush points
+    // stay unpredictable
+    adapted = avg > base;
+    min = (adapted ? avg : base) + get_flush_bucket_size();
 }
 
 //--------------------------------------------------------------------------
@@ -116,6 +116,8 @@ private:
     uint16_t min;
     uint16_t segs;
     uint16_t bytes;
+    uint16_t avg = 0;       // running estimate of this flow's flush size
+    bool adapted = false;   // current min came from the estimate
 };
 
 //-------------------------------------------------------------------------
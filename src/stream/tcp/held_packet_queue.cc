@@ -54,16 +54,39 @@ HeldPacketQueue::iter_t HeldPacketQueue::append(DAQ_Msg_h msg, uint32_t seq,
     timeradd(&now, &timeout, &expiration);
 
     q.emplace_back(msg, seq, expiration, trk);
+
+    if ( q.size() == 1 )
+        cache_head();
+
     return --q.end();
 }
 
 void HeldPacketQueue::erase(iter_t it)
 {
+    bool was_head = ( it == q.begin() );
     q.erase(it);
+
+    if ( was_head )
+        cache_head();
+}
+
+void HeldPacketQueue::cache_head()
+{
+    if ( q.empty() )
+        head_expiration = { 0, 0 };
+    else
+        head_expiration = q.front().get_expiration();
 }
 
 bool HeldPacketQueue::execute(const timeval& cur_time, int max_remove)
 {
+    // common case - nothing expired; decided from the cached expiration
+    // so the list nodes are never pulled into cache
+    if ( q.empty() || timercmp(&cur_time, &head_expiration, <) )
+        return false;
+
+    PegCount removed = 0;
+
     while ( !q.empty() && (max_remove < 0 || max_remove--) )
     {
         auto held_packet = q.begin();
@@ -72,11 +95,16 @@ bool HeldPacketQueue::execute(const timeval& cur_time, int max_remove)
             assert(held_packet == held_packet->get_tracker().held_packet);
             held_packet->get_tracker().perform_partial_flush();
             tcpStats.held_packet_timeouts++;
+            removed++;
         }
         else
             break;
     }
 
+    if ( removed > tcpStats.max_held_packet_expirys )
+        tcpStats.max_held_packet_expirys = removed;
+
+    cache_head();
     return !q.empty() && q.front().has_expired(cur_time);
 }
 
@@ -109,5 +137,6 @@ bool HeldPacketQueue::adjust_expiration(uint32_t new_timeout, const timeval& now
     for ( auto& hp : q )
         hp.adjust_expiration(delta, up);
 
+    cache_head();
     return q.front().has_expired(now);
 }
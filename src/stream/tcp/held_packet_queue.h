@@ -46,6 +46,7 @@ public:
     TcpStreamTracker& get_tracker() const { return tracker; }
     DAQ_Msg_h get_daq_msg() const { return daq_msg; }
     uint32_t get_seq_num() const { return seq_num; }
+    const timeval& get_expiration() const { return expiration; }
     void adjust_expiration(const timeval& delta, bool up);
 
 private:
@@ -63,6 +64,10 @@ public:
     using list_t = std::list<HeldPacket>;
     using iter_t = list_t::iterator;
 
+    // the timeout is uniform and entries are appended at the tail, so the
+    // queue is always ordered by expiration and the head expiration can be
+    // cached; execute() then decides nothing has expired without touching
+    // any list node
     iter_t append(DAQ_Msg_h msg, uint32_t seq, TcpStreamTracker& trk);
     void erase(iter_t it);
 
@@ -86,7 +91,10 @@ public:
     bool adjust_expiration(uint32_t new_timeout_ms, const timeval& now);
 
 private:
+    void cache_head();
+
     timeval timeout = {1, 0};
+    timeval head_expiration = {0, 0};
     list_t q;
 };
 
@@ -53,6 +53,9 @@ const PegInfo tcp_pegs[] =
     { CountType::SUM, "data_trackers", "tcp session tracking started on data" },
     { CountType::SUM, "segs_queued", "total segments queued" },
     { CountType::SUM, "segs_released", "total segments released" },
+    { CountType::SUM, "segs_pooled", "segment nodes recycled from the per-thread pools" },
+    { CountType::SUM, "segs_alloced", "segment nodes allocated from the heap" },
+    { CountType::SUM, "adaptive_flushes", "flushes at a threshold learned from the flow" },
     { CountType::SUM, "segs_split", "tcp segments split when reassembling PDUs" },
     { CountType::SUM, "segs_used", "queued tcp segments applied to reassembled PDUs" },
     { CountType::SUM, "rebuilt_packets", "total reassembled PDUs" },
@@ -86,14 +89,17 @@ const PegInfo tcp_pegs[] =
     { CountType::SUM, "held_packet_purges", "number of held packets that were purged without flushing" },
     { CountType::NOW, "cur_packets_held", "number of packets currently held" },
     { CountType::MAX, "max_packets_held", "maximum number of packets held simultaneously" },
+    { CountType::MAX, "max_held_packet_expirys", "maximum held packets expired by one sweep" },
     { CountType::SUM, "partial_flushes", "number of partial flushes initiated" },
     { CountType::SUM, "partial_flush_bytes", "partial flush total bytes" },
     { CountType::SUM, "inspector_fallbacks", "count of fallbacks from assigned service inspector" },
     { CountType::SUM, "partial_fallbacks", "count of fallbacks from assigned service stream splitter" },
+    { CountType::SUM, "paf_rescanned_bytes",
+        "stream bytes handed to a splitter scan more than once" },
     { CountType::END, nullptr, nullptr }
 };
 
-THREAD_LOCAL TcpStats tcpStats;
+PEG_SLAB_ALIGN THREAD_LOCAL TcpStats tcpStats;
 
 #define STREAM_TCP_SYN_ON_EST_STR \
     "SYN on established session"
@@ -71,6 +71,9 @@ struct TcpStats
     PegCount sessions_on_data;
     PegCount segs_queued;
     PegCount segs_released;
+    PegCount segs_pooled;
+    PegCount segs_alloced;
+    PegCount adaptive_flushes;
     PegCount segs_split;
     PegCount segs_used;
     PegCount rebuilt_packets;
@@ -100,10 +103,12 @@ struct TcpStats
     PegCount held_packet_purges;
     PegCount current_packets_held;
     PegCount max_packets_held;
+    PegCount max_held_packet_expirys;
     PegCount partial_flushes;
     PegCount partial_flush_bytes;
     PegCount inspector_fallbacks;
     PegCount partial_fallbacks;
+    PegCount paf_rescanned_bytes;
 };
 
 extern THREAD_LOCAL struct TcpStats tcpStats;
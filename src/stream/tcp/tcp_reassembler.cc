@@ -1213,6 +1213,14 @@ void TcpReassembler::init_overlap_editor(
     TcpSegmentNode* left = nullptr, *right = nullptr, *tsn = nullptr;
     int32_t dist_head = 0, dist_tail = 0;
 
+    // on long lists the seglist keeps a sparse ordered index so badly
+    // out of order flows don't degrade to a full walk per insert
+    if ( TcpSegmentNode* hint = trs.sos.seglist.find_node_before(tsd.get_seq()) )
+    {
+        trs.sos.init_soe(tsd, hint, hint->next);
+        return;
+    }
+
     if ( trs.sos.seglist.head && trs.sos.seglist.tail )
     {
         if ( SEQ_GT(tsd.get_seq(), trs.sos.seglist.head->i_seq) )
@@ -40,6 +40,15 @@ static THREAD_LOCAL unsigned reserve_sz = 0;
 static constexpr unsigned num_res = 4096;
 static constexpr unsigned res_min = 1024;
 static constexpr unsigned res_max = 1460;
+
+// interactive traffic queues lots of tiny segments; they get their own
+// pool of fixed capacity nodes so a 1 byte telnet keystroke does not
+// take the allocator path on every queue/release
+static THREAD_LOCAL TcpSegmentNode* reserved_small = nullptr;
+static THREAD_LOCAL unsigned reserve_small_sz = 0;
+
+static constexpr unsigned num_res_small = 4096;
+static constexpr unsigned res_small_max = 128;
 #endif
 
 void TcpSegmentNode::setup()
@@ -47,6 +56,8 @@ void TcpSegmentNode::setup()
 #ifdef USE_RESERVE
     reserved = nullptr;
     reserve_sz = 0;
+    reserved_small = nullptr;
+    reserve_small_sz = 0;
 #endif
 }
 
@@ -62,6 +73,16 @@ void TcpSegmentNode::clear()
         snort_free(tsn);
     }
     reserve_sz = 0;
+
+    while ( reserved_small )
+    {
+        TcpSegmentNode* tsn = reserved_small;
+        reserved_small = reserved_small->next;
+        memory::MemoryCap::update_deallocations(sizeof(*tsn) + tsn->size);
+        tcpStats.mem_in_use -= tsn->size;
+        snort_free(tsn);
+    }
+    reserve_small_sz = 0;
 #endif
 }
 
@@ -80,6 +101,24 @@ TcpSegmentNode* TcpSegmentNode::create(
         tsn = reserved;
         reserved = tsn->next;
         --reserve_sz;
+        tcpStats.segs_pooled++;
+    }
+    else if ( reserved_small and len <= res_small_max )
+    {
+        tsn = reserved_small;
+        reserved_small = tsn->next;
+        --reserve_small_sz;
+        tcpStats.segs_pooled++;
+    }
+    else if ( len <= res_small_max )
+    {
+        // allocate at pool capacity so the node is recyclable on release
+        size_t size = sizeof(*tsn) + res_small_max;
+        memory::MemoryCap::update_allocations(size);
+        tsn = (TcpSegmentNode*)snort_alloc(size);
+        tsn->size = res_small_max;
+        tcpStats.mem_in_use += res_small_max;
+        tcpStats.segs_alloced++;
     }
     else
 #endif
@@ -89,6 +128,7 @@ TcpSegmentNode* TcpSegmentNode::create(
         tsn = (TcpSegmentNode*)snort_alloc(size);
         tsn->size = len;
         tcpStats.mem_in_use += len;
+        tcpStats.segs_alloced++;
     }
     tsn->tv = tv;
     tsn->i_len = tsn->c_len = len;
@@ -121,6 +161,12 @@ void TcpSegmentNode::term()
         reserved = this;
         reserve_sz++;
     }
+    else if ( size == res_small_max and reserve_small_sz < num_res_small )
+    {
+        next = reserved_small;
+        reserved_small = this;
+        reserve_small_sz++;
+    }
     else
 #endif
     {
@@ -22,6 +22,8 @@
 #ifndef TCP_SEGMENT_H
 #define TCP_SEGMENT_H
 
+#include <vector>
+
 #include "tcp_segment_descriptor.h"
 #include "tcp_defs.h"
 
@@ -93,9 +95,48 @@ public:
 
         head = tail = cur_rseg = cur_pseg = nullptr;
         count = 0;
+        index.clear();
+        index_valid = false;
+        index_skew = 0;
         return i;
     }
 
+    // returns the last node with i_seq before seq or null if the caller
+    // should walk from the ends; only engages on long lists so in order
+    // traffic never pays for the index
+    TcpSegmentNode* find_node_before(uint32_t seq)
+    {
+        if ( count < index_min )
+            return nullptr;
+
+        if ( !index_valid or index_skew >= rebuild_skew )
+            rebuild_index();
+
+        if ( index.empty() or !SEQ_LT(index.front()->i_seq, seq) )
+            return nullptr;
+
+        // binary search for the last anchor before seq
+        uint32_t lo = 0, hi = index.size();
+
+        while ( hi - lo > 1 )
+        {
+            uint32_t mid = (lo + hi) / 2;
+
+            if ( SEQ_LT(index[mid]->i_seq, seq) )
+                lo = mid;
+            else
+                hi = mid;
+        }
+        TcpSegmentNode* tsn = index[lo];
+
+        // the index is sparse and trails recent inserts, so finish with
+        // a short walk to the true predecessor
+        while ( tsn->next and SEQ_LT(tsn->next->i_seq, seq) )
+            tsn = tsn->next;
+
+        return tsn;
+    }
+
     void insert(TcpSegmentNode* prev, TcpSegmentNode* ss)
     {
         if ( prev )
@@ -121,6 +162,7 @@ public:
         }
 
         count++;
+        index_skew++;
     }
 
     void remove(TcpSegmentNode* ss)
@@ -136,6 +178,10 @@ public:
             tail = ss->prev;
 
         count--;
+
+        // removal can dangle an anchor so the index must be rebuilt
+        // before it is searched again
+        index_valid = false;
     }
 
     TcpSegmentNode* head = nullptr;
@@ -143,6 +189,28 @@ public:
     TcpSegmentNode* cur_rseg = nullptr;
     TcpSegmentNode* cur_pseg = nullptr;
     uint32_t count = 0;
+
+private:
+    void rebuild_index()
+    {
+        index.clear();
+        unsigned i = 0;
+
+        for ( TcpSegmentNode* tsn = head; tsn; tsn = tsn->next )
+            if ( !(i++ & (index_stride - 1)) )
+                index.emplace_back(tsn);
+
+        index_valid = true;
+        index_skew = 0;
+    }
+
+    static constexpr uint32_t index_min = 64;     // list length to engage index
+    static constexpr uint32_t index_stride = 8;   // nodes per anchor, power of 2
+    static constexpr uint32_t rebuild_skew = 32;  // inserts tolerated before rebuild
+
+    std::vector<TcpSegmentNode*> index;
+    uint32_t index_skew = 0;
+    bool index_valid = false;
 };
 
 #endif
@@ -25,6 +25,8 @@
 
 #include "tcp_state_established.h"
 
+#include <cassert>
+
 #include "tcp_normalizers.h"
 #include "tcp_session.h"
 
@@ -33,6 +35,57 @@ TcpStateEstablished::TcpStateEstablished(TcpStateMachine& tsm) :
 {
 }
 
+// dispatch for this state is merged here so the per event handlers are
+// called directly and can be inlined; cold states keep the generic
+// virtual dispatch in TcpStateHandler
+bool TcpStateEstablished::eval(TcpSegmentDescriptor& tsd, TcpStreamTracker& trk)
+{
+    switch ( trk.get_tcp_event() )
+    {
+    case TcpStreamTracker::TCP_SYN_SENT_EVENT:
+        return syn_sent(tsd, trk);
+
+    case TcpStreamTracker::TCP_SYN_RECV_EVENT:
+        return syn_recv(tsd, trk);
+
+    case TcpStreamTracker::TCP_SYN_ACK_SENT_EVENT:
+        return syn_ack_sent(tsd, trk);
+
+    case TcpStreamTracker::TCP_SYN_ACK_RECV_EVENT:
+        return true;
+
+    case TcpStreamTracker::TCP_ACK_SENT_EVENT:
+        return ack_sent(tsd, trk);
+
+    case TcpStreamTracker::TCP_ACK_RECV_EVENT:
+        return ack_recv(tsd, trk);
+
+    case TcpStreamTracker::TCP_DATA_SEG_SENT_EVENT:
+        return data_seg_sent(tsd, trk);
+
+    case TcpStreamTracker::TCP_DATA_SEG_RECV_EVENT:
+        return data_seg_recv(tsd, trk);
+
+    case TcpStreamTracker::TCP_FIN_SENT_EVENT:
+        return fin_sent(tsd, trk);
+
+    case TcpStreamTracker::TCP_FIN_RECV_EVENT:
+        return fin_recv(tsd, trk);
+
+    case TcpStreamTracker::TCP_RST_SENT_EVENT:
+        return true;
+
+    case TcpStreamTracker::TCP_RST_RECV_EVENT:
+        return rst_recv(tsd, trk);
+
+    default:
+        break;
+    }
+
+    assert(false);
+    return false;
+}
+
 bool TcpStateEstablished::syn_sent(TcpSegmentDescriptor& tsd, TcpStreamTracker& trk)
 {
     trk.session->check_for_repeated_syn(tsd);
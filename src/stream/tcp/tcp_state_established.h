@@ -24,11 +24,15 @@
 
 #include "tcp_state_handler.h"
 
-class TcpStateEstablished : public TcpStateHandler
+// final so the merged event dispatch in the cc file devirtualizes; this
+// is the hottest state and skips the generic two-step handler dispatch
+class TcpStateEstablished final : public TcpStateHandler
 {
 public:
     TcpStateEstablished(TcpStateMachine&);
 
+    bool eval(TcpSegmentDescriptor&, TcpStreamTracker&) override;
+
     bool syn_sent(TcpSegmentDescriptor&, TcpStreamTracker&) override;
     bool syn_recv(TcpSegmentDescriptor&, TcpStreamTracker&) override;
     bool syn_ack_sent(TcpSegmentDescriptor&, TcpStreamTracker&) override;
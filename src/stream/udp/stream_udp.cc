@@ -109,6 +109,7 @@ static void udp_tinit()
 static void udp_tterm()
 {
     UdpHAManager::tterm();
+    release_udp_session_pool();
 }
 
 static Inspector* udp_ctor(Module* m)
@@ -44,12 +44,68 @@ const PegInfo udp_pegs[] =
     SESSION_PEGS("udp"),
     { CountType::SUM, "total_bytes", "total number of bytes processed" },
     { CountType::SUM, "ignored", "udp packets ignored" },
+    { CountType::SUM, "pooled", "session objects recycled from the per-thread pool" },
     { CountType::END, nullptr, nullptr }
 };
 
-THREAD_LOCAL UdpStats udpStats;
+PEG_SLAB_ALIGN THREAD_LOCAL UdpStats udpStats;
 THREAD_LOCAL ProfileStats udp_perf_stats;
 
+//-------------------------------------------------------------------------
+// session object pool
+//
+// most udp flows are single query conversations that tear down almost
+// immediately, so the session object is recycled through a per thread
+// free list rather than going back to the heap each time
+//-------------------------------------------------------------------------
+
+#define UDP_SSN_POOL_MAX 4096
+
+struct SsnPoolNode
+{
+    SsnPoolNode* next;
+};
+
+static THREAD_LOCAL SsnPoolNode* udp_ssn_pool = nullptr;
+static THREAD_LOCAL unsigned udp_ssn_pool_count = 0;
+
+void* UdpSession::operator new(size_t sz)
+{
+    if ( sz == sizeof(UdpSession) and udp_ssn_pool )
+    {
+        SsnPoolNode* n = udp_ssn_pool;
+        udp_ssn_pool = n->next;
+        --udp_ssn_pool_count;
+        udpStats.pooled++;
+        return n;
+    }
+    return ::operator new(sz);
+}
+
+void UdpSession::operator delete(void* p, size_t sz)
+{
+    if ( sz == sizeof(UdpSession) and udp_ssn_pool_count < UDP_SSN_POOL_MAX )
+    {
+        SsnPoolNode* n = (SsnPoolNode*)p;
+        n->next = udp_ssn_pool;
+        udp_ssn_pool = n;
+        ++udp_ssn_pool_count;
+        return;
+    }
+    ::operator delete(p);
+}
+
+void release_udp_session_pool()
+{
+    while ( udp_ssn_pool )
+    {
+        SsnPoolNode* n = udp_ssn_pool;
+        udp_ssn_pool = n->next;
+        ::operator delete(n);
+    }
+    udp_ssn_pool_count = 0;
+}
+
 //-------------------------------------------------------------------------
 
 static void UdpSessionCleanup(Flow* lwssn)
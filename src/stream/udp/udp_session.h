@@ -30,6 +30,11 @@ public:
     UdpSession(snort::Flow*);
     ~UdpSession() override;
 
+    // one shot flows (dns) churn sessions at packet rate, so instances
+    // are recycled through a per thread free list instead of the heap
+    static void* operator new(size_t);
+    static void operator delete(void*, size_t);
+
     bool setup(snort::Packet*) override;
     void update_direction(char dir, const snort::SfIp*, uint16_t port) override;
     int process(snort::Packet*) override;
@@ -41,6 +46,7 @@ public:
 
 void udp_stats();
 void udp_reset();
+void release_udp_session_pool();
 
 #endif
 
@@ -25,6 +25,15 @@
 
 #include "host_attributes.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
 #include "log/messages.h"
 #include "main/shell.h"
 #include "main/snort_config.h"
@@ -42,7 +51,7 @@ void HostAttributesTable::free_host_entry(void* host)
 { delete (HostAttributeEntry*)host; }
 
 HostAttributesTable::HostAttributesTable(uint32_t max_hosts)
-    : max_hosts(max_hosts)
+    : host_filter(FILTER_BITS / 64, 0), max_hosts(max_hosts)
 {
     // Add 1 to max for table purposes
     // We use max_hosts to limit memcap, assume 16k per entry costs
@@ -50,6 +59,16 @@ HostAttributesTable::HostAttributesTable(uint32_t max_hosts)
     host_table = sfrt_new(DIR_8x16, IPv6, max_hosts + 1, (max_hosts >> 6) + 1);
 }
 
+uint32_t HostAttributesTable::filter_hash(const SfIp* ipAddr)
+{
+    const uint32_t* w = ipAddr->get_ip6_ptr();
+    uint32_t h = w[0] ^ w[1] ^ w[2] ^ w[3];
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    return h & (FILTER_BITS - 1);
+}
+
 HostAttributesTable::~HostAttributesTable()
 {
     sfrt_cleanup(host_table, HostAttributesTable::free_host_entry);
@@ -64,6 +83,13 @@ bool HostAttributesTable::add_host(HostAttributeEntry* host)
 
     if ( ret == RT_SUCCESS )
     {
+        if ( ipAddr->get_bits() != 128 )
+            filter_exact = false;
+        else
+        {
+            uint32_t b = filter_hash(ipAddr->get_addr());
+            host_filter[b >> 6] |= (uint64_t)1 << (b & 63);
+        }
         ++num_hosts;
         return true;
     }
@@ -108,7 +134,23 @@ HostAttributeEntry* HostAttributesTable::get_host(SfIp* ipAddr)
 }
 
 HostAttributeEntry* HostAttributesTable::find_host(const SfIp* ipAddr)
-{ return (HostAttributeEntry*)sfrt_lookup(ipAddr, host_table); }
+{
+    if ( !num_hosts )
+        return nullptr;
+
+    if ( filter_exact )
+    {
+        uint32_t b = filter_hash(ipAddr);
+
+        if ( !(host_filter[b >> 6] & ((uint64_t)1 << (b & 63))) )
+            return nullptr;
+    }
+
+    return (HostAttributeEntry*)sfrt_lookup(ipAddr, host_table);
+}
+
+void HostAttributesTable::for_all_hosts(sfrt_iterator_callback_arg cb, void* arg)
+{ sfrt_iterate(host_table, cb, arg); }
 
 HostAttributeEntry::~HostAttributeEntry()
 {
@@ -154,9 +196,250 @@ SnortProtocolId HostAttributeEntry::get_snort_protocol_id(int ipprotocol, uint16
     return 0;
 }
 
+//-------------------------------------------------------------------------
+// binary snapshot
+//
+// parsing a large hosts table from Lua can take minutes and must be
+// repeated by every process using the table.  the first successful parse
+// compiles the table to <hosts_file>.hab; later loads map that file read
+// only and rebuild the table from it, skipping the Lua interpreter
+// entirely.  protocol ids are config dependent, so services are stored
+// by name and re-resolved against proto_ref on load.
+//-------------------------------------------------------------------------
+
+static const char snapshot_suffix[] = ".hab";
+static const char snapshot_magic[4] = { 'S', 'N', 'H', 'A' };
+static const uint32_t snapshot_version = 1;
+
+struct SnapshotWriter
+{
+    FILE* fh;
+    ProtocolReference* proto_ref;
+    bool ok;
+};
+
+static bool write_bytes(SnapshotWriter* sw, const void* data, size_t len)
+{
+    if ( sw->ok and fwrite(data, 1, len, sw->fh) != len )
+        sw->ok = false;
+
+    return sw->ok;
+}
+
+static void write_string(SnapshotWriter* sw, const char* s)
+{
+    uint16_t len = (uint16_t)strlen(s);
+    write_bytes(sw, &len, sizeof(len));
+    write_bytes(sw, s, len);
+}
+
+static void snapshot_host(void* pv, void* arg)
+{
+    SnapshotWriter* sw = (SnapshotWriter*)arg;
+    const HostAttributeEntry* host = (const HostAttributeEntry*)pv;
+
+    const SfIp* ip = host->ipAddr.get_addr();
+    uint16_t family = ip->get_family();
+    uint8_t addr[16];
+    memset(addr, 0, sizeof(addr));
+
+    if ( family == AF_INET )
+        memcpy(addr, ip->get_ip4_ptr(), 4);
+    else
+        memcpy(addr, ip->get_ip6_ptr(), 16);
+
+    uint8_t bits = (uint8_t)host->ipAddr.get_bits();
+    uint16_t num_services = (uint16_t)host->services.size();
+
+    write_bytes(sw, &family, sizeof(family));
+    write_bytes(sw, addr, sizeof(addr));
+    write_bytes(sw, &bits, sizeof(bits));
+    write_bytes(sw, &host->hostInfo.streamPolicy, sizeof(uint8_t));
+    write_bytes(sw, &host->hostInfo.fragPolicy, sizeof(uint8_t));
+    write_bytes(sw, &num_services, sizeof(num_services));
+
+    for ( auto app : host->services )
+    {
+        write_bytes(sw, &app->port, sizeof(app->port));
+        write_string(sw, sw->proto_ref->get_name(app->ipproto));
+        write_string(sw, sw->proto_ref->get_name(app->snort_protocol_id));
+    }
+}
+
+static void save_snapshot(SnortConfig* sc, const char* path)
+{
+    std::string tmp = std::string(path) + ".tmp";
+    FILE* fh = fopen(tmp.c_str(), "wb");
+
+    if ( !fh )
+    {
+        WarningMessage("hosts: can't write attribute table snapshot %s\n", path);
+        return;
+    }
+
+    SnapshotWriter sw = { fh, sc->proto_ref, true };
+    uint32_t num_hosts = next_cfg->get_num_hosts();
+
+    write_bytes(&sw, snapshot_magic, sizeof(snapshot_magic));
+    write_bytes(&sw, &snapshot_version, sizeof(snapshot_version));
+    write_bytes(&sw, &num_hosts, sizeof(num_hosts));
+
+    next_cfg->for_all_hosts(snapshot_host, &sw);
+
+    bool ok = ( fclose(fh) == 0 ) and sw.ok and ( rename(tmp.c_str(), path) == 0 );
+
+    if ( !ok )
+    {
+        unlink(tmp.c_str());
+        WarningMessage("hosts: can't write attribute table snapshot %s\n", path);
+    }
+}
+
+struct SnapshotReader
+{
+    const uint8_t* pos;
+    const uint8_t* end;
+};
+
+static bool read_bytes(SnapshotReader* sr, void* data, size_t len)
+{
+    if ( (size_t)(sr->end - sr->pos) < len )
+        return false;
+
+    memcpy(data, sr->pos, len);
+    sr->pos += len;
+    return true;
+}
+
+static bool read_string(SnapshotReader* sr, std::string& s)
+{
+    uint16_t len;
+
+    if ( !read_bytes(sr, &len, sizeof(len)) or (size_t)(sr->end - sr->pos) < len )
+        return false;
+
+    s.assign((const char*)sr->pos, len);
+    sr->pos += len;
+    return true;
+}
+
+static bool load_snapshot_hosts(SnortConfig* sc, SnapshotReader* sr)
+{
+    uint32_t num_hosts;
+
+    if ( !read_bytes(sr, &num_hosts, sizeof(num_hosts)) )
+        return false;
+
+    for ( uint32_t i = 0; i < num_hosts; i++ )
+    {
+        uint16_t family, num_services;
+        uint8_t addr[16], bits, stream, frag;
+
+        if ( !read_bytes(sr, &family, sizeof(family)) or
+            !read_bytes(sr, addr, sizeof(addr)) or
+            !read_bytes(sr, &bits, sizeof(bits)) or
+            !read_bytes(sr, &stream, sizeof(stream)) or
+            !read_bytes(sr, &frag, sizeof(frag)) or
+            !read_bytes(sr, &num_services, sizeof(num_services)) )
+            return false;
+
+        HostAttributeEntry* host = new HostAttributeEntry;
+
+        SfIp ip;
+        if ( ip.set(addr, family) != SFIP_SUCCESS )
+        {
+            delete host;
+            return false;
+        }
+        host->ipAddr.set(ip);
+        host->ipAddr.set_bits(bits);
+        host->hostInfo.streamPolicy = stream;
+        host->hostInfo.fragPolicy = frag;
+
+        bool ok = true;
+        for ( uint16_t j = 0; ok and j < num_services; j++ )
+        {
+            uint16_t port;
+            std::string proto, name;
+
+            ok = read_bytes(sr, &port, sizeof(port)) and
+                read_string(sr, proto) and read_string(sr, name);
+
+            if ( ok )
+                host->add_service(new ApplicationEntry(port,
+                    sc->proto_ref->add(proto.c_str()), sc->proto_ref->add(name.c_str())));
+        }
+
+        if ( !ok )
+        {
+            delete host;
+            return false;
+        }
+
+        if ( !HostAttributes::add_host(host, sc) )
+            delete host;
+    }
+
+    return sr->pos == sr->end;
+}
+
+// true if the table was populated from a snapshot at least as new as the
+// hosts file
+static bool load_snapshot(SnortConfig* sc, const char* path, const char* hosts_file)
+{
+    struct stat snap_st, hosts_st;
+
+    if ( stat(path, &snap_st) or stat(hosts_file, &hosts_st) or
+        snap_st.st_mtime < hosts_st.st_mtime )
+        return false;
+
+    int fd = open(path, O_RDONLY);
+
+    if ( fd < 0 )
+        return false;
+
+    size_t size = (size_t)snap_st.st_size;
+    void* base = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if ( base == MAP_FAILED )
+        return false;
+
+    SnapshotReader sr = { (const uint8_t*)base, (const uint8_t*)base + size };
+
+    char magic[4];
+    uint32_t version = 0;
+    bool ok = read_bytes(&sr, magic, sizeof(magic)) and
+        !memcmp(magic, snapshot_magic, sizeof(magic)) and
+        read_bytes(&sr, &version, sizeof(version)) and version == snapshot_version;
+
+    if ( ok )
+        ok = load_snapshot_hosts(sc, &sr);
+
+    munmap(base, size);
+
+    if ( !ok )
+    {
+        WarningMessage("hosts: ignoring corrupt attribute table snapshot %s\n", path);
+        delete next_cfg;
+        next_cfg = nullptr;
+    }
+    else if ( !next_cfg )
+        next_cfg = new HostAttributesTable(sc->max_attribute_hosts);
+
+    return ok;
+}
+
 void HostAttributes::load_hosts_file(SnortConfig* sc, const char* fname)
 {
     delete next_cfg;
+    next_cfg = nullptr;
+
+    std::string snapshot = std::string(fname) + snapshot_suffix;
+
+    if ( load_snapshot(sc, snapshot.c_str(), fname) )
+        return;
+
     next_cfg = new HostAttributesTable(sc->max_attribute_hosts);
 
     Shell sh(fname);
@@ -165,7 +448,10 @@ void HostAttributes::load_hosts_file(SnortConfig* sc, const char* fname)
     {
         delete next_cfg;
         next_cfg = nullptr;
+        return;
     }
+
+    save_snapshot(sc, snapshot.c_str());
 }
 
 HostAttributesTable* HostAttributes::activate()
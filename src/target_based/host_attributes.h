@@ -82,6 +82,7 @@ struct HostAttributesTable
     HostAttributeEntry* get_host(snort::SfIp*);
     HostAttributeEntry* find_host(const snort::SfIp*);
     void add_service(HostAttributeEntry*, ApplicationEntry*);
+    void for_all_hosts(sfrt_iterator_callback_arg, void* arg);
 
     bool is_host_attribute_table_full()
     { return num_hosts >= max_hosts; }
@@ -90,9 +91,19 @@ struct HostAttributesTable
     { return num_hosts; }
 
 private:
+    // presence filter: one bit per hashed host address, armed while all
+    // entries are exact hosts (the usual table shape).  a clear bit means
+    // no entry, so the common miss costs a couple of loads instead of a
+    // trie walk.  any cidr entry disarms it.
+    static const uint32_t FILTER_BITS = 1 << 16;
+
+    static uint32_t filter_hash(const snort::SfIp*);
+
     table_t* host_table;
+    std::vector<uint64_t> host_filter;
     uint32_t max_hosts;
     uint32_t num_hosts = 0;
+    bool filter_exact = true;
 
     bool sfat_grammar_error_printed = false;
     bool sfat_insufficient_space_logged = false;
@@ -22,9 +22,9 @@
 #ifndef SNORT_PROTOCOLS_H
 #define SNORT_PROTOCOLS_H
 
+#include <map>
 #include <string>
 #include <vector>
-#include <unordered_map>
 
 #include "main/snort_types.h"
 
@@ -83,7 +83,11 @@ public:
 private:
     std::vector<std::string> id_map;
     std::vector<SnortProtocolId> ind_map;
-    std::unordered_map<std::string, SnortProtocolId> ref_table;
+
+    // transparent comparator so find() can probe with the raw service
+    // name from the flow; the hashed alternative builds a std::string
+    // key per lookup, which shows up on every service resolution
+    std::map<std::string, SnortProtocolId, std::less<>> ref_table;
 
     SnortProtocolId protocol_number = 0;
 
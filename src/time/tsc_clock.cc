@@ -34,11 +34,27 @@ long clock_scale()
 
     if ( !tpus )
     {
+        // measure the actual elapsed time instead of assuming nanosleep
+        // slept exactly one second; early wakeups and scheduling delay
+        // otherwise skew the tick rate and thus all latency budgets
         struct timespec one_sec = { 1, 0 };
+        struct timespec t0, t1;
+
+        clock_gettime(CLOCK_MONOTONIC, &t0);
         uint64_t start = TscClock::counter();
         nanosleep(&one_sec, nullptr);
         uint64_t end = TscClock::counter();
-        tpus = (long)((end - start)/1e6);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+
+        int64_t ns = (t1.tv_sec - t0.tv_sec) * 1000000000LL + (t1.tv_nsec - t0.tv_nsec);
+
+        if ( ns < 1000000 )
+            ns = 1000000000;
+
+        tpus = (long)(((end - start) * 1000) / ns);
+
+        if ( tpus < 1 )
+            tpus = 1;
     }
     return tpus;
 #endif
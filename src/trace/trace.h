@@ -81,6 +81,15 @@ public:
         return option_levels[trace_option_id] >= log_level;
     }
 
+    bool has_enabled_options() const
+    {
+        for ( auto level : option_levels )
+            if ( level )
+                return true;
+
+        return false;
+    }
+
 private:
     std::string mod_name;
     const TraceOption* options;
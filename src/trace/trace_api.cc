@@ -33,6 +33,8 @@
 
 using namespace snort;
 
+THREAD_LOCAL bool snort::g_trace_active = false;
+
 static THREAD_LOCAL TraceLogger* g_trace_logger = nullptr;
 static THREAD_LOCAL PacketConstraints* g_packet_constraints = nullptr;
 static THREAD_LOCAL uint8_t g_constraints_generation = 0;
@@ -58,10 +60,12 @@ void TraceApi::thread_init(const TraceConfig* trace_config)
 
     update_constraints(trace_config->constraints);
     trace_config->setup_module_trace();
+    g_trace_active = trace_config->any_trace_enabled();
 }
 
 void TraceApi::thread_term()
 {
+    g_trace_active = false;
     g_packet_constraints = nullptr;
 
     delete g_trace_logger;
@@ -72,6 +76,7 @@ void TraceApi::thread_reinit(const TraceConfig* trace_config)
 {
     update_constraints(trace_config->constraints);
     trace_config->setup_module_trace();
+    g_trace_active = trace_config->any_trace_enabled();
 }
 
 void TraceApi::log(const char* log_msg, const char* name,
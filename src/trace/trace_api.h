@@ -23,6 +23,7 @@
 #include <cstdint>
 
 #include "main/snort_types.h"
+#include "main/thread.h"
 
 class TraceConfig;
 
@@ -42,6 +43,11 @@ public:
     static void filter(const Packet& p);
     static uint8_t get_constraints_generation();
 };
+
+// master switch; false unless the config enables at least one trace
+// option, so disabled trace sites cost a single predictable test and
+// never evaluate their arguments
+SO_PUBLIC extern THREAD_LOCAL bool g_trace_active;
 }
 
 #endif // TRACE_API_H
@@ -71,6 +71,16 @@ bool TraceConfig::set_trace(const std::string& module_name, const std::string& t
     return false;
 }
 
+bool TraceConfig::any_trace_enabled() const
+{
+    for ( const auto& trace : traces )
+    {
+        if ( trace.has_enabled_options() )
+            return true;
+    }
+    return false;
+}
+
 void TraceConfig::clear_traces()
 {
     for ( auto& trace : traces )
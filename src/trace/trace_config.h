@@ -39,6 +39,8 @@ public:
     bool set_trace(const std::string& module_name,
         const std::string& trace_option_name, uint8_t trace_level);
 
+    bool any_trace_enabled() const;
+
     void clear_traces();
 
 public:
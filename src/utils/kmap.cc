@@ -59,34 +59,16 @@ static int KMapFreeNodeList(KMAP* km)
     return 0;
 }
 
-static void KMapFreeNode(KMAP* km, KMAPNODE* r)
-{
-    if ( r->sibling )
-        KMapFreeNode(km, r->sibling);
-
-    if ( r->child )
-        KMapFreeNode(km, r->child);
-
-    snort_free(r);
-}
-
 void KMapDelete(KMAP* km)
 {
-    for (int i=0; i<256; i++)
-    {
-        KMAPNODE* r = km->root[i];
-
-        if ( r )
-            KMapFreeNode(km,r);
-
-        km->root[i] = nullptr;
-    }
+    if ( km->table )
+        snort_free(km->table);
 
     KMapFreeNodeList(km);
     snort_free(km);
 }
 
-static KEYNODE* KMapAddKeyNode(KMAP* km,void* key, int n, void* userdata)
+static KEYNODE* KMapAddKeyNode(KMAP* km,const void* key, int n, void* userdata)
 {
     KEYNODE* knode;
 
@@ -113,11 +95,37 @@ static KEYNODE* KMapAddKeyNode(KMAP* km,void* key, int n, void* userdata)
     return knode;
 }
 
-static KMAPNODE* KMapCreateNode(KMAP* km)
+/* Orders keys by content, shorter keys first on a shared prefix */
+static inline int KMapCompare(const unsigned char* key, int n, const KEYNODE* k)
 {
-    KMAPNODE* mn=(KMAPNODE*)snort_calloc(sizeof(KMAPNODE));
-    km->nchars++;
-    return mn;
+    int min = (n < k->nkey) ? n : k->nkey;
+    int cmp = memcmp(key, k->key, min);
+
+    if ( cmp )
+        return cmp;
+
+    return n - k->nkey;
+}
+
+/* Returns the index of the key, or the insertion point as -(index + 1) */
+static int KMapLookup(const KMAP* km, const unsigned char* key, int n)
+{
+    int lo = 0;
+    int hi = km->nkeys - 1;
+
+    while ( lo <= hi )
+    {
+        int mid = lo + (hi - lo) / 2;
+        int cmp = KMapCompare(key, n, km->table[mid]);
+
+        if ( cmp < 0 )
+            hi = mid - 1;
+        else if ( cmp > 0 )
+            lo = mid + 1;
+        else
+            return mid;
+    }
+    return -(lo + 1);
 }
 
 /*
@@ -135,7 +143,6 @@ int KMapAdd(KMAP* km, void* key, int n, void* userdata)
 {
     assert(n > 0);
 
-    int type = 0;
     const unsigned char* P = (unsigned char*)key;
     std::string xkey;
 
@@ -149,108 +156,35 @@ int KMapAdd(KMAP* km, void* key, int n, void* userdata)
         P = (const unsigned char*)xkey.c_str();
     }
 
-    int ksize = n;
-    KMAPNODE* root;
+    int idx = KMapLookup(km, P, n);
 
-    //printf("adding key='%.*s'\n",n,P);
+    if ( idx >= 0 ) /* Already present */
+        return 1;
 
-    /* Make sure we at least have a root character for the tree */
-    if ( !km->root[ *P ] )
-    {
-        root = KMapCreateNode(km);
-        km->root[ *P ] = root;
-        root->nodechar = *P;
-    }
-    else
-    {
-        root = km->root[ *P ];
-    }
+    idx = -idx - 1;
 
-    /* Walk existing Patterns */
-    while ( n )
+    if ( km->nkeys == km->capacity )
     {
-        if ( root->nodechar == *P )
-        {
-            //printf("matched char = %c, nleft = %d\n",*P,n-1);
-            P++;
-            n--;
-            if ( n && root->child )
-            {
-                root=root->child;
-            }
-            else /* cannot continue */
-            {
-                type = 0; /* Expand the tree via the child */
-                break;
-            }
-        }
-        else
-        {
-            if ( root->sibling )
-            {
-                root=root->sibling;
-            }
-            else /* cannot continue */
-            {
-                type = 1; /* Expand the tree via the sibling */
-                break;
-            }
-        }
-    }
+        int cap = km->capacity ? km->capacity * 2 : 16;
+        KEYNODE** table = (KEYNODE**)snort_calloc(cap, sizeof(KEYNODE*));
 
-    /*
-    * Add the next char of the Keyword, if any
-    */
-    if ( n )
-    {
-        if ( type == 0 )
-        {
-            /*
-            *  Start with a new child to finish this Keyword
-                */
-            //printf("added child branch nodechar = %c \n",*P);
-            root->child= KMapCreateNode(km);
-            root=root->child;
-            root->nodechar  = *P;
-            P++;
-            n--;
-        }
-        else
+        if ( km->table )
         {
-            /*
-            *  Start a new sibling branch to finish this Keyword
-                */
-            //printf("added sibling branch nodechar = %c \n",*P);
-            root->sibling= KMapCreateNode(km);
-            root=root->sibling;
-            root->nodechar  = *P;
-            P++;
-            n--;
+            memcpy(table, km->table, km->nkeys * sizeof(KEYNODE*));
+            snort_free(km->table);
         }
+        km->table = table;
+        km->capacity = cap;
     }
 
-    /*
-    *    Finish the keyword as child nodes
-    */
-    while ( n )
-    {
-        //printf("added child nodechar = %c \n",*P);
-        root->child = KMapCreateNode(km);
-        root=root->child;
-        root->nodechar  = *P;
-        P++;
-        n--;
-    }
+    /* Keys are stored normalized so lookups compare bytes directly */
+    KEYNODE* knode = KMapAddKeyNode(km, P, n, userdata);
 
-    /*
-    * Iteration support - Add this key/data to the linked list
-    * This allows us to do a findfirst/findnext search of
-    * all map nodes.
-    */
-    if ( root->knode ) /* Already present */
-        return 1;
+    memmove(&km->table[idx + 1], &km->table[idx],
+        (km->nkeys - idx) * sizeof(KEYNODE*));
 
-    root->knode = KMapAddKeyNode(km, key, ksize, userdata);
+    km->table[idx] = knode;
+    km->nkeys++;
 
     return 0;
 }
@@ -276,46 +210,11 @@ void* KMapFind(KMAP* ks, void* key, int n)
 
         T = (const unsigned char*)xkey.c_str();
     }
-    //printf("finding key='%.*s'\n",n,T);
-
-    /* Check if any keywords start with this character */
-    KMAPNODE* root = ks->root[ *T ];
-    if ( !root )
-        return nullptr;
 
-    while ( n )
-    {
-        if ( root->nodechar == *T )
-        {
-            T++;
-            n--;
-            if ( n && root->child )
-            {
-                root = root->child;
-            }
-            else /* cannot continue -- match is over */
-            {
-                break;
-            }
-        }
-        else
-        {
-            if ( root->sibling )
-            {
-                root = root->sibling;
-            }
-            else /* cannot continue */
-            {
-                break;
-            }
-        }
-    }
+    int idx = KMapLookup(ks, T, n);
 
-    if ( !n )
-    {
-        if (root && root->knode)
-            return root->knode->userdata; /* success */
-    }
+    if ( idx >= 0 )
+        return ks->table[idx]->userdata; /* success */
 
     return nullptr;
 }
@@ -22,21 +22,19 @@
 #ifndef KMAP_H
 #define KMAP_H
 
-// Keyword Trie based Map Table
-// The tree uses linked lists to build the finite automata
+// Keyword Map Table
+// A flat table of key pointers kept sorted for binary search
 //
 // MapKeyFind(): Performs a setwise strcmp() equivalent.
 //
 // Keys may be ascii or binary, both may be of random sizes.  Each key may
 // be a different size, or all one size.  Fast dictionary lookup,
-// proportional to the length of the key, and independent of the number of
-// keys in the table.  May use more memory than a hash table, depends.
-// Memory is allocated as needed, so none is wasted.
+// proportional to the length of the key and the log of the number of keys
+// in the table.  The sorted pointer array keeps lookups cache dense; this
+// replaced a per character trie whose nodes scattered across the heap.
 
 #include "main/snort_types.h"
 
-#define ALPHABET_SIZE 256
-
 typedef struct _keynode
 {
     struct  _keynode* next;
@@ -46,28 +44,18 @@ typedef struct _keynode
     void* userdata;          /* data associated with this pattern */
 } KEYNODE;
 
-typedef struct _kmapnode
-{
-    int nodechar;     /* node character */
-
-    struct  _kmapnode* sibling;
-    struct  _kmapnode* child;
-
-    KEYNODE* knode;
-} KMAPNODE;
-
 typedef void (* KMapUserFreeFunc)(void* p);
 
 typedef struct _kmap
 {
-    KMAPNODE* root[256]; /* KTrie nodes */
+    KEYNODE** table; // key+data pairs sorted by key for binary search
+    int nkeys;
+    int capacity;
 
     KEYNODE* keylist; // list of key+data pairs
     KEYNODE* keynext; // findfirst/findnext node
 
     KMapUserFreeFunc userfree;
-
-    int nchars;      // # character nodes
     bool nocase;
 
 } KMAP;
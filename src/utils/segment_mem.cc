@@ -31,9 +31,44 @@ static MEM_OFFSET unused_ptr = 0;
 static size_t unused_mem = 0;
 static void* base_ptr = nullptr;
 
+/* every block but the first is preceded by a header recording its total
+ * size so segment_free() can recycle the block.  the first allocation
+ * anchors the segment: sfrt resolves stored offsets against it, so it
+ * must land at offset 0.  it gets no header and is never recycled
+ * (segment_free(0) is a no-op).  freed blocks are kept on an address
+ * ordered list threaded through their headers so adjacent blocks
+ * coalesce and the tail of the segment is handed back to the bump
+ * region, compacting in place. */
+struct BlockHeader
+{
+    uint32_t size;    /* total bytes including this header */
+    MEM_OFFSET next;  /* next free block when on the free list */
+};
+
+#define SEGMENT_ALIGN 8
+
+static MEM_OFFSET free_list = 0;
+static size_t freed_mem = 0;
+
+static inline BlockHeader* block_at(MEM_OFFSET off)
+{
+    return (BlockHeader*)((uint8_t*)base_ptr + off);
+}
+
+static inline size_t block_size(size_t size)
+{
+    size = (size + SEGMENT_ALIGN - 1) & ~(size_t)(SEGMENT_ALIGN - 1);
+    return size + sizeof(BlockHeader);
+}
+
 size_t segment_unusedmem()
 {
-    return unused_mem;
+    return unused_mem + freed_mem;
+}
+
+size_t segment_usedmem()
+{
+    return unused_ptr;
 }
 
 /***************************************************************************
@@ -47,45 +82,187 @@ int segment_meminit(uint8_t* buff, size_t mem_cap)
     base_ptr = buff;
     unused_ptr = 0;
     unused_mem = mem_cap;
+    free_list = 0;
+    freed_mem = 0;
+    return 1;
+}
+
+/***************************************************************************
+ *  Rebind the allocator to a segment that already holds "used" bytes of
+ *  live data, e.g. a copy of a previously built segment. Subsequent
+ *  allocations extend the copied data.
+ * Return values:
+ *   1: success
+ *   0: fail
+ **************************************************************************/
+int segment_memrestore(uint8_t* buff, size_t mem_cap, size_t used)
+{
+    if (used > mem_cap)
+        return 0;
+
+    base_ptr = buff;
+    unused_ptr = (MEM_OFFSET)used;
+    unused_mem = mem_cap - used;
+
+    /* the copy starts a new generation: blocks freed in the source
+     * segment were reused or returned to the tail there, so the copy
+     * begins with a clean free list */
+    free_list = 0;
+    freed_mem = 0;
     return 1;
 }
 
 /***************************************************************************
  * allocate memory block from segment
- * todo:currently, we only allocate memory continuously. Need to reuse freed
- *      memory in the future.
+ * freed blocks are reused first fit and split when the remainder can
+ * hold another block; otherwise the block is carved from the unused
+ * tail of the segment.
  * return:
  *    0: fail
  *    other: the offset of the allocated memory block
  **************************************************************************/
 MEM_OFFSET segment_snort_alloc(size_t size)
 {
-    MEM_OFFSET current_ptr = unused_ptr;
+    /* first allocation from a fresh segment: headerless, at offset 0 */
+    if (unused_ptr == 0 and free_list == 0)
+    {
+        size = (size + SEGMENT_ALIGN - 1) & ~(size_t)(SEGMENT_ALIGN - 1);
+
+        if (unused_mem < size)
+            return 0;
 
-    if (unused_mem < size)
+        unused_ptr = (MEM_OFFSET)size;
+        unused_mem -= size;
         return 0;
+    }
 
-    unused_ptr += size;
-    unused_mem -= size;
+    size_t total = block_size(size);
+    MEM_OFFSET prev = 0;
+    MEM_OFFSET cur = free_list;
 
-    return current_ptr;
+    while (cur)
+    {
+        BlockHeader* h = block_at(cur);
+
+        if (h->size >= total)
+        {
+            if (h->size - total >= block_size(SEGMENT_ALIGN))
+            {
+                /* split; the remainder stays on the free list */
+                MEM_OFFSET rest = cur + (MEM_OFFSET)total;
+                BlockHeader* r = block_at(rest);
+                r->size = h->size - (uint32_t)total;
+                r->next = h->next;
+                h->size = (uint32_t)total;
+
+                if (prev)
+                    block_at(prev)->next = rest;
+                else
+                    free_list = rest;
+            }
+            else
+            {
+                if (prev)
+                    block_at(prev)->next = h->next;
+                else
+                    free_list = h->next;
+            }
+
+            freed_mem -= h->size;
+            h->next = 0;
+            return cur + sizeof(BlockHeader);
+        }
+
+        prev = cur;
+        cur = h->next;
+    }
+
+    if (unused_mem < total)
+        return 0;
+
+    MEM_OFFSET block = unused_ptr;
+    unused_ptr += total;
+    unused_mem -= total;
+
+    BlockHeader* h = block_at(block);
+    h->size = (uint32_t)total;
+    h->next = 0;
+
+    return block + sizeof(BlockHeader);
 }
 
 /***************************************************************************
  * Free memory block from segment
- * Todo: currently, no action for free. Need to reuse freed memory in the
- *       future.
+ * the block goes onto the address ordered free list, coalesces with
+ * adjacent free neighbors, and when it ends at the allocation frontier
+ * it is handed back to the unused tail so the segment compacts in place.
  **************************************************************************/
 
-void segment_free(MEM_OFFSET)
+void segment_free(MEM_OFFSET ptr)
 {
+    if (!ptr)
+        return;
+
+    MEM_OFFSET block = ptr - sizeof(BlockHeader);
+    BlockHeader* h = block_at(block);
+
+    MEM_OFFSET prev = 0;
+    MEM_OFFSET prev2 = 0;
+    MEM_OFFSET cur = free_list;
+
+    while (cur and cur < block)
+    {
+        prev2 = prev;
+        prev = cur;
+        cur = block_at(cur)->next;
+    }
+
+    h->next = cur;
+
+    if (prev)
+        block_at(prev)->next = block;
+    else
+        free_list = block;
+
+    freed_mem += h->size;
+
+    /* coalesce with the following neighbor */
+    if (cur and block + h->size == cur)
+    {
+        h->size += block_at(cur)->size;
+        h->next = block_at(cur)->next;
+    }
+
+    /* coalesce with the preceding neighbor */
+    MEM_OFFSET pred = prev;
+
+    if (prev and prev + block_at(prev)->size == block)
+    {
+        BlockHeader* ph = block_at(prev);
+        ph->size += h->size;
+        ph->next = h->next;
+        block = prev;
+        h = ph;
+        pred = prev2;
+    }
+
+    /* release the tail back to the bump region */
+    if (block + h->size == unused_ptr)
+    {
+        if (pred)
+            block_at(pred)->next = h->next;
+        else
+            free_list = h->next;
+
+        unused_ptr = block;
+        unused_mem += h->size;
+        freed_mem -= h->size;
+    }
 }
 
 /***************************************************************************
  * allocate memory block from segment and initialize it to zero
  * It calls segment_snort_alloc() to get memory.
- * todo:currently, we only allocate memory continuously. Need to reuse freed
- *      memory in the future.
  * return:
  *    0: fail
  *    other: the offset of the allocated memory block
@@ -114,3 +291,44 @@ void* segment_basePtr()
     return base_ptr;
 }
 
+
+#ifdef UNIT_TEST
+#include "catch/snort_catch.h"
+
+TEST_CASE("segment mem block reuse", "[segment_mem]")
+{
+    static uint8_t seg[4096];
+    REQUIRE(segment_meminit(seg, sizeof(seg)) == 1);
+
+    // the first allocation anchors the segment at offset 0
+    REQUIRE(segment_snort_alloc(64) == 0);
+
+    MEM_OFFSET a = segment_snort_alloc(100);
+    MEM_OFFSET b = segment_snort_alloc(200);
+    MEM_OFFSET c = segment_snort_alloc(50);
+    REQUIRE(a != 0);
+    REQUIRE(b != 0);
+    REQUIRE(c != 0);
+
+    size_t used = segment_usedmem();
+
+    // a freed block is reused in place
+    segment_free(b);
+    REQUIRE(segment_snort_alloc(200) == b);
+    REQUIRE(segment_usedmem() == used);
+
+    // adjacent freed blocks coalesce
+    segment_free(b);
+    segment_free(a);
+    REQUIRE(segment_snort_alloc(300) == a);
+
+    // freeing the newest block rewinds the allocation frontier
+    segment_free(c);
+    REQUIRE(segment_usedmem() < used);
+    REQUIRE(segment_snort_alloc(50) == c);
+
+    // an impossible request fails without disturbing the segment
+    REQUIRE(segment_snort_alloc(1 << 20) == 0);
+    REQUIRE(segment_snort_alloc(50) != 0);
+}
+#endif
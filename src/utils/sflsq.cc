@@ -37,6 +37,54 @@
 
 #include "util.h"
 
+#define SFLSQ_BLOCK_NODES 32
+
+struct sf_lblock
+{
+    struct sf_lblock* next;
+    SF_LNODE nodes[SFLSQ_BLOCK_NODES];
+};
+
+static SF_LNODE* sflist_alloc_node(SF_LIST* s)
+{
+    if ( s->free_nodes )
+    {
+        SF_LNODE* q = s->free_nodes;
+        s->free_nodes = q->next;
+        return q;
+    }
+
+    if ( !s->blocks || s->block_used == SFLSQ_BLOCK_NODES )
+    {
+        sf_lblock* b = (sf_lblock*)snort_calloc(sizeof(sf_lblock));
+        b->next = s->blocks;
+        s->blocks = b;
+        s->block_used = 0;
+    }
+
+    return &s->blocks->nodes[s->block_used++];
+}
+
+static void sflist_free_node(SF_LIST* s, SF_LNODE* q)
+{
+    q->next = s->free_nodes;
+    s->free_nodes = q;
+}
+
+static void sflist_release_blocks(SF_LIST* s)
+{
+    for ( sf_lblock* b = s->blocks; b; )
+    {
+        sf_lblock* old = b;
+        b = b->next;
+        snort_free(old);
+    }
+
+    s->blocks = nullptr;
+    s->free_nodes = nullptr;
+    s->block_used = 0;
+}
+
 namespace snort
 {
 SF_LIST* sflist_new()
@@ -50,6 +98,9 @@ void sflist_init(SF_LIST* s)
 {
     s->count = 0;
     s->head = s->tail = nullptr;
+    s->free_nodes = nullptr;
+    s->blocks = nullptr;
+    s->block_used = 0;
 }
 
 void sflist_add_before(SF_LIST* s, SF_LNODE* lnode, NODE_DATA ndata)
@@ -61,7 +112,7 @@ void sflist_add_before(SF_LIST* s, SF_LNODE* lnode, NODE_DATA ndata)
             sflist_add_head (s, ndata);
         else
         {
-            SF_LNODE* q = (SF_LNODE*)snort_calloc(sizeof (SF_LNODE));
+            SF_LNODE* q = sflist_alloc_node(s);
             q->ndata = (NODE_DATA)ndata;
             q->next = lnode;
             q->prev = lnode->prev;
@@ -77,14 +128,14 @@ void sflist_add_head(SF_LIST* s, NODE_DATA ndata)
     SF_LNODE* q;
     if (!s->head)
     {
-        q = s->tail = s->head = (SF_LNODE*)snort_calloc(sizeof (SF_LNODE));
+        q = s->tail = s->head = sflist_alloc_node(s);
         q->ndata = (NODE_DATA)ndata;
         q->next = nullptr;
         q->prev = nullptr;
     }
     else
     {
-        q = (SF_LNODE*)snort_calloc(sizeof (SF_LNODE));
+        q = sflist_alloc_node(s);
         q->ndata = ndata;
         q->next = s->head;
         q->prev = nullptr;
@@ -99,14 +150,14 @@ void sflist_add_tail(SF_LIST* s, NODE_DATA ndata)
     SF_LNODE* q;
     if (!s->head)
     {
-        q = s->tail = s->head = (SF_LNODE*)snort_calloc(sizeof (SF_LNODE));
+        q = s->tail = s->head = sflist_alloc_node(s);
         q->ndata = (NODE_DATA)ndata;
         q->next = nullptr;
         q->prev = nullptr;
     }
     else
     {
-        q = (SF_LNODE*)snort_calloc(sizeof (SF_LNODE));
+        q = sflist_alloc_node(s);
         q->ndata = ndata;
         q->next = nullptr;
         q->prev = s->tail;
@@ -158,7 +209,7 @@ NODE_DATA sflist_remove_head(SF_LIST* s)
         else
             s->head->prev = nullptr;
 
-        snort_free(q);
+        sflist_free_node(s, q);
     }
     return (NODE_DATA)ndata;
 }
@@ -180,7 +231,7 @@ NODE_DATA sflist_remove_tail(SF_LIST* s)
         else
             s->tail->next = nullptr;
 
-        snort_free(q);
+        sflist_free_node(s, q);
     }
     return (NODE_DATA)ndata;
 }
@@ -198,6 +249,7 @@ void sflist_free(SF_LIST* s)
     {
         sflist_remove_head(s);
     }
+    sflist_release_blocks(s);
     snort_free(s);
 }
 
@@ -213,6 +265,7 @@ void sflist_free_all(SF_LIST* s, void (* nfree)(void*) )
         if ( p && nfree )
             nfree(p);
     }
+    sflist_release_blocks(s);
     snort_free(s);
 }
 
@@ -228,6 +281,7 @@ void sflist_static_free_all(SF_LIST* s, void (* nfree)(void*) )
         if ( p && nfree )
             nfree(p);
     }
+    sflist_release_blocks(s);
 }
 
 }
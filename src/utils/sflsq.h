@@ -37,10 +37,19 @@ typedef struct sf_lnode
 }
 SF_LNODE;
 
+struct sf_lblock;
+
 struct sf_list
 {
     SF_LNODE* head, * tail;
     unsigned count;
+
+    /* Nodes are carved from chained blocks instead of allocated one at a
+     * time so list walks stay cache dense; removed nodes are recycled via
+     * the free list and blocks are released when the list is freed. */
+    SF_LNODE* free_nodes;
+    struct sf_lblock* blocks;
+    unsigned block_used;
 };
 
 typedef sf_list SF_LIST;
@@ -24,9 +24,12 @@
 #include "stats.h"
 
 #include <cassert>
+#include <fstream>
+#include <map>
 
 #include "detection/detection_engine.h"
 #include "file_api/file_stats.h"
+#include "framework/data_bus.h"
 #include "filters/sfthreshold.h"
 #include "framework/module.h"
 #include "helpers/process.h"
@@ -50,7 +53,7 @@ ProcessCount proc_stats;
 namespace snort
 {
 
-THREAD_LOCAL PacketCount pc;
+PEG_SLAB_ALIGN THREAD_LOCAL PacketCount pc;
 
 //-------------------------------------------------------------------------
 
@@ -204,9 +207,29 @@ const PegInfo pc_names[] =
     { CountType::SUM, "offload_fallback", "fast pattern offload search fallback attempts" },
     { CountType::SUM, "offload_failures", "fast pattern offload search failures" },
     { CountType::SUM, "offload_suspends", "fast pattern search suspends due to offload context chains" },
+    { CountType::MAX, "offload_depth", "peak number of concurrently offloaded contexts" },
+    { CountType::SUM, "offload_wait_us", "microseconds spent blocked waiting for offload results" },
+    { CountType::SUM, "offload_boosts", "offloads admitted below the limit while running a backlog" },
+    { CountType::SUM, "response_templates", "tcp resets built from the preformatted response template" },
+    { CountType::SUM, "inject_templates", "tcp data segments built from the preformatted inject template" },
+    { CountType::SUM, "flow_data_pool_hits", "flow data allocations served from the per thread pool" },
+    { CountType::SUM, "flow_data_pool_misses", "flow data allocations that fell through to the heap" },
+    { CountType::SUM, "svc_memo_skips", "rule subtree evaluations skipped by the memoized service check" },
+    { CountType::SUM, "fp_confirm_skips", "content re-searches elided because the fast pattern match was conclusive" },
+    { CountType::SUM, "event_sort_skips", "queued event entries left unsorted by top-K selection" },
     { CountType::SUM, "pcre_match_limit", "total number of times pcre hit the match limit" },
     { CountType::SUM, "pcre_recursion_limit", "total number of times pcre hit the recursion limit" },
     { CountType::SUM, "pcre_error", "total number of times pcre returns error" },
+    { CountType::SUM, "pcre_jit_evals", "pcre evaluations run by the jit engine" },
+    { CountType::SUM, "pcre_interp_evals", "pcre evaluations run by the interpreter" },
+    { CountType::SUM, "content_cmp_evals", "anchored content checks using the vector compare fast path" },
+    { CountType::SUM, "content_search_evals", "content checks running a full literal search" },
+    { CountType::SUM, "byte_fused_evals", "rule evals that ran a fused byte option chain" },
+    { CountType::SUM, "cursor_scratch_fallbacks", "cursor data arrays heap allocated because the context scratchpad was full" },
+    { CountType::SUM, "ipvar_pos_hits", "ip variable lookups matching a positive interval" },
+    { CountType::SUM, "ipvar_neg_hits", "ip variable lookups rejected by a negated interval" },
+    { CountType::SUM, "ipvar_misses", "ip variable lookups matching no interval" },
+    { CountType::SUM, "ipvar_list_walks", "ip variable lookups that fell back to walking the node lists" },
     { CountType::END, nullptr, nullptr }
 };
 
@@ -222,6 +245,8 @@ const PegInfo proc_names[] =
     { CountType::SUM, "attribute_table_reloads", "number of times hosts attribute table was reloaded" },
     { CountType::SUM, "attribute_table_hosts", "number of hosts added to the attribute table" },
     { CountType::SUM, "attribute_table_overflow", "number of host additions that failed due to attribute table full" },
+    { CountType::SUM, "pcap_readaheads", "pcap files staged in the page cache before the analysis thread needed them" },
+    { CountType::SUM, "pcap_readahead_bytes", "total bytes pre-read from upcoming pcap files" },
     { CountType::END, nullptr, nullptr }
 };
 
@@ -239,11 +264,133 @@ void DropStats()
     ModuleManager::dump_stats(exclude, false);
     ModuleManager::dump_stats(exclude, true);
 
+    // publish rates per event show which pub sub traffic is driving the
+    // constant per transaction dispatch overhead
+    std::map<std::string, PegCount> event_pubs;
+    DataBus::get_publish_counts(event_pubs);
+
+    if ( !event_pubs.empty() )
+    {
+        LogLabel("Event Statistics");
+
+        for ( const auto& ep : event_pubs )
+            LogCount(ep.first.c_str(), ep.second);
+    }
+
     LogLabel("Summary Statistics");
     show_stats((PegCount*)&proc_stats, proc_names, array_size(proc_names)-1, "process");
 
 }
 
+//-------------------------------------------------------------------------
+// trough shard stats
+//
+// when --trough-shard is used, each process dumps its final counters to
+// <log_dir>/trough_shard_<i>.stats and whichever process finishes last
+// (sees all n shard files present) folds them into
+// trough_shards_merged.stats.  files are written to a temp name and
+// renamed so partially written files are never read, and the merge is
+// idempotent, so concurrent finishers writing the summary is harmless.
+//-------------------------------------------------------------------------
+
+static void write_shard_counters(FILE* fh)
+{
+    for ( Module* m : ModuleManager::get_all_modules() )
+    {
+        const PegInfo* info = m->get_pegs();
+        PegCount* counts = m->get_counts();
+
+        if ( !info || !counts )
+            continue;
+
+        for ( unsigned i = 0; info[i].name; i++ )
+            if ( counts[i] )
+                fprintf(fh, "%s.%s " STDu64 "\n", m->get_name(), info[i].name, counts[i]);
+    }
+
+    const PegCount* pegs = (const PegCount*)&proc_stats;
+
+    for ( unsigned i = 0; i < array_size(proc_names) - 1; i++ )
+        if ( pegs[i] )
+            fprintf(fh, "process.%s " STDu64 "\n", proc_names[i].name, pegs[i]);
+}
+
+static void merge_shard_stats(const std::string& dir, unsigned count)
+{
+    // keep first-seen order so the summary reads like a shard file
+    std::vector<std::pair<std::string, PegCount>> sums;
+    std::map<std::string, size_t> index;
+
+    for ( unsigned i = 0; i < count; i++ )
+    {
+        std::ifstream in(dir + "/trough_shard_" + std::to_string(i) + ".stats");
+
+        // not all shards have finished; a later finisher will merge
+        if ( !in.is_open() )
+            return;
+
+        std::string name;
+        PegCount val;
+
+        while ( in >> name >> val )
+        {
+            auto it = index.find(name);
+            if ( it == index.end() )
+            {
+                index[name] = sums.size();
+                sums.emplace_back(name, val);
+            }
+            else
+                sums[it->second].second += val;
+        }
+    }
+
+    std::string merged = dir + "/trough_shards_merged.stats";
+    std::string tmp = merged + ".tmp";
+    FILE* fh = fopen(tmp.c_str(), "w");
+
+    if ( !fh )
+    {
+        ErrorMessage("Could not write merged trough shard stats: %s\n", get_error(errno));
+        return;
+    }
+
+    for ( const auto& sum : sums )
+        fprintf(fh, "%s " STDu64 "\n", sum.first.c_str(), sum.second);
+
+    fclose(fh);
+    rename(tmp.c_str(), merged.c_str());
+    LogMessage("Merged stats for %u trough shards into %s\n", count, merged.c_str());
+}
+
+static void shard_stats()
+{
+    const unsigned count = Trough::get_shard_count();
+
+    if ( count < 2 )
+        return;
+
+    const SnortConfig* sc = SnortConfig::get_conf();
+    std::string dir = sc->log_dir.empty() ? "." : sc->log_dir;
+
+    std::string mine = dir + "/trough_shard_" +
+        std::to_string(Trough::get_shard_index()) + ".stats";
+    std::string tmp = mine + ".tmp";
+    FILE* fh = fopen(tmp.c_str(), "w");
+
+    if ( !fh )
+    {
+        ErrorMessage("Could not write trough shard stats: %s\n", get_error(errno));
+        return;
+    }
+
+    write_shard_counters(fh);
+    fclose(fh);
+    rename(tmp.c_str(), mine.c_str());
+
+    merge_shard_stats(dir, count);
+}
+
 //-------------------------------------------------------------------------
 
 void PrintStatistics()
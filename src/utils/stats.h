@@ -66,9 +66,29 @@ struct PacketCount
     PegCount offload_fallback;
     PegCount offload_failures;
     PegCount offload_suspends;
+    PegCount offload_depth;
+    PegCount offload_wait_us;
+    PegCount offload_boosts;
+    PegCount response_templates;
+    PegCount inject_templates;
+    PegCount flow_data_pool_hits;
+    PegCount flow_data_pool_misses;
+    PegCount svc_memo_skips;
+    PegCount fp_confirm_skips;
+    PegCount event_sort_skips;
     PegCount pcre_match_limit;
     PegCount pcre_recursion_limit;
     PegCount pcre_error;
+    PegCount pcre_jit_evals;
+    PegCount pcre_interp_evals;
+    PegCount content_cmp_evals;
+    PegCount content_search_evals;
+    PegCount byte_fused_evals;
+    PegCount cursor_scratch_fallbacks;
+    PegCount ipvar_pos_hits;
+    PegCount ipvar_neg_hits;
+    PegCount ipvar_misses;
+    PegCount ipvar_list_walks;
 };
 
 struct ProcessCount
@@ -83,6 +103,8 @@ struct ProcessCount
     PegCount attribute_table_reloads;
     PegCount attribute_table_hosts;
     PegCount attribute_table_overflow;
+    PegCount pcap_readaheads;
+    PegCount pcap_readahead_bytes;
 };
 
 extern ProcessCount proc_stats;
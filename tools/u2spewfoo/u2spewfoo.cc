@@ -319,11 +319,9 @@ static void print_addr_port(
     printf("\t%s IP: %s\tPort: %hu\n", which, ip_buf, htons(port));
 }
 
-static void event3_dump(u2record* record)
+// takes the record in network order, as written
+static void event3_print(const Unified2Event& event)
 {
-    Unified2Event event;
-    memcpy(&event, record->data, sizeof(event));
-
     printf("%s", "\n(Event)\n");
 
     printf("\tSnort ID: %u\tEvent ID: %u\tSeconds: %u.%06u\n",
@@ -355,6 +353,165 @@ static void event3_dump(u2record* record)
         get_status(event.snort_status), get_action(event.snort_action));
 }
 
+static void event3_dump(u2record* record)
+{
+    Unified2Event event;
+    memcpy(&event, record->data, sizeof(event));
+    event3_print(event);
+}
+
+//--------------------------------------------------------------------------
+// compact event support - see log/unified2.h for the wire format
+//--------------------------------------------------------------------------
+
+// previous record values; compact deltas are relative to the prior
+// compact record in the same file
+struct U2CompactPrev
+{
+    uint32_t snort_id;
+    uint32_t event_id;
+    uint32_t event_second;
+    uint32_t rule_gid;
+    uint32_t rule_sid;
+    uint32_t policy_id_context;
+    uint32_t policy_id_inspect;
+    uint32_t policy_id_detect;
+};
+
+static bool get_varint(const uint8_t*& p, const uint8_t* end, uint64_t& v)
+{
+    v = 0;
+
+    for ( unsigned shift = 0; p < end and shift < 64; shift += 7 )
+    {
+        uint8_t b = *p++;
+        v |= (uint64_t)(b & 0x7F) << shift;
+
+        if ( !(b & 0x80) )
+            return true;
+    }
+    return false;
+}
+
+static bool get_delta(const uint8_t*& p, const uint8_t* end, uint32_t& prev)
+{
+    uint64_t z;
+
+    if ( !get_varint(p, end, z) )
+        return false;
+
+    int64_t d = (int64_t)(z >> 1) ^ -(int64_t)(z & 1);
+    prev = (uint32_t)((int64_t)prev + d);
+    return true;
+}
+
+static bool get_addr(const uint8_t*& p, const uint8_t* end, unsigned ver, uint32_t* addr)
+{
+    unsigned n = (ver == 0x6) ? 16 : 4;
+
+    if ( p + n > end )
+        return false;
+
+    if ( n == 16 )
+        memcpy(addr, p, 16);
+    else
+        memcpy(addr + 3, p, 4);
+
+    p += n;
+    return true;
+}
+
+static void event3_compact_dump(u2record* record, U2CompactPrev& prev)
+{
+    const uint8_t* p = record->data;
+    const uint8_t* end = p + record->length;
+    uint64_t v = 0;
+
+    Unified2Event event;
+    memset(&event, 0, sizeof(event));
+
+    // rebuild the fixed record in network order so it prints like one
+    bool ok = get_delta(p, end, prev.snort_id);
+    event.snort_id = htonl(prev.snort_id);
+
+    ok = ok and get_delta(p, end, prev.event_id);
+    event.event_id = htonl(prev.event_id);
+
+    ok = ok and get_delta(p, end, prev.event_second);
+    event.event_second = htonl(prev.event_second);
+
+    ok = ok and get_varint(p, end, v);
+    event.event_microsecond = htonl((uint32_t)v);
+
+    ok = ok and get_delta(p, end, prev.rule_gid);
+    event.rule_gid = htonl(prev.rule_gid);
+
+    ok = ok and get_delta(p, end, prev.rule_sid);
+    event.rule_sid = htonl(prev.rule_sid);
+
+    ok = ok and get_varint(p, end, v);
+    event.rule_rev = htonl((uint32_t)v);
+
+    ok = ok and get_varint(p, end, v);
+    event.rule_class = htonl((uint32_t)v);
+
+    ok = ok and get_varint(p, end, v);
+    event.rule_priority = htonl((uint32_t)v);
+
+    ok = ok and get_delta(p, end, prev.policy_id_context);
+    event.policy_id_context = htonl(prev.policy_id_context);
+
+    ok = ok and get_delta(p, end, prev.policy_id_inspect);
+    event.policy_id_inspect = htonl(prev.policy_id_inspect);
+
+    ok = ok and get_delta(p, end, prev.policy_id_detect);
+    event.policy_id_detect = htonl(prev.policy_id_detect);
+
+    if ( ok and p < end )
+        event.pkt_ip_ver = *p++;
+    else
+        ok = false;
+
+    ok = ok and get_addr(p, end, event.pkt_ip_ver >> 4, event.pkt_src_ip);
+    ok = ok and get_addr(p, end, event.pkt_ip_ver & 0xF, event.pkt_dst_ip);
+
+    ok = ok and get_varint(p, end, v);
+    event.pkt_src_port_itype = htons((uint16_t)v);
+
+    ok = ok and get_varint(p, end, v);
+    event.pkt_dst_port_icode = htons((uint16_t)v);
+
+    ok = ok and get_varint(p, end, v);
+    event.pkt_vlan_id = htons((uint16_t)v);
+
+    ok = ok and get_varint(p, end, v);
+    event.pkt_mpls_label = htonl((uint32_t)v);
+
+    if ( ok and p + 3 <= end )
+    {
+        event.pkt_ip_proto = *p++;
+        event.snort_status = *p++;
+        event.snort_action = *p++;
+    }
+    else
+        ok = false;
+
+    ok = ok and get_varint(p, end, v);
+
+    if ( ok and v < sizeof(event.app_name) and p + v <= end )
+        memcpy(event.app_name, p, v);
+    else if ( v )
+        ok = false;
+
+    if ( !ok )
+    {
+        printf("WARNING: skipping malformed compact event record\n");
+        return;
+    }
+
+    event3_print(event);
+}
+
 static void event2_dump(u2record* record)
 {
     uint8_t* field;
@@ -546,8 +703,10 @@ static int u2dump(char* file)
 {
     u2record record;
     u2iterator* it = new_iterator(file);
+    U2CompactPrev prev;
 
     memset(&record, 0, sizeof(record));
+    memset(&prev, 0, sizeof(prev));
 
     if (!it)
     {
@@ -560,6 +719,9 @@ static int u2dump(char* file)
         if ( record.type == UNIFIED2_EVENT3 and record.length == sizeof(Unified2Event) )
             event3_dump(&record);
 
+        else if ( record.type == UNIFIED2_EVENT3_COMPACT )
+            event3_compact_dump(&record, prev);
+
         else if ( (record.type == UNIFIED2_PACKET) or (record.type == UNIFIED2_BUFFER) )
             packet_dump(&record);
 